@@ -0,0 +1,237 @@
+/**
+ * @file BenchmarkSupport.cpp
+ * @brief Implementation of the benchmark fixtures and counters
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "BenchmarkSupport.h"
+
+#include "core/CDicomLoader.h"
+
+#include <dcmtk/config/osconfig.h>
+#include <dcmtk/dcmdata/dctk.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace
+{
+std::atomic<uint64_t> g_allocationCount{0};
+
+/**
+ * @brief Deterministic pixel content: gradient plus pseudo-random noise
+ *
+ * Enough structure that histograms and LUT ranges are realistic, and
+ * the same bytes on every run so results compare across versions.
+ */
+template <typename T>
+std::vector<T> makeSamples(const BenchmarkSupport::SSyntheticSpec &spec)
+{
+    const size_t count = static_cast<size_t>(spec.width) * spec.height * spec.samplesPerPixel;
+    const int64_t range = static_cast<int64_t>(spec.maxValue) - spec.minValue + 1;
+    std::vector<T> samples(count);
+    uint32_t state = 0x9E3779B9u;
+    for (size_t i = 0; i < count; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const size_t pixel = i / spec.samplesPerPixel;
+        const int64_t x = static_cast<int64_t>(pixel % spec.width);
+        const int64_t y = static_cast<int64_t>(pixel / spec.width);
+        const int64_t gradient = (x * range) / spec.width / 2 + (y * range) / spec.height / 2;
+        const int64_t noise = static_cast<int64_t>(state >> 24) - 128;
+        const int64_t value = (gradient + noise) % range;
+        samples[i] = static_cast<T>(spec.minValue + (value < 0 ? value + range : value));
+    }
+    return samples;
+}
+
+bool writeSyntheticFile(const BenchmarkSupport::SSyntheticSpec &spec, const std::string &path)
+{
+    DcmFileFormat fileFormat;
+    DcmDataset *dataset = fileFormat.getDataset();
+
+    char uid[100];
+    dataset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dataset->putAndInsertString(DCM_SOPInstanceUID,
+                                dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+    dataset->putAndInsertString(DCM_PatientName, "Benchmark^Synthetic");
+    dataset->putAndInsertString(DCM_PatientID, spec.name);
+    dataset->putAndInsertString(DCM_Modality, "OT");
+    dataset->putAndInsertUint16(DCM_Rows, static_cast<Uint16>(spec.height));
+    dataset->putAndInsertUint16(DCM_Columns, static_cast<Uint16>(spec.width));
+    dataset->putAndInsertUint16(DCM_SamplesPerPixel, spec.samplesPerPixel);
+    dataset->putAndInsertString(DCM_PhotometricInterpretation,
+                                spec.samplesPerPixel == 3 ? "RGB" : "MONOCHROME2");
+    if (spec.samplesPerPixel == 3)
+    {
+        dataset->putAndInsertUint16(DCM_PlanarConfiguration, 0);
+    }
+    dataset->putAndInsertUint16(DCM_BitsAllocated, spec.bitsAllocated);
+    dataset->putAndInsertUint16(DCM_BitsStored, spec.bitsAllocated);
+    dataset->putAndInsertUint16(DCM_HighBit, static_cast<Uint16>(spec.bitsAllocated - 1));
+    dataset->putAndInsertUint16(DCM_PixelRepresentation, spec.isSigned ? 1 : 0);
+
+    OFCondition status;
+    if (spec.bitsAllocated == 16)
+    {
+        const auto samples = makeSamples<Uint16>(spec);
+        status = dataset->putAndInsertUint16Array(DCM_PixelData, samples.data(),
+                                                  static_cast<unsigned long>(samples.size()));
+    }
+    else
+    {
+        const auto samples = makeSamples<Uint8>(spec);
+        status = dataset->putAndInsertUint8Array(DCM_PixelData, samples.data(),
+                                                 static_cast<unsigned long>(samples.size()));
+    }
+    if (status.bad())
+    {
+        return false;
+    }
+    return fileFormat.saveFile(path.c_str(), EXS_LittleEndianExplicit).good();
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace BenchmarkSupport
+{
+/**
+ * @brief Writes the synthetic file once per process and returns its path
+ * @param spec Image layout
+ * @return Path of an uncompressed little-endian DICOM file, empty on failure
+ */
+std::string syntheticFile(const SSyntheticSpec &spec)
+{
+    static std::mutex s_mutex;
+    static std::map<std::string, std::string> s_written;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_written.find(spec.name);
+    if (it != s_written.end())
+    {
+        return it->second;
+    }
+
+    std::error_code error;
+    const auto directory = std::filesystem::temp_directory_path(error) / "dicom-visualizer-benchmarks";
+    std::filesystem::create_directories(directory, error);
+    const std::string path = (directory / (std::string(spec.name) + ".dcm")).string();
+    const std::string result = writeSyntheticFile(spec, path) ? path : std::string();
+    s_written.emplace(spec.name, result);
+    return result;
+}
+
+/**
+ * @brief All synthetic specs plus the repository sample
+ * @return Inputs in a stable order
+ */
+std::vector<SInput> standardInputs()
+{
+    std::vector<SInput> inputs;
+    for (const auto &spec : {kCtSigned, kCtUnsigned, kMammo, kXa8, kUltrasound})
+    {
+        inputs.push_back({spec.name, [spec]()
+                          { return syntheticFile(spec); }});
+    }
+    inputs.push_back({"anonymized_mamo.dcm", []()
+                      { return sampleFile("anonymized_mamo.dcm"); }});
+    return inputs;
+}
+
+/**
+ * @brief Path of a file in the repository's samples/ directory
+ * @param name File name
+ * @return Full path, empty if the file does not exist
+ */
+std::string sampleFile(const char *name)
+{
+    const auto path = std::filesystem::path(DICOM_SAMPLES_DIR) / name;
+    std::error_code error;
+    return std::filesystem::exists(path, error) ? path.string() : std::string();
+}
+
+/**
+ * @brief Loads a file once per process with pixels resident
+ * @param path DICOM file
+ * @return Shared image, nullptr if loading failed
+ */
+std::shared_ptr<const CDicomImage> loadedImage(const std::string &path)
+{
+    static std::mutex s_mutex;
+    static std::map<std::string, std::shared_ptr<const CDicomImage>> s_images;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_images.find(path);
+    if (it != s_images.end())
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<const CDicomImage> image;
+    if (!path.empty())
+    {
+        CDicomLoader loader;
+        auto [loaded, result] = loader.loadFile(path, DicomViewer::EPixelLoadPolicy::Immediate);
+        if (result == DicomViewer::ELoadResult::Success)
+        {
+            image = std::move(loaded);
+        }
+    }
+    s_images.emplace(path, image);
+    return image;
+}
+
+/**
+ * @brief Number of operator new calls since process start (all threads)
+ * @return Allocation count
+ */
+uint64_t allocationCount()
+{
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds MPix/s and allocs/call counters to a finished benchmark
+ * @param state Benchmark state after its timing loop
+ * @param pixelsPerCall Source pixels processed by one iteration
+ * @param allocationsBefore allocationCount() taken before the loop
+ */
+void reportCounters(benchmark::State &state, uint64_t pixelsPerCall, uint64_t allocationsBefore)
+{
+    const auto iterations = static_cast<double>(state.iterations());
+    if (iterations <= 0.0)
+    {
+        return;
+    }
+    const auto allocations = static_cast<double>(allocationCount() - allocationsBefore);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pixelsPerCall));
+    state.counters["MPix/s"] = benchmark::Counter(static_cast<double>(pixelsPerCall) * iterations / 1e6,
+                                                  benchmark::Counter::kIsRate);
+    state.counters["allocs/call"] = benchmark::Counter(allocations / iterations);
+}
+} // namespace BenchmarkSupport
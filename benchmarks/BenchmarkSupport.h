@@ -0,0 +1,107 @@
+/**
+ * @file BenchmarkSupport.h
+ * @brief Shared fixtures and counters for the benchmark suite
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Synthetic DICOM files of realistic sizes, a per-process image cache
+ * so conversion benchmarks do not time the loader, and the MPix/s and
+ * allocations-per-call counters every benchmark reports.
+ */
+
+#pragma once
+
+#include "core/CDicomImage.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace BenchmarkSupport
+{
+/**
+ * @brief Layout and value range of a synthetic image
+ */
+struct SSyntheticSpec
+{
+    const char *name;
+    uint32_t width;
+    uint32_t height;
+    uint16_t samplesPerPixel;
+    uint16_t bitsAllocated;
+    bool isSigned;
+    int32_t minValue;
+    int32_t maxValue;
+};
+
+// 512^2 CT slices, signed (HU) and unsigned
+constexpr SSyntheticSpec kCtSigned{"CT512_S16", 512, 512, 1, 16, true, -1024, 3071};
+constexpr SSyntheticSpec kCtUnsigned{"CT512_U16", 512, 512, 1, 16, false, 0, 4095};
+// 3k x 4k full-field mammogram, 14 bits stored
+constexpr SSyntheticSpec kMammo{"MG3328x4096_U16", 3328, 4096, 1, 16, false, 0, 16383};
+// 8-bit monochrome (XA/secondary capture)
+constexpr SSyntheticSpec kXa8{"XA1024_U8", 1024, 1024, 1, 8, false, 0, 255};
+// 8-bit RGB ultrasound frame
+constexpr SSyntheticSpec kUltrasound{"US800x600_RGB", 800, 600, 3, 8, false, 0, 255};
+
+/**
+ * @brief A named benchmark input
+ *
+ * The path is resolved when the benchmark runs, not at registration,
+ * because registration happens during static initialization.
+ */
+struct SInput
+{
+    std::string name;
+    std::function<std::string()> path;
+};
+
+/**
+ * @brief All synthetic specs plus the repository sample
+ * @return Inputs in a stable order
+ */
+std::vector<SInput> standardInputs();
+
+/**
+ * @brief Writes the synthetic file once per process and returns its path
+ * @param spec Image layout
+ * @return Path of an uncompressed little-endian DICOM file
+ */
+std::string syntheticFile(const SSyntheticSpec &spec);
+
+/**
+ * @brief Path of a file in the repository's samples/ directory
+ * @param name File name
+ * @return Full path, empty if the file does not exist
+ */
+std::string sampleFile(const char *name);
+
+/**
+ * @brief Loads a file once per process with pixels resident
+ * @param path DICOM file
+ * @return Shared image, nullptr if loading failed
+ */
+std::shared_ptr<const CDicomImage> loadedImage(const std::string &path);
+
+/**
+ * @brief Number of operator new calls since process start (all threads)
+ * @return Allocation count
+ */
+uint64_t allocationCount();
+
+/**
+ * @brief Adds MPix/s and allocs/call counters to a finished benchmark
+ *
+ * Allocations are counted through the global operator new, so buffers
+ * Qt allocates with malloc (QImage pixels) are not included.
+ *
+ * @param state Benchmark state after its timing loop
+ * @param pixelsPerCall Source pixels processed by one iteration
+ * @param allocationsBefore allocationCount() taken before the loop
+ */
+void reportCounters(benchmark::State &state, uint64_t pixelsPerCall, uint64_t allocationsBefore);
+} // namespace BenchmarkSupport
@@ -0,0 +1,120 @@
+/**
+ * @file ConversionBenchmarks.cpp
+ * @brief Benchmarks for CImageConverter, CLutCache and QtImageRenderer
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Images are loaded once per process, so only the conversion itself is
+ * timed.
+ */
+
+#include "BenchmarkSupport.h"
+
+#include "infrastructure/qt/QtImageRenderer.h"
+#include "utils/CImageConverter.h"
+#include "utils/CLutCache.h"
+
+#include <QImage>
+
+using namespace BenchmarkSupport;
+
+namespace
+{
+std::shared_ptr<const CDicomImage> imageOrSkip(benchmark::State &state, const SInput &input)
+{
+    const std::string path = input.path();
+    auto image = loadedImage(path);
+    if (!image)
+    {
+        state.SkipWithError(path.empty() ? "Input file not available"
+                                         : "Failed to load input file");
+    }
+    return image;
+}
+
+uint64_t pixelCount(const CDicomImage &image)
+{
+    const auto dims = image.dimensions();
+    return static_cast<uint64_t>(dims.width) * dims.height;
+}
+
+void convertImage(benchmark::State &state, const SInput &input, DicomViewer::EPaletteType palette)
+{
+    const auto image = imageOrSkip(state, input);
+    if (!image)
+    {
+        return;
+    }
+
+    CImageConverter converter;
+    converter.setPalette(palette);
+    const auto wl = image->windowLevel();
+    const uint64_t allocationsBefore = allocationCount();
+    for (auto _ : state)
+    {
+        QImage result = converter.toQImage(*image, wl);
+        benchmark::DoNotOptimize(result.constBits());
+    }
+    reportCounters(state, pixelCount(*image), allocationsBefore);
+}
+
+void buildLut(benchmark::State &state, const SInput &input)
+{
+    const auto image = imageOrSkip(state, input);
+    if (!image)
+    {
+        return;
+    }
+
+    const auto wl = image->windowLevel();
+    const auto range = image->valueRange();
+    const uint64_t entries = static_cast<uint64_t>(range.max - range.min) + 1;
+    const uint64_t allocationsBefore = allocationCount();
+    for (auto _ : state)
+    {
+        auto lut = CLutCache::buildWindowLevelLut(wl, range.min, range.max, false);
+        benchmark::DoNotOptimize(lut.data());
+    }
+    // One "pixel" per LUT entry, so MPix/s reads as entries per second
+    reportCounters(state, entries, allocationsBefore);
+}
+
+void renderImage(benchmark::State &state, const SInput &input)
+{
+    const auto image = imageOrSkip(state, input);
+    if (!image)
+    {
+        return;
+    }
+
+    QtImageRenderer renderer;
+    const uint64_t allocationsBefore = allocationCount();
+    for (auto _ : state)
+    {
+        SImageBuffer buffer = renderer.render(*image, DicomViewer::EPaletteType::Grayscale, std::nullopt);
+        benchmark::DoNotOptimize(buffer.data.data());
+    }
+    reportCounters(state, pixelCount(*image), allocationsBefore);
+}
+
+const bool g_registered = []()
+{
+    for (const auto &input : standardInputs())
+    {
+        benchmark::RegisterBenchmark(("ToQImage_Grayscale/" + input.name).c_str(), convertImage,
+                                     input, DicomViewer::EPaletteType::Grayscale)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("ToQImage_Hot/" + input.name).c_str(), convertImage,
+                                     input, DicomViewer::EPaletteType::Hot)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("BuildWindowLevelLut/" + input.name).c_str(), buildLut, input)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("QtImageRenderer_Render/" + input.name).c_str(), renderImage, input)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+    }
+    return true;
+}();
+} // namespace
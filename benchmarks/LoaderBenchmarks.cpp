@@ -0,0 +1,62 @@
+/**
+ * @file LoaderBenchmarks.cpp
+ * @brief Benchmarks for CDicomLoader::loadFile
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Files are read from disk on every iteration; after the first one they
+ * come from the OS page cache, so results measure parsing and decoding
+ * rather than storage speed.
+ */
+
+#include "BenchmarkSupport.h"
+
+#include "core/CDicomLoader.h"
+
+using namespace BenchmarkSupport;
+
+namespace
+{
+void loadFile(benchmark::State &state, const SInput &input, DicomViewer::EPixelLoadPolicy policy)
+{
+    const std::string path = input.path();
+    const auto reference = loadedImage(path);
+    if (!reference)
+    {
+        state.SkipWithError(path.empty() ? "Input file not available"
+                                         : "Failed to load input file");
+        return;
+    }
+    const auto dims = reference->dimensions();
+
+    CDicomLoader loader;
+    const uint64_t allocationsBefore = allocationCount();
+    for (auto _ : state)
+    {
+        auto [image, result] = loader.loadFile(path, policy);
+        if (result != DicomViewer::ELoadResult::Success)
+        {
+            state.SkipWithError("Failed to load input file");
+            break;
+        }
+        benchmark::DoNotOptimize(image.get());
+    }
+    reportCounters(state, static_cast<uint64_t>(dims.width) * dims.height, allocationsBefore);
+}
+
+const bool g_registered = []()
+{
+    for (const auto &input : standardInputs())
+    {
+        benchmark::RegisterBenchmark(("LoadFile_Immediate/" + input.name).c_str(), loadFile,
+                                     input, DicomViewer::EPixelLoadPolicy::Immediate)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("LoadFile_OnDemand/" + input.name).c_str(), loadFile,
+                                     input, DicomViewer::EPixelLoadPolicy::OnDemand)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+    }
+    return true;
+}();
+} // namespace
@@ -24,6 +24,12 @@ enum class ELoadResult
     Unknown
 };
 
+enum class EPixelLoadPolicy
+{
+    Immediate, // Decode pixel data during load
+    OnDemand   // Parse the header only; decode on first pixel access
+};
+
 enum class EPaletteType
 {
     Grayscale,
@@ -36,6 +42,24 @@ enum class EPaletteType
     Ocean
 };
 
+// Plane shown for an assembled series; Acquisition shows slices as loaded
+enum class EMprPlane
+{
+    Acquisition,
+    Axial,
+    Coronal,
+    Sagittal
+};
+
+// Intensity projection over a slab of acquired slices; Off shows single slices
+enum class EProjectionMode
+{
+    Off,
+    Maximum,
+    Minimum,
+    Average
+};
+
 struct SWindowLevel
 {
     double center = 0.0;
@@ -53,6 +77,13 @@ struct SImageDimensions
     bool isSigned = false;
 };
 
+// Smallest and largest decoded sample value of an image
+struct SValueRange
+{
+    int32_t min = 0;
+    int32_t max = 255;
+};
+
 constexpr int kMinWindowWidth = 1;
 
 } // namespace DicomViewer
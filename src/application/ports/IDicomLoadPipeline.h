@@ -0,0 +1,52 @@
+/**
+ * @file IDicomLoadPipeline.h
+ * @brief Interface for asynchronous batch DICOM loading (application port)
+ * @date 2026
+ */
+
+#pragma once
+
+#include "application/ports/IDicomLoader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct SDicomLoadRequest
+{
+    std::string filePath;
+    uint64_t batchId = 0;
+    DicomViewer::EPixelLoadPolicy policy = DicomViewer::EPixelLoadPolicy::Immediate;
+};
+
+class IDicomLoadPipeline
+{
+  public:
+    /**
+     * @brief Invoked once per finished file, on a worker thread
+     */
+    using LoadCallback = std::function<void(const SDicomLoadRequest &request,
+                                            SDicomLoadResult result)>;
+
+    virtual ~IDicomLoadPipeline() = default;
+
+    /**
+     * @brief Queues files for background loading without blocking
+     * @param requests Files to load, processed in the given order
+     * @param onLoaded Callback invoked as each file finishes
+     */
+    virtual void enqueue(std::vector<SDicomLoadRequest> requests,
+                         LoadCallback onLoaded) = 0;
+
+    /**
+     * @brief Drops every queued file; files already decoding are discarded
+     */
+    virtual void cancelAll() = 0;
+
+    /**
+     * @brief Number of files queued or decoding
+     */
+    virtual size_t pendingCount() const = 0;
+};
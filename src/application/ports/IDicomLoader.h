@@ -23,5 +23,6 @@ class IDicomLoader
 {
   public:
     virtual ~IDicomLoader() = default;
-    virtual SDicomLoadResult load(const std::string &filePath) = 0;
+    virtual SDicomLoadResult load(const std::string &filePath,
+                                  DicomViewer::EPixelLoadPolicy policy) = 0;
 };
@@ -0,0 +1,55 @@
+/**
+ * @file IFolderIndexer.h
+ * @brief Interface for cataloging folders of DICOM files (application port)
+ * @date 2026
+ */
+
+#pragma once
+
+#include "core/CDicomCatalog.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+class IFolderIndexer
+{
+  public:
+    /**
+     * @brief Invoked with a catalog of the folder, on a worker thread
+     *
+     * A run reports the catalog saved by the previous run of the same
+     * folder first, if there is one (complete = false), and the catalog
+     * after changed files were read again last (complete = true).
+     */
+    using CatalogCallback = std::function<void(std::shared_ptr<const CDicomCatalog> catalog,
+                                               bool complete)>;
+
+    /**
+     * @brief Invoked as headers are read, on a worker thread
+     */
+    using ProgressCallback = std::function<void(size_t read, size_t total)>;
+
+    virtual ~IFolderIndexer() = default;
+
+    /**
+     * @brief Catalogs a folder and its subfolders without blocking
+     *
+     * Only files that are new or whose size or modification time
+     * changed since the last run are opened, and only their headers are
+     * read. Starting a run cancels the previous one.
+     *
+     * @param folderPath Folder to catalog, or a DICOMDIR inside it
+     * @param onProgress Callback invoked as headers are read
+     * @param onCatalog Callback invoked with the catalog
+     */
+    virtual void index(const std::string &folderPath,
+                       ProgressCallback onProgress,
+                       CatalogCallback onCatalog) = 0;
+
+    /**
+     * @brief Stops the current run; its catalog is not reported or saved
+     */
+    virtual void cancel() = 0;
+};
@@ -0,0 +1,37 @@
+/**
+ * @file IImageExporter.h
+ * @brief Interface for writing rendered images to PNG/JPEG/PDF files
+ * @date 2026
+ */
+
+#pragma once
+
+#include "application/dto/ImageBuffer.h"
+
+#include <string>
+
+enum class EExportFormat
+{
+    Png,
+    Jpeg,
+    Pdf
+};
+
+class IImageExporter
+{
+  public:
+    virtual ~IImageExporter() = default;
+
+    /**
+     * @brief Writes a rendered image; safe to call from several threads
+     * @param image Rendered pixels
+     * @param filePath Destination file
+     * @param format File format (PDF places the image on an A4 page)
+     * @param errorMessage Set when the export fails
+     * @return True on success
+     */
+    virtual bool exportImage(const SImageBuffer &image,
+                             const std::string &filePath,
+                             EExportFormat format,
+                             std::string &errorMessage) const = 0;
+};
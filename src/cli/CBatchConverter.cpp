@@ -0,0 +1,115 @@
+/**
+ * @file CBatchConverter.cpp
+ * @brief Implementation of the CBatchConverter class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CBatchConverter.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Constructor
+ * @param pipeline Loader pipeline (decides the number of workers)
+ * @param rendererFactory Creates a renderer per file
+ * @param exporter Thread-safe image writer
+ */
+CBatchConverter::CBatchConverter(std::unique_ptr<IDicomLoadPipeline> pipeline,
+                                 RendererFactory rendererFactory,
+                                 std::unique_ptr<IImageExporter> exporter)
+    : m_pipeline(std::move(pipeline)),
+      m_rendererFactory(std::move(rendererFactory)),
+      m_exporter(std::move(exporter))
+{
+}
+
+/**
+ * @brief Converts all jobs and waits for them
+ * @param jobs Files to convert
+ * @param options Rendering settings
+ * @param onProgress Optional per-file callback
+ * @return Counts and timing of the run
+ */
+CBatchConverter::SStats CBatchConverter::run(const std::vector<SJob> &jobs,
+                                             const SOptions &options,
+                                             const ProgressCallback &onProgress)
+{
+    SStats stats;
+    if (jobs.empty() || !m_pipeline || !m_rendererFactory || !m_exporter)
+    {
+        stats.failed = jobs.size();
+        return stats;
+    }
+
+    // The pipeline does not interpret batch ids, so each request carries
+    // its job index; a path may appear in several jobs
+    std::vector<SDicomLoadRequest> requests;
+    requests.reserve(jobs.size());
+    for (size_t index = 0; index < jobs.size(); ++index)
+    {
+        requests.push_back({jobs[index].inputPath, index,
+                            DicomViewer::EPixelLoadPolicy::Immediate});
+    }
+
+    const size_t expected = requests.size();
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t finished = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    m_pipeline->enqueue(
+        std::move(requests),
+        [&](const SDicomLoadRequest &request, SDicomLoadResult result)
+        {
+            const SJob &job = jobs[static_cast<size_t>(request.batchId)];
+            std::string error = result.errorMessage;
+            uint64_t pixels = 0;
+            bool success = false;
+
+            if (result.image)
+            {
+                const auto dims = result.image->dimensions();
+                const auto renderer = m_rendererFactory();
+                const SImageBuffer buffer = renderer->render(*result.image, options.palette,
+                                                             options.windowLevel);
+                // Drop the decoded pixels before writing the output file
+                result.image.reset();
+                success = m_exporter->exportImage(buffer, job.outputPath, options.format, error);
+                pixels = static_cast<uint64_t>(dims.width) * dims.height;
+            }
+            else if (error.empty())
+            {
+                error = "Failed to load file.";
+            }
+
+            if (onProgress)
+            {
+                onProgress(job, success, error);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (success)
+            {
+                ++stats.converted;
+                stats.sourcePixels += pixels;
+            }
+            else
+            {
+                ++stats.failed;
+            }
+            if (++finished == expected)
+            {
+                done.notify_all();
+            }
+        });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]()
+              { return finished == expected; });
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
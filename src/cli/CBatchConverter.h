@@ -0,0 +1,102 @@
+/**
+ * @file CBatchConverter.h
+ * @brief Headless batch DICOM to PNG/JPEG/PDF conversion
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CBatchConverter class which drives the same load
+ * pipeline, renderer and exporter as the viewer, without any widget,
+ * to convert many files at once on all cores.
+ */
+
+#pragma once
+
+#include "DicomViewer/Types.h"
+#include "application/ports/IDicomLoadPipeline.h"
+#include "application/ports/IImageExporter.h"
+#include "application/ports/IImageRenderer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @class CBatchConverter
+ * @brief Loads, renders and writes a list of files in parallel
+ *
+ * Files are decoded on the pipeline's workers and rendered and written
+ * on the same worker as soon as they arrive, so each image is resident
+ * only while it is being converted. run() blocks until every file is
+ * done.
+ */
+class CBatchConverter
+{
+  public:
+    using RendererFactory = std::function<std::unique_ptr<IImageRenderer>()>;
+
+    /**
+     * @brief One file to convert
+     */
+    struct SJob
+    {
+        std::string inputPath;
+        std::string outputPath;
+    };
+
+    /**
+     * @brief Rendering settings applied to every file
+     */
+    struct SOptions
+    {
+        EExportFormat format = EExportFormat::Png;
+        DicomViewer::EPaletteType palette = DicomViewer::EPaletteType::Grayscale;
+        std::optional<DicomViewer::SWindowLevel> windowLevel; /**< Header default if unset */
+    };
+
+    /**
+     * @brief Totals of one run
+     */
+    struct SStats
+    {
+        size_t converted = 0;
+        size_t failed = 0;
+        uint64_t sourcePixels = 0; /**< Pixels of all converted images */
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Invoked once per file, on a worker thread
+     */
+    using ProgressCallback = std::function<void(const SJob &job, bool success,
+                                                const std::string &errorMessage)>;
+
+    /**
+     * @brief Constructor
+     * @param pipeline Loader pipeline (decides the number of workers)
+     * @param rendererFactory Creates a renderer per file (renderers are not shared across threads)
+     * @param exporter Thread-safe image writer
+     */
+    CBatchConverter(std::unique_ptr<IDicomLoadPipeline> pipeline,
+                     RendererFactory rendererFactory,
+                     std::unique_ptr<IImageExporter> exporter);
+
+    /**
+     * @brief Converts all jobs and waits for them
+     * @param jobs Files to convert
+     * @param options Rendering settings
+     * @param onProgress Optional per-file callback
+     * @return Counts and timing of the run
+     */
+    SStats run(const std::vector<SJob> &jobs,
+               const SOptions &options,
+               const ProgressCallback &onProgress = {});
+
+  private:
+    std::unique_ptr<IDicomLoadPipeline> m_pipeline;
+    RendererFactory m_rendererFactory;
+    std::unique_ptr<IImageExporter> m_exporter;
+};
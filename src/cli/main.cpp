@@ -0,0 +1,298 @@
+/**
+ * @file main.cpp
+ * @brief Headless batch converter entry point (dicom-visualizer-cli)
+ * @date 2026
+ *
+ * Converts DICOM files and directories to PNG, JPEG or PDF with the
+ * same rendering as the viewer, using all cores, and prints throughput.
+ * Runs on Qt's offscreen platform; no display or OpenGL is needed.
+ */
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "cli/CBatchConverter.h"
+#include "infrastructure/concurrency/DicomLoadPipeline.h"
+#include "infrastructure/dcmtk/DcmtkDicomLoader.h"
+#include "infrastructure/qt/QtImageExporter.h"
+#include "infrastructure/qt/QtImageRenderer.h"
+#include "utils/CColorPalette.h"
+
+namespace
+{
+    bool parseFormat(const QString &name, EExportFormat &format, QString &extension)
+    {
+        const QString lower = name.toLower();
+        if (lower == "png")
+        {
+            format = EExportFormat::Png;
+            extension = "png";
+            return true;
+        }
+        if (lower == "jpeg" || lower == "jpg")
+        {
+            format = EExportFormat::Jpeg;
+            extension = "jpg";
+            return true;
+        }
+        if (lower == "pdf")
+        {
+            format = EExportFormat::Pdf;
+            extension = "pdf";
+            return true;
+        }
+        return false;
+    }
+
+    bool parsePalette(const QString &name, DicomViewer::EPaletteType &palette)
+    {
+        for (const auto type : CColorPalette::availablePalettes())
+        {
+            if (CColorPalette::paletteName(type).compare(name, Qt::CaseInsensitive) == 0)
+            {
+                palette = type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    QString paletteNames()
+    {
+        QStringList names;
+        for (const auto type : CColorPalette::availablePalettes())
+        {
+            names << CColorPalette::paletteName(type).toLower();
+        }
+        return names.join(", ");
+    }
+
+    /**
+     * @brief Output name of an input file, without extension
+     *
+     * Only a .dcm or .dicom suffix is dropped: files are often named by
+     * SOP Instance UID, whose dots are not extensions.
+     */
+    QString outputBaseName(const QFileInfo &file)
+    {
+        const QString suffix = file.suffix();
+        if (suffix.compare("dcm", Qt::CaseInsensitive) == 0 ||
+            suffix.compare("dicom", Qt::CaseInsensitive) == 0)
+        {
+            return file.completeBaseName();
+        }
+        return file.fileName();
+    }
+
+    /**
+     * @brief Maps every input file to an output path
+     *
+     * Files inside a directory keep their path relative to it, so a
+     * study tree is mirrored under the output directory. Inputs that
+     * would share an output path get a numbered suffix.
+     */
+    std::vector<CBatchConverter::SJob> collectJobs(const QStringList &inputs,
+                                                   const QDir &outputDir,
+                                                   const QString &extension,
+                                                   bool recursive)
+    {
+        std::vector<CBatchConverter::SJob> jobs;
+        QSet<QString> seen;
+        QSet<QString> outputs;
+        const auto addJob = [&](const QString &filePath, const QString &relativePath)
+        {
+            const QString canonical = QFileInfo(filePath).canonicalFilePath();
+            if (canonical.isEmpty() || seen.contains(canonical))
+            {
+                return;
+            }
+            seen.insert(canonical);
+            const QFileInfo relative(relativePath);
+            const QString baseName = QDir::cleanPath(
+                outputDir.filePath(QDir(relative.path()).filePath(outputBaseName(relative))));
+            QString outputPath = baseName + "." + extension;
+            for (int copy = 2; outputs.contains(outputPath); ++copy)
+            {
+                outputPath = QString("%1_%2.%3").arg(baseName).arg(copy).arg(extension);
+            }
+            outputs.insert(outputPath);
+            jobs.push_back({canonical.toStdString(), outputPath.toStdString()});
+        };
+
+        for (const QString &input : inputs)
+        {
+            const QFileInfo info(input);
+            if (info.isDir())
+            {
+                const QDir root(info.absoluteFilePath());
+                QDirIterator it(root.absolutePath(), QDir::Files,
+                                recursive ? QDirIterator::Subdirectories
+                                          : QDirIterator::NoIteratorFlags);
+                while (it.hasNext())
+                {
+                    const QString filePath = it.next();
+                    addJob(filePath, root.relativeFilePath(filePath));
+                }
+            }
+            else if (info.isFile())
+            {
+                addJob(info.absoluteFilePath(), info.fileName());
+            }
+        }
+        return jobs;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Rendering needs QtGui (QImage, QPdfWriter) but never a screen
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    app.setApplicationName("dicom-visualizer-cli");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Batch-converts DICOM files to PNG, JPEG or PDF.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("inputs", "DICOM files or directories to convert.", "<inputs...>");
+
+    const QCommandLineOption outputOption({"o", "output"}, "Output directory.", "dir");
+    const QCommandLineOption formatOption({"f", "format"}, "Output format: png, jpeg or pdf.",
+                                          "format", "png");
+    const QCommandLineOption paletteOption({"p", "palette"},
+                                           QString("Color palette: %1.").arg(paletteNames()),
+                                           "name", "grayscale");
+    const QCommandLineOption centerOption({"c", "center"}, "Window center (needs --width).", "value");
+    const QCommandLineOption widthOption({"w", "width"}, "Window width (needs --center).", "value");
+    const QCommandLineOption recursiveOption({"r", "recursive"}, "Descend into subdirectories.");
+    const QCommandLineOption jobsOption({"j", "jobs"}, "Worker threads (0 = all cores).", "count", "0");
+    const QCommandLineOption qualityOption({"q", "quality"}, "JPEG quality (0-100).", "value",
+                                           QString::number(QtImageExporter::kDefaultJpegQuality));
+    const QCommandLineOption quietOption("quiet", "Only print the summary.");
+    parser.addOptions({outputOption, formatOption, paletteOption, centerOption, widthOption,
+                       recursiveOption, jobsOption, qualityOption, quietOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty() || !parser.isSet(outputOption))
+    {
+        err << "error: inputs and --output are required (see --help)\n";
+        return 2;
+    }
+
+    CBatchConverter::SOptions options;
+    QString extension;
+    if (!parseFormat(parser.value(formatOption), options.format, extension))
+    {
+        err << "error: unknown format '" << parser.value(formatOption) << "'\n";
+        return 2;
+    }
+    if (!parsePalette(parser.value(paletteOption), options.palette))
+    {
+        err << "error: unknown palette '" << parser.value(paletteOption)
+            << "' (expected one of: " << paletteNames() << ")\n";
+        return 2;
+    }
+    if (parser.isSet(centerOption) != parser.isSet(widthOption))
+    {
+        err << "error: --center and --width must be given together\n";
+        return 2;
+    }
+    if (parser.isSet(centerOption))
+    {
+        bool centerOk = false;
+        bool widthOk = false;
+        const double center = parser.value(centerOption).toDouble(&centerOk);
+        const double width = parser.value(widthOption).toDouble(&widthOk);
+        if (!centerOk || !widthOk || width < DicomViewer::kMinWindowWidth)
+        {
+            err << "error: invalid window center/width\n";
+            return 2;
+        }
+        options.windowLevel = DicomViewer::SWindowLevel{center, width};
+    }
+
+    bool jobsOk = false;
+    bool qualityOk = false;
+    const int jobCount = parser.value(jobsOption).toInt(&jobsOk);
+    const int quality = parser.value(qualityOption).toInt(&qualityOk);
+    if (!jobsOk || jobCount < 0 || !qualityOk || quality < 0 || quality > 100)
+    {
+        err << "error: invalid --jobs or --quality\n";
+        return 2;
+    }
+
+    const QDir outputDir(parser.value(outputOption));
+    const auto jobs = collectJobs(inputs, outputDir, extension, parser.isSet(recursiveOption));
+    if (jobs.empty())
+    {
+        err << "error: no input files found\n";
+        return 1;
+    }
+    for (const auto &job : jobs)
+    {
+        QDir().mkpath(QFileInfo(QString::fromStdString(job.outputPath)).path());
+    }
+
+    const size_t threads = jobCount > 0 ? static_cast<size_t>(jobCount)
+                                        : static_cast<size_t>(QThread::idealThreadCount());
+    CBatchConverter converter(
+        std::make_unique<DicomLoadPipeline>(
+            []() -> std::unique_ptr<IDicomLoader>
+            { return std::make_unique<DcmtkDicomLoader>(); },
+            threads),
+        []() -> std::unique_ptr<IImageRenderer>
+        { return std::make_unique<QtImageRenderer>(); },
+        std::make_unique<QtImageExporter>(quality));
+
+    std::mutex outputMutex;
+    const bool quiet = parser.isSet(quietOption);
+    const auto stats = converter.run(
+        jobs, options,
+        [&](const CBatchConverter::SJob &job, bool success, const std::string &errorMessage)
+        {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (!success)
+            {
+                err << "failed: " << QString::fromStdString(job.inputPath) << ": "
+                    << QString::fromStdString(errorMessage) << "\n";
+                err.flush();
+            }
+            else if (!quiet)
+            {
+                out << QString::fromStdString(job.outputPath) << "\n";
+                out.flush();
+            }
+        });
+
+    const double seconds = std::max(stats.seconds, 1e-9);
+    out << QString("Converted %1 of %2 file(s) in %3 s on %4 thread(s): %5 files/s, %6 MPixel/s\n")
+               .arg(stats.converted)
+               .arg(jobs.size())
+               .arg(stats.seconds, 0, 'f', 2)
+               .arg(threads)
+               .arg(static_cast<double>(stats.converted) / seconds, 0, 'f', 1)
+               .arg(static_cast<double>(stats.sourcePixels) / 1e6 / seconds, 0, 'f', 1);
+    if (stats.failed > 0)
+    {
+        out << QString("%1 file(s) failed\n").arg(stats.failed);
+    }
+    return stats.failed == 0 ? 0 : 1;
+}
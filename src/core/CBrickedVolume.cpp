@@ -0,0 +1,72 @@
+/**
+ * @file CBrickedVolume.cpp
+ * @brief Implementation of the CBrickedVolume class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CBrickedVolume.h"
+
+#include "CVolume.h"
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+void CBrickedVolume::SAlignedDelete::operator()(uint16_t *memory) const
+{
+    ::operator delete(memory, std::align_val_t(CVolume::kAlignment));
+}
+
+/**
+ * @brief Copies @p volume into brick order
+ * @param volume Source volume
+ */
+CBrickedVolume::CBrickedVolume(const CVolume &volume)
+    : m_width(volume.width()),
+      m_height(volume.height()),
+      m_depth(volume.depth()),
+      m_bricksX((volume.width() + kBrickMask) >> kBrickShift),
+      m_bricksY((volume.height() + kBrickMask) >> kBrickShift),
+      m_bricksZ((volume.depth() + kBrickMask) >> kBrickShift),
+      m_signed(volume.isSigned())
+{
+    m_voxels.reset(static_cast<uint16_t *>(
+        ::operator new(byteSize(), std::align_val_t(CVolume::kAlignment))));
+    uint16_t *bricks = m_voxels.get();
+
+    // One task per slab of bricks: each reads kBrickSize whole slices
+    // sequentially and writes its own contiguous range of bricks
+    CThreadPool::shared().parallelFor(
+        m_bricksZ, 1,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t bz = begin; bz < end; ++bz)
+            {
+                uint16_t *slab = bricks + bz * m_bricksY * m_bricksX * kBrickVoxels;
+                std::fill(slab, slab + m_bricksY * m_bricksX * kBrickVoxels, uint16_t{0});
+
+                const auto zBegin = static_cast<uint32_t>(bz << kBrickShift);
+                const uint32_t zEnd = std::min(m_depth, zBegin + kBrickSize);
+                for (uint32_t z = zBegin; z < zEnd; ++z)
+                {
+                    const uint16_t *slice = volume.sliceData(z);
+                    for (uint32_t y = 0; y < m_height; ++y)
+                    {
+                        const uint16_t *row = slice + static_cast<size_t>(y) * m_width;
+                        for (uint32_t x = 0; x < m_width; x += kBrickSize)
+                        {
+                            const uint32_t run = std::min(kBrickSize, m_width - x);
+                            std::memcpy(bricks + offset(x, y, z), row + x, run * sizeof(uint16_t));
+                        }
+                    }
+                }
+            }
+        });
+}
+
+size_t CBrickedVolume::byteSize() const
+{
+    return m_bricksX * m_bricksY * m_bricksZ * kBrickVoxels * sizeof(uint16_t);
+}
@@ -0,0 +1,469 @@
+/**
+ * @file CDicomCatalog.cpp
+ * @brief Implementation of the CDicomCatalog class
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * The catalog file is a flat little endian record list:
+ *   magic "DVCATLOG", format version, root path, entry count, then per
+ *   entry its path, modification time, size and image flag, followed
+ *   for images by the text fields and the three integers.
+ * Strings are stored as a 32-bit length and their bytes.
+ */
+
+#include "CDicomCatalog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+
+namespace
+{
+constexpr char kMagic[8] = {'D', 'V', 'C', 'A', 'T', 'L', 'O', 'G'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kMaxEntries = 16 * 1024 * 1024;
+
+const std::string kEmpty;
+
+/**
+ * @brief Appends values to a catalog buffer
+ */
+class CWriter
+{
+  public:
+    explicit CWriter(std::string &buffer) : m_buffer(buffer) {}
+
+    template <typename T>
+    void number(T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            m_buffer += static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void text(std::string_view value)
+    {
+        number(static_cast<uint32_t>(value.size()));
+        m_buffer.append(value.data(), value.size());
+    }
+
+  private:
+    std::string &m_buffer;
+};
+
+/**
+ * @brief Reads values from a catalog buffer; fails once past the end
+ */
+class CReader
+{
+  public:
+    CReader(const char *data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool number(T &value)
+    {
+        if (m_size - m_pos < sizeof(T))
+        {
+            return false;
+        }
+        uint64_t bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            bits |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[m_pos + i])) << (8 * i);
+        }
+        value = static_cast<T>(bits);
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool text(std::string_view &value)
+    {
+        uint32_t length = 0;
+        if (!number(length) || m_size - m_pos < length)
+        {
+            return false;
+        }
+        value = std::string_view(m_data + m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+    bool bytes(const char *expected, size_t length)
+    {
+        if (m_size - m_pos < length || std::memcmp(m_data + m_pos, expected, length) != 0)
+        {
+            return false;
+        }
+        m_pos += length;
+        return true;
+    }
+
+  private:
+    const char *m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
+
+/**
+ * @brief Text of a catalog field in loaded metadata
+ */
+const std::string &metadataField(const CDicomMetadata &metadata, CDicomCatalog::EField field)
+{
+    using EField = CDicomCatalog::EField;
+    switch (field)
+    {
+    case EField::PatientId:
+        return metadata.patientId();
+    case EField::PatientName:
+        return metadata.patientName();
+    case EField::PatientBirthDate:
+        return metadata.patientBirthDate();
+    case EField::PatientSex:
+        return metadata.patientSex();
+    case EField::StudyInstanceUid:
+        return metadata.studyInstanceUid();
+    case EField::StudyDate:
+        return metadata.studyDate();
+    case EField::StudyTime:
+        return metadata.studyTime();
+    case EField::StudyDescription:
+        return metadata.studyDescription();
+    case EField::AccessionNumber:
+        return metadata.accessionNumber();
+    case EField::SeriesInstanceUid:
+        return metadata.seriesInstanceUid();
+    case EField::SeriesDescription:
+        return metadata.seriesDescription();
+    case EField::Modality:
+        return metadata.modality();
+    case EField::SopInstanceUid:
+        return metadata.sopInstanceUid();
+    case EField::Count:
+        break;
+    }
+    return kEmpty;
+}
+} // namespace
+
+/**
+ * @brief Text tag of the instance
+ * @param field Tag to read
+ * @return Value, empty if absent
+ */
+const std::string &CDicomCatalog::SEntry::field(EField field) const
+{
+    const auto &handle = fields[static_cast<size_t>(field)];
+    return handle ? *handle : kEmpty;
+}
+
+/**
+ * @brief Takes the catalog tags from loaded metadata
+ * @param metadata Header tags of the file
+ */
+void CDicomCatalog::SEntry::setMetadata(const CDicomMetadata &metadata)
+{
+    CStringPool &pool = CStringPool::shared();
+    for (size_t i = 0; i < kFieldCount; ++i)
+    {
+        fields[i] = pool.intern(metadataField(metadata, static_cast<EField>(i)));
+    }
+    seriesNumber = metadata.seriesNumber().value_or(0);
+    instanceNumber = metadata.instanceNumber().value_or(0);
+    numberOfFrames = std::max(1, metadata.numberOfFrames().value_or(1));
+}
+
+/**
+ * @brief Constructor
+ * @param rootPath Folder the catalog describes
+ */
+CDicomCatalog::CDicomCatalog(std::string rootPath)
+    : m_rootPath(std::move(rootPath))
+{
+}
+
+const std::string &CDicomCatalog::rootPath() const
+{
+    return m_rootPath;
+}
+
+size_t CDicomCatalog::size() const
+{
+    return m_entries.size();
+}
+
+size_t CDicomCatalog::imageCount() const
+{
+    return m_imageCount;
+}
+
+const CDicomCatalog::SEntry &CDicomCatalog::entry(size_t index) const
+{
+    return m_entries[index];
+}
+
+/**
+ * @brief Looks up the entry of a file
+ * @param filePath Path as stored by add()
+ * @return Entry, nullptr if the file is not cataloged
+ */
+const CDicomCatalog::SEntry *CDicomCatalog::find(const std::string &filePath) const
+{
+    auto it = m_byPath.find(filePath);
+    return it == m_byPath.end() ? nullptr : &m_entries[it->second];
+}
+
+/**
+ * @brief Adds or replaces the entry of a file
+ * @param entry Entry to store
+ */
+void CDicomCatalog::add(SEntry entry)
+{
+    auto it = m_byPath.find(entry.filePath);
+    if (it != m_byPath.end())
+    {
+        SEntry &existing = m_entries[it->second];
+        m_imageCount -= existing.isImage ? 1 : 0;
+        m_imageCount += entry.isImage ? 1 : 0;
+        existing = std::move(entry);
+        return;
+    }
+    m_imageCount += entry.isImage ? 1 : 0;
+    m_byPath.emplace(entry.filePath, static_cast<uint32_t>(m_entries.size()));
+    m_entries.push_back(std::move(entry));
+}
+
+/**
+ * @brief Groups the image entries by patient, study and series
+ *
+ * Instances without a study or series UID are grouped under an empty
+ * one, so every image is listed somewhere.
+ *
+ * @return Patients sorted by name
+ */
+std::vector<CDicomCatalog::SPatient> CDicomCatalog::patients() const
+{
+    std::vector<SPatient> patients;
+    std::unordered_map<std::string, size_t> patientSlots;
+    std::unordered_map<std::string, std::pair<size_t, size_t>> studySlots;
+    std::unordered_map<std::string, std::tuple<size_t, size_t, size_t>> seriesSlots;
+
+    // Keys join the values with a separator that cannot occur in them
+    const char separator = '\x1f';
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        const SEntry &instance = m_entries[i];
+        if (!instance.isImage)
+        {
+            continue;
+        }
+
+        const std::string patientKey = instance.field(EField::PatientId) + separator +
+                                       instance.field(EField::PatientName);
+        const std::string studyKey = patientKey + separator +
+                                     instance.field(EField::StudyInstanceUid);
+        const std::string seriesKey = studyKey + separator +
+                                      instance.field(EField::SeriesInstanceUid);
+
+        auto series = seriesSlots.find(seriesKey);
+        if (series == seriesSlots.end())
+        {
+            auto study = studySlots.find(studyKey);
+            if (study == studySlots.end())
+            {
+                auto patient = patientSlots.find(patientKey);
+                if (patient == patientSlots.end())
+                {
+                    patient = patientSlots.emplace(patientKey, patients.size()).first;
+                    patients.emplace_back();
+                }
+                auto &studies = patients[patient->second].studies;
+                study = studySlots.emplace(studyKey, std::make_pair(patient->second, studies.size()))
+                            .first;
+                studies.emplace_back();
+            }
+            const auto [patientSlot, studySlot] = study->second;
+            auto &seriesList = patients[patientSlot].studies[studySlot].series;
+            series = seriesSlots
+                         .emplace(seriesKey,
+                                  std::make_tuple(patientSlot, studySlot, seriesList.size()))
+                         .first;
+            seriesList.emplace_back();
+        }
+        const auto [patientSlot, studySlot, seriesSlot] = series->second;
+        patients[patientSlot].studies[studySlot].series[seriesSlot].instances.push_back(
+            static_cast<uint32_t>(i));
+    }
+
+    // Every group holds at least one instance; its first one stands for it
+    auto first = [this](const SSeries &series) -> const SEntry &
+    { return m_entries[series.instances.front()]; };
+    for (SPatient &patient : patients)
+    {
+        for (SStudy &study : patient.studies)
+        {
+            for (SSeries &series : study.series)
+            {
+                std::sort(series.instances.begin(), series.instances.end(),
+                          [this](uint32_t a, uint32_t b)
+                          {
+                              return std::tie(m_entries[a].instanceNumber, m_entries[a].filePath) <
+                                     std::tie(m_entries[b].instanceNumber, m_entries[b].filePath);
+                          });
+            }
+            std::sort(study.series.begin(), study.series.end(),
+                      [&first](const SSeries &a, const SSeries &b)
+                      { return first(a).seriesNumber < first(b).seriesNumber; });
+        }
+        std::sort(patient.studies.begin(), patient.studies.end(),
+                  [&first](const SStudy &a, const SStudy &b)
+                  {
+                      const SEntry &left = first(a.series.front());
+                      const SEntry &right = first(b.series.front());
+                      return std::tie(left.field(EField::StudyDate), left.field(EField::StudyTime)) >
+                             std::tie(right.field(EField::StudyDate), right.field(EField::StudyTime));
+                  });
+    }
+    std::sort(patients.begin(), patients.end(),
+              [&first](const SPatient &a, const SPatient &b)
+              {
+                  const SEntry &left = first(a.studies.front().series.front());
+                  const SEntry &right = first(b.studies.front().series.front());
+                  return std::tie(left.field(EField::PatientName), left.field(EField::PatientId)) <
+                         std::tie(right.field(EField::PatientName), right.field(EField::PatientId));
+              });
+    return patients;
+}
+
+/**
+ * @brief Replaces the entries with a saved catalog
+ * @param catalogPath Catalog file written by save()
+ * @return False if the file is missing, damaged, from another format
+ *         version or for another folder
+ */
+bool CDicomCatalog::load(const std::string &catalogPath)
+{
+    std::ifstream file(catalogPath, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    const std::string buffer((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+    CReader reader(buffer.data(), buffer.size());
+
+    uint32_t version = 0;
+    std::string_view rootPath;
+    uint32_t count = 0;
+    if (!reader.bytes(kMagic, sizeof(kMagic)) || !reader.number(version) ||
+        version != kFormatVersion || !reader.text(rootPath) || rootPath != m_rootPath ||
+        !reader.number(count) || count > kMaxEntries)
+    {
+        return false;
+    }
+
+    std::vector<SEntry> entries(count);
+    CStringPool &pool = CStringPool::shared();
+    std::string_view text;
+    for (SEntry &entry : entries)
+    {
+        uint8_t isImage = 0;
+        if (!reader.text(text) || !reader.number(entry.modifiedTime) ||
+            !reader.number(entry.fileSize) || !reader.number(isImage))
+        {
+            return false;
+        }
+        entry.filePath.assign(text);
+        entry.isImage = (isImage != 0);
+        if (!entry.isImage)
+        {
+            continue;
+        }
+        for (auto &field : entry.fields)
+        {
+            if (!reader.text(text))
+            {
+                return false;
+            }
+            field = pool.intern(text);
+        }
+        if (!reader.number(entry.seriesNumber) || !reader.number(entry.instanceNumber) ||
+            !reader.number(entry.numberOfFrames))
+        {
+            return false;
+        }
+    }
+
+    m_entries.clear();
+    m_byPath.clear();
+    m_imageCount = 0;
+    m_entries.reserve(entries.size());
+    m_byPath.reserve(entries.size());
+    for (SEntry &entry : entries)
+    {
+        add(std::move(entry));
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the catalog, replacing the file atomically
+ * @param catalogPath Destination; missing folders are created
+ * @return True on success
+ */
+bool CDicomCatalog::save(const std::string &catalogPath) const
+{
+    std::string buffer;
+    buffer.reserve(m_entries.size() * 256);
+    buffer.append(kMagic, sizeof(kMagic));
+    CWriter writer(buffer);
+    writer.number(kFormatVersion);
+    writer.text(m_rootPath);
+    writer.number(static_cast<uint32_t>(m_entries.size()));
+    for (const SEntry &entry : m_entries)
+    {
+        writer.text(entry.filePath);
+        writer.number(entry.modifiedTime);
+        writer.number(entry.fileSize);
+        writer.number(static_cast<uint8_t>(entry.isImage ? 1 : 0));
+        if (!entry.isImage)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < kFieldCount; ++i)
+        {
+            writer.text(entry.field(static_cast<EField>(i)));
+        }
+        writer.number(entry.seriesNumber);
+        writer.number(entry.instanceNumber);
+        writer.number(entry.numberOfFrames);
+    }
+
+    // Write next to the target and rename, so readers never see half a file
+    const std::filesystem::path target(catalogPath);
+    std::error_code error;
+    if (target.has_parent_path())
+    {
+        std::filesystem::create_directories(target.parent_path(), error);
+    }
+    const std::filesystem::path temporary = target.string() + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+        {
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, target, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file CDicomCatalog.h
+ * @brief Patient/study/series catalog of a folder class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CDicomCatalog class which records, for every file under a
+ * folder, its size, modification time and the header tags needed to
+ * group it by patient, study and series. Catalogs are saved to disk so
+ * that reopening a folder only re-reads the files that changed.
+ */
+
+#pragma once
+
+#include "CDicomMetadata.h"
+#include "CStringPool.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class CDicomCatalog
+ * @brief Header-only index of the DICOM files in a folder
+ *
+ * Holds one entry per file, DICOM or not, keyed by path; an entry is
+ * current as long as the file's size and modification time match.
+ * Files that are not DICOM images are kept too, so they are not probed
+ * again. Text tags are interned in CStringPool::shared(), so patient,
+ * study and series values repeated by every instance are held once.
+ *
+ * Not thread-safe while being filled; immutable once shared.
+ */
+class CDicomCatalog
+{
+  public:
+    /**
+     * @brief Text tags kept per instance
+     */
+    enum class EField : uint8_t
+    {
+        PatientId,
+        PatientName,
+        PatientBirthDate,
+        PatientSex,
+        StudyInstanceUid,
+        StudyDate,
+        StudyTime,
+        StudyDescription,
+        AccessionNumber,
+        SeriesInstanceUid,
+        SeriesDescription,
+        Modality,
+        SopInstanceUid,
+        Count
+    };
+
+    static constexpr size_t kFieldCount = static_cast<size_t>(EField::Count);
+
+    /**
+     * @brief One file under the folder
+     */
+    struct SEntry
+    {
+        std::string filePath;
+        int64_t modifiedTime = 0; /**< Ticks of the file clock */
+        uint64_t fileSize = 0;
+        bool isImage = false;     /**< False for files that are not DICOM images */
+        std::array<CStringPool::Handle, kFieldCount> fields{};
+        int32_t seriesNumber = 0;
+        int32_t instanceNumber = 0;
+        int32_t numberOfFrames = 1;
+
+        /**
+         * @brief Text tag of the instance
+         * @param field Tag to read
+         * @return Value, empty if absent
+         */
+        const std::string &field(EField field) const;
+
+        /**
+         * @brief Takes the catalog tags from loaded metadata
+         * @param metadata Header tags of the file
+         */
+        void setMetadata(const CDicomMetadata &metadata);
+    };
+
+    /**
+     * @brief Instances sharing a Series Instance UID
+     */
+    struct SSeries
+    {
+        std::vector<uint32_t> instances; /**< Entry indices by instance number */
+    };
+
+    /**
+     * @brief Series sharing a Study Instance UID
+     */
+    struct SStudy
+    {
+        std::vector<SSeries> series; /**< By series number */
+    };
+
+    /**
+     * @brief Studies sharing a Patient ID and name
+     */
+    struct SPatient
+    {
+        std::vector<SStudy> studies; /**< Most recent first */
+    };
+
+    /**
+     * @brief Constructor
+     * @param rootPath Folder the catalog describes
+     */
+    explicit CDicomCatalog(std::string rootPath = std::string());
+
+    /** @name Entries */
+    ///@{
+    const std::string &rootPath() const;
+    size_t size() const;
+    size_t imageCount() const;
+    const SEntry &entry(size_t index) const;
+
+    /**
+     * @brief Looks up the entry of a file
+     * @param filePath Path as stored by add()
+     * @return Entry, nullptr if the file is not cataloged
+     */
+    const SEntry *find(const std::string &filePath) const;
+
+    /**
+     * @brief Adds or replaces the entry of a file
+     * @param entry Entry to store
+     */
+    void add(SEntry entry);
+
+    /**
+     * @brief Groups the image entries by patient, study and series
+     * @return Patients sorted by name
+     */
+    std::vector<SPatient> patients() const;
+    ///@}
+
+    /** @name Persistence */
+    ///@{
+    /**
+     * @brief Replaces the entries with a saved catalog
+     * @param catalogPath Catalog file written by save()
+     * @return False if the file is missing, damaged, from another
+     *         format version or for another folder
+     */
+    bool load(const std::string &catalogPath);
+
+    /**
+     * @brief Writes the catalog, replacing the file atomically
+     * @param catalogPath Destination; missing folders are created
+     * @return True on success
+     */
+    bool save(const std::string &catalogPath) const;
+    ///@}
+
+  private:
+    std::string m_rootPath;
+    std::vector<SEntry> m_entries;
+    std::unordered_map<std::string, uint32_t> m_byPath; /**< Entry index per file path */
+    size_t m_imageCount = 0;
+};
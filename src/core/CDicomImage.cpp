@@ -10,24 +10,217 @@
 
 #include "CDicomImage.h"
 
+#include <utility>
+
 /**
- * @brief Retrieves the pixel data
- * @return Const reference to pixel data vector
+ * @brief Retrieves the pixel data, decoding it first if needed
+ * @return Shared pixel storage
  */
-const std::vector<uint8_t> &CDicomImage::pixelData() const
+CPixelStorage CDicomImage::pixelData() const
 {
+    ensurePixelData();
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     return m_pixelData;
 }
 
 /**
- * @brief Checks if pixel data is present
- * @return True if pixel data exists and is not empty
+ * @brief Checks if pixel data is present or can be decoded on demand
+ * @return True if pixel data exists or a working decoder is attached
  */
 bool CDicomImage::hasPixelData() const
 {
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    return !m_pixelData.empty() || (m_pixelDecoder && !m_pixelDecodeFailed);
+}
+
+/**
+ * @brief Checks if pixel data is decoded and held in memory
+ * @return True if pixel data is resident
+ */
+bool CDicomImage::isPixelDataResident() const
+{
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     return !m_pixelData.empty();
 }
 
+/**
+ * @brief Retrieves the size of the resident pixel buffers
+ * @return Bytes held by decoded pixels, pyramid levels and frames, 0 if not resident
+ */
+size_t CDicomImage::residentPixelBytes() const
+{
+    size_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_pixelMutex);
+        bytes = m_pixelData.size() + m_pyramid.residentBytes();
+    }
+    return bytes + m_frames.residentBytes();
+}
+
+/**
+ * @brief Drops decoded pixels that can be decoded again on demand
+ *
+ * Outstanding CPixelStorage copies keep their bytes alive; memory is
+ * returned once the last of them goes away.
+ *
+ * @return Number of bytes released
+ */
+size_t CDicomImage::releasePixelData()
+{
+    size_t bytes = m_frames.residentBytes();
+    m_frames.clear();
+
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    bytes += m_pyramid.residentBytes();
+    m_pyramid.clear();
+    if (!m_pixelDecoder || m_pixelData.empty())
+    {
+        return bytes;
+    }
+    bytes += m_pixelData.size();
+    m_pixelData.reset();
+    return bytes;
+}
+
+/**
+ * @brief Retrieves a reduced-resolution copy, building it on first use
+ * @param level Level index (1 = half size)
+ * @return Level image, nullptr for level 0, out-of-range levels or missing pixels
+ */
+std::shared_ptr<const CDicomImage> CDicomImage::pyramidLevel(uint32_t level) const
+{
+    return m_pyramid.level(*this, level);
+}
+
+/**
+ * @brief Retrieves a reduced-resolution copy without building it
+ * @param level Level index (1 = half size)
+ * @return Level image, nullptr if it has not been built yet
+ */
+std::shared_ptr<const CDicomImage> CDicomImage::residentPyramidLevel(uint32_t level) const
+{
+    return m_pyramid.builtLevel(level);
+}
+
+/**
+ * @brief Checks if pixels and every pyramid level are held in memory
+ * @return True if neither pixelData() nor pyramidLevel() will do any work
+ */
+bool CDicomImage::isStagedForDisplay() const
+{
+    if (!isPixelDataResident())
+    {
+        return false;
+    }
+    // Levels are built in order, so the coarsest one implies all others
+    const uint32_t levels = pyramidLevelCount();
+    return levels <= 1 || residentPyramidLevel(levels - 1) != nullptr;
+}
+
+/**
+ * @brief Number of pyramid levels, including full resolution
+ * @return Levels down to 1x1
+ */
+uint32_t CDicomImage::pyramidLevelCount() const
+{
+    return CImagePyramid::levelCount(m_dimensions);
+}
+
+/**
+ * @brief Coarsest level that still has a pixel per screen pixel
+ * @param scale Screen pixels per image pixel
+ * @return Level to display at @p scale (0 when magnified)
+ */
+uint32_t CDicomImage::pyramidLevelForScale(double scale) const
+{
+    return CImagePyramid::levelForScale(m_dimensions, scale);
+}
+
+/**
+ * @brief Number of frames in the object
+ * @return Frame count, 1 for single-frame images
+ */
+uint32_t CDicomImage::frameCount() const
+{
+    return m_frames.frameCount();
+}
+
+/**
+ * @brief Retrieves a frame other than the first
+ * @param index Zero-based frame index
+ * @return Frame image, nullptr for frame 0 (this image) or out-of-range frames
+ */
+std::shared_ptr<const CDicomImage> CDicomImage::frame(uint32_t index) const
+{
+    return m_frames.frame(*this, index);
+}
+
+/**
+ * @brief Decodes the frames around @p center in the background
+ * @param center Frame being displayed
+ * @param ahead Frames after @p center to keep decoded
+ * @param behind Frames before @p center to keep decoded
+ */
+void CDicomImage::prefetchFrames(uint32_t center, uint32_t ahead, uint32_t behind) const
+{
+    m_frames.prefetch(*this, center, ahead, behind);
+}
+
+/**
+ * @brief Playback rate recorded in the header
+ * @return Frames per second, 0 if the header has none
+ */
+double CDicomImage::cineFrameRate() const
+{
+    return m_cineFrameRate;
+}
+
+/**
+ * @brief Runs the pixel decoder once if pixels are not resident
+ *
+ * The decoder fills a scratch image; only the decoded state is taken
+ * from it, so header fields and metadata are never touched.
+ *
+ * @return True if pixel data is resident afterwards
+ */
+bool CDicomImage::ensurePixelData() const
+{
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    if (!m_pixelData.empty())
+    {
+        return true;
+    }
+    if (!m_pixelDecoder || m_pixelDecodeFailed)
+    {
+        return false;
+    }
+
+    CDicomImage decoded;
+    decoded.m_dimensions = m_dimensions;
+    decoded.m_photometricInterpretation = m_photometricInterpretation;
+    if (!m_pixelDecoder(decoded) || decoded.m_pixelData.empty())
+    {
+        m_pixelDecodeFailed = true;
+        return false;
+    }
+
+    m_pixelData = std::move(decoded.m_pixelData);
+    m_defaultWindowLevel = decoded.m_defaultWindowLevel;
+    if (!m_windowLevelSet)
+    {
+        // Callers that never reset the window must not render with the placeholder
+        m_windowLevel = m_defaultWindowLevel;
+    }
+    m_bitsPerSample = decoded.m_bitsPerSample;
+    m_pixelSigned = decoded.m_pixelSigned;
+    m_valueRange = decoded.m_valueRange;
+    if (!m_statistics)
+    {
+        m_statistics = std::move(decoded.m_statistics);
+    }
+    return true;
+}
+
 /**
  * @brief Retrieves image dimensions
  * @return Struct containing width, height, and bit depth information
@@ -52,16 +245,27 @@ DicomViewer::EPhotometricInterpretation CDicomImage::photometricInterpretation()
  */
 void CDicomImage::setWindowLevel(const DicomViewer::SWindowLevel &wl)
 {
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     m_windowLevel = wl;
+    m_windowLevelSet = true;
 }
 
 /**
  * @brief Retrieves current window/level values
- * @return Current window center and width settings
+ * @return Current window center and width settings, defaultWindowLevel()
+ *         until a window is set
  */
 DicomViewer::SWindowLevel CDicomImage::windowLevel() const
 {
-    return m_windowLevel;
+    {
+        std::lock_guard<std::mutex> lock(m_pixelMutex);
+        if (m_windowLevelSet)
+        {
+            return m_windowLevel;
+        }
+    }
+    // Until one is set, the window is the header default (decoding if needed)
+    return defaultWindowLevel();
 }
 
 /**
@@ -70,6 +274,8 @@ DicomViewer::SWindowLevel CDicomImage::windowLevel() const
  */
 DicomViewer::SWindowLevel CDicomImage::defaultWindowLevel() const
 {
+    ensurePixelData();
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     return m_defaultWindowLevel;
 }
 
@@ -78,7 +284,7 @@ DicomViewer::SWindowLevel CDicomImage::defaultWindowLevel() const
  */
 void CDicomImage::resetWindowLevel()
 {
-    m_windowLevel = m_defaultWindowLevel;
+    setWindowLevel(defaultWindowLevel());
 }
 
 /**
@@ -110,7 +316,7 @@ const CDicomMetadata *CDicomImage::metadata() const
 
 /**
  * @brief Checks if image is valid and displayable
- * @return True if image has valid pixel data and non-zero dimensions
+ * @return True if pixel data is available and dimensions are non-zero
  */
 bool CDicomImage::isValid() const
 {
@@ -125,15 +331,25 @@ bool CDicomImage::isValid() const
  */
 void CDicomImage::clear()
 {
-    m_pixelData.clear();
+    m_frames.setSource(1, nullptr);
+
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    m_pixelData.reset();
+    m_pixelDecoder = nullptr;
+    m_pixelDecodeFailed = false;
     m_dimensions = DicomViewer::SImageDimensions{};
     m_photometricInterpretation = DicomViewer::EPhotometricInterpretation::Unknown;
     m_windowLevel = DicomViewer::SWindowLevel{};
+    m_windowLevelSet = false;
     m_defaultWindowLevel = DicomViewer::SWindowLevel{};
     m_rescaleSlope = 1.0;
     m_rescaleIntercept = 0.0;
+    m_cineFrameRate = 0.0;
     m_bitsPerSample = 8;
     m_pixelSigned = false;
+    m_valueRange = DicomViewer::SValueRange{};
+    m_statistics.reset();
+    m_pyramid.clear();
     m_metadata.reset();
 }
 
@@ -143,7 +359,16 @@ void CDicomImage::clear()
  */
 void CDicomImage::setPixelData(std::vector<uint8_t> &&data)
 {
-    m_pixelData = std::move(data);
+    m_pixelData = CPixelStorage::fromVector(std::move(data));
+}
+
+/**
+ * @brief Sets the pixel data from a shared storage without copying
+ * @param storage Storage referencing the decoded pixel bytes
+ */
+void CDicomImage::setPixelData(CPixelStorage storage)
+{
+    m_pixelData = std::move(storage);
 }
 
 /**
@@ -170,8 +395,10 @@ void CDicomImage::setPhotometricInterpretation(DicomViewer::EPhotometricInterpre
  */
 void CDicomImage::setDefaultWindowLevel(const DicomViewer::SWindowLevel &wl)
 {
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     m_defaultWindowLevel = wl;
     m_windowLevel = wl;
+    m_windowLevelSet = true;
 }
 
 /**
@@ -207,6 +434,8 @@ void CDicomImage::setMetadata(std::unique_ptr<CDicomMetadata> metadata)
  */
 uint8_t CDicomImage::bitsPerSample() const
 {
+    ensurePixelData();
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     return m_bitsPerSample;
 }
 
@@ -216,9 +445,72 @@ uint8_t CDicomImage::bitsPerSample() const
  */
 bool CDicomImage::isPixelSigned() const
 {
+    ensurePixelData();
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
     return m_pixelSigned;
 }
 
+/**
+ * @brief Retrieves the range of decoded sample values
+ * @return Smallest and largest value present in the pixel data
+ */
+DicomViewer::SValueRange CDicomImage::valueRange() const
+{
+    ensurePixelData();
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    return m_valueRange;
+}
+
+/**
+ * @brief Retrieves min/max/histogram statistics of the pixel data
+ *
+ * The scan runs outside the lock; if two threads get here first at
+ * once, both compute and the first result stored is kept.
+ *
+ * @return Shared statistics, nullptr if pixel data is unavailable
+ */
+std::shared_ptr<const CPixelStatistics> CDicomImage::statistics() const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pixelMutex);
+        if (m_statistics)
+        {
+            return m_statistics;
+        }
+    }
+    if (!ensurePixelData())
+    {
+        return nullptr;
+    }
+
+    CPixelStorage pixels;
+    uint8_t bitsPerSample = 8;
+    bool pixelSigned = false;
+    DicomViewer::SValueRange range;
+    {
+        std::lock_guard<std::mutex> lock(m_pixelMutex);
+        pixels = m_pixelData;
+        bitsPerSample = m_bitsPerSample;
+        pixelSigned = m_pixelSigned;
+        range = m_valueRange;
+    }
+    if (pixels.empty())
+    {
+        // Released again before we got to it
+        return nullptr;
+    }
+
+    auto computed = std::make_shared<const CPixelStatistics>(
+        CPixelStatistics::compute(pixels, bitsPerSample, pixelSigned, range));
+
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    if (!m_statistics)
+    {
+        m_statistics = std::move(computed);
+    }
+    return m_statistics;
+}
+
 /**
  * @brief Sets bits per sample
  * @param bits 8 or 16
@@ -236,3 +528,42 @@ void CDicomImage::setPixelSigned(bool isSigned)
 {
     m_pixelSigned = isSigned;
 }
+
+/**
+ * @brief Attaches a decoder used to materialize pixels on first access
+ * @param decoder Callable that fills a scratch image with pixel data
+ */
+void CDicomImage::setPixelDecoder(PixelDecoder decoder)
+{
+    std::lock_guard<std::mutex> lock(m_pixelMutex);
+    m_pixelDecoder = std::move(decoder);
+    m_pixelDecodeFailed = false;
+}
+
+/**
+ * @brief Sets the range of decoded sample values
+ * @param range Smallest and largest value present in the pixel data
+ */
+void CDicomImage::setValueRange(const DicomViewer::SValueRange &range)
+{
+    m_valueRange = range;
+}
+
+/**
+ * @brief Attaches the decoder of a multi-frame object's frames
+ * @param frameCount Number of frames in the object
+ * @param decoder Callable that fills a scratch image with one frame
+ */
+void CDicomImage::setFrameDecoder(uint32_t frameCount, FrameDecoder decoder)
+{
+    m_frames.setSource(frameCount, std::move(decoder));
+}
+
+/**
+ * @brief Sets the playback rate recorded in the header
+ * @param framesPerSecond Frames per second, 0 if unknown
+ */
+void CDicomImage::setCineFrameRate(double framesPerSecond)
+{
+    m_cineFrameRate = framesPerSecond;
+}
@@ -12,10 +12,17 @@
 #pragma once
 
 #include "CDicomMetadata.h"
+#include "CFrameSequence.h"
+#include "CImagePyramid.h"
+#include "CPixelStatistics.h"
+#include "CPixelStorage.h"
 #include "DicomViewer/Types.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class CDicomLoader;
@@ -33,10 +40,29 @@ class CDicomLoader;
  * - Associated metadata
  *
  * Pixel data setters are private and accessible only via CDicomLoader.
+ *
+ * Images loaded header-only carry a pixel decoder instead of pixels.
+ * The first call to pixelData(), bitsPerSample(), isPixelSigned(),
+ * valueRange(), statistics() or defaultWindowLevel() runs it; concurrent
+ * callers wait for the same decode. Dimensions, photometric interpretation and metadata never
+ * need the decoder. The same decoder lets releasePixelData() evict
+ * pixels under memory pressure and bring them back transparently.
+ * Pixel statistics are computed once and outlive evicted pixels.
+ * Reduced-resolution copies for small displays come from a pyramid
+ * built on first request and dropped together with the pixels.
+ * Multi-frame objects hold frame 0 like any image; the other frames
+ * are separate images decoded one at a time on request.
+ * Slices of an assembled CVolume are images whose pixels point into
+ * the volume's voxel buffer.
  */
 class CDicomImage
 {
     friend class CDicomLoader;
+    friend class CFrameSequence;
+    friend class CImagePyramid;
+    friend class CMprReformatter;
+    friend class CSlabProjector;
+    friend class CVolume;
 
   public:
     /**
@@ -47,16 +73,127 @@ class CDicomImage
     /** @name Pixel Data Access */
     ///@{
     /**
-     * @brief Retrieves the pixel data
-     * @return Const reference to pixel data vector
+     * @brief Retrieves the pixel data, decoding it first if needed
+     *
+     * Returned by value so the buffer stays alive for the caller even
+     * if releasePixelData() runs meanwhile; copies only share the bytes.
+     *
+     * @return Shared pixel storage (empty on decode failure)
      */
-    const std::vector<uint8_t> &pixelData() const;
+    CPixelStorage pixelData() const;
 
     /**
-     * @brief Checks if pixel data is present
-     * @return True if pixel data exists
+     * @brief Checks if pixel data is present or can be decoded on demand
+     * @return True if pixel data exists or a decoder is attached
      */
     bool hasPixelData() const;
+
+    /**
+     * @brief Checks if pixel data is decoded and held in memory
+     * @return True if pixelData() will not trigger a decode
+     */
+    bool isPixelDataResident() const;
+
+    /**
+     * @brief Retrieves the size of the resident pixel buffers
+     * @return Bytes held by decoded pixels, pyramid levels and frames, 0 if not resident
+     */
+    size_t residentPixelBytes() const;
+
+    /**
+     * @brief Drops decoded pixels that can be decoded again on demand
+     *
+     * Pyramid levels and other frames are always dropped; full-resolution
+     * pixels only when a pixel decoder is attached. The header, metadata
+     * and window/level stay untouched.
+     *
+     * @return Number of bytes released
+     */
+    size_t releasePixelData();
+    ///@}
+
+    /** @name Resolution Pyramid */
+    ///@{
+    /**
+     * @brief Retrieves a reduced-resolution copy, building it on first use
+     *
+     * Level n halves both dimensions n times. Levels share pixel format
+     * and value range with this image, so they convert and window the
+     * same way; pass the window/level explicitly when rendering them.
+     *
+     * @param level Level index (1 = half size)
+     * @return Level image, nullptr for level 0, out-of-range levels or missing pixels
+     */
+    std::shared_ptr<const CDicomImage> pyramidLevel(uint32_t level) const;
+
+    /**
+     * @brief Retrieves a reduced-resolution copy without building it
+     * @param level Level index (1 = half size)
+     * @return Level image, nullptr if it has not been built yet
+     */
+    std::shared_ptr<const CDicomImage> residentPyramidLevel(uint32_t level) const;
+
+    /**
+     * @brief Checks if pixels and every pyramid level are held in memory
+     *
+     * Staged images (see CDisplayPrefetcher::stage()) can be displayed
+     * without decoding or filtering anything on the calling thread.
+     *
+     * @return True if neither pixelData() nor pyramidLevel() will do any work
+     */
+    bool isStagedForDisplay() const;
+
+    /**
+     * @brief Number of pyramid levels, including full resolution
+     * @return Levels down to 1x1
+     */
+    uint32_t pyramidLevelCount() const;
+
+    /**
+     * @brief Coarsest level that still has a pixel per screen pixel
+     * @param scale Screen pixels per image pixel
+     * @return Level to display at @p scale (0 when magnified)
+     */
+    uint32_t pyramidLevelForScale(double scale) const;
+    ///@}
+
+    /** @name Multi-frame Access */
+    ///@{
+    /**
+     * @brief Number of frames in the object
+     * @return Frame count, 1 for single-frame images
+     */
+    uint32_t frameCount() const;
+
+    /**
+     * @brief Retrieves a frame other than the first
+     *
+     * The frame decodes its pixels on first access. Frames share the
+     * header fields of this image but have their own value range, so
+     * pass the window/level explicitly when rendering them.
+     *
+     * @param index Zero-based frame index
+     * @return Frame image, nullptr for frame 0 (this image) or out-of-range frames
+     */
+    std::shared_ptr<const CDicomImage> frame(uint32_t index) const;
+
+    /**
+     * @brief Decodes the frames around @p center in the background
+     *
+     * Frames outside the window are dropped, so memory stays bounded
+     * however long the loop is. The window wraps around the last frame.
+     *
+     * @param center Frame being displayed
+     * @param ahead Frames after @p center to keep decoded
+     * @param behind Frames before @p center to keep decoded
+     */
+    void prefetchFrames(uint32_t center, uint32_t ahead, uint32_t behind) const;
+
+    /**
+     * @brief Playback rate recorded in the header
+     * @return Frames per second, 0 if the header has none
+     */
+    double cineFrameRate() const;
     ///@}
 
     /** @name Image Properties */
@@ -84,6 +221,10 @@ class CDicomImage
 
     /**
      * @brief Retrieves current window/level values
+     *
+     * Until setWindowLevel() or resetWindowLevel() is called this is
+     * defaultWindowLevel(), so it may decode a header-only image.
+     *
      * @return Current window/level settings
      */
     DicomViewer::SWindowLevel windowLevel() const;
@@ -128,6 +269,22 @@ class CDicomImage
      * @return True if signed, false if unsigned
      */
     bool isPixelSigned() const;
+
+    /**
+     * @brief Retrieves the range of decoded sample values
+     * @return Smallest and largest value present in the pixel data
+     */
+    DicomViewer::SValueRange valueRange() const;
+
+    /**
+     * @brief Retrieves min/max/histogram statistics of the pixel data
+     *
+     * Computed on first use (decoding pixels if needed) and kept for
+     * the lifetime of the image, including across releasePixelData().
+     *
+     * @return Shared statistics, nullptr if pixel data is unavailable
+     */
+    std::shared_ptr<const CPixelStatistics> statistics() const;
     ///@}
 
     /** @name Metadata Access */
@@ -143,7 +300,7 @@ class CDicomImage
     ///@{
     /**
      * @brief Checks if image is valid and displayable
-     * @return True if image has valid pixel data and dimensions
+     * @return True if pixel data is available (resident or decodable) and dimensions are valid
      */
     bool isValid() const;
 
@@ -154,9 +311,22 @@ class CDicomImage
     ///@}
 
   private:
+    /**
+     * @brief Fills a scratch image with decoded pixels; returns success
+     */
+    using PixelDecoder = std::function<bool(CDicomImage &target)>;
+    using FrameDecoder = CFrameSequence::FrameDecoder;
+
+    /**
+     * @brief Runs the pixel decoder once if pixels are not resident
+     * @return True if pixel data is resident afterwards
+     */
+    bool ensurePixelData() const;
+
     /** @name Private Setters (accessed by CDicomLoader) */
     ///@{
     void setPixelData(std::vector<uint8_t> &&data);
+    void setPixelData(CPixelStorage storage);
     void setDimensions(const DicomViewer::SImageDimensions &dims);
     void setPhotometricInterpretation(DicomViewer::EPhotometricInterpretation pi);
     void setDefaultWindowLevel(const DicomViewer::SWindowLevel &wl);
@@ -165,21 +335,38 @@ class CDicomImage
     void setMetadata(std::unique_ptr<CDicomMetadata> metadata);
     void setBitsPerSample(uint8_t bits);
     void setPixelSigned(bool isSigned);
+    void setValueRange(const DicomViewer::SValueRange &range);
+    void setPixelDecoder(PixelDecoder decoder);
+    void setFrameDecoder(uint32_t frameCount, FrameDecoder decoder);
+    void setCineFrameRate(double framesPerSecond);
     ///@}
 
-    std::vector<uint8_t> m_pixelData;           /**< Raw pixel data */
     DicomViewer::SImageDimensions m_dimensions; /**< Image dimensions */
     DicomViewer::EPhotometricInterpretation m_photometricInterpretation =
         DicomViewer::EPhotometricInterpretation::Unknown; /**< Color space */
 
-    DicomViewer::SWindowLevel m_windowLevel;        /**< Current window/level */
-    DicomViewer::SWindowLevel m_defaultWindowLevel; /**< Default window/level */
+    /** Current window/level; follows the decoded default until set (guarded by m_pixelMutex) */
+    mutable DicomViewer::SWindowLevel m_windowLevel;
+    bool m_windowLevelSet = false; /**< Set explicitly or from a loaded header */
 
     double m_rescaleSlope = 1.0;     /**< Rescale slope */
     double m_rescaleIntercept = 0.0; /**< Rescale intercept */
+    double m_cineFrameRate = 0.0;    /**< Header playback rate (fps), 0 if none */
 
-    uint8_t m_bitsPerSample = 8; /**< Bits per sample (8 or 16) */
-    bool m_pixelSigned = false;  /**< True if pixel data is signed */
+    /** @name Decoded State (materialized lazily, guarded by m_pixelMutex) */
+    ///@{
+    mutable std::mutex m_pixelMutex;
+    mutable CPixelStorage m_pixelData;                      /**< Raw pixel data */
+    mutable DicomViewer::SWindowLevel m_defaultWindowLevel; /**< Default window/level */
+    mutable uint8_t m_bitsPerSample = 8;                    /**< Bits per sample (8 or 16) */
+    mutable bool m_pixelSigned = false;                     /**< True if pixel data is signed */
+    mutable DicomViewer::SValueRange m_valueRange;          /**< Decoded sample value range */
+    mutable std::shared_ptr<const CPixelStatistics> m_statistics; /**< Computed on first use */
+    mutable CImagePyramid m_pyramid;                        /**< Reduced-resolution levels */
+    mutable CFrameSequence m_frames;                        /**< Frames 1..N-1 of multi-frame objects */
+    mutable bool m_pixelDecodeFailed = false;               /**< Decoder ran and failed */
+    PixelDecoder m_pixelDecoder;                            /**< Decodes pixels of header-only images */
+    ///@}
 
     std::unique_ptr<CDicomMetadata> m_metadata; /**< Associated metadata */
 };
@@ -11,6 +11,8 @@
 
 #include "CDicomLoader.h"
 
+#include "CMappedFile.h"
+
 #include <dcmtk/config/osconfig.h>
 #include <dcmtk/dcmdata/dctk.h>
 #include <dcmtk/dcmdata/dcxfer.h>
@@ -21,9 +23,17 @@
 #include <dcmtk/dcmjpeg/djencode.h>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cmath>
 #include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <tuple>
+#include <utility>
 
 namespace
 {
@@ -42,16 +52,192 @@ struct SCodecRegistration
     }
 };
 static SCodecRegistration s_codecRegistration;
+
+/**
+ * @brief Values longer than this are left on disk until first accessed
+ */
+constexpr Uint32 kHeaderMaxReadLength = 4096;
+
+/**
+ * @brief Offset of the "DICM" prefix, after the Part 10 preamble
+ */
+constexpr size_t kDicomPrefixOffset = 128;
+
+/**
+ * @brief Parsed header of a multi-frame file, shared by all its frames
+ *
+ * PixelData stays on disk; each frame decode reads only that frame.
+ * DCMTK datasets are not thread-safe, so decodes take turns.
+ */
+struct SFrameSource
+{
+    std::mutex mutex;
+    std::unique_ptr<DcmFileFormat> fileFormat;
+};
+
+/**
+ * @brief Text tags copied into the metadata as they are
+ */
+const std::pair<DcmTagKey, CDicomMetadata::ETag> kTextTags[] = {
+    {DCM_SOPInstanceUID, CDicomMetadata::ETag::SopInstanceUid},
+    {DCM_StudyDate, CDicomMetadata::ETag::StudyDate},
+    {DCM_StudyTime, CDicomMetadata::ETag::StudyTime},
+    {DCM_AccessionNumber, CDicomMetadata::ETag::AccessionNumber},
+    {DCM_Modality, CDicomMetadata::ETag::Modality},
+    {DCM_StudyDescription, CDicomMetadata::ETag::StudyDescription},
+    {DCM_SeriesDescription, CDicomMetadata::ETag::SeriesDescription},
+    {DCM_PatientName, CDicomMetadata::ETag::PatientName},
+    {DCM_PatientID, CDicomMetadata::ETag::PatientId},
+    {DCM_PatientBirthDate, CDicomMetadata::ETag::PatientBirthDate},
+    {DCM_PatientSex, CDicomMetadata::ETag::PatientSex},
+    {DCM_StudyInstanceUID, CDicomMetadata::ETag::StudyInstanceUid},
+    {DCM_SeriesInstanceUID, CDicomMetadata::ETag::SeriesInstanceUid},
+};
+
+/**
+ * @brief Decimal string tags kept as numbers, with their multiplicity
+ */
+const std::tuple<DcmTagKey, CDicomMetadata::ETag, size_t> kDecimalTags[] = {
+    {DCM_SliceThickness, CDicomMetadata::ETag::SliceThickness, 1},
+    {DCM_ImagePositionPatient, CDicomMetadata::ETag::ImagePositionPatient, 3},
+    {DCM_ImageOrientationPatient, CDicomMetadata::ETag::ImageOrientationPatient, 6},
+    {DCM_PixelSpacing, CDicomMetadata::ETag::PixelSpacing, 2},
+};
+
+bool textTagOf(const DcmTagKey &key, CDicomMetadata::ETag &tag)
+{
+    for (const auto &entry : kTextTags)
+    {
+        if (entry.first == key)
+        {
+            tag = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool decimalTagOf(const DcmTagKey &key, CDicomMetadata::ETag &tag, size_t &multiplicity)
+{
+    for (const auto &entry : kDecimalTags)
+    {
+        if (std::get<0>(entry) == key)
+        {
+            tag = std::get<1>(entry);
+            multiplicity = std::get<2>(entry);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Reads the first values of a decimal string element
+ * @param element Element to read
+ * @param values Receives @p count values
+ * @param count Number of values required
+ * @return True if the element holds at least @p count values
+ */
+bool readDecimals(DcmElement *element, Float64 *values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (element->getFloat64(values[i], static_cast<unsigned long>(i)).bad())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief How far before its expected position PixelData is searched for
+ *
+ * Only trailing elements such as Data Set Trailing Padding or digital
+ * signatures may follow the pixel data of a native single-frame file.
+ */
+constexpr size_t kPixelDataSearchBytes = 64 * 1024;
+
+constexpr size_t kPixelDataNotFound = static_cast<size_t>(-1);
+
+/**
+ * @brief Locates the value of the top-level PixelData element in a file
+ *
+ * Searches backwards from the end, so PixelData in an icon sequence
+ * earlier in the file is never mistaken for the image's own.
+ *
+ * @param data File contents
+ * @param size File size in bytes
+ * @param valueLength Length of the PixelData value from the parsed header
+ * @param explicitVr True if the element header carries a VR
+ * @return Offset of the first pixel byte, kPixelDataNotFound if absent
+ */
+size_t findPixelData(const uint8_t *data, size_t size, uint32_t valueLength, bool explicitVr)
+{
+    const size_t headerLength = explicitVr ? 12 : 8;
+    if (size < headerLength + valueLength)
+    {
+        return kPixelDataNotFound;
+    }
+    const size_t last = size - headerLength - valueLength;
+    const size_t first = last > kPixelDataSearchBytes ? last - kPixelDataSearchBytes : 0;
+    for (size_t pos = last + 1; pos-- > first;)
+    {
+        const uint8_t *header = data + pos;
+        if (header[0] != 0xE0 || header[1] != 0x7F || header[2] != 0x10 || header[3] != 0x00)
+        {
+            continue;
+        }
+        if (explicitVr && (header[4] != 'O' || (header[5] != 'W' && header[5] != 'B') ||
+                           header[6] != 0 || header[7] != 0))
+        {
+            continue;
+        }
+        const uint8_t *lengthField = header + headerLength - 4;
+        const uint32_t length = lengthField[0] | (lengthField[1] << 8) | (lengthField[2] << 16) |
+                                (static_cast<uint32_t>(lengthField[3]) << 24);
+        if (length == valueLength)
+        {
+            return pos + headerLength;
+        }
+    }
+    return kPixelDataNotFound;
+}
+
+/**
+ * @brief Smallest and largest sample of a buffer
+ * @param samples First sample
+ * @param count Number of samples
+ * @return Range of the values present
+ */
+template <typename T>
+DicomViewer::SValueRange sampleRange(const T *samples, size_t count)
+{
+    if (count == 0)
+    {
+        return {};
+    }
+    T minValue = samples[0];
+    T maxValue = samples[0];
+    for (size_t i = 1; i < count; ++i)
+    {
+        minValue = std::min(minValue, samples[i]);
+        maxValue = std::max(maxValue, samples[i]);
+    }
+    return {static_cast<int32_t>(minValue), static_cast<int32_t>(maxValue)};
+}
 } // namespace
 
 /**
  * @brief Loads a DICOM file from disk
  * @param filePath Path to the DICOM file
+ * @param policy Decode pixels now, or parse the header and defer decoding
  * @return Tuple containing the loaded image (or nullptr on failure) and result code
  */
 std::tuple<std::unique_ptr<CDicomImage>, DicomViewer::ELoadResult>
-CDicomLoader::loadFile(const std::string &filePath)
+CDicomLoader::loadFile(const std::string &filePath, DicomViewer::EPixelLoadPolicy policy)
 {
+    const bool headerOnly = (policy == DicomViewer::EPixelLoadPolicy::OnDemand);
     auto image = std::make_unique<CDicomImage>();
 
     // Check if file exists
@@ -60,51 +246,273 @@ CDicomLoader::loadFile(const std::string &filePath)
         return {nullptr, DicomViewer::ELoadResult::FileNotFound};
     }
 
-    // Load DICOM file using DCMTK
-    DcmFileFormat fileFormat;
-    OFCondition status = fileFormat.loadFile(filePath.c_str());
+    // Reject files that are not DICOM from their first bytes, before
+    // DCMTK tries to parse them as a dataset
+    if (!isValidDicomFile(filePath))
+    {
+        return {nullptr, DicomViewer::ELoadResult::InvalidFormat};
+    }
+
+    // Load DICOM file using DCMTK (ownership later passes to DicomImage).
+    // Large values are read on first access, so a multi-frame object's
+    // pixel data is never loaded as a whole.
+    auto fileFormat = std::make_unique<DcmFileFormat>();
+    OFCondition status = fileFormat->loadFile(filePath.c_str(), EXS_Unknown, EGL_noChange,
+                                              kHeaderMaxReadLength);
 
     if (status.bad())
     {
         return {nullptr, DicomViewer::ELoadResult::InvalidFormat};
     }
 
-    DcmDataset *dataset = fileFormat.getDataset();
+    DcmDataset *dataset = fileFormat->getDataset();
     if (dataset == nullptr)
     {
         return {nullptr, DicomViewer::ELoadResult::InvalidFormat};
     }
 
-    // Extract metadata
+    // Extract image properties and metadata
     auto metadata = std::make_unique<CDicomMetadata>();
-    extractMetadata(dataset, *metadata);
+    SHeaderInfo info;
+    const bool hasImage = extractHeader(dataset, *image, *metadata, info);
     image->setMetadata(std::move(metadata));
-
-    // Extract image properties
-    if (!extractImageData(dataset, *image))
+    if (!hasImage)
     {
         return {nullptr, DicomViewer::ELoadResult::InvalidFormat};
     }
 
+    const uint32_t frameCount = info.frameCount;
+    if (frameCount > 1)
+    {
+        // Keep the parsed header and decode frames, frame 0 included, one
+        // at a time from it, instead of all frames up front
+        auto source = std::make_shared<SFrameSource>();
+        source->fileFormat = std::move(fileFormat);
+        CDicomImage::FrameDecoder decoder = [source](uint32_t frame, CDicomImage &target)
+        {
+            std::lock_guard<std::mutex> lock(source->mutex);
+            CDicomLoader loader;
+            return loader.extractFramePixelData(source->fileFormat->getDataset(), frame,
+                                                source, target);
+        };
+        image->setCineFrameRate(info.frameRate);
+        image->setPixelDecoder([decoder](CDicomImage &target)
+                               { return decoder(0, target); });
+        image->setFrameDecoder(frameCount, std::move(decoder));
+
+        if (!headerOnly)
+        {
+            if (image->pixelData().empty())
+            {
+                return {nullptr, DicomViewer::ELoadResult::DecompressionFailed};
+            }
+            image->statistics();
+        }
+        return {std::move(image), DicomViewer::ELoadResult::Success};
+    }
+
+    // Uncompressed samples that need no modality transform are used
+    // straight from a mapping of the file instead of being decoded
+    SMappedPixels layout;
+    const bool mappable = mappedPixelLayout(dataset, *image, info, layout);
+
+    // Pixels can always be decoded again from the file, so an image whose
+    // pixels were evicted (or never decoded) reloads them on demand
+    image->setPixelDecoder([filePath, mappable, layout](CDicomImage &target)
+                           {
+                               CDicomLoader loader;
+                               if (mappable && loader.mapPixelData(filePath, layout, target))
+                               {
+                                   return true;
+                               }
+                               return loader.decodePixelData(filePath, target); });
+
+    if (headerOnly)
+    {
+        // Decode later from the file; the header parse is dropped here
+        return {std::move(image), DicomViewer::ELoadResult::Success};
+    }
+
+    if (mappable && mapPixelData(filePath, layout, *image))
+    {
+        image->statistics();
+        return {std::move(image), DicomViewer::ELoadResult::Success};
+    }
+
     // Extract pixel data using DicomImage for proper rendering
-    if (!extractPixelData(&fileFormat, *image))
+    if (!extractPixelData(fileFormat.release(), *image))
     {
         return {nullptr, DicomViewer::ELoadResult::DecompressionFailed};
     }
 
+    // Compute statistics while still on the loading thread
+    image->statistics();
+
     return {std::move(image), DicomViewer::ELoadResult::Success};
 }
 
 /**
- * @brief Validates if a file is a valid DICOM file
+ * @brief Reads the header tags of a file without its pixel data
+ * @param filePath Path to the DICOM file
+ * @param metadata Receives the header tags
+ * @return Success if the file is a DICOM image
+ */
+DicomViewer::ELoadResult CDicomLoader::loadHeader(const std::string &filePath,
+                                                  CDicomMetadata &metadata)
+{
+    metadata.clear();
+    if (!isValidDicomFile(filePath))
+    {
+        return DicomViewer::ELoadResult::InvalidFormat;
+    }
+
+    // Everything the catalog needs precedes the pixel data
+    DcmFileFormat fileFormat;
+    if (fileFormat
+            .loadFileUntilTag(filePath.c_str(), EXS_Unknown, EGL_noChange, kHeaderMaxReadLength,
+                              ERM_autoDetect, DCM_PixelData)
+            .bad())
+    {
+        return DicomViewer::ELoadResult::InvalidFormat;
+    }
+
+    DcmDataset *dataset = fileFormat.getDataset();
+    if (dataset == nullptr)
+    {
+        return DicomViewer::ELoadResult::InvalidFormat;
+    }
+
+    CDicomImage image;
+    SHeaderInfo info;
+    if (!extractHeader(dataset, image, metadata, info))
+    {
+        return DicomViewer::ELoadResult::InvalidFormat;
+    }
+    return DicomViewer::ELoadResult::Success;
+}
+
+/**
+ * @brief Reads the image records of a DICOMDIR
+ * @param dicomDirPath Path to the DICOMDIR file
+ * @return Referenced image files, empty if the directory cannot be read
+ */
+std::vector<CDicomLoader::SDirectoryImage>
+CDicomLoader::loadDicomDir(const std::string &dicomDirPath)
+{
+    std::vector<SDirectoryImage> images;
+    DcmDicomDir dicomDir(dicomDirPath.c_str());
+    if (dicomDir.error().bad())
+    {
+        return images;
+    }
+
+    // Referenced File IDs are relative to the folder holding the DICOMDIR
+    const std::filesystem::path base = std::filesystem::path(dicomDirPath).parent_path();
+    OFString fileId;
+
+    DcmDirectoryRecord &root = dicomDir.getRootRecord();
+    for (unsigned long p = 0; p < root.cardSub(); ++p)
+    {
+        DcmDirectoryRecord *patient = root.getSub(p);
+        if (patient == nullptr || patient->getRecordType() != ERT_Patient)
+        {
+            continue;
+        }
+        for (unsigned long s = 0; s < patient->cardSub(); ++s)
+        {
+            DcmDirectoryRecord *study = patient->getSub(s);
+            if (study == nullptr || study->getRecordType() != ERT_Study)
+            {
+                continue;
+            }
+            for (unsigned long r = 0; r < study->cardSub(); ++r)
+            {
+                DcmDirectoryRecord *series = study->getSub(r);
+                if (series == nullptr || series->getRecordType() != ERT_Series)
+                {
+                    continue;
+                }
+                for (unsigned long i = 0; i < series->cardSub(); ++i)
+                {
+                    DcmDirectoryRecord *record = series->getSub(i);
+                    if (record == nullptr || record->getRecordType() != ERT_Image ||
+                        record->findAndGetOFStringArray(DCM_ReferencedFileID, fileId).bad())
+                    {
+                        continue;
+                    }
+
+                    SDirectoryImage image;
+                    std::filesystem::path path = base;
+                    std::string_view components(fileId.c_str(), fileId.length());
+                    while (!components.empty())
+                    {
+                        const size_t separator = components.find('\\');
+                        path /= std::string(components.substr(0, separator));
+                        components = separator == std::string_view::npos
+                                         ? std::string_view()
+                                         : components.substr(separator + 1);
+                    }
+                    image.filePath = path.lexically_normal().string();
+
+                    copyRecordTags(patient, image.metadata);
+                    copyRecordTags(study, image.metadata);
+                    copyRecordTags(series, image.metadata);
+                    copyRecordTags(record, image.metadata);
+                    images.push_back(std::move(image));
+                }
+            }
+        }
+    }
+    return images;
+}
+
+/**
+ * @brief Checks whether a file looks like a DICOM file
+ *
+ * Only the first bytes are read: the 128-byte preamble followed by
+ * "DICM", or, for files written without
+ * a preamble, a little endian dataset whose first element belongs to
+ * group 0002 or 0008 and has either an explicit VR or a plausible
+ * implicit length.
+ *
  * @param filePath Path to the file to validate
- * @return True if the file appears to be a valid DICOM file
+ * @return True if the file appears to be a DICOM file
  */
 bool CDicomLoader::isValidDicomFile(const std::string &filePath)
 {
-    DcmFileFormat fileFormat;
-    OFCondition status = fileFormat.loadFile(filePath.c_str());
-    return status.good();
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::array<unsigned char, kDicomPrefixOffset + 8> head{};
+    file.read(reinterpret_cast<char *>(head.data()), static_cast<std::streamsize>(head.size()));
+    const size_t length = static_cast<size_t>(file.gcount());
+
+    if (length >= kDicomPrefixOffset + 4 &&
+        std::memcmp(head.data() + kDicomPrefixOffset, "DICM", 4) == 0)
+    {
+        return true;
+    }
+
+    // No preamble: the dataset starts at offset 0
+    if (length < 8)
+    {
+        return false;
+    }
+    const unsigned group = head[0] | (head[1] << 8);
+    if (group != 0x0002 && group != 0x0008)
+    {
+        return false;
+    }
+    if (std::isupper(head[4]) && std::isupper(head[5]))
+    {
+        return true;
+    }
+    const uint32_t valueLength =
+        head[4] | (head[5] << 8) | (head[6] << 16) | (static_cast<uint32_t>(head[7]) << 24);
+    return valueLength < kHeaderMaxReadLength;
 }
 
 /**
@@ -134,188 +542,415 @@ std::string CDicomLoader::errorMessage(DicomViewer::ELoadResult result)
 }
 
 /**
- * @brief Extracts image properties from DICOM dataset
+ * @brief Extracts image properties and metadata in one pass over the dataset
+ *
+ * Visits each top-level element once instead of searching the dataset
+ * for every tag, and stops after the last tag of interest; elements are
+ * kept sorted by tag, so only the pixel data and what follows it are
+ * never touched.
+ *
  * @param dcmDataset Pointer to DcmDataset (void* to avoid header exposure)
  * @param image Target image to populate with properties
- * @return True if extraction succeeded
+ * @param metadata Target metadata to populate
+ * @param info Receives frame count and cine rate
+ * @return True if the dataset has image dimensions
  */
-bool CDicomLoader::extractImageData(void *dcmDataset, CDicomImage &image)
+bool CDicomLoader::extractHeader(void *dcmDataset, CDicomImage &image, CDicomMetadata &metadata,
+                                 SHeaderInfo &info)
 {
     DcmDataset *dataset = static_cast<DcmDataset *>(dcmDataset);
 
     DicomViewer::SImageDimensions dims;
+    dims.samplesPerPixel = 1;
+    bool hasRows = false;
+    bool hasColumns = false;
+    Float64 frameTime = 0.0;
+    Sint32 cineRate = 0;
+    Sint32 displayRate = 0;
+    bool hasWindowCenter = false;
+    bool hasWindowWidth = false;
+
+    OFString value;
+    Uint16 number = 0;
+    Float64 real = 0.0;
+    Sint32 integer = 0;
 
-    // Extract dimensions
-    Uint16 rows = 0, columns = 0;
-    if (dataset->findAndGetUint16(DCM_Rows, rows).good() &&
-        dataset->findAndGetUint16(DCM_Columns, columns).good())
+    const unsigned long count = dataset->card();
+    for (unsigned long i = 0; i < count; ++i)
     {
-        dims.height = rows;
-        dims.width = columns;
+        DcmElement *element = dataset->getElement(i);
+        if (element == nullptr)
+        {
+            continue;
+        }
+        const DcmTagKey key = element->getTag();
+        if (key > DCM_ModalityLUTSequence)
+        {
+            break;
+        }
+
+        CDicomMetadata::ETag tag{};
+        size_t multiplicity = 0;
+        if (textTagOf(key, tag))
+        {
+            // Patient, study and series text, interned by the metadata
+            if (element->getOFStringArray(value).good())
+            {
+                metadata.setText(tag, std::string_view(value.c_str(), value.length()));
+            }
+        }
+        else if (decimalTagOf(key, tag, multiplicity))
+        {
+            std::array<Float64, 6> reals{};
+            if (readDecimals(element, reals.data(), multiplicity))
+            {
+                metadata.setReals(tag, reals.data(), multiplicity);
+            }
+        }
+        else if (key == DCM_SeriesNumber || key == DCM_InstanceNumber)
+        {
+            if (element->getSint32(integer, 0).good())
+            {
+                metadata.setInteger(key == DCM_SeriesNumber ? CDicomMetadata::ETag::SeriesNumber
+                                                            : CDicomMetadata::ETag::InstanceNumber,
+                                    integer);
+            }
+        }
+        // Multi-frame and cine
+        else if (key == DCM_NumberOfFrames)
+        {
+            if (element->getSint32(integer, 0).good())
+            {
+                metadata.setInteger(CDicomMetadata::ETag::NumberOfFrames, integer);
+                if (integer > 1)
+                {
+                    info.frameCount = static_cast<uint32_t>(integer);
+                }
+            }
+        }
+        else if (key == DCM_FrameTime)
+        {
+            element->getFloat64(frameTime, 0);
+        }
+        else if (key == DCM_CineRate)
+        {
+            element->getSint32(cineRate, 0);
+        }
+        else if (key == DCM_RecommendedDisplayFrameRate)
+        {
+            element->getSint32(displayRate, 0);
+        }
+        // Image pixel description
+        else if (key == DCM_SamplesPerPixel)
+        {
+            if (element->getUint16(number, 0).good())
+            {
+                dims.samplesPerPixel = number;
+            }
+        }
+        else if (key == DCM_PhotometricInterpretation)
+        {
+            if (element->getOFString(value, 0).good())
+            {
+                image.setPhotometricInterpretation(parsePhotometricInterpretation(value.c_str()));
+                metadata.setText(CDicomMetadata::ETag::PhotometricInterpretation,
+                                 std::string_view(value.c_str(), value.length()));
+            }
+        }
+        else if (key == DCM_Rows)
+        {
+            hasRows = element->getUint16(number, 0).good();
+            if (hasRows)
+            {
+                dims.height = number;
+                metadata.setInteger(CDicomMetadata::ETag::Rows, number);
+            }
+        }
+        else if (key == DCM_Columns)
+        {
+            hasColumns = element->getUint16(number, 0).good();
+            if (hasColumns)
+            {
+                dims.width = number;
+                metadata.setInteger(CDicomMetadata::ETag::Columns, number);
+            }
+        }
+        else if (key == DCM_BitsAllocated)
+        {
+            if (element->getUint16(number, 0).good())
+            {
+                dims.bitsAllocated = number;
+                metadata.setInteger(CDicomMetadata::ETag::BitsAllocated, number);
+            }
+        }
+        else if (key == DCM_BitsStored)
+        {
+            if (element->getUint16(number, 0).good())
+            {
+                dims.bitsStored = number;
+            }
+        }
+        else if (key == DCM_HighBit)
+        {
+            if (element->getUint16(number, 0).good())
+            {
+                dims.highBit = number;
+            }
+        }
+        else if (key == DCM_PixelRepresentation)
+        {
+            if (element->getUint16(number, 0).good())
+            {
+                dims.isSigned = (number == 1);
+            }
+        }
+        // Window/Level and rescale
+        else if (key == DCM_WindowCenter)
+        {
+            hasWindowCenter = element->getFloat64(real, 0).good();
+            if (hasWindowCenter)
+            {
+                info.window.center = real;
+                metadata.setReals(CDicomMetadata::ETag::WindowCenter, &real, 1);
+            }
+        }
+        else if (key == DCM_WindowWidth)
+        {
+            hasWindowWidth = element->getFloat64(real, 0).good();
+            if (hasWindowWidth)
+            {
+                info.window.width = real;
+                metadata.setReals(CDicomMetadata::ETag::WindowWidth, &real, 1);
+            }
+        }
+        else if (key == DCM_RescaleIntercept)
+        {
+            if (element->getFloat64(real, 0).good())
+            {
+                image.setRescaleIntercept(real);
+            }
+        }
+        else if (key == DCM_RescaleSlope)
+        {
+            if (element->getFloat64(real, 0).good())
+            {
+                image.setRescaleSlope(real);
+            }
+        }
+        else if (key == DCM_ModalityLUTSequence)
+        {
+            info.hasModalityLut = true;
+        }
     }
-    else
+    info.hasWindow = hasWindowCenter && hasWindowWidth && info.window.width > 0.0;
+
+    // The transfer syntax lives in the file meta information, not the
+    // dataset; the dataset remembers the one it was read with
+    const DcmXfer xfer(dataset->getOriginalXfer());
+    if (xfer.getXfer() != EXS_Unknown)
     {
-        return false;
+        metadata.setText(CDicomMetadata::ETag::TransferSyntaxUid, xfer.getXferID());
     }
 
-    // Extract bit depth information
-    Uint16 bitsAllocated = 0, bitsStored = 0, highBit = 0;
-    dataset->findAndGetUint16(DCM_BitsAllocated, bitsAllocated);
-    dataset->findAndGetUint16(DCM_BitsStored, bitsStored);
-    dataset->findAndGetUint16(DCM_HighBit, highBit);
-    dims.bitsAllocated = bitsAllocated;
-    dims.bitsStored = bitsStored;
-    dims.highBit = highBit;
-
-    // Extract samples per pixel
-    Uint16 samplesPerPixel = 1;
-    dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel);
-    dims.samplesPerPixel = samplesPerPixel;
-
-    // Check pixel representation (signed/unsigned)
-    Uint16 pixelRepresentation = 0;
-    dataset->findAndGetUint16(DCM_PixelRepresentation, pixelRepresentation);
-    dims.isSigned = (pixelRepresentation == 1);
-
-    image.setDimensions(dims);
-
-    // Extract photometric interpretation
-    OFString piString;
-    if (dataset->findAndGetOFString(DCM_PhotometricInterpretation, piString).good())
+    if (frameTime > 0.0)
     {
-        image.setPhotometricInterpretation(
-            parsePhotometricInterpretation(piString.c_str()));
+        info.frameRate = 1000.0 / frameTime;
     }
-
-    // Extract rescale parameters
-    Float64 rescaleSlope = 1.0, rescaleIntercept = 0.0;
-    if (dataset->findAndGetFloat64(DCM_RescaleSlope, rescaleSlope).good())
+    else if (cineRate > 0)
     {
-        image.setRescaleSlope(rescaleSlope);
+        info.frameRate = static_cast<double>(cineRate);
     }
-    if (dataset->findAndGetFloat64(DCM_RescaleIntercept, rescaleIntercept).good())
+    else if (displayRate > 0)
     {
-        image.setRescaleIntercept(rescaleIntercept);
+        info.frameRate = static_cast<double>(displayRate);
     }
 
+    if (!hasRows || !hasColumns)
+    {
+        return false;
+    }
+    image.setDimensions(dims);
     return true;
 }
 
 /**
- * @brief Extracts metadata from DICOM dataset
- * @param dcmDataset Pointer to DcmDataset
- * @param metadata Target metadata to populate
- * @return True if extraction succeeded
+ * @brief Copies the catalog tags of a DICOMDIR record into metadata
+ * @param directoryRecord Pointer to DcmDirectoryRecord
+ * @param metadata Target metadata; tags already set are overwritten
  */
-bool CDicomLoader::extractMetadata(void *dcmDataset, CDicomMetadata &metadata)
+void CDicomLoader::copyRecordTags(void *directoryRecord, CDicomMetadata &metadata)
 {
-    DcmDataset *dataset = static_cast<DcmDataset *>(dcmDataset);
+    DcmDirectoryRecord *record = static_cast<DcmDirectoryRecord *>(directoryRecord);
     OFString value;
+    Sint32 integer = 0;
 
-    // Patient information
-    if (dataset->findAndGetOFStringArray(DCM_PatientName, value).good())
-    {
-        metadata.setPatientName(value.c_str());
-    }
-    if (dataset->findAndGetOFString(DCM_PatientID, value).good())
-    {
-        metadata.setPatientId(value.c_str());
-    }
-    if (dataset->findAndGetOFString(DCM_PatientBirthDate, value).good())
+    for (const auto &entry : kTextTags)
     {
-        metadata.setPatientBirthDate(value.c_str());
+        if (record->findAndGetOFStringArray(entry.first, value).good())
+        {
+            metadata.setText(entry.second, std::string_view(value.c_str(), value.length()));
+        }
     }
-    if (dataset->findAndGetOFString(DCM_PatientSex, value).good())
+    // Image records name the instance they point to differently
+    if (record->findAndGetOFString(DCM_ReferencedSOPInstanceUIDInFile, value).good())
     {
-        metadata.setPatientSex(value.c_str());
+        metadata.setText(CDicomMetadata::ETag::SopInstanceUid,
+                         std::string_view(value.c_str(), value.length()));
     }
 
-    // Study information
-    if (dataset->findAndGetOFString(DCM_StudyDate, value).good())
+    const std::pair<DcmTagKey, CDicomMetadata::ETag> integerTags[] = {
+        {DCM_SeriesNumber, CDicomMetadata::ETag::SeriesNumber},
+        {DCM_InstanceNumber, CDicomMetadata::ETag::InstanceNumber},
+        {DCM_NumberOfFrames, CDicomMetadata::ETag::NumberOfFrames},
+    };
+    for (const auto &entry : integerTags)
     {
-        metadata.setStudyDate(value.c_str());
-    }
-    if (dataset->findAndGetOFString(DCM_StudyTime, value).good())
-    {
-        metadata.setStudyTime(value.c_str());
-    }
-    if (dataset->findAndGetOFString(DCM_StudyDescription, value).good())
-    {
-        metadata.setStudyDescription(value.c_str());
-    }
-    if (dataset->findAndGetOFString(DCM_AccessionNumber, value).good())
-    {
-        metadata.setAccessionNumber(value.c_str());
+        if (record->findAndGetSint32(entry.first, integer).good())
+        {
+            metadata.setInteger(entry.second, integer);
+        }
     }
+}
 
-    // Series information
-    if (dataset->findAndGetOFString(DCM_SeriesDescription, value).good())
-    {
-        metadata.setSeriesDescription(value.c_str());
-    }
-    if (dataset->findAndGetOFString(DCM_Modality, value).good())
+/**
+ * @brief Checks whether the pixel data can be used straight from the file
+ *
+ * DicomImage masks unused high bits and applies the modality transform
+ * to the stored samples. Only when both are no-ops, and the samples are
+ * uncompressed in host byte order, are the stored bytes exactly what
+ * decoding would produce.
+ *
+ * @param dcmDataset Pointer to DcmDataset (PixelData need not be loaded)
+ * @param image Image populated by extractHeader()
+ * @param info Header values from extractHeader()
+ * @param layout Receives what mapPixelData() needs to find the pixels
+ * @return True if the pixel data can be mapped
+ */
+bool CDicomLoader::mappedPixelLayout(void *dcmDataset, const CDicomImage &image,
+                                     const SHeaderInfo &info, SMappedPixels &layout)
+{
+    DcmDataset *dataset = static_cast<DcmDataset *>(dcmDataset);
+
+    const E_TransferSyntax xfer = dataset->getOriginalXfer();
+    if (gLocalByteOrder != EBO_LittleEndian ||
+        (xfer != EXS_LittleEndianExplicit && xfer != EXS_LittleEndianImplicit))
     {
-        metadata.setModality(value.c_str());
+        return false;
     }
-    if (dataset->findAndGetOFString(DCM_SeriesNumber, value).good())
+
+    const auto dims = image.dimensions();
+    const auto photometric = image.photometricInterpretation();
+    if (info.frameCount != 1 || dims.samplesPerPixel != 1 ||
+        (photometric != DicomViewer::EPhotometricInterpretation::Monochrome1 &&
+         photometric != DicomViewer::EPhotometricInterpretation::Monochrome2))
     {
-        metadata.setSeriesNumber(value.c_str());
+        return false;
     }
 
-    // Image information
-    if (dataset->findAndGetOFString(DCM_InstanceNumber, value).good())
+    // Signed 8-bit samples are rendered through the 8-bit output instead
+    const bool wholeSamples = (dims.bitsAllocated == 16 ||
+                               (dims.bitsAllocated == 8 && !dims.isSigned)) &&
+                              dims.bitsStored == dims.bitsAllocated &&
+                              dims.highBit == dims.bitsAllocated - 1;
+    if (!wholeSamples || info.hasModalityLut || image.rescaleSlope() != 1.0 ||
+        image.rescaleIntercept() != 0.0)
     {
-        metadata.setInstanceNumber(value.c_str());
+        return false;
     }
-    if (dataset->findAndGetOFStringArray(DCM_ImagePositionPatient, value).good())
+
+    DcmElement *pixelData = nullptr;
+    if (dataset->findAndGetElement(DCM_PixelData, pixelData).bad() || pixelData == nullptr)
     {
-        metadata.setImagePositionPatient(value.c_str());
+        return false;
     }
-    if (dataset->findAndGetOFString(DCM_SliceThickness, value).good())
+    const Uint32 length = pixelData->getLength();
+    const size_t expected =
+        static_cast<size_t>(dims.width) * dims.height * (dims.bitsAllocated / 8);
+    if (length == DCM_UndefinedLength || length < expected)
     {
-        metadata.setSliceThickness(value.c_str());
+        return false;
     }
-    if (dataset->findAndGetOFString(DCM_PhotometricInterpretation, value).good())
+
+    layout.valueLength = length;
+    layout.explicitVr = (xfer == EXS_LittleEndianExplicit);
+    layout.hasWindow = info.hasWindow;
+    layout.window = info.window;
+    return true;
+}
+
+/**
+ * @brief Maps a file and references its native pixel data
+ *
+ * The pixel storage shares ownership of the mapping, which stays in
+ * place until the pixels are released. Nothing is copied or allocated
+ * for the samples; reopening a file that is in the page cache costs
+ * one mapping and a min/max scan.
+ *
+ * @param filePath Path to the DICOM file
+ * @param layout Layout from mappedPixelLayout()
+ * @param image Target image to populate
+ * @return True if the pixel data was found in the mapping
+ */
+bool CDicomLoader::mapPixelData(const std::string &filePath, const SMappedPixels &layout,
+                                CDicomImage &image)
+{
+    auto mapped = CMappedFile::open(filePath);
+    if (!mapped)
     {
-        metadata.setTag("Photometric Interpretation", value.c_str());
+        return false;
     }
-    if (dataset->findAndGetOFString(DCM_TransferSyntaxUID, value).good())
+    const size_t offset = findPixelData(mapped->data(), mapped->size(), layout.valueLength,
+                                        layout.explicitVr);
+    if (offset == kPixelDataNotFound)
     {
-        metadata.setTag("Transfer Syntax", value.c_str());
+        return false;
     }
 
-    // Numeric values as strings for display
-    Uint16 numValue = 0;
-    if (dataset->findAndGetUint16(DCM_Rows, numValue).good())
+    const auto dims = image.dimensions();
+    const size_t count = static_cast<size_t>(dims.width) * dims.height;
+    const size_t bytes = count * (dims.bitsAllocated / 8);
+    mapped->willNeed(offset, bytes);
+    const uint8_t *pixels = mapped->data() + offset;
+
+    image.setPixelData(CPixelStorage::adopt(pixels, bytes, mapped));
+    image.setBitsPerSample(static_cast<uint8_t>(dims.bitsAllocated));
+    image.setPixelSigned(dims.isSigned);
+
+    // Narrow to the values actually present, as for decoded samples
+    if (dims.bitsAllocated == 8)
     {
-        metadata.setRows(std::to_string(numValue));
+        image.setValueRange(sampleRange(pixels, count));
     }
-    if (dataset->findAndGetUint16(DCM_Columns, numValue).good())
+    else if (dims.isSigned)
     {
-        metadata.setColumns(std::to_string(numValue));
+        image.setValueRange(sampleRange(reinterpret_cast<const int16_t *>(pixels), count));
     }
-    if (dataset->findAndGetUint16(DCM_BitsAllocated, numValue).good())
+    else
     {
-        metadata.setBitsAllocated(std::to_string(numValue));
+        image.setValueRange(sampleRange(reinterpret_cast<const uint16_t *>(pixels), count));
     }
 
-    // Window/Level values
-    Float64 floatValue = 0.0;
-    if (dataset->findAndGetFloat64(DCM_WindowCenter, floatValue).good())
+    if (layout.hasWindow)
     {
-        metadata.setWindowCenter(std::to_string(floatValue));
+        image.setDefaultWindowLevel(layout.window);
     }
-    if (dataset->findAndGetFloat64(DCM_WindowWidth, floatValue).good())
+    else if (auto stats = image.statistics(); stats && stats->isValid())
     {
-        metadata.setWindowWidth(std::to_string(floatValue));
+        image.setDefaultWindowLevel(stats->minMaxWindow());
     }
-
     return true;
 }
 
 /**
  * @brief Extracts pixel data using DicomImage rendering pipeline
- * @param dcmFileFormat Pointer to DcmFileFormat
+ *
+ * The decoded buffer is not copied: the image's pixel storage shares
+ * ownership of the DicomImage that holds it. DicomImage takes over the
+ * file format and may detach the raw PixelData element once the
+ * intermediate representation exists, so only one full-size buffer
+ * stays resident per image.
+ *
+ * @param dcmFileFormat Pointer to DcmFileFormat (ownership is transferred)
  * @param image Target image to populate with pixel data
  * @return True if extraction succeeded
  */
@@ -324,104 +959,194 @@ bool CDicomLoader::extractPixelData(void *dcmFileFormat, CDicomImage &image)
     DcmFileFormat *fileFormat = static_cast<DcmFileFormat *>(dcmFileFormat);
 
     // Use DicomImage for proper rendering pipeline (handles Modality LUT)
-    DicomImage dcmImage(fileFormat, EXS_Unknown);
+    auto dcmImage = std::make_shared<DicomImage>(
+        fileFormat, EXS_Unknown,
+        CIF_TakeOverExternalDataset | CIF_MayDetachPixelData);
+
+    return adoptPixelData(dcmImage.get(), dcmImage, image);
+}
 
-    if (dcmImage.getStatus() != EIS_Normal)
+/**
+ * @brief Decodes a single frame of a dataset that stays with the caller
+ *
+ * With partial access DCMTK reads (and decompresses) only the requested
+ * frame, so the cost of a frame does not grow with the number of frames.
+ *
+ * @param dcmDataset Pointer to DcmDataset (borrowed)
+ * @param frame Zero-based frame index
+ * @param datasetOwner Keeps the dataset alive as long as the decoded pixels
+ * @param image Target image to populate
+ * @return True if decoding succeeded
+ */
+bool CDicomLoader::extractFramePixelData(void *dcmDataset, uint32_t frame,
+                                         std::shared_ptr<const void> datasetOwner,
+                                         CDicomImage &image)
+{
+    DcmDataset *dataset = static_cast<DcmDataset *>(dcmDataset);
+
+    // The DicomImage refers to the borrowed dataset, which must outlive it
+    std::shared_ptr<DicomImage> dcmImage(
+        new DicomImage(dataset, dataset->getOriginalXfer(),
+                       CIF_UsePartialAccessToPixelData, frame, 1),
+        [datasetOwner](DicomImage *decoded)
+        { delete decoded; });
+
+    return adoptPixelData(dcmImage.get(), dcmImage, image);
+}
+
+/**
+ * @brief Shares the decoded samples of a DicomImage with an image
+ *
+ * Monochrome intermediate data is not copied: the image's pixel storage
+ * shares ownership of the DicomImage that holds it. The 8-bit output of
+ * color and unsupported formats is copied instead, so the DicomImage and
+ * its intermediate data are freed once the caller drops it.
+ *
+ * @param dicomImage Pointer to DicomImage
+ * @param owner Keeps the DicomImage alive as long as the pixels
+ * @param image Target image to populate
+ * @return True if the DicomImage holds usable pixel data
+ */
+bool CDicomLoader::adoptPixelData(void *dicomImage, std::shared_ptr<const void> owner,
+                                  CDicomImage &image)
+{
+    DicomImage *dcmImage = static_cast<DicomImage *>(dicomImage);
+
+    if (dcmImage->getStatus() != EIS_Normal)
     {
         return false;
     }
 
-    // Set window/level from DICOM or calculate from min/max
-    double windowCenter = 0.0, windowWidth = 0.0;
-    if (dcmImage.getWindow(windowCenter, windowWidth))
+    // Get intermediate data to preserve original bit depth. Color
+    // intermediate data is planar (one buffer per channel), so color
+    // images always go through the interleaved 8-bit output below.
+    const DiPixel *interData = dcmImage->isMonochrome() ? dcmImage->getInterData() : nullptr;
+    if (dcmImage->isMonochrome() && interData == nullptr)
     {
-        image.setDefaultWindowLevel({windowCenter, windowWidth});
+        return false;
     }
-    else
+
+    // Set window/level from DICOM; without one, intermediate data gets a
+    // min/max window from the pixel statistics further down
+    double windowCenter = 0.0, windowWidth = 0.0;
+    const bool hasHeaderWindow = dcmImage->getWindow(windowCenter, windowWidth) != 0;
+    if (hasHeaderWindow)
     {
-        // Calculate window from image min/max
-        dcmImage.setMinMaxWindow();
-        dcmImage.getWindow(windowCenter, windowWidth);
         image.setDefaultWindowLevel({windowCenter, windowWidth});
     }
-
-    // Get intermediate data to preserve original bit depth
-    const DiPixel *interData = dcmImage.getInterData();
-    if (interData == nullptr)
+    else if (interData == nullptr)
     {
-        return false;
+        // The 8-bit output below is rendered through DCMTK's own window
+        dcmImage->setMinMaxWindow();
+        dcmImage->getWindow(windowCenter, windowWidth);
+        image.setDefaultWindowLevel({windowCenter, windowWidth});
     }
 
-    EP_Representation rep = interData->getRepresentation();
-    const void *pixelData = interData->getData();
-    const unsigned long pixelCount = interData->getCount();
+    EP_Representation rep = interData ? interData->getRepresentation() : EPR_Uint8;
+    const void *pixelData = interData ? interData->getData() : nullptr;
+    const unsigned long pixelCount = interData ? interData->getCount() : 0;
 
-    if (pixelData == nullptr || pixelCount == 0)
+    if (interData && (pixelData == nullptr || pixelCount == 0))
     {
         return false;
     }
 
-    // Copy pixel data based on representation
-    if (rep == EPR_Uint8)
+    // Share pixel data based on representation
+    const auto *bytes = static_cast<const uint8_t *>(pixelData);
+    if (interData && rep == EPR_Uint8)
     {
         // 8-bit unsigned
-        std::vector<uint8_t> data(pixelCount);
-        std::memcpy(data.data(), pixelData, pixelCount);
-        image.setPixelData(std::move(data));
+        image.setPixelData(CPixelStorage::adopt(bytes, pixelCount, owner));
         image.setBitsPerSample(8);
         image.setPixelSigned(false);
+        image.setValueRange({0, 255});
     }
-    else if (rep == EPR_Uint16)
+    else if (interData && rep == EPR_Uint16)
     {
         // 16-bit unsigned
-        std::vector<uint8_t> data(pixelCount * 2);
-        std::memcpy(data.data(), pixelData, pixelCount * 2);
-        image.setPixelData(std::move(data));
+        image.setPixelData(CPixelStorage::adopt(bytes, pixelCount * 2, owner));
         image.setBitsPerSample(16);
         image.setPixelSigned(false);
+        image.setValueRange({0, 65535});
     }
-    else if (rep == EPR_Sint16)
+    else if (interData && rep == EPR_Sint16)
     {
         // 16-bit signed
-        std::vector<uint8_t> data(pixelCount * 2);
-        std::memcpy(data.data(), pixelData, pixelCount * 2);
-        image.setPixelData(std::move(data));
+        image.setPixelData(CPixelStorage::adopt(bytes, pixelCount * 2, owner));
         image.setBitsPerSample(16);
         image.setPixelSigned(true);
+        image.setValueRange({-32768, 32767});
     }
     else
     {
-        // Fallback to 8-bit output for unsupported formats
+        // Fallback to 8-bit output for color and unsupported formats
         constexpr int kOutputBitDepth = 8;
-        const void *outputData = dcmImage.getOutputData(kOutputBitDepth);
+        const void *outputData = dcmImage->getOutputData(kOutputBitDepth);
         if (outputData == nullptr)
         {
             return false;
         }
-        size_t dataSize = dcmImage.getOutputDataSize(kOutputBitDepth);
+        size_t dataSize = dcmImage->getOutputDataSize(kOutputBitDepth);
         if (dataSize == 0)
         {
             return false;
         }
-        std::vector<uint8_t> data(dataSize);
-        std::memcpy(data.data(), outputData, dataSize);
-        image.setPixelData(std::move(data));
+        // Adopting the output would keep the DicomImage alive with its
+        // intermediate data as well, doubling the footprint; copy it out
+        const auto *outputBytes = static_cast<const uint8_t *>(outputData);
+        image.setPixelData(std::vector<uint8_t>(outputBytes, outputBytes + dataSize));
         image.setBitsPerSample(8);
         image.setPixelSigned(false);
         // For fallback, use 8-bit W/L range
         image.setDefaultWindowLevel({128.0, 256.0});
+        image.setValueRange({0, 255});
+    }
+
+    // Narrow 16-bit data to the values actually present (after the modality
+    // transform) so window/level lookup tables only cover the stored range;
+    // 8-bit samples keep the full {0, 255} range their type implies
+    double minValue = 0.0, maxValue = 0.0;
+    if (interData && rep != EPR_Uint8 && dcmImage->getMinMaxValues(minValue, maxValue) != 0)
+    {
+        image.setValueRange({static_cast<int32_t>(std::floor(minValue)),
+                             static_cast<int32_t>(std::ceil(maxValue))});
+    }
+
+    if (interData && !hasHeaderWindow)
+    {
+        // One parallel scan gives the window and warms the statistics
+        if (auto stats = image.statistics(); stats && stats->isValid())
+        {
+            image.setDefaultWindowLevel(stats->minMaxWindow());
+        }
     }
 
     // Update dimensions from DicomImage (may differ from dataset if interpolated)
     auto dims = image.dimensions();
-    dims.width = dcmImage.getWidth();
-    dims.height = dcmImage.getHeight();
-    dims.samplesPerPixel = dcmImage.isMonochrome() ? 1 : 3;
+    dims.width = dcmImage->getWidth();
+    dims.height = dcmImage->getHeight();
+    dims.samplesPerPixel = dcmImage->isMonochrome() ? 1 : 3;
     image.setDimensions(dims);
 
     return true;
 }
 
+/**
+ * @brief Reads a file in full and decodes its pixel data
+ * @param filePath Path to the DICOM file
+ * @param image Target image to populate with pixel data
+ * @return True if decoding succeeded
+ */
+bool CDicomLoader::decodePixelData(const std::string &filePath, CDicomImage &image)
+{
+    auto fileFormat = std::make_unique<DcmFileFormat>();
+    if (fileFormat->loadFile(filePath.c_str()).bad())
+    {
+        return false;
+    }
+    return extractPixelData(fileFormat.release(), image);
+}
+
 /**
  * @brief Parses photometric interpretation string to enum
  * @param piString Photometric interpretation string from DICOM
@@ -14,9 +14,11 @@
 #include "CDicomImage.h"
 #include "DicomViewer/Types.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 /**
  * @class CDicomLoader
@@ -39,6 +41,15 @@
 class CDicomLoader
 {
   public:
+    /**
+     * @brief An image file referenced by a DICOMDIR
+     */
+    struct SDirectoryImage
+    {
+        std::string filePath;    /**< Absolute path of the referenced file */
+        CDicomMetadata metadata; /**< Tags of the patient, study, series and image records */
+    };
+
     /**
      * @brief Default constructor
      */
@@ -61,16 +72,53 @@ class CDicomLoader
     ///@{
     /**
      * @brief Loads a DICOM file from disk
+     *
+     * With EPixelLoadPolicy::OnDemand only the header is parsed (large
+     * values such as PixelData are skipped); the returned image decodes
+     * its pixels from @p filePath on first access.
+     *
      * @param filePath Path to the DICOM file
+     * @param policy When to decode the pixel data
      * @return Tuple containing the loaded image (or nullptr) and result code
      */
     std::tuple<std::unique_ptr<CDicomImage>, DicomViewer::ELoadResult>
-    loadFile(const std::string &filePath);
+    loadFile(const std::string &filePath,
+             DicomViewer::EPixelLoadPolicy policy = DicomViewer::EPixelLoadPolicy::Immediate);
 
     /**
-     * @brief Validates if a file is a valid DICOM file
+     * @brief Reads the header tags of a file without its pixel data
+     *
+     * Parsing stops at PixelData, so the cost does not depend on the
+     * size of the image. No CDicomImage is created.
+     *
+     * @param filePath Path to the DICOM file
+     * @param metadata Receives the header tags
+     * @return Success if the file is a DICOM image
+     */
+    DicomViewer::ELoadResult loadHeader(const std::string &filePath, CDicomMetadata &metadata);
+
+    /**
+     * @brief Reads the image records of a DICOMDIR
+     *
+     * The directory already holds the patient, study and series of every
+     * referenced image, so media with a DICOMDIR can be cataloged without
+     * opening the image files.
+     *
+     * @param dicomDirPath Path to the DICOMDIR file
+     * @return Referenced image files, empty if the directory cannot be read
+     */
+    std::vector<SDirectoryImage> loadDicomDir(const std::string &dicomDirPath);
+
+    /**
+     * @brief Checks whether a file looks like a DICOM file
+     *
+     * Reads only the first few hundred bytes: a Part 10 preamble with
+     * the "DICM" prefix, or a raw little endian dataset starting with a
+     * group 0002 or 0008 element. The dataset itself is not parsed, so a
+     * file passing the probe may still fail to load.
+     *
      * @param filePath Path to the file to validate
-     * @return True if the file is a valid DICOM file
+     * @return True if the file appears to be a DICOM file
      */
     static bool isValidDicomFile(const std::string &filePath);
 
@@ -86,29 +134,104 @@ class CDicomLoader
     /** @name Internal Helper Methods */
     ///@{
     /**
-     * @brief Extracts image properties from DICOM dataset
+     * @brief Header values that do not belong to the image or its metadata
+     */
+    struct SHeaderInfo
+    {
+        uint32_t frameCount = 1; /**< Number of Frames, 1 if absent or invalid */
+        double frameRate = 0.0;  /**< Cine rate in frames per second, 0 if none */
+        bool hasWindow = false;  /**< First Window Center/Width pair present */
+        DicomViewer::SWindowLevel window{};
+        bool hasModalityLut = false; /**< Modality LUT Sequence present */
+    };
+
+    /**
+     * @brief Where the native pixel data of a file can be mapped from
+     */
+    struct SMappedPixels
+    {
+        uint32_t valueLength = 0; /**< Length of the PixelData value */
+        bool explicitVr = false;  /**< PixelData header carries a VR */
+        bool hasWindow = false;
+        DicomViewer::SWindowLevel window{};
+    };
+
+    /**
+     * @brief Extracts image properties and metadata in one pass over the dataset
      * @param dcmDataset Pointer to DcmDataset
      * @param image Target image to populate
-     * @return True if extraction succeeded
+     * @param metadata Target metadata to populate
+     * @param info Receives frame count and cine rate
+     * @return True if the dataset has image dimensions
+     */
+    bool extractHeader(void *dcmDataset, CDicomImage &image, CDicomMetadata &metadata,
+                       SHeaderInfo &info);
+
+    /**
+     * @brief Copies the catalog tags of a DICOMDIR record into metadata
+     * @param directoryRecord Pointer to DcmDirectoryRecord
+     * @param metadata Target metadata; tags already set are overwritten
      */
-    bool extractImageData(void *dcmDataset, CDicomImage &image);
+    void copyRecordTags(void *directoryRecord, CDicomMetadata &metadata);
 
     /**
-     * @brief Extracts metadata from DICOM dataset
+     * @brief Checks whether the pixel data can be used straight from the file
      * @param dcmDataset Pointer to DcmDataset
-     * @param metadata Target metadata to populate
-     * @return True if extraction succeeded
+     * @param image Image populated by extractHeader()
+     * @param info Header values from extractHeader()
+     * @param layout Receives what mapPixelData() needs to find the pixels
+     * @return True if the stored samples equal the decoded ones
+     */
+    bool mappedPixelLayout(void *dcmDataset, const CDicomImage &image, const SHeaderInfo &info,
+                           SMappedPixels &layout);
+
+    /**
+     * @brief Maps a file and references its native pixel data
+     * @param filePath Path to the DICOM file
+     * @param layout Layout from mappedPixelLayout()
+     * @param image Target image to populate
+     * @return True if the pixel data was found in the mapping
      */
-    bool extractMetadata(void *dcmDataset, CDicomMetadata &metadata);
+    bool mapPixelData(const std::string &filePath, const SMappedPixels &layout,
+                      CDicomImage &image);
 
     /**
      * @brief Extracts pixel data using DicomImage rendering pipeline
-     * @param dcmFileFormat Pointer to DcmFileFormat
+     * @param dcmFileFormat Pointer to DcmFileFormat (ownership is transferred)
      * @param image Target image to populate
      * @return True if extraction succeeded
      */
     bool extractPixelData(void *dcmFileFormat, CDicomImage &image);
 
+    /**
+     * @brief Decodes a single frame of a dataset that stays with the caller
+     * @param dcmDataset Pointer to DcmDataset (borrowed)
+     * @param frame Zero-based frame index
+     * @param datasetOwner Keeps the dataset alive as long as the decoded pixels
+     * @param image Target image to populate
+     * @return True if decoding succeeded
+     */
+    bool extractFramePixelData(void *dcmDataset, uint32_t frame,
+                               std::shared_ptr<const void> datasetOwner,
+                               CDicomImage &image);
+
+    /**
+     * @brief Shares the decoded samples of a DicomImage with an image
+     * @param dicomImage Pointer to DicomImage
+     * @param owner Keeps the DicomImage alive as long as adopted pixels
+     * @param image Target image to populate
+     * @return True if the DicomImage holds usable pixel data
+     */
+    bool adoptPixelData(void *dicomImage, std::shared_ptr<const void> owner, CDicomImage &image);
+
+    /**
+     * @brief Reads a file in full and decodes its pixel data
+     * @param filePath Path to the DICOM file
+     * @param image Target image to populate
+     * @return True if decoding succeeded
+     */
+    bool decodePixelData(const std::string &filePath, CDicomImage &image);
+
     /**
      * @brief Parses photometric interpretation string
      * @param piString Photometric interpretation from DICOM
@@ -11,232 +11,448 @@
 
 #include "CDicomMetadata.h"
 
-#include <utility>
+#include <cstdio>
 
 namespace
 {
-    std::string getTagValue(const std::unordered_map<std::string, std::string> &tags,
-                            const std::string &key)
+using ETag = CDicomMetadata::ETag;
+
+enum class EValueKind : uint8_t
+{
+    Text,
+    Integer,
+    Real
+};
+
+/**
+ * @brief Where a tag is stored
+ */
+struct SField
+{
+    ETag tag;
+    const char *name;
+    EValueKind kind;
+    uint8_t slot;  /**< First slot in the storage of its kind */
+    uint8_t count; /**< Value multiplicity */
+};
+
+/** Sorted by tag; the index of a field is its bit in the presence mask */
+constexpr SField kFields[] = {
+    {ETag::TransferSyntaxUid, "Transfer Syntax", EValueKind::Text, 0, 1},
+    {ETag::SopInstanceUid, "SOP Instance UID", EValueKind::Text, 13, 1},
+    {ETag::StudyDate, "Study Date", EValueKind::Text, 1, 1},
+    {ETag::StudyTime, "Study Time", EValueKind::Text, 2, 1},
+    {ETag::AccessionNumber, "Accession Number", EValueKind::Text, 3, 1},
+    {ETag::Modality, "Modality", EValueKind::Text, 4, 1},
+    {ETag::StudyDescription, "Study Description", EValueKind::Text, 5, 1},
+    {ETag::SeriesDescription, "Series Description", EValueKind::Text, 6, 1},
+    {ETag::PatientName, "Patient Name", EValueKind::Text, 7, 1},
+    {ETag::PatientId, "Patient ID", EValueKind::Text, 8, 1},
+    {ETag::PatientBirthDate, "Patient Birth Date", EValueKind::Text, 9, 1},
+    {ETag::PatientSex, "Patient Sex", EValueKind::Text, 10, 1},
+    {ETag::SliceThickness, "Slice Thickness", EValueKind::Real, 0, 1},
+    {ETag::StudyInstanceUid, "Study Instance UID", EValueKind::Text, 14, 1},
+    {ETag::SeriesInstanceUid, "Series Instance UID", EValueKind::Text, 11, 1},
+    {ETag::SeriesNumber, "Series Number", EValueKind::Integer, 0, 1},
+    {ETag::InstanceNumber, "Instance Number", EValueKind::Integer, 1, 1},
+    {ETag::ImagePositionPatient, "Image Position Patient", EValueKind::Real, 1, 3},
+    {ETag::ImageOrientationPatient, "Image Orientation Patient", EValueKind::Real, 4, 6},
+    {ETag::PhotometricInterpretation, "Photometric Interpretation", EValueKind::Text, 12, 1},
+    {ETag::NumberOfFrames, "Number of Frames", EValueKind::Integer, 2, 1},
+    {ETag::Rows, "Rows", EValueKind::Integer, 3, 1},
+    {ETag::Columns, "Columns", EValueKind::Integer, 4, 1},
+    {ETag::PixelSpacing, "Pixel Spacing", EValueKind::Real, 10, 2},
+    {ETag::BitsAllocated, "Bits Allocated", EValueKind::Integer, 5, 1},
+    {ETag::WindowCenter, "Window Center", EValueKind::Real, 12, 1},
+    {ETag::WindowWidth, "Window Width", EValueKind::Real, 13, 1},
+};
+
+constexpr size_t kFieldCount = sizeof(kFields) / sizeof(kFields[0]);
+static_assert(kFieldCount <= 32, "Presence mask holds one bit per field");
+
+/** Tags that identify the patient, study and series rather than one instance */
+constexpr ETag kSeriesIdentityTags[] = {
+    ETag::StudyDate,         ETag::StudyTime,         ETag::AccessionNumber,
+    ETag::Modality,          ETag::StudyDescription,  ETag::SeriesDescription,
+    ETag::PatientName,       ETag::PatientId,         ETag::PatientBirthDate,
+    ETag::PatientSex,        ETag::StudyInstanceUid,  ETag::SeriesInstanceUid,
+    ETag::SeriesNumber,
+};
+
+/**
+ * @brief Index of a tag in kFields
+ */
+constexpr size_t fieldIndex(ETag tag)
+{
+    for (size_t i = 0; i < kFieldCount; ++i)
     {
-        auto it = tags.find(key);
-        return it != tags.end() ? it->second : std::string();
+        if (kFields[i].tag == tag)
+        {
+            return i;
+        }
     }
+    return kFieldCount;
 }
 
-std::string CDicomMetadata::patientName() const
+/**
+ * @brief Formats a decimal value the way DS values are usually written
+ */
+std::string formatReal(double value)
 {
-    return getTagValue(m_tags, "Patient Name");
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    return buffer;
 }
 
-std::string CDicomMetadata::patientId() const
+const std::string kEmpty;
+} // namespace
+
+const std::string &CDicomMetadata::patientName() const
 {
-    return getTagValue(m_tags, "Patient ID");
+    return text(ETag::PatientName);
 }
 
-std::string CDicomMetadata::patientBirthDate() const
+const std::string &CDicomMetadata::patientId() const
 {
-    return getTagValue(m_tags, "Patient Birth Date");
+    return text(ETag::PatientId);
 }
 
-std::string CDicomMetadata::patientSex() const
+const std::string &CDicomMetadata::patientBirthDate() const
 {
-    return getTagValue(m_tags, "Patient Sex");
+    return text(ETag::PatientBirthDate);
 }
 
-std::string CDicomMetadata::studyDate() const
+const std::string &CDicomMetadata::patientSex() const
 {
-    return getTagValue(m_tags, "Study Date");
+    return text(ETag::PatientSex);
 }
 
-std::string CDicomMetadata::studyTime() const
+const std::string &CDicomMetadata::studyDate() const
 {
-    return getTagValue(m_tags, "Study Time");
+    return text(ETag::StudyDate);
 }
 
-std::string CDicomMetadata::studyDescription() const
+const std::string &CDicomMetadata::studyTime() const
 {
-    return getTagValue(m_tags, "Study Description");
+    return text(ETag::StudyTime);
 }
 
-std::string CDicomMetadata::accessionNumber() const
+const std::string &CDicomMetadata::studyDescription() const
 {
-    return getTagValue(m_tags, "Accession Number");
+    return text(ETag::StudyDescription);
 }
 
-std::string CDicomMetadata::seriesDescription() const
+const std::string &CDicomMetadata::accessionNumber() const
 {
-    return getTagValue(m_tags, "Series Description");
+    return text(ETag::AccessionNumber);
 }
 
-std::string CDicomMetadata::modality() const
+const std::string &CDicomMetadata::studyInstanceUid() const
 {
-    return getTagValue(m_tags, "Modality");
+    return text(ETag::StudyInstanceUid);
 }
 
-std::string CDicomMetadata::seriesNumber() const
+const std::string &CDicomMetadata::seriesDescription() const
 {
-    return getTagValue(m_tags, "Series Number");
+    return text(ETag::SeriesDescription);
 }
 
-std::string CDicomMetadata::instanceNumber() const
+const std::string &CDicomMetadata::modality() const
 {
-    return getTagValue(m_tags, "Instance Number");
+    return text(ETag::Modality);
 }
 
-std::string CDicomMetadata::imagePositionPatient() const
+std::optional<int32_t> CDicomMetadata::seriesNumber() const
 {
-    return getTagValue(m_tags, "Image Position Patient");
+    return integer(ETag::SeriesNumber);
 }
 
-std::string CDicomMetadata::sliceThickness() const
+const std::string &CDicomMetadata::seriesInstanceUid() const
 {
-    return getTagValue(m_tags, "Slice Thickness");
+    return text(ETag::SeriesInstanceUid);
 }
 
-std::string CDicomMetadata::rows() const
+const std::string &CDicomMetadata::sopInstanceUid() const
 {
-    return getTagValue(m_tags, "Rows");
+    return text(ETag::SopInstanceUid);
 }
 
-std::string CDicomMetadata::columns() const
+std::optional<int32_t> CDicomMetadata::instanceNumber() const
 {
-    return getTagValue(m_tags, "Columns");
+    return integer(ETag::InstanceNumber);
 }
 
-std::string CDicomMetadata::bitsAllocated() const
+std::optional<std::array<double, 3>> CDicomMetadata::imagePositionPatient() const
 {
-    return getTagValue(m_tags, "Bits Allocated");
+    return reals<3>(ETag::ImagePositionPatient);
 }
 
-std::string CDicomMetadata::windowCenter() const
+std::optional<std::array<double, 6>> CDicomMetadata::imageOrientationPatient() const
 {
-    return getTagValue(m_tags, "Window Center");
+    return reals<6>(ETag::ImageOrientationPatient);
 }
 
-std::string CDicomMetadata::windowWidth() const
+std::optional<std::array<double, 2>> CDicomMetadata::pixelSpacing() const
 {
-    return getTagValue(m_tags, "Window Width");
+    return reals<2>(ETag::PixelSpacing);
 }
 
-std::optional<std::string> CDicomMetadata::tag(const std::string &tagName) const
+std::optional<double> CDicomMetadata::sliceThickness() const
 {
-    auto it = m_tags.find(tagName);
-    if (it == m_tags.end())
+    if (auto value = reals<1>(ETag::SliceThickness))
     {
-        return std::nullopt;
+        return (*value)[0];
     }
-    return it->second;
+    return std::nullopt;
 }
 
-std::unordered_map<std::string, std::string> CDicomMetadata::allTags() const
-{
-    return m_tags;
-}
-
-bool CDicomMetadata::isEmpty() const
+std::optional<int32_t> CDicomMetadata::rows() const
 {
-    return m_tags.empty();
+    return integer(ETag::Rows);
 }
 
-void CDicomMetadata::setPatientName(const std::string &name)
+std::optional<int32_t> CDicomMetadata::columns() const
 {
-    setTag("Patient Name", name);
+    return integer(ETag::Columns);
 }
 
-void CDicomMetadata::setPatientId(const std::string &id)
+std::optional<int32_t> CDicomMetadata::bitsAllocated() const
 {
-    setTag("Patient ID", id);
+    return integer(ETag::BitsAllocated);
 }
 
-void CDicomMetadata::setPatientBirthDate(const std::string &date)
+std::optional<int32_t> CDicomMetadata::numberOfFrames() const
 {
-    setTag("Patient Birth Date", date);
+    return integer(ETag::NumberOfFrames);
 }
 
-void CDicomMetadata::setPatientSex(const std::string &sex)
+std::optional<double> CDicomMetadata::windowCenter() const
 {
-    setTag("Patient Sex", sex);
+    if (auto value = reals<1>(ETag::WindowCenter))
+    {
+        return (*value)[0];
+    }
+    return std::nullopt;
 }
 
-void CDicomMetadata::setStudyDate(const std::string &date)
+std::optional<double> CDicomMetadata::windowWidth() const
 {
-    setTag("Study Date", date);
+    if (auto value = reals<1>(ETag::WindowWidth))
+    {
+        return (*value)[0];
+    }
+    return std::nullopt;
 }
 
-void CDicomMetadata::setStudyTime(const std::string &time)
+const std::string &CDicomMetadata::photometricInterpretation() const
 {
-    setTag("Study Time", time);
+    return text(ETag::PhotometricInterpretation);
 }
 
-void CDicomMetadata::setStudyDescription(const std::string &description)
+const std::string &CDicomMetadata::transferSyntaxUid() const
 {
-    setTag("Study Description", description);
+    return text(ETag::TransferSyntaxUid);
 }
 
-void CDicomMetadata::setAccessionNumber(const std::string &number)
+/**
+ * @brief Retrieves a tag formatted for display
+ * @param tag Tag to retrieve
+ * @return Optional containing the value if present; multiple values
+ *         are separated by backslashes as in the file
+ */
+std::optional<std::string> CDicomMetadata::tag(ETag tag) const
 {
-    setTag("Accession Number", number);
-}
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || !(m_present & (1u << index)))
+    {
+        return std::nullopt;
+    }
 
-void CDicomMetadata::setSeriesDescription(const std::string &description)
-{
-    setTag("Series Description", description);
+    const SField &field = kFields[index];
+    switch (field.kind)
+    {
+    case EValueKind::Text:
+        return *m_text[field.slot];
+    case EValueKind::Integer:
+        return std::to_string(m_integers[field.slot]);
+    case EValueKind::Real:
+    {
+        std::string value;
+        for (size_t i = 0; i < field.count; ++i)
+        {
+            if (i > 0)
+            {
+                value += '\\';
+            }
+            value += formatReal(m_reals[field.slot + i]);
+        }
+        return value;
+    }
+    }
+    return std::nullopt;
 }
 
-void CDicomMetadata::setModality(const std::string &modality)
+/**
+ * @brief Display name of a tag
+ * @param tag Tag to name
+ * @return Name such as "Patient Name", empty for an unknown tag
+ */
+const char *CDicomMetadata::tagName(ETag tag)
 {
-    setTag("Modality", modality);
+    const size_t index = fieldIndex(tag);
+    return index == kFieldCount ? "" : kFields[index].name;
 }
 
-void CDicomMetadata::setSeriesNumber(const std::string &number)
+/**
+ * @brief Retrieves all stored tags formatted for display
+ * @return Pairs of tag name and value, in tag order
+ */
+std::vector<std::pair<std::string, std::string>> CDicomMetadata::allTags() const
 {
-    setTag("Series Number", number);
+    std::vector<std::pair<std::string, std::string>> tags;
+    for (const SField &field : kFields)
+    {
+        if (auto value = tag(field.tag))
+        {
+            tags.emplace_back(field.name, std::move(*value));
+        }
+    }
+    return tags;
 }
 
-void CDicomMetadata::setInstanceNumber(const std::string &number)
+/**
+ * @brief Copy holding only the patient, study and series tags
+ * @return Metadata with the identifying tags of this one
+ */
+CDicomMetadata CDicomMetadata::seriesIdentity() const
 {
-    setTag("Instance Number", number);
+    CDicomMetadata identity;
+    for (const ETag tag : kSeriesIdentityTags)
+    {
+        const size_t index = fieldIndex(tag);
+        if (!(m_present & (1u << index)))
+        {
+            continue;
+        }
+        const SField &field = kFields[index];
+        switch (field.kind)
+        {
+        case EValueKind::Text:
+            identity.m_text[field.slot] = m_text[field.slot];
+            break;
+        case EValueKind::Integer:
+            identity.m_integers[field.slot] = m_integers[field.slot];
+            break;
+        case EValueKind::Real:
+            for (size_t i = 0; i < field.count; ++i)
+            {
+                identity.m_reals[field.slot + i] = m_reals[field.slot + i];
+            }
+            break;
+        }
+        identity.m_present |= 1u << index;
+    }
+    return identity;
 }
 
-void CDicomMetadata::setImagePositionPatient(const std::string &position)
+bool CDicomMetadata::isEmpty() const
 {
-    setTag("Image Position Patient", position);
+    return m_present == 0;
 }
 
-void CDicomMetadata::setSliceThickness(const std::string &thickness)
+/**
+ * @brief Stores a text tag through the shared string pool
+ * @param tag Text tag
+ * @param value Value; empty values are not stored
+ */
+void CDicomMetadata::setText(ETag tag, std::string_view value)
 {
-    setTag("Slice Thickness", thickness);
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || kFields[index].kind != EValueKind::Text || value.empty())
+    {
+        return;
+    }
+    m_text[kFields[index].slot] = CStringPool::shared().intern(value);
+    m_present |= 1u << index;
 }
 
-void CDicomMetadata::setRows(const std::string &rows)
+/**
+ * @brief Stores an integer tag
+ * @param tag Integer tag (IS or US)
+ * @param value Value
+ */
+void CDicomMetadata::setInteger(ETag tag, int32_t value)
 {
-    setTag("Rows", rows);
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || kFields[index].kind != EValueKind::Integer)
+    {
+        return;
+    }
+    m_integers[kFields[index].slot] = value;
+    m_present |= 1u << index;
 }
 
-void CDicomMetadata::setColumns(const std::string &columns)
+/**
+ * @brief Stores a decimal tag
+ * @param tag Decimal tag (DS)
+ * @param values Values; must match the tag's value multiplicity
+ * @param count Number of values
+ */
+void CDicomMetadata::setReals(ETag tag, const double *values, size_t count)
 {
-    setTag("Columns", columns);
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || kFields[index].kind != EValueKind::Real ||
+        kFields[index].count != count)
+    {
+        return;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_reals[kFields[index].slot + i] = values[i];
+    }
+    m_present |= 1u << index;
 }
 
-void CDicomMetadata::setBitsAllocated(const std::string &bits)
+void CDicomMetadata::clear()
 {
-    setTag("Bits Allocated", bits);
+    m_text.fill(nullptr);
+    m_integers.fill(0);
+    m_reals.fill(0.0);
+    m_present = 0;
 }
 
-void CDicomMetadata::setWindowCenter(const std::string &center)
+const std::string &CDicomMetadata::text(ETag tag) const
 {
-    setTag("Window Center", center);
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || !(m_present & (1u << index)))
+    {
+        return kEmpty;
+    }
+    return *m_text[kFields[index].slot];
 }
 
-void CDicomMetadata::setWindowWidth(const std::string &width)
+std::optional<int32_t> CDicomMetadata::integer(ETag tag) const
 {
-    setTag("Window Width", width);
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || !(m_present & (1u << index)))
+    {
+        return std::nullopt;
+    }
+    return m_integers[kFields[index].slot];
 }
 
-void CDicomMetadata::setTag(const std::string &tagName, const std::string &value)
+template <size_t N>
+std::optional<std::array<double, N>> CDicomMetadata::reals(ETag tag) const
 {
-    if (!value.empty())
+    const size_t index = fieldIndex(tag);
+    if (index == kFieldCount || !(m_present & (1u << index)))
+    {
+        return std::nullopt;
+    }
+    std::array<double, N> values{};
+    for (size_t i = 0; i < N; ++i)
     {
-        m_tags[tagName] = value;
+        values[i] = m_reals[kFields[index].slot + i];
     }
+    return values;
 }
@@ -11,9 +11,15 @@
 
 #pragma once
 
+#include "CStringPool.h"
+
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 class CDicomLoader;
 
@@ -24,12 +30,51 @@ class CDicomLoader;
  * Stores DICOM header information extracted from medical image files.
  * Provides typed accessors for common tags and generic access for any tag.
  * Setters are private and accessible only via friend class CDicomLoader.
+ *
+ * Storage is a fixed set of slots keyed by DICOM tag: text values are
+ * handles into CStringPool::shared(), so values repeated across a study
+ * are held once, and numeric values are kept as numbers. Holding the
+ * metadata of an instance allocates nothing beyond the pool.
  */
 class CDicomMetadata
 {
     friend class CDicomLoader;
 
   public:
+    /**
+     * @brief Tags stored by the metadata, valued (group << 16) | element
+     */
+    enum class ETag : uint32_t
+    {
+        TransferSyntaxUid = 0x00020010,
+        SopInstanceUid = 0x00080018,
+        StudyDate = 0x00080020,
+        StudyTime = 0x00080030,
+        AccessionNumber = 0x00080050,
+        Modality = 0x00080060,
+        StudyDescription = 0x00081030,
+        SeriesDescription = 0x0008103E,
+        PatientName = 0x00100010,
+        PatientId = 0x00100020,
+        PatientBirthDate = 0x00100030,
+        PatientSex = 0x00100040,
+        SliceThickness = 0x00180050,
+        StudyInstanceUid = 0x0020000D,
+        SeriesInstanceUid = 0x0020000E,
+        SeriesNumber = 0x00200011,
+        InstanceNumber = 0x00200013,
+        ImagePositionPatient = 0x00200032,
+        ImageOrientationPatient = 0x00200037,
+        PhotometricInterpretation = 0x00280004,
+        NumberOfFrames = 0x00280008,
+        Rows = 0x00280010,
+        Columns = 0x00280011,
+        PixelSpacing = 0x00280030,
+        BitsAllocated = 0x00280100,
+        WindowCenter = 0x00281050,
+        WindowWidth = 0x00281051
+    };
+
     /**
      * @brief Default constructor
      */
@@ -37,53 +82,78 @@ class CDicomMetadata
 
     /** @name Patient Information Getters */
     ///@{
-    std::string patientName() const;
-    std::string patientId() const;
-    std::string patientBirthDate() const;
-    std::string patientSex() const;
+    const std::string &patientName() const;
+    const std::string &patientId() const;
+    const std::string &patientBirthDate() const;
+    const std::string &patientSex() const;
     ///@}
 
     /** @name Study Information Getters */
     ///@{
-    std::string studyDate() const;
-    std::string studyTime() const;
-    std::string studyDescription() const;
-    std::string accessionNumber() const;
+    const std::string &studyDate() const;
+    const std::string &studyTime() const;
+    const std::string &studyDescription() const;
+    const std::string &accessionNumber() const;
+    const std::string &studyInstanceUid() const;
     ///@}
 
     /** @name Series Information Getters */
     ///@{
-    std::string seriesDescription() const;
-    std::string modality() const;
-    std::string seriesNumber() const;
+    const std::string &seriesDescription() const;
+    const std::string &modality() const;
+    std::optional<int32_t> seriesNumber() const;
+    const std::string &seriesInstanceUid() const;
     ///@}
 
     /** @name Image Information Getters */
     ///@{
-    std::string instanceNumber() const;
-    std::string imagePositionPatient() const;
-    std::string sliceThickness() const;
-    std::string rows() const;
-    std::string columns() const;
-    std::string bitsAllocated() const;
-    std::string windowCenter() const;
-    std::string windowWidth() const;
+    const std::string &sopInstanceUid() const;
+    std::optional<int32_t> instanceNumber() const;
+    std::optional<std::array<double, 3>> imagePositionPatient() const;
+    std::optional<std::array<double, 6>> imageOrientationPatient() const;
+    std::optional<std::array<double, 2>> pixelSpacing() const; /**< (row, column) spacing */
+    std::optional<double> sliceThickness() const;
+    std::optional<int32_t> rows() const;
+    std::optional<int32_t> columns() const;
+    std::optional<int32_t> bitsAllocated() const;
+    std::optional<int32_t> numberOfFrames() const;
+    std::optional<double> windowCenter() const;
+    std::optional<double> windowWidth() const;
+    const std::string &photometricInterpretation() const;
+    const std::string &transferSyntaxUid() const;
     ///@}
 
     /** @name Generic Tag Access */
     ///@{
     /**
-     * @brief Retrieves a tag by name
-     * @param tagName Name of the tag to retrieve
-     * @return Optional containing value if found
+     * @brief Retrieves a tag formatted for display
+     * @param tag Tag to retrieve
+     * @return Optional containing the value if present
      */
-    std::optional<std::string> tag(const std::string &tagName) const;
+    std::optional<std::string> tag(ETag tag) const;
 
     /**
-     * @brief Retrieves all stored tags
-     * @return Map of tag names to values
+     * @brief Display name of a tag
+     * @param tag Tag to name
+     * @return Name such as "Patient Name"
      */
-    std::unordered_map<std::string, std::string> allTags() const;
+    static const char *tagName(ETag tag);
+
+    /**
+     * @brief Retrieves all stored tags formatted for display
+     * @return Pairs of tag name and value, in tag order
+     */
+    std::vector<std::pair<std::string, std::string>> allTags() const;
+
+    /**
+     * @brief Copy holding only the patient, study and series tags
+     *
+     * For images derived from a series, such as reformatted planes, that
+     * the instance, geometry and pixel-format tags would misdescribe.
+     *
+     * @return Metadata with the identifying tags of this one
+     */
+    CDicomMetadata seriesIdentity() const;
 
     /**
      * @brief Checks if metadata is empty
@@ -93,46 +163,44 @@ class CDicomMetadata
     ///@}
 
   private:
-    /** @name Patient Information Setters */
-    ///@{
-    void setPatientName(const std::string &name);
-    void setPatientId(const std::string &id);
-    void setPatientBirthDate(const std::string &date);
-    void setPatientSex(const std::string &sex);
-    ///@}
+    static constexpr size_t kTextSlots = 15;
+    static constexpr size_t kIntegerSlots = 6;
+    static constexpr size_t kRealSlots = 14;
 
-    /** @name Study Information Setters */
+    /** @name Setters */
     ///@{
-    void setStudyDate(const std::string &date);
-    void setStudyTime(const std::string &time);
-    void setStudyDescription(const std::string &description);
-    void setAccessionNumber(const std::string &number);
-    ///@}
+    /**
+     * @brief Stores a text tag through the shared string pool
+     * @param tag Text tag
+     * @param value Value; empty values are not stored
+     */
+    void setText(ETag tag, std::string_view value);
 
-    /** @name Series Information Setters */
-    ///@{
-    void setSeriesDescription(const std::string &description);
-    void setModality(const std::string &modality);
-    void setSeriesNumber(const std::string &number);
-    ///@}
+    /**
+     * @brief Stores an integer tag
+     * @param tag Integer tag (IS or US)
+     * @param value Value
+     */
+    void setInteger(ETag tag, int32_t value);
 
-    /** @name Image Information Setters */
-    ///@{
-    void setInstanceNumber(const std::string &number);
-    void setImagePositionPatient(const std::string &position);
-    void setSliceThickness(const std::string &thickness);
-    void setRows(const std::string &rows);
-    void setColumns(const std::string &columns);
-    void setBitsAllocated(const std::string &bits);
-    void setWindowCenter(const std::string &center);
-    void setWindowWidth(const std::string &width);
-    ///@}
+    /**
+     * @brief Stores a decimal tag
+     * @param tag Decimal tag (DS)
+     * @param values Values; must match the tag's value multiplicity
+     * @param count Number of values
+     */
+    void setReals(ETag tag, const double *values, size_t count);
 
-    /** @name Generic Tag Manipulation */
-    ///@{
-    void setTag(const std::string &tagName, const std::string &value);
     void clear();
     ///@}
 
-    std::unordered_map<std::string, std::string> m_tags; /**< Storage for all metadata tags */
+    const std::string &text(ETag tag) const;
+    std::optional<int32_t> integer(ETag tag) const;
+    template <size_t N>
+    std::optional<std::array<double, N>> reals(ETag tag) const;
+
+    std::array<CStringPool::Handle, kTextSlots> m_text{}; /**< Interned text values */
+    std::array<int32_t, kIntegerSlots> m_integers{};
+    std::array<double, kRealSlots> m_reals{};
+    uint32_t m_present = 0; /**< One bit per stored tag */
 };
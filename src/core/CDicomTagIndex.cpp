@@ -0,0 +1,688 @@
+/**
+ * @file CDicomTagIndex.cpp
+ * @brief Implementation of the CDicomTagIndex class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CDicomTagIndex.h"
+
+#include <dcmtk/config/osconfig.h>
+#include <dcmtk/dcmdata/dctk.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+constexpr uint32_t kItemDelimitationTag = 0xFFFEE00D;
+constexpr uint32_t kSequenceDelimitationTag = 0xFFFEE0DD;
+constexpr uint32_t kPixelDataTag = 0x7FE00010;
+constexpr uint32_t kTransferSyntaxTag = 0x00020010;
+constexpr size_t kPreambleLength = 132; /**< 128-byte preamble and "DICM" */
+constexpr size_t kMaxBinaryValues = 16; /**< Numbers shown before "..." */
+constexpr size_t kBinaryPreviewBytes = 16;
+
+constexpr const char *kImplicitLittleEndian = "1.2.840.10008.1.2";
+constexpr const char *kExplicitBigEndian = "1.2.840.10008.1.2.2";
+constexpr const char *kDeflatedLittleEndian = "1.2.840.10008.1.2.1.99";
+
+/**
+ * @brief Dictionary name and VR of a tag
+ */
+struct SDictionaryEntry
+{
+    std::string name;
+    char vr[2] = {'U', 'N'};
+};
+
+/**
+ * @brief Looks a tag up in the DCMTK dictionary, once per tag
+ *
+ * Entries are never removed, so references stay valid after the lock
+ * is released.
+ */
+const SDictionaryEntry &dictionaryEntry(uint32_t tag)
+{
+    static std::mutex mutex;
+    static std::unordered_map<uint32_t, SDictionaryEntry> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(tag);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+
+    SDictionaryEntry entry;
+    if (tag == CDicomTagIndex::kItemTag)
+    {
+        entry.name = "Item";
+        entry.vr[0] = entry.vr[1] = ' ';
+    }
+    else
+    {
+        DcmTag dcmTag(static_cast<Uint16>(tag >> 16), static_cast<Uint16>(tag & 0xFFFF));
+        entry.name = dcmTag.getTagName();
+        // Pseudo VRs such as "ox" or "xs" have no fixed encoding
+        const char *vr = dcmTag.getVR().getVRName();
+        if (vr && std::isupper(static_cast<unsigned char>(vr[0])) &&
+            std::isupper(static_cast<unsigned char>(vr[1])) && vr[2] == '\0')
+        {
+            entry.vr[0] = vr[0];
+            entry.vr[1] = vr[1];
+        }
+        else if (vr && std::strcmp(vr, "xs") == 0)
+        {
+            entry.vr[0] = 'U';
+            entry.vr[1] = 'S';
+        }
+        else if (vr && (std::strcmp(vr, "ox") == 0 || std::strcmp(vr, "lt") == 0))
+        {
+            entry.vr[0] = 'O';
+            entry.vr[1] = 'W';
+        }
+    }
+    return cache.emplace(tag, std::move(entry)).first->second;
+}
+
+bool isVr(const char *vr, const char *name)
+{
+    return vr[0] == name[0] && vr[1] == name[1];
+}
+
+/**
+ * @brief Whether an explicit VR element has a 32-bit length field
+ */
+bool hasLongLength(const char *vr)
+{
+    static const char *const kLongVrs[] = {"OB", "OD", "OF", "OL", "OV", "OW", "SQ",
+                                           "SV", "UC", "UN", "UR", "UT", "UV"};
+    for (const char *name : kLongVrs)
+    {
+        if (isVr(vr, name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isTextVr(const char *vr)
+{
+    static const char *const kTextVrs[] = {"AE", "AS", "CS", "DA", "DS", "DT", "IS", "LO", "LT",
+                                           "PN", "SH", "ST", "TM", "UC", "UI", "UR", "UT"};
+    for (const char *name : kTextVrs)
+    {
+        if (isVr(vr, name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t read16(const uint8_t *bytes, bool bigEndian)
+{
+    return bigEndian ? static_cast<uint16_t>((bytes[0] << 8) | bytes[1])
+                     : static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t read32(const uint8_t *bytes, bool bigEndian)
+{
+    return bigEndian ? (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) |
+                           (bytes[2] << 8) | bytes[3]
+                     : bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+                           (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+/**
+ * @brief Appends a value, or "..." and false once @p maxLength is reached
+ */
+bool appendClipped(std::string &text, const std::string &value, size_t maxLength)
+{
+    if (text.size() + value.size() > maxLength)
+    {
+        text.append(value, 0, maxLength - std::min(maxLength, text.size()));
+        text += "...";
+        return false;
+    }
+    text += value;
+    return true;
+}
+
+template <typename T>
+std::string formatNumber(T value)
+{
+    return std::to_string(value);
+}
+
+std::string formatNumber(double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+std::string formatNumber(float value)
+{
+    return formatNumber(static_cast<double>(value));
+}
+
+/**
+ * @brief Joins fixed-size binary numbers with backslashes
+ */
+template <typename T>
+std::string formatNumbers(const uint8_t *bytes, size_t length, bool bigEndian, size_t maxLength)
+{
+    std::string text;
+    const size_t count = length / sizeof(T);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i == kMaxBinaryValues)
+        {
+            text += "...";
+            break;
+        }
+        uint8_t raw[sizeof(T)];
+        std::memcpy(raw, bytes + i * sizeof(T), sizeof(T));
+        if (bigEndian)
+        {
+            std::reverse(raw, raw + sizeof(T));
+        }
+        T value;
+        std::memcpy(&value, raw, sizeof(T));
+        if (!appendClipped(text, (i > 0 ? "\\" : "") + formatNumber(value), maxLength))
+        {
+            break;
+        }
+    }
+    return text;
+}
+
+std::string toLower(std::string_view text)
+{
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c)
+                   { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+} // namespace
+
+/**
+ * @class CDicomTagIndex::CParser
+ * @brief Walks element headers and appends nodes
+ */
+class CDicomTagIndex::CParser
+{
+  public:
+    CParser(CDicomTagIndex &index, const uint8_t *data) : m_index(index), m_data(data)
+    {
+    }
+
+    /**
+     * @brief Indexes elements in [pos, end) until an item delimiter
+     * @return Position after the last element, or after the item delimiter
+     */
+    size_t elements(size_t pos, size_t end, bool explicitVr, bool bigEndian, int32_t parent,
+                    int depth)
+    {
+        while (pos + 8 <= end)
+        {
+            const uint32_t tag = (static_cast<uint32_t>(read16(m_data + pos, bigEndian)) << 16) |
+                                 read16(m_data + pos + 2, bigEndian);
+            if (tag == kItemDelimitationTag)
+            {
+                return pos + 8;
+            }
+            if ((tag >> 16) == 0xFFFE || m_index.m_nodes.size() >= kMaxNodes)
+            {
+                return stop(end);
+            }
+
+            SNode node;
+            node.tag = tag;
+            node.parent = parent;
+            uint32_t length = 0;
+            size_t header = 8;
+            if (explicitVr)
+            {
+                node.vr[0] = static_cast<char>(m_data[pos + 4]);
+                node.vr[1] = static_cast<char>(m_data[pos + 5]);
+                if (!std::isupper(static_cast<unsigned char>(node.vr[0])) ||
+                    !std::isupper(static_cast<unsigned char>(node.vr[1])))
+                {
+                    return stop(end);
+                }
+                if (hasLongLength(node.vr))
+                {
+                    header = 12;
+                    if (pos + header > end)
+                    {
+                        return stop(end);
+                    }
+                    length = read32(m_data + pos + 8, bigEndian);
+                }
+                else
+                {
+                    length = read16(m_data + pos + 6, bigEndian);
+                }
+            }
+            else
+            {
+                const SDictionaryEntry &entry = dictionaryEntry(tag);
+                node.vr[0] = entry.vr[0];
+                node.vr[1] = entry.vr[1];
+                length = read32(m_data + pos + 4, bigEndian);
+            }
+
+            pos += header;
+            // A value running past the data is never indexed, so value()
+            // cannot be asked to read it
+            if (length != kUndefinedLength && length > end - pos)
+            {
+                return stop(end);
+            }
+            node.offset = pos;
+            node.length = length;
+            const auto self = static_cast<int32_t>(m_index.m_nodes.size());
+            m_index.m_nodes.push_back(node);
+
+            if (isVr(node.vr, "SQ") || length == kUndefinedLength)
+            {
+                // UN of undefined length holds implicit VR little endian data
+                const bool nestedExplicit = explicitVr && !isVr(node.vr, "UN");
+                const bool nestedBigEndian = bigEndian && !isVr(node.vr, "UN");
+                const bool fragments = (tag == kPixelDataTag && !isVr(node.vr, "SQ"));
+                if (length == kUndefinedLength)
+                {
+                    pos = items(pos, end, nestedExplicit, nestedBigEndian, fragments, self,
+                                depth + 1);
+                    continue;
+                }
+                items(pos, pos + length, nestedExplicit, nestedBigEndian, fragments, self,
+                      depth + 1);
+            }
+            pos += length;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Indexes the items of a sequence in [pos, end)
+     * @return Position after the sequence delimiter, or @p end
+     */
+    size_t items(size_t pos, size_t end, bool explicitVr, bool bigEndian, bool fragments,
+                 int32_t parent, int depth)
+    {
+        if (depth > kMaxDepth)
+        {
+            return stop(end);
+        }
+        while (pos + 8 <= end)
+        {
+            const uint32_t tag = (static_cast<uint32_t>(read16(m_data + pos, bigEndian)) << 16) |
+                                 read16(m_data + pos + 2, bigEndian);
+            const uint32_t length = read32(m_data + pos + 4, bigEndian);
+            pos += 8;
+            if (tag == kSequenceDelimitationTag)
+            {
+                return pos;
+            }
+            if (tag != kItemTag || m_index.m_nodes.size() >= kMaxNodes ||
+                (length != kUndefinedLength && length > end - pos))
+            {
+                return stop(end);
+            }
+
+            SNode item;
+            item.tag = tag;
+            item.vr[0] = item.vr[1] = ' ';
+            item.offset = pos;
+            item.length = length;
+            item.parent = parent;
+            const auto self = static_cast<int32_t>(m_index.m_nodes.size());
+            m_index.m_nodes.push_back(item);
+
+            if (length == kUndefinedLength)
+            {
+                if (fragments)
+                {
+                    return stop(end);
+                }
+                pos = elements(pos, end, explicitVr, bigEndian, self, depth + 1);
+                continue;
+            }
+            if (!fragments)
+            {
+                elements(pos, pos + length, explicitVr, bigEndian, self, depth + 1);
+            }
+            pos += length;
+        }
+        return pos;
+    }
+
+  private:
+    size_t stop(size_t end)
+    {
+        m_index.m_truncated = true;
+        return end;
+    }
+
+    CDicomTagIndex &m_index;
+    const uint8_t *m_data;
+};
+
+/**
+ * @brief Indexes a file
+ * @param filePath Path to the DICOM file
+ * @return Index, nullptr if the file cannot be mapped or holds no elements
+ */
+std::shared_ptr<const CDicomTagIndex> CDicomTagIndex::build(const std::string &filePath)
+{
+    auto file = CMappedFile::open(filePath);
+    if (!file)
+    {
+        return nullptr;
+    }
+    std::shared_ptr<CDicomTagIndex> index(new CDicomTagIndex());
+    const uint8_t *data = file->data();
+    const size_t size = file->size();
+    CParser parser(*index, data);
+
+    size_t pos = 0;
+    bool explicitVr = true;
+    if (size >= kPreambleLength && std::memcmp(data + 128, "DICM", 4) == 0)
+    {
+        // File meta information: explicit VR little endian group 0002
+        pos = kPreambleLength;
+        size_t metaEnd = pos;
+        while (metaEnd + 8 <= size && read16(data + metaEnd, false) == 0x0002)
+        {
+            const char vr[2] = {static_cast<char>(data[metaEnd + 4]),
+                                static_cast<char>(data[metaEnd + 5])};
+            const bool longLength = hasLongLength(vr);
+            if (longLength && metaEnd + 12 > size)
+            {
+                break;
+            }
+            metaEnd += longLength ? 12 + read32(data + metaEnd + 8, false)
+                                  : 8 + read16(data + metaEnd + 6, false);
+        }
+        pos = parser.elements(pos, std::min(metaEnd, size), true, false, -1, 0);
+
+        std::string syntax;
+        for (const SNode &node : index->m_nodes)
+        {
+            if (node.tag == kTransferSyntaxTag && node.offset + node.length <= size)
+            {
+                syntax.assign(reinterpret_cast<const char *>(data + node.offset), node.length);
+                syntax.erase(syntax.find_last_not_of(std::string(" \0", 2)) + 1);
+            }
+        }
+        explicitVr = (syntax != kImplicitLittleEndian);
+        index->m_bigEndian = (syntax == kExplicitBigEndian);
+        index->m_deflated = (syntax == kDeflatedLittleEndian);
+    }
+    else if (size >= 8)
+    {
+        // No preamble: guess the encoding from the first element
+        explicitVr = std::isupper(data[4]) && std::isupper(data[5]);
+    }
+
+    index->m_datasetOffset = pos;
+    if (!index->m_deflated)
+    {
+        parser.elements(pos, size, explicitVr, index->m_bigEndian, -1, 0);
+    }
+    if (index->m_nodes.empty())
+    {
+        return nullptr;
+    }
+
+    index->m_file = std::move(file);
+    index->linkChildren();
+    return index;
+}
+
+size_t CDicomTagIndex::size() const
+{
+    return m_nodes.size();
+}
+
+const CDicomTagIndex::SNode &CDicomTagIndex::node(uint32_t index) const
+{
+    return m_nodes[index];
+}
+
+size_t CDicomTagIndex::childCount(int32_t parent) const
+{
+    return m_childCount[static_cast<size_t>(parent + 1)];
+}
+
+uint32_t CDicomTagIndex::child(int32_t parent, size_t row) const
+{
+    return m_children[m_firstChild[static_cast<size_t>(parent + 1)] + row];
+}
+
+bool CDicomTagIndex::isTruncated() const
+{
+    return m_truncated;
+}
+
+bool CDicomTagIndex::isDeflated() const
+{
+    return m_deflated;
+}
+
+/**
+ * @brief Groups node indices by parent, keeping file order
+ */
+void CDicomTagIndex::linkChildren()
+{
+    const size_t slots = m_nodes.size() + 1;
+    m_childCount.assign(slots, 0);
+    for (const SNode &node : m_nodes)
+    {
+        ++m_childCount[static_cast<size_t>(node.parent + 1)];
+    }
+    m_firstChild.assign(slots, 0);
+    for (size_t slot = 1; slot < slots; ++slot)
+    {
+        m_firstChild[slot] = m_firstChild[slot - 1] + m_childCount[slot - 1];
+    }
+    std::vector<uint32_t> next(m_firstChild);
+    m_children.resize(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        m_children[next[static_cast<size_t>(m_nodes[i].parent + 1)]++] = static_cast<uint32_t>(i);
+    }
+}
+
+bool CDicomTagIndex::isBigEndian(const SNode &node) const
+{
+    return m_bigEndian && node.offset >= m_datasetOffset;
+}
+
+/**
+ * @brief Decodes the value of a node for display
+ * @param index Node index
+ * @param maxLength Longest string returned; longer values end in "..."
+ * @return Display text
+ */
+std::string CDicomTagIndex::value(uint32_t index, size_t maxLength) const
+{
+    const SNode &node = m_nodes[index];
+    const size_t children = childCount(static_cast<int32_t>(index));
+    if (node.tag == kItemTag)
+    {
+        if (m_nodes[static_cast<size_t>(node.parent)].tag == kPixelDataTag)
+        {
+            return "Fragment, " + std::to_string(node.length) + " bytes";
+        }
+        return std::to_string(children) + (children == 1 ? " element" : " elements");
+    }
+    if (isVr(node.vr, "SQ") || node.length == kUndefinedLength)
+    {
+        const bool fragments = (node.tag == kPixelDataTag && !isVr(node.vr, "SQ"));
+        return std::to_string(children) +
+               (fragments ? (children == 1 ? " fragment" : " fragments")
+                          : (children == 1 ? " item" : " items"));
+    }
+
+    // The walk only indexes values inside the file; clamp regardless
+    const size_t fileSize = m_file->size();
+    const size_t available = node.offset < fileSize ? fileSize - node.offset : 0;
+    const uint8_t *bytes = m_file->data() + std::min<size_t>(node.offset, fileSize);
+    const size_t length = std::min<size_t>(node.length, available);
+    const bool bigEndian = isBigEndian(node);
+
+    if (isTextVr(node.vr))
+    {
+        std::string text(reinterpret_cast<const char *>(bytes), std::min(length, maxLength + 1));
+        text.erase(text.find_last_not_of(std::string(" \0", 2)) + 1);
+        if (text.size() > maxLength)
+        {
+            text.resize(maxLength);
+            text += "...";
+        }
+        return text;
+    }
+    if (isVr(node.vr, "US"))
+    {
+        return formatNumbers<uint16_t>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "SS"))
+    {
+        return formatNumbers<int16_t>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "UL"))
+    {
+        return formatNumbers<uint32_t>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "SL"))
+    {
+        return formatNumbers<int32_t>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "UV"))
+    {
+        return formatNumbers<uint64_t>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "SV"))
+    {
+        return formatNumbers<int64_t>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "FL"))
+    {
+        return formatNumbers<float>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "FD"))
+    {
+        return formatNumbers<double>(bytes, length, bigEndian, maxLength);
+    }
+    if (isVr(node.vr, "AT"))
+    {
+        std::string text;
+        for (size_t i = 0; i + 4 <= length; i += 4)
+        {
+            const uint32_t tag = (static_cast<uint32_t>(read16(bytes + i, bigEndian)) << 16) |
+                                 read16(bytes + i + 2, bigEndian);
+            if (!appendClipped(text, (i > 0 ? "\\" : "") + tagText(tag), maxLength))
+            {
+                break;
+            }
+        }
+        return text;
+    }
+
+    // OB, OW, OF, OD, OL, OV, UN: size and the first bytes
+    std::string text = std::to_string(length) + " bytes";
+    if (length > 0)
+    {
+        text += ":";
+        char hex[4];
+        for (size_t i = 0; i < std::min(length, kBinaryPreviewBytes); ++i)
+        {
+            std::snprintf(hex, sizeof(hex), " %02X", bytes[i]);
+            text += hex;
+        }
+        if (length > kBinaryPreviewBytes)
+        {
+            text += " ...";
+        }
+    }
+    return text;
+}
+
+/**
+ * @brief Formats a tag as "(gggg,eeee)"
+ * @param tag Tag number
+ * @return Tag text
+ */
+std::string CDicomTagIndex::tagText(uint32_t tag)
+{
+    char text[16];
+    std::snprintf(text, sizeof(text), "(%04X,%04X)", static_cast<unsigned>(tag >> 16),
+                  static_cast<unsigned>(tag & 0xFFFF));
+    return text;
+}
+
+/**
+ * @brief Dictionary keyword of a tag
+ * @param tag Tag number
+ * @return Keyword such as "PatientName"; "Item" for items
+ */
+const std::string &CDicomTagIndex::tagName(uint32_t tag)
+{
+    return dictionaryEntry(tag).name;
+}
+
+/**
+ * @brief Finds the nodes whose tag or keyword contains a pattern
+ * @param pattern Text to look for, case-insensitive
+ * @return One flag per node, true if the node matches
+ */
+std::vector<bool> CDicomTagIndex::match(std::string_view pattern) const
+{
+    std::vector<bool> matches(m_nodes.size(), false);
+    const std::string name = toLower(pattern);
+
+    // "(0010,0010)" and "0010,0010" are matched as "00100010"
+    std::string digits;
+    bool isTag = !name.empty();
+    for (char c : name)
+    {
+        if (std::isxdigit(static_cast<unsigned char>(c)))
+        {
+            digits += c;
+        }
+        else if (c != '(' && c != ')' && c != ',' && c != ' ')
+        {
+            isTag = false;
+        }
+    }
+    isTag = isTag && !digits.empty();
+
+    // Tags repeat heavily (per-frame items), so each is tested once
+    std::unordered_map<uint32_t, bool> tested;
+    char hex[9];
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        const uint32_t tag = m_nodes[i].tag;
+        auto it = tested.find(tag);
+        if (it == tested.end())
+        {
+            std::snprintf(hex, sizeof(hex), "%08x", static_cast<unsigned>(tag));
+            const bool found = (isTag && std::strstr(hex, digits.c_str()) != nullptr) ||
+                               toLower(tagName(tag)).find(name) != std::string::npos;
+            it = tested.emplace(tag, found).first;
+        }
+        matches[i] = it->second;
+    }
+    return matches;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file CDicomTagIndex.h
+ * @brief Structural index of a complete DICOM dataset class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CDicomTagIndex class which records where every element
+ * of a DICOM file lives (tag, VR, offset, length), sequences and items
+ * included, without decoding any value. Values are decoded from the
+ * memory-mapped file only when asked for.
+ */
+
+#pragma once
+
+#include "CMappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class CDicomTagIndex
+ * @brief Lazily decoded tree of all elements in a DICOM file
+ *
+ * build() walks the element headers of the file meta information and
+ * the dataset once, skipping over values, so even headers with tens of
+ * thousands of elements are indexed in a few milliseconds. Nodes are
+ * stored in file order; a node's children (the items of a sequence,
+ * the elements of an item, the fragments of encapsulated pixel data)
+ * always come after it.
+ *
+ * Deflated datasets cannot be walked in place; their index holds the
+ * file meta information only.
+ *
+ * Immutable once built, so it may be shared between threads.
+ */
+class CDicomTagIndex
+{
+  public:
+    static constexpr uint32_t kUndefinedLength = 0xFFFFFFFF;
+    static constexpr uint32_t kItemTag = 0xFFFEE000;
+    static constexpr size_t kMaxNodes = size_t(4) * 1024 * 1024;
+    static constexpr int kMaxDepth = 32;
+
+    /**
+     * @brief One element, item or fragment
+     */
+    struct SNode
+    {
+        uint32_t tag = 0;     /**< (group << 16) | element */
+        char vr[2] = {'U', 'N'};
+        uint32_t length = 0;  /**< Value length, kUndefinedLength if undefined */
+        uint64_t offset = 0;  /**< First value byte in the file */
+        int32_t parent = -1;  /**< Index of the enclosing node, -1 at top level */
+    };
+
+    /**
+     * @brief Indexes a file
+     * @param filePath Path to the DICOM file
+     * @return Index, nullptr if the file cannot be mapped or holds no elements
+     */
+    static std::shared_ptr<const CDicomTagIndex> build(const std::string &filePath);
+
+    /** @name Structure */
+    ///@{
+    size_t size() const;
+    const SNode &node(uint32_t index) const;
+
+    /**
+     * @brief Number of children of a node
+     * @param parent Node index, -1 for the top level
+     * @return Child count
+     */
+    size_t childCount(int32_t parent) const;
+
+    /**
+     * @brief Index of a child node
+     * @param parent Node index, -1 for the top level
+     * @param row Position among the children
+     * @return Child node index
+     */
+    uint32_t child(int32_t parent, size_t row) const;
+
+    /**
+     * @brief Whether the walk stopped early at malformed or truncated data
+     * @return True if the index does not cover the whole file
+     */
+    bool isTruncated() const;
+
+    /**
+     * @brief Whether the dataset is deflated and was not indexed
+     * @return True if only the file meta information is indexed
+     */
+    bool isDeflated() const;
+    ///@}
+
+    /** @name Values */
+    ///@{
+    /**
+     * @brief Decodes the value of a node for display
+     *
+     * Multiple values are separated by backslashes; binary values are
+     * summarized by their size and first bytes.
+     *
+     * @param index Node index
+     * @param maxLength Longest string returned; longer values end in "..."
+     * @return Display text
+     */
+    std::string value(uint32_t index, size_t maxLength = 256) const;
+    ///@}
+
+    /** @name Names and Search */
+    ///@{
+    /**
+     * @brief Formats a tag as "(gggg,eeee)"
+     * @param tag Tag number
+     * @return Tag text
+     */
+    static std::string tagText(uint32_t tag);
+
+    /**
+     * @brief Dictionary keyword of a tag
+     * @param tag Tag number
+     * @return Keyword such as "PatientName"; "Item" for items
+     */
+    static const std::string &tagName(uint32_t tag);
+
+    /**
+     * @brief Finds the nodes whose tag or keyword contains a pattern
+     *
+     * Runs against the tags and dictionary keywords only; no value is
+     * decoded. "0010,0010", "(0010,0010)" and "00100010" all match
+     * Patient Name, as does "patientname".
+     *
+     * @param pattern Text to look for, case-insensitive
+     * @return One flag per node, true if the node matches
+     */
+    std::vector<bool> match(std::string_view pattern) const;
+    ///@}
+
+  private:
+    CDicomTagIndex() = default;
+
+    class CParser;
+
+    void linkChildren();
+    bool isBigEndian(const SNode &node) const;
+
+    std::shared_ptr<const CMappedFile> m_file; /**< Values are decoded from here */
+    std::vector<SNode> m_nodes;
+    std::vector<uint32_t> m_children;   /**< Child lists, grouped by parent */
+    std::vector<uint32_t> m_firstChild; /**< Per parent + 1: start in m_children */
+    std::vector<uint32_t> m_childCount; /**< Per parent + 1: number of children */
+    uint64_t m_datasetOffset = 0;       /**< Elements before this are little endian meta */
+    bool m_bigEndian = false;           /**< Dataset is explicit VR big endian */
+    bool m_truncated = false;
+    bool m_deflated = false;
+};
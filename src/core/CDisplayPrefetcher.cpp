@@ -0,0 +1,100 @@
+/**
+ * @file CDisplayPrefetcher.cpp
+ * @brief Implementation of the CDisplayPrefetcher class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CDisplayPrefetcher.h"
+
+#include "CDicomImage.h"
+#include "utils/CThreadPool.h"
+
+CDisplayPrefetcher::CDisplayPrefetcher()
+    : m_state(std::make_shared<SState>())
+{
+}
+
+CDisplayPrefetcher::~CDisplayPrefetcher()
+{
+    cancel();
+}
+
+/**
+ * @brief Stages images in the background, most important first
+ * @param images Images predicted to be displayed next
+ */
+void CDisplayPrefetcher::prefetch(const std::vector<std::shared_ptr<const CDicomImage>> &images)
+{
+    std::vector<std::shared_ptr<const CDicomImage>> queued;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->wanted.clear();
+        for (const auto &image : images)
+        {
+            if (image && m_state->wanted.insert(image.get()).second &&
+                m_state->inFlight.insert(image.get()).second)
+            {
+                queued.push_back(image);
+            }
+        }
+    }
+
+    for (const auto &image : queued)
+    {
+        const bool submitted = CThreadPool::shared().trySubmit(
+            [state = m_state, image]()
+            {
+                bool wanted = false;
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    wanted = state->wanted.count(image.get()) > 0;
+                }
+                if (wanted)
+                {
+                    stage(*image);
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->inFlight.erase(image.get());
+            });
+        if (!submitted)
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->inFlight.erase(image.get());
+        }
+    }
+}
+
+/**
+ * @brief Abandons queued jobs that have not started yet
+ */
+void CDisplayPrefetcher::cancel()
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->wanted.clear();
+}
+
+/**
+ * @brief Prepares one image for display on the calling thread
+ *
+ * Mirrors what CImageViewer reads when it uploads a texture: the
+ * full-resolution samples and every pyramid level, plus the
+ * statistics used by the window/level controls.
+ *
+ * @param image Image to stage
+ */
+void CDisplayPrefetcher::stage(const CDicomImage &image)
+{
+    if (!image.hasPixelData() || image.pixelData().empty())
+    {
+        return;
+    }
+    image.statistics();
+    for (uint32_t level = 1; level < image.pyramidLevelCount(); ++level)
+    {
+        if (!image.pyramidLevel(level))
+        {
+            break;
+        }
+    }
+}
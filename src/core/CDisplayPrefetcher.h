@@ -0,0 +1,78 @@
+/**
+ * @file CDisplayPrefetcher.h
+ * @brief Background preparation of images about to be displayed
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CDisplayPrefetcher class which readies images the user
+ * is likely to step to next, so showing them costs no more than a
+ * texture upload.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+class CDicomImage;
+
+/**
+ * @class CDisplayPrefetcher
+ * @brief Stages images on CThreadPool::shared() ahead of display
+ *
+ * Staging does everything the viewer would otherwise do synchronously
+ * on first display: decode evicted pixels, compute statistics and
+ * build the pyramid levels uploaded as mipmaps. All of these are
+ * cached on the image, so staging twice is cheap.
+ *
+ * Each prefetch() supersedes the previous one: queued jobs for images
+ * that are no longer wanted return without work. Jobs hold their image
+ * alive, never the prefetcher.
+ *
+ * Not thread-safe; owned and driven by the presentation layer.
+ */
+class CDisplayPrefetcher
+{
+  public:
+    CDisplayPrefetcher();
+    ~CDisplayPrefetcher();
+
+    CDisplayPrefetcher(const CDisplayPrefetcher &) = delete;
+    CDisplayPrefetcher &operator=(const CDisplayPrefetcher &) = delete;
+
+    /**
+     * @brief Stages @p images in the background, most important first
+     *
+     * Images already being staged are not queued again. Submission
+     * never blocks; images that do not fit the pool's queue are skipped.
+     *
+     * @param images Images predicted to be displayed next (null entries are skipped)
+     */
+    void prefetch(const std::vector<std::shared_ptr<const CDicomImage>> &images);
+
+    /**
+     * @brief Abandons queued jobs that have not started yet
+     */
+    void cancel();
+
+    /**
+     * @brief Prepares one image for display on the calling thread
+     * @param image Image to stage
+     */
+    static void stage(const CDicomImage &image);
+
+  private:
+    /**
+     * @brief State shared with queued jobs
+     */
+    struct SState
+    {
+        std::mutex mutex;
+        std::unordered_set<const CDicomImage *> wanted;   /**< Images of the latest prefetch() */
+        std::unordered_set<const CDicomImage *> inFlight; /**< Queued or running */
+    };
+
+    std::shared_ptr<SState> m_state;
+};
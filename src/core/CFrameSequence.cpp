@@ -0,0 +1,209 @@
+/**
+ * @file CFrameSequence.cpp
+ * @brief Implementation of the CFrameSequence class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CFrameSequence.h"
+
+#include "CDicomImage.h"
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Attaches the frame source
+ *
+ * Frames created from a previous source are dropped.
+ *
+ * @param frameCount Number of frames in the object (1 = single-frame)
+ * @param decoder Decodes a frame by zero-based index
+ */
+void CFrameSequence::setSource(uint32_t frameCount, FrameDecoder decoder)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameCount = frameCount > 0 ? frameCount : 1;
+    m_decoder = std::move(decoder);
+    m_frames.clear();
+}
+
+/**
+ * @brief Number of frames, including frame 0
+ * @return Frame count (at least 1)
+ */
+uint32_t CFrameSequence::frameCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frameCount;
+}
+
+/**
+ * @brief Retrieves a frame, creating its header-only image if needed
+ * @param base Image the sequence belongs to
+ * @param frame Zero-based frame index
+ * @return Frame image, nullptr for frame 0, out-of-range frames or no source
+ */
+std::shared_ptr<const CDicomImage> CFrameSequence::frame(const CDicomImage &base, uint32_t frame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (frame == 0 || frame >= m_frameCount || !m_decoder)
+    {
+        return nullptr;
+    }
+    auto &slot = m_frames[frame];
+    if (!slot)
+    {
+        slot = makeFrame(base, frame, m_decoder);
+    }
+    return slot;
+}
+
+/**
+ * @brief Decodes the frames around @p center in the background
+ *
+ * All newly scheduled frames go to one pool task, nearest first, so a
+ * prefetch never occupies more than one worker; frames dropped before
+ * the task reaches them are skipped.
+ *
+ * @param base Image the sequence belongs to
+ * @param center Frame being displayed
+ * @param ahead Frames after @p center to keep decoded
+ * @param behind Frames before @p center to keep decoded
+ */
+void CFrameSequence::prefetch(const CDicomImage &base, uint32_t center, uint32_t ahead, uint32_t behind)
+{
+    std::vector<uint32_t> window;
+    std::vector<uint32_t> scheduledIndices;
+    std::vector<std::weak_ptr<const CDicomImage>> scheduled;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_frameCount <= 1 || !m_decoder)
+        {
+            return;
+        }
+
+        const uint32_t count = m_frameCount;
+        center %= count;
+        ahead = std::min(ahead, count - 1);
+        behind = std::min(behind, count - 1 - ahead);
+
+        // Nearest first, favouring the playback direction
+        window.push_back(center);
+        for (uint32_t distance = 1; distance <= std::max(ahead, behind); ++distance)
+        {
+            if (distance <= ahead)
+            {
+                window.push_back((center + distance) % count);
+            }
+            if (distance <= behind)
+            {
+                window.push_back((center + count - distance) % count);
+            }
+        }
+
+        const std::set<uint32_t> keep(window.begin(), window.end());
+        for (auto it = m_frames.begin(); it != m_frames.end();)
+        {
+            it = keep.count(it->first) ? std::next(it) : m_frames.erase(it);
+        }
+
+        for (const uint32_t index : window)
+        {
+            if (index == 0 || m_frames.count(index))
+            {
+                continue;
+            }
+            auto frame = makeFrame(base, index, m_decoder);
+            scheduledIndices.push_back(index);
+            scheduled.push_back(frame);
+            m_frames.emplace(index, std::move(frame));
+        }
+    }
+
+    if (scheduled.empty())
+    {
+        return;
+    }
+
+    const bool queued = CThreadPool::shared().trySubmit([scheduled]()
+                                                        {
+        for (const auto &weak : scheduled)
+        {
+            if (const auto frame = weak.lock())
+            {
+                frame->pixelData();
+            }
+        } });
+    if (!queued)
+    {
+        // Pool is full: forget the frames so the next prefetch retries them
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const uint32_t index : scheduledIndices)
+        {
+            auto it = m_frames.find(index);
+            if (it != m_frames.end() && !it->second->isPixelDataResident())
+            {
+                m_frames.erase(it);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Drops all frame images
+ *
+ * Frames still referenced elsewhere (the one on screen) stay valid.
+ */
+void CFrameSequence::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frames.clear();
+}
+
+/**
+ * @brief Bytes held by decoded frames
+ * @return Sum of the frames' resident pixel bytes
+ */
+size_t CFrameSequence::residentBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t bytes = 0;
+    for (const auto &entry : m_frames)
+    {
+        bytes += entry.second->residentPixelBytes();
+    }
+    return bytes;
+}
+
+/**
+ * @brief Creates the header-only image of a frame
+ *
+ * Only fields that are the same for every frame are copied; the pixel
+ * format, value range and default window come from the frame's decode.
+ *
+ * @param base Image the sequence belongs to
+ * @param frame Zero-based frame index
+ * @param decoder Frame source
+ * @return Frame image that decodes on first access
+ */
+std::shared_ptr<const CDicomImage> CFrameSequence::makeFrame(const CDicomImage &base, uint32_t frame,
+                                                             const FrameDecoder &decoder)
+{
+    auto image = std::make_shared<CDicomImage>();
+    image->setDimensions(base.m_dimensions);
+    image->setPhotometricInterpretation(base.m_photometricInterpretation);
+    image->setRescaleSlope(base.m_rescaleSlope);
+    image->setRescaleIntercept(base.m_rescaleIntercept);
+    if (base.m_windowLevelSet)
+    {
+        image->setWindowLevel(base.windowLevel());
+    }
+    image->setPixelDecoder([decoder, frame](CDicomImage &target)
+                           { return decoder(frame, target); });
+    return image;
+}
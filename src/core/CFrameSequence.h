@@ -0,0 +1,113 @@
+/**
+ * @file CFrameSequence.h
+ * @brief Lazily decoded frames of a multi-frame image class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CFrameSequence class which hands out the frames of a
+ * multi-frame object (ultrasound and XA cine loops, enhanced CT/MR)
+ * one at a time, decoding each on demand and keeping only a window of
+ * frames around the one being displayed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+class CDicomImage;
+
+/**
+ * @class CFrameSequence
+ * @brief Frame 1..N-1 of an image, decoded on first use
+ *
+ * Frame 0 is the image itself. Every other frame is a stand-alone
+ * CDicomImage sharing the header fields of the base image and carrying
+ * a pixel decoder bound to its frame index, so it decodes on first
+ * pixel access like any header-only image and can be converted,
+ * rendered and mip-mapped as is.
+ *
+ * prefetch() schedules the decode of a window of frames on
+ * CThreadPool::shared() and drops the frames outside it, which keeps
+ * memory bounded during cine playback of long loops.
+ *
+ * Thread-safe. Decodes never run under the sequence lock.
+ */
+class CFrameSequence
+{
+  public:
+    /**
+     * @brief Fills a scratch image with the pixels of one frame; returns success
+     */
+    using FrameDecoder = std::function<bool(uint32_t frame, CDicomImage &target)>;
+
+    CFrameSequence() = default;
+
+    /**
+     * @brief Attaches the frame source
+     * @param frameCount Number of frames in the object (1 = single-frame)
+     * @param decoder Decodes a frame by zero-based index
+     */
+    void setSource(uint32_t frameCount, FrameDecoder decoder);
+
+    /**
+     * @brief Number of frames, including frame 0
+     * @return Frame count (at least 1)
+     */
+    uint32_t frameCount() const;
+
+    /**
+     * @brief Retrieves a frame, creating its header-only image if needed
+     *
+     * The returned frame decodes its pixels on first access.
+     *
+     * @param base Image the sequence belongs to
+     * @param frame Zero-based frame index
+     * @return Frame image, nullptr for frame 0, out-of-range frames or no source
+     */
+    std::shared_ptr<const CDicomImage> frame(const CDicomImage &base, uint32_t frame);
+
+    /**
+     * @brief Decodes the frames around @p center in the background
+     *
+     * Frames are scheduled nearest first; playback wraps around, so the
+     * window does too. Frames outside the window are dropped.
+     *
+     * @param base Image the sequence belongs to
+     * @param center Frame being displayed
+     * @param ahead Frames after @p center to keep decoded
+     * @param behind Frames before @p center to keep decoded
+     */
+    void prefetch(const CDicomImage &base, uint32_t center, uint32_t ahead, uint32_t behind);
+
+    /**
+     * @brief Drops all frame images
+     */
+    void clear();
+
+    /**
+     * @brief Bytes held by decoded frames
+     * @return Sum of the frames' resident pixel bytes
+     */
+    size_t residentBytes() const;
+
+  private:
+    /**
+     * @brief Creates the header-only image of a frame
+     * @param base Image the sequence belongs to
+     * @param frame Zero-based frame index
+     * @param decoder Frame source
+     * @return Frame image that decodes on first access
+     */
+    static std::shared_ptr<const CDicomImage> makeFrame(const CDicomImage &base, uint32_t frame,
+                                                        const FrameDecoder &decoder);
+
+    mutable std::mutex m_mutex;
+    uint32_t m_frameCount = 1;
+    FrameDecoder m_decoder;
+    std::map<uint32_t, std::shared_ptr<const CDicomImage>> m_frames; /**< Frames created so far */
+};
@@ -0,0 +1,250 @@
+/**
+ * @file CImagePyramid.cpp
+ * @brief Implementation of the CImagePyramid class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CImagePyramid.h"
+
+#include "CDicomImage.h"
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Output pixels per parallel band when halving
+constexpr size_t kGrainPixels = size_t(256) * 1024;
+
+/**
+ * @brief Averages 2x2 blocks of interleaved samples into one
+ *
+ * Odd trailing columns and rows are averaged with themselves. Sums
+ * are rounded half up; for signed samples the shift floors, which
+ * keeps the rounding consistent across zero.
+ */
+template <typename T>
+void halveRows(const T *src, uint32_t srcWidth, uint32_t srcHeight, uint32_t channels,
+               T *dst, uint32_t dstWidth, uint32_t rowBegin, uint32_t rowEnd)
+{
+    const size_t srcStride = static_cast<size_t>(srcWidth) * channels;
+    const size_t dstStride = static_cast<size_t>(dstWidth) * channels;
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        const T *row0 = src + static_cast<size_t>(2 * y) * srcStride;
+        const T *row1 = src + static_cast<size_t>(std::min(2 * y + 1, srcHeight - 1)) * srcStride;
+        T *out = dst + static_cast<size_t>(y) * dstStride;
+        for (uint32_t x = 0; x < dstWidth; ++x)
+        {
+            const size_t x0 = static_cast<size_t>(2 * x) * channels;
+            const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, srcWidth - 1)) * channels;
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                const int32_t sum = static_cast<int32_t>(row0[x0 + c]) + row0[x1 + c] +
+                                    row1[x0 + c] + row1[x1 + c];
+                out[static_cast<size_t>(x) * channels + c] = static_cast<T>((sum + 2) >> 2);
+            }
+        }
+    }
+}
+} // namespace
+
+/**
+ * @brief Retrieves a reduced-resolution level, building it if needed
+ *
+ * Missing levels between the last built one and @p level are built in
+ * order, each from the previous, so a full chain costs about a third
+ * of one pass over the source.
+ *
+ * @param base Full-resolution image the pyramid belongs to
+ * @param level Level index (1 = half size)
+ * @return Level image, nullptr for level 0, out-of-range levels or missing pixels
+ */
+std::shared_ptr<const CDicomImage> CImagePyramid::level(const CDicomImage &base, uint32_t level)
+{
+    if (level == 0 || level >= levelCount(base.dimensions()))
+    {
+        return nullptr;
+    }
+
+    size_t built = 0;
+    std::shared_ptr<const CDicomImage> current;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_levels.size() >= level)
+        {
+            return m_levels[level - 1];
+        }
+        built = m_levels.size();
+        if (built > 0)
+        {
+            current = m_levels.back();
+        }
+    }
+
+    std::vector<std::shared_ptr<const CDicomImage>> fresh;
+    for (size_t next = built + 1; next <= level; ++next)
+    {
+        current = halve(current ? *current : base);
+        if (!current)
+        {
+            return nullptr;
+        }
+        fresh.push_back(current);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_levels.size() < built)
+    {
+        // Cleared while building; hand out the result without keeping it
+        return current;
+    }
+    for (size_t index = m_levels.size() - built; index < fresh.size(); ++index)
+    {
+        m_residentBytes += fresh[index]->residentPixelBytes();
+        m_levels.push_back(fresh[index]);
+    }
+    return m_levels[level - 1];
+}
+
+/**
+ * @brief Retrieves a level only if it is already built
+ * @param level Level index (1 = half size)
+ * @return Level image, nullptr if not built yet
+ */
+std::shared_ptr<const CDicomImage> CImagePyramid::builtLevel(uint32_t level) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (level == 0 || m_levels.size() < level)
+    {
+        return nullptr;
+    }
+    return m_levels[level - 1];
+}
+
+/**
+ * @brief Drops all built levels
+ */
+void CImagePyramid::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_levels.clear();
+    m_residentBytes = 0;
+}
+
+/**
+ * @brief Bytes held by built levels
+ * @return Sum of the level pixel buffer sizes
+ */
+size_t CImagePyramid::residentBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_residentBytes;
+}
+
+/**
+ * @brief Number of levels of an image, including level 0
+ * @param dims Full-resolution dimensions
+ * @return Levels down to 1x1 (0 for an empty image)
+ */
+uint32_t CImagePyramid::levelCount(const DicomViewer::SImageDimensions &dims)
+{
+    if (dims.width == 0 || dims.height == 0)
+    {
+        return 0;
+    }
+    uint32_t width = dims.width;
+    uint32_t height = dims.height;
+    uint32_t count = 1;
+    while (width > 1 || height > 1)
+    {
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Coarsest level that still has a pixel per screen pixel
+ * @param dims Full-resolution dimensions
+ * @param scale Screen pixels per image pixel
+ * @return Level to sample at @p scale (0 when magnified)
+ */
+uint32_t CImagePyramid::levelForScale(const DicomViewer::SImageDimensions &dims, double scale)
+{
+    const uint32_t count = levelCount(dims);
+    if (count <= 1 || !(scale > 0.0) || scale >= 0.5)
+    {
+        return 0;
+    }
+    const double level = std::floor(std::log2(1.0 / scale));
+    return static_cast<uint32_t>(std::min(level, static_cast<double>(count - 1)));
+}
+
+/**
+ * @brief Builds the next level from @p source with a 2x2 box filter
+ * @param source Image to halve
+ * @return Half-size image, nullptr if @p source has no pixels
+ */
+std::shared_ptr<const CDicomImage> CImagePyramid::halve(const CDicomImage &source)
+{
+    const CPixelStorage pixels = source.pixelData();
+    const auto dims = source.dimensions();
+    const uint32_t channels = std::max<uint32_t>(1, dims.samplesPerPixel);
+    const bool is16bit = (source.bitsPerSample() == 16);
+    const size_t bytesPerSample = is16bit ? 2 : 1;
+    const size_t srcBytes = static_cast<size_t>(dims.width) * dims.height * channels * bytesPerSample;
+    if (pixels.empty() || pixels.size() < srcBytes || dims.width == 0 || dims.height == 0)
+    {
+        return nullptr;
+    }
+
+    auto levelDims = dims;
+    levelDims.width = (dims.width + 1) / 2;
+    levelDims.height = (dims.height + 1) / 2;
+    std::vector<uint8_t> bytes(static_cast<size_t>(levelDims.width) * levelDims.height *
+                               channels * bytesPerSample);
+
+    const bool isSigned = source.isPixelSigned();
+    const size_t rowsPerBand = std::max<size_t>(1, kGrainPixels / levelDims.width);
+    CThreadPool::shared().parallelFor(
+        levelDims.height, rowsPerBand,
+        [&](size_t begin, size_t end)
+        {
+            const auto rowBegin = static_cast<uint32_t>(begin);
+            const auto rowEnd = static_cast<uint32_t>(end);
+            if (!is16bit)
+            {
+                halveRows(pixels.data(), dims.width, dims.height, channels,
+                          bytes.data(), levelDims.width, rowBegin, rowEnd);
+            }
+            else if (isSigned)
+            {
+                halveRows(reinterpret_cast<const int16_t *>(pixels.data()), dims.width,
+                          dims.height, channels, reinterpret_cast<int16_t *>(bytes.data()),
+                          levelDims.width, rowBegin, rowEnd);
+            }
+            else
+            {
+                halveRows(reinterpret_cast<const uint16_t *>(pixels.data()), dims.width,
+                          dims.height, channels, reinterpret_cast<uint16_t *>(bytes.data()),
+                          levelDims.width, rowBegin, rowEnd);
+            }
+        });
+
+    auto result = std::make_shared<CDicomImage>();
+    result->setDimensions(levelDims);
+    result->setPhotometricInterpretation(source.photometricInterpretation());
+    result->setDefaultWindowLevel(source.defaultWindowLevel());
+    result->setWindowLevel(source.windowLevel());
+    result->setRescaleSlope(source.rescaleSlope());
+    result->setRescaleIntercept(source.rescaleIntercept());
+    result->setBitsPerSample(source.bitsPerSample());
+    result->setPixelSigned(isSigned);
+    result->setValueRange(source.valueRange());
+    result->setPixelData(std::move(bytes));
+    return result;
+}
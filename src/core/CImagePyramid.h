@@ -0,0 +1,99 @@
+/**
+ * @file CImagePyramid.h
+ * @brief Lazily built multi-resolution pyramid class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CImagePyramid class which keeps successively halved
+ * copies of an image's decoded samples, so displays smaller than the
+ * image (thumbnails, zoomed-out views, GL mip levels) read a level
+ * close to screen size instead of the full-resolution buffer.
+ */
+
+#pragma once
+
+#include "DicomViewer/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class CDicomImage;
+
+/**
+ * @class CImagePyramid
+ * @brief Mip chain of an image, built level by level on first use
+ *
+ * Level 0 is the image itself; level n halves both dimensions n times
+ * (rounding up) down to 1x1. Each level is a 2x2 box filter of the
+ * previous one, computed on the raw 8/16-bit samples before any
+ * window/level, so windowing a level matches windowing the original.
+ * Levels are stand-alone CDicomImage objects without metadata or
+ * decoder, and can be handed to the converter and renderers as is.
+ *
+ * Thread-safe. Levels are built outside the lock; if two threads
+ * build the same level at once, the first one stored is kept.
+ */
+class CImagePyramid
+{
+  public:
+    CImagePyramid() = default;
+
+    /**
+     * @brief Retrieves a reduced-resolution level, building it if needed
+     * @param base Full-resolution image the pyramid belongs to
+     * @param level Level index (1 = half size)
+     * @return Level image, nullptr for level 0, out-of-range levels or missing pixels
+     */
+    std::shared_ptr<const CDicomImage> level(const CDicomImage &base, uint32_t level);
+
+    /**
+     * @brief Retrieves a level only if it is already built
+     * @param level Level index (1 = half size)
+     * @return Level image, nullptr if not built yet
+     */
+    std::shared_ptr<const CDicomImage> builtLevel(uint32_t level) const;
+
+    /**
+     * @brief Drops all built levels
+     */
+    void clear();
+
+    /**
+     * @brief Bytes held by built levels
+     * @return Sum of the level pixel buffer sizes
+     */
+    size_t residentBytes() const;
+
+    /** @name Level Selection */
+    ///@{
+    /**
+     * @brief Number of levels of an image, including level 0
+     * @param dims Full-resolution dimensions
+     * @return Levels down to 1x1
+     */
+    static uint32_t levelCount(const DicomViewer::SImageDimensions &dims);
+
+    /**
+     * @brief Coarsest level that still has a pixel per screen pixel
+     * @param dims Full-resolution dimensions
+     * @param scale Screen pixels per image pixel
+     * @return Level to sample at @p scale (0 when magnified)
+     */
+    static uint32_t levelForScale(const DicomViewer::SImageDimensions &dims, double scale);
+    ///@}
+
+  private:
+    /**
+     * @brief Builds the next level from @p source with a 2x2 box filter
+     * @param source Image to halve
+     * @return Half-size image, nullptr if @p source has no pixels
+     */
+    static std::shared_ptr<const CDicomImage> halve(const CDicomImage &source);
+
+    mutable std::mutex m_mutex;
+    std::vector<std::shared_ptr<const CDicomImage>> m_levels; /**< Index 0 holds level 1 */
+    size_t m_residentBytes = 0;
+};
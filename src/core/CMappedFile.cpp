@@ -0,0 +1,136 @@
+/**
+ * @file CMappedFile.cpp
+ * @brief Implementation of the CMappedFile class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CMappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Maps a file read-only
+ * @param filePath Path to the file
+ * @return Mapping, nullptr if the file cannot be opened or mapped or is empty
+ */
+std::shared_ptr<const CMappedFile> CMappedFile::open(const std::string &filePath)
+{
+    std::shared_ptr<CMappedFile> mapped(new CMappedFile());
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        return nullptr;
+    }
+    // The view keeps the mapping object alive after its handle is closed
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr)
+    {
+        return nullptr;
+    }
+    mapped->m_data = static_cast<const uint8_t *>(view);
+    mapped->m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat status{};
+    if (::fstat(fd, &status) != 0 || status.st_size <= 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    const size_t size = static_cast<size_t>(status.st_size);
+    // The mapping holds its own reference to the file
+    void *view = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    mapped->m_data = static_cast<const uint8_t *>(view);
+    mapped->m_size = size;
+#endif
+
+    return mapped;
+}
+
+CMappedFile::~CMappedFile()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    ::munmap(const_cast<uint8_t *>(m_data), m_size);
+#endif
+}
+
+const uint8_t *CMappedFile::data() const
+{
+    return m_data;
+}
+
+size_t CMappedFile::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief Asks the system to start reading a range into the page cache
+ *
+ * Only a hint; does nothing where the platform offers no equivalent.
+ *
+ * @param offset First byte of the range
+ * @param length Number of bytes
+ */
+void CMappedFile::willNeed(size_t offset, size_t length) const
+{
+#ifndef _WIN32
+    if (offset >= m_size)
+    {
+        return;
+    }
+    if (length > m_size - offset)
+    {
+        length = m_size - offset;
+    }
+    // madvise wants a page-aligned start
+    const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t start = offset - offset % pageSize;
+    ::madvise(const_cast<uint8_t *>(m_data) + start, length + (offset - start), MADV_WILLNEED);
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
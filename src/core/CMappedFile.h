@@ -0,0 +1,67 @@
+/**
+ * @file CMappedFile.h
+ * @brief Read-only memory-mapped file class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CMappedFile class which maps a whole file into the
+ * address space, so pixel storage can reference the file's bytes in
+ * the page cache instead of copying them onto the heap.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @class CMappedFile
+ * @brief Read-only mapping of a file that lives as long as its last reference
+ *
+ * Instances are only handed out through shared pointers, so a
+ * CPixelStorage adopting a range of the mapping keeps it pinned for as
+ * long as the pixels are in use; the mapping is removed when the last
+ * reference goes away.
+ *
+ * The file is expected not to change while it is mapped. Truncating a
+ * mapped file makes reads past its new end fault.
+ */
+class CMappedFile
+{
+  public:
+    /**
+     * @brief Maps a file read-only
+     * @param filePath Path to the file
+     * @return Mapping, nullptr if the file cannot be opened or mapped or is empty
+     */
+    static std::shared_ptr<const CMappedFile> open(const std::string &filePath);
+
+    /**
+     * @brief Destructor; unmaps the file
+     */
+    ~CMappedFile();
+
+    CMappedFile(const CMappedFile &) = delete;
+    CMappedFile &operator=(const CMappedFile &) = delete;
+
+    /** @name Access */
+    ///@{
+    const uint8_t *data() const;
+    size_t size() const;
+    ///@}
+
+    /**
+     * @brief Asks the system to start reading a range into the page cache
+     * @param offset First byte of the range
+     * @param length Number of bytes
+     */
+    void willNeed(size_t offset, size_t length) const;
+
+  private:
+    CMappedFile() = default;
+
+    const uint8_t *m_data = nullptr; /**< First byte of the mapping */
+    size_t m_size = 0;               /**< File size in bytes */
+};
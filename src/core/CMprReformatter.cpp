@@ -0,0 +1,331 @@
+/**
+ * @file CMprReformatter.cpp
+ * @brief Implementation of the CMprReformatter class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CMprReformatter.h"
+
+#include "CDicomImage.h"
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr double kSpacingTolerance = 1e-3; /**< Relative; closer spacings count as equal */
+
+/**
+ * @brief Interpolation taps of one output row or column
+ */
+struct STap
+{
+    size_t offset0 = 0; /**< axisOffset() of the lower voxel */
+    size_t offset1 = 0; /**< axisOffset() of the upper voxel */
+    float weight = 0.f; /**< Weight of the upper voxel */
+};
+
+/**
+ * @brief Output size along an axis resampled from @p spacing to @p target
+ */
+uint32_t resampledCount(uint32_t count, double spacing, double target)
+{
+    if (count <= 1)
+    {
+        return count;
+    }
+    return static_cast<uint32_t>(std::lround((count - 1) * spacing / target)) + 1;
+}
+
+/**
+ * @brief Tabulates the taps of every output position along one axis
+ * @param bricks Volume whose offsets to use
+ * @param axis Volume axis
+ * @param count Voxels along @p axis
+ * @param outputCount Output samples along @p axis
+ * @param flip True to run from the last voxel to the first
+ * @return One tap per output sample
+ */
+std::vector<STap> makeTaps(const CBrickedVolume &bricks, uint32_t axis, uint32_t count,
+                           uint32_t outputCount, bool flip)
+{
+    std::vector<STap> taps(outputCount);
+    const double step = outputCount > 1 ? static_cast<double>(count - 1) / (outputCount - 1) : 0.0;
+    for (uint32_t i = 0; i < outputCount; ++i)
+    {
+        double position = std::min(i * step, static_cast<double>(count - 1));
+        if (flip)
+        {
+            position = (count - 1) - position;
+        }
+        const auto lower = static_cast<uint32_t>(position);
+        const uint32_t upper = std::min(lower + 1, count - 1);
+        taps[i] = {bricks.axisOffset(axis, lower), bricks.axisOffset(axis, upper),
+                   static_cast<float>(position - lower)};
+    }
+    return taps;
+}
+
+/**
+ * @brief Bilinear resampling of a band of output rows, tile by tile
+ */
+template <typename T>
+void resampleRows(const T *voxels, size_t planeOffset, const std::vector<STap> &columns,
+                  const std::vector<STap> &rows, T *output, size_t rowBegin, size_t rowEnd)
+{
+    const size_t width = columns.size();
+    constexpr size_t kTile = CBrickedVolume::kBrickSize;
+    for (size_t tileX = 0; tileX < width; tileX += kTile)
+    {
+        const size_t tileEnd = std::min(width, tileX + kTile);
+        for (size_t y = rowBegin; y < rowEnd; ++y)
+        {
+            const STap &row = rows[y];
+            const T *row0 = voxels + planeOffset + row.offset0;
+            const T *row1 = voxels + planeOffset + row.offset1;
+            T *target = output + y * width;
+            for (size_t x = tileX; x < tileEnd; ++x)
+            {
+                const STap &column = columns[x];
+                const float top = row0[column.offset0] +
+                                  (row0[column.offset1] - row0[column.offset0]) * column.weight;
+                const float bottom = row1[column.offset0] +
+                                     (row1[column.offset1] - row1[column.offset0]) * column.weight;
+                target[x] = static_cast<T>(std::floor(top + (bottom - top) * row.weight + 0.5f));
+            }
+        }
+    }
+}
+} // namespace
+
+/**
+ * @brief Constructor
+ * @param volume Volume to reformat
+ */
+CMprReformatter::CMprReformatter(std::shared_ptr<const CVolume> volume)
+    : m_volume(std::move(volume))
+{
+}
+
+const std::shared_ptr<const CVolume> &CMprReformatter::volume() const
+{
+    return m_volume;
+}
+
+/**
+ * @brief Number of planes along the normal of @p plane
+ * @param plane Plane orientation
+ * @return Plane count, 0 without a volume
+ */
+uint32_t CMprReformatter::planeCount(DicomViewer::EMprPlane plane) const
+{
+    if (!m_volume)
+    {
+        return 0;
+    }
+    const uint32_t counts[3] = {m_volume->width(), m_volume->height(), m_volume->depth()};
+    return counts[axesFor(plane).normal];
+}
+
+/**
+ * @brief Cuts one plane out of the volume
+ * @param plane Plane orientation
+ * @param index Plane index along the normal, < planeCount(plane)
+ * @return 16-bit image, nullptr if @p index is out of range
+ */
+std::shared_ptr<CDicomImage> CMprReformatter::reformat(DicomViewer::EMprPlane plane, uint32_t index) const
+{
+    if (index >= planeCount(plane))
+    {
+        return nullptr;
+    }
+
+    const SPlaneAxes axes = axesFor(plane);
+    const uint32_t counts[3] = {m_volume->width(), m_volume->height(), m_volume->depth()};
+    const auto spacing = m_volume->spacing();
+    const double target = std::min(spacing[axes.horizontal], spacing[axes.vertical]);
+
+    // The acquisition grid needs no resampling: show the slice itself
+    if (isAcquisitionGrid(axes))
+    {
+        return m_volume->slice(index);
+    }
+
+    const CBrickedVolume &volume = bricks();
+    const uint32_t width = resampledCount(counts[axes.horizontal], spacing[axes.horizontal], target);
+    const uint32_t height = resampledCount(counts[axes.vertical], spacing[axes.vertical], target);
+    const auto columns = makeTaps(volume, axes.horizontal, counts[axes.horizontal], width,
+                                  axes.flipHorizontal);
+    const auto rows = makeTaps(volume, axes.vertical, counts[axes.vertical], height,
+                               axes.flipVertical);
+    const size_t planeOffset = volume.axisOffset(axes.normal, index);
+
+    std::vector<uint8_t> bytes(static_cast<size_t>(width) * height * sizeof(uint16_t));
+    const bool isSigned = volume.isSigned();
+    CThreadPool::shared().parallelFor(
+        height, CBrickedVolume::kBrickSize,
+        [&](size_t begin, size_t end)
+        {
+            if (isSigned)
+            {
+                resampleRows(reinterpret_cast<const int16_t *>(volume.data()), planeOffset, columns,
+                             rows, reinterpret_cast<int16_t *>(bytes.data()), begin, end);
+            }
+            else
+            {
+                resampleRows(volume.data(), planeOffset, columns, rows,
+                             reinterpret_cast<uint16_t *>(bytes.data()), begin, end);
+            }
+        });
+
+    DicomViewer::SImageDimensions dims;
+    dims.width = width;
+    dims.height = height;
+    dims.bitsAllocated = 16;
+    dims.bitsStored = 16;
+    dims.highBit = 15;
+    dims.samplesPerPixel = 1;
+    dims.isSigned = isSigned;
+
+    auto image = std::make_shared<CDicomImage>();
+    image->setDimensions(dims);
+    image->setPhotometricInterpretation(m_volume->photometricInterpretation());
+    if (const CDicomMetadata *metadata = m_volume->sliceMetadata(0))
+    {
+        // Position, orientation and spacing of slice 0 do not describe this plane
+        image->setMetadata(std::make_unique<CDicomMetadata>(metadata->seriesIdentity()));
+    }
+    image->setBitsPerSample(16);
+    image->setPixelSigned(isSigned);
+    image->setValueRange(m_volume->valueRange());
+    image->setDefaultWindowLevel(m_volume->defaultWindowLevel());
+    image->setPixelData(std::move(bytes));
+    return image;
+}
+
+/**
+ * @brief Maps an anatomical plane onto the volume axes
+ * @param plane Plane orientation
+ * @return Axes and flips, identity for EMprPlane::Acquisition
+ */
+CMprReformatter::SPlaneAxes CMprReformatter::axesFor(DicomViewer::EMprPlane plane) const
+{
+    using Vector3 = CVolume::Vector3;
+    Vector3 normal;
+    Vector3 right;
+    Vector3 down;
+    // Patient coordinates are LPS: +x left, +y posterior, +z superior
+    switch (plane)
+    {
+    case DicomViewer::EMprPlane::Axial:
+        normal = {0.0, 0.0, 1.0};
+        right = {1.0, 0.0, 0.0};
+        down = {0.0, 1.0, 0.0};
+        break;
+    case DicomViewer::EMprPlane::Coronal:
+        normal = {0.0, 1.0, 0.0};
+        right = {1.0, 0.0, 0.0};
+        down = {0.0, 0.0, -1.0};
+        break;
+    case DicomViewer::EMprPlane::Sagittal:
+        normal = {1.0, 0.0, 0.0};
+        right = {0.0, 1.0, 0.0};
+        down = {0.0, 0.0, -1.0};
+        break;
+    default:
+        return {};
+    }
+
+    const Vector3 directions[3] = {m_volume->rowDirection(), m_volume->columnDirection(),
+                                   m_volume->sliceDirection()};
+    const auto dot = [](const Vector3 &a, const Vector3 &b)
+    { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+
+    SPlaneAxes axes;
+    axes.normal = 0;
+    for (uint32_t axis = 1; axis < 3; ++axis)
+    {
+        if (std::abs(dot(directions[axis], normal)) > std::abs(dot(directions[axes.normal], normal)))
+        {
+            axes.normal = axis;
+        }
+    }
+    const uint32_t first = axes.normal == 0 ? 1 : 0;
+    const uint32_t second = axes.normal == 2 ? 1 : 2;
+    const bool firstIsHorizontal = std::abs(dot(directions[first], right)) >=
+                                   std::abs(dot(directions[second], right));
+    axes.horizontal = firstIsHorizontal ? first : second;
+    axes.vertical = firstIsHorizontal ? second : first;
+    axes.flipHorizontal = dot(directions[axes.horizontal], right) < 0.0;
+    axes.flipVertical = dot(directions[axes.vertical], down) < 0.0;
+    return axes;
+}
+
+/**
+ * @brief Checks whether reformat() can cut a plane without building the bricked copy
+ * @param plane Plane orientation
+ * @return True for planes on the acquisition grid or once the copy exists
+ */
+bool CMprReformatter::isReady(DicomViewer::EMprPlane plane) const
+{
+    if (!m_volume || isAcquisitionGrid(axesFor(plane)))
+    {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(m_bricksMutex);
+    return m_bricks != nullptr;
+}
+
+/**
+ * @brief Builds the bricked copy if it does not exist yet
+ */
+void CMprReformatter::prepare() const
+{
+    if (m_volume)
+    {
+        bricks();
+    }
+}
+
+/**
+ * @brief Memory held by the bricked copy
+ * @return Bytes, 0 until the copy is built
+ */
+size_t CMprReformatter::byteSize() const
+{
+    std::lock_guard<std::mutex> lock(m_bricksMutex);
+    return m_bricks ? m_bricks->byteSize() : 0;
+}
+
+/**
+ * @brief Checks whether a plane is an acquired slice, needing no resampling
+ * @param axes Axes of the plane
+ * @return True if reformat() can return a CVolume slice
+ */
+bool CMprReformatter::isAcquisitionGrid(const SPlaneAxes &axes) const
+{
+    const auto spacing = m_volume->spacing();
+    const double target = std::min(spacing[axes.horizontal], spacing[axes.vertical]);
+    const bool squarePixels = std::abs(spacing[axes.horizontal] - spacing[axes.vertical]) <=
+                              kSpacingTolerance * target;
+    return axes.normal == 2 && axes.horizontal == 0 && !axes.flipHorizontal &&
+           !axes.flipVertical && squarePixels;
+}
+
+/**
+ * @brief Brick-ordered copy of the volume, built on first use
+ * @return Bricked volume
+ */
+const CBrickedVolume &CMprReformatter::bricks() const
+{
+    std::lock_guard<std::mutex> lock(m_bricksMutex);
+    if (!m_bricks)
+    {
+        m_bricks = std::make_unique<const CBrickedVolume>(*m_volume);
+    }
+    return *m_bricks;
+}
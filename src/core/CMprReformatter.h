@@ -0,0 +1,143 @@
+/**
+ * @file CMprReformatter.h
+ * @brief Multi-planar reformatting of a voxel volume class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CMprReformatter class which cuts axial, coronal and
+ * sagittal planes out of an assembled CVolume on the CPU and returns
+ * them as ordinary 16-bit CDicomImage objects, so they are windowed,
+ * coloured and displayed by the same converter and viewer paths as
+ * acquired slices.
+ */
+
+#pragma once
+
+#include "CBrickedVolume.h"
+#include "CVolume.h"
+#include "DicomViewer/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+class CDicomImage;
+
+/**
+ * @class CMprReformatter
+ * @brief Orthogonal planes through a volume, resampled to square pixels
+ *
+ * Each anatomical plane is cut perpendicular to the volume axis
+ * closest to its normal and oriented in the usual radiological way
+ * (patient left on screen right; superior up on coronal and sagittal
+ * planes). Both in-plane axes are resampled with bilinear
+ * interpolation to the finer of their two spacings, so thick slices
+ * are stretched to their true extent.
+ *
+ * Planes that need resampling read from a CBrickedVolume, built by
+ * prepare() or else on the first such request. Building it copies the
+ * whole volume, so interactive callers run prepare() on a worker and
+ * check isReady() before cutting a plane. Output rows are split into bands across
+ * CThreadPool::shared(), and each band is walked in brick-sized tiles
+ * so the bricks a tile reads stay in cache. Planes that match the
+ * acquisition grid are returned as zero-copy CVolume slices.
+ *
+ * Thread-safe.
+ */
+class CMprReformatter
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param volume Volume to reformat
+     */
+    explicit CMprReformatter(std::shared_ptr<const CVolume> volume);
+
+    /**
+     * @brief Volume being reformatted
+     * @return Shared volume
+     */
+    const std::shared_ptr<const CVolume> &volume() const;
+
+    /**
+     * @brief Number of planes along the normal of @p plane
+     * @param plane Plane orientation
+     * @return Plane count, 0 without a volume
+     */
+    uint32_t planeCount(DicomViewer::EMprPlane plane) const;
+
+    /**
+     * @brief Cuts one plane out of the volume
+     *
+     * The image has the volume's value range, default window/level
+     * and photometric interpretation, and the metadata of the volume's
+     * first slice.
+     *
+     * @param plane Plane orientation
+     * @param index Plane index along the normal, < planeCount(plane)
+     * @return 16-bit image, nullptr if @p index is out of range
+     */
+    std::shared_ptr<CDicomImage> reformat(DicomViewer::EMprPlane plane, uint32_t index) const;
+
+    /** @name Bricked Copy */
+    ///@{
+    /**
+     * @brief Checks whether reformat() can cut a plane without building the bricked copy
+     * @param plane Plane orientation
+     * @return True for planes on the acquisition grid or once the copy exists
+     */
+    bool isReady(DicomViewer::EMprPlane plane) const;
+
+    /**
+     * @brief Builds the bricked copy if it does not exist yet
+     *
+     * Takes about as long as copying the volume; call it off the GUI
+     * thread.
+     */
+    void prepare() const;
+
+    /**
+     * @brief Memory held by the bricked copy
+     * @return Bytes, 0 until the copy is built
+     */
+    size_t byteSize() const;
+    ///@}
+
+  private:
+    /**
+     * @brief Volume axes (0 = x, 1 = y, 2 = z) making up a plane
+     */
+    struct SPlaneAxes
+    {
+        uint32_t normal = 2;
+        uint32_t horizontal = 0;
+        uint32_t vertical = 1;
+        bool flipHorizontal = false;
+        bool flipVertical = false;
+    };
+
+    /**
+     * @brief Maps an anatomical plane onto the volume axes
+     * @param plane Plane orientation
+     * @return Axes and flips, identity for EMprPlane::Acquisition
+     */
+    SPlaneAxes axesFor(DicomViewer::EMprPlane plane) const;
+
+    /**
+     * @brief Checks whether a plane is an acquired slice, needing no resampling
+     * @param axes Axes of the plane
+     * @return True if reformat() can return a CVolume slice
+     */
+    bool isAcquisitionGrid(const SPlaneAxes &axes) const;
+
+    /**
+     * @brief Brick-ordered copy of the volume, built on first use
+     * @return Bricked volume
+     */
+    const CBrickedVolume &bricks() const;
+
+    std::shared_ptr<const CVolume> m_volume;
+    mutable std::mutex m_bricksMutex;
+    mutable std::unique_ptr<const CBrickedVolume> m_bricks;
+};
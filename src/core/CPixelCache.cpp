@@ -0,0 +1,147 @@
+/**
+ * @file CPixelCache.cpp
+ * @brief Implementation of the CPixelCache class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CPixelCache.h"
+
+#include "CDicomImage.h"
+
+#include <algorithm>
+
+/**
+ * @brief Constructor
+ * @param budgetBytes Maximum resident pixel bytes (0 = unlimited)
+ */
+CPixelCache::CPixelCache(size_t budgetBytes)
+    : m_budgetBytes(budgetBytes)
+{
+}
+
+/**
+ * @brief Sets the resident byte budget
+ * @param budgetBytes Maximum resident pixel bytes (0 = unlimited)
+ */
+void CPixelCache::setBudget(size_t budgetBytes)
+{
+    m_budgetBytes = budgetBytes;
+}
+
+/**
+ * @brief Retrieves the resident byte budget
+ * @return Budget in bytes (0 = unlimited)
+ */
+size_t CPixelCache::budget() const
+{
+    return m_budgetBytes;
+}
+
+/**
+ * @brief Sums the resident pixel bytes of all tracked images
+ * @return Total resident bytes
+ */
+size_t CPixelCache::residentBytes() const
+{
+    size_t total = 0;
+    for (const auto &entry : m_lru)
+    {
+        if (auto image = entry.image.lock())
+        {
+            total += image->residentPixelBytes();
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Marks an image as most recently used
+ * @param image Image to touch
+ */
+void CPixelCache::touch(const std::shared_ptr<CDicomImage> &image)
+{
+    if (!image)
+    {
+        return;
+    }
+
+    auto it = m_index.find(image.get());
+    if (it != m_index.end())
+    {
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return;
+    }
+
+    m_lru.push_front({image.get(), image});
+    m_index[image.get()] = m_lru.begin();
+}
+
+/**
+ * @brief Stops tracking an image
+ * @param image Image to forget
+ */
+void CPixelCache::remove(const CDicomImage *image)
+{
+    auto it = m_index.find(image);
+    if (it == m_index.end())
+    {
+        return;
+    }
+    m_lru.erase(it->second);
+    m_index.erase(it);
+}
+
+/**
+ * @brief Forgets all tracked images without releasing their pixels
+ */
+void CPixelCache::clear()
+{
+    m_lru.clear();
+    m_index.clear();
+}
+
+/**
+ * @brief Releases least recently used pixels until within budget
+ * @param pinned Images whose pixels must stay resident
+ * @param reservedBytes Bytes held outside the cache that count against the budget
+ * @return Number of bytes released
+ */
+size_t CPixelCache::trim(const std::unordered_set<const CDicomImage *> &pinned,
+                         size_t reservedBytes)
+{
+    // Drop entries whose images no longer exist
+    for (auto it = m_lru.begin(); it != m_lru.end();)
+    {
+        if (it->image.expired())
+        {
+            m_index.erase(it->key);
+            it = m_lru.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_budgetBytes == 0)
+    {
+        return 0;
+    }
+
+    const size_t budget = m_budgetBytes - std::min(m_budgetBytes, reservedBytes);
+    size_t resident = residentBytes();
+    size_t released = 0;
+    for (auto it = m_lru.rbegin(); it != m_lru.rend() && resident > budget; ++it)
+    {
+        auto image = it->image.lock();
+        if (!image || pinned.count(image.get()) > 0)
+        {
+            continue;
+        }
+        const size_t bytes = image->releasePixelData();
+        resident -= bytes;
+        released += bytes;
+    }
+    return released;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file CPixelCache.h
+ * @brief Byte-budgeted LRU cache of resident pixel data
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CPixelCache class which bounds the memory held by decoded
+ * pixel buffers across all loaded images. Evicted images keep their
+ * header and metadata and decode their pixels again on next access.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+class CDicomImage;
+
+/**
+ * @class CPixelCache
+ * @brief Tracks image usage and releases pixels beyond a byte budget
+ *
+ * Images are ordered by last use. trim() walks from the least recently
+ * used end and releases pixel data until the resident total fits the
+ * budget, skipping pinned images (e.g. the current one and its
+ * neighbours). Resident sizes are sampled at trim time, so images that
+ * re-decode on their own are accounted for without notification.
+ *
+ * Not thread-safe; owned and driven by the presentation layer.
+ */
+class CPixelCache
+{
+  public:
+    static constexpr size_t kDefaultBudgetBytes = size_t(2048) * 1024 * 1024;
+
+    /**
+     * @brief Constructor
+     * @param budgetBytes Maximum resident pixel bytes (0 = unlimited)
+     */
+    explicit CPixelCache(size_t budgetBytes = kDefaultBudgetBytes);
+
+    /** @name Budget */
+    ///@{
+    void setBudget(size_t budgetBytes);
+    size_t budget() const;
+
+    /**
+     * @brief Sums the resident pixel bytes of all tracked images
+     * @return Total resident bytes
+     */
+    size_t residentBytes() const;
+    ///@}
+
+    /** @name Usage Tracking */
+    ///@{
+    /**
+     * @brief Marks an image as most recently used (tracking it if new)
+     * @param image Image to touch
+     */
+    void touch(const std::shared_ptr<CDicomImage> &image);
+
+    /**
+     * @brief Stops tracking an image
+     * @param image Image to forget
+     */
+    void remove(const CDicomImage *image);
+
+    /**
+     * @brief Forgets all tracked images without releasing their pixels
+     */
+    void clear();
+    ///@}
+
+    /**
+     * @brief Releases least recently used pixels until within budget
+     * @param pinned Images whose pixels must stay resident
+     * @param reservedBytes Bytes held outside the cache (e.g. assembled
+     *        volumes) that count against the same budget
+     * @return Number of bytes released
+     */
+    size_t trim(const std::unordered_set<const CDicomImage *> &pinned = {},
+                size_t reservedBytes = 0);
+
+  private:
+    struct SEntry
+    {
+        const CDicomImage *key = nullptr;
+        std::weak_ptr<CDicomImage> image;
+    };
+
+    std::list<SEntry> m_lru; /**< Front = most recently used */
+    std::unordered_map<const CDicomImage *, std::list<SEntry>::iterator> m_index;
+    size_t m_budgetBytes = kDefaultBudgetBytes;
+};
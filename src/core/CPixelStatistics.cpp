@@ -0,0 +1,277 @@
+/**
+ * @file CPixelStatistics.cpp
+ * @brief Implementation of the CPixelStatistics class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CPixelStatistics.h"
+
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+// Samples per parallel chunk; each chunk keeps a private histogram
+constexpr size_t kGrainSamples = size_t(1) << 20;
+
+/**
+ * @brief Partial result of one chunk, merged into the totals
+ */
+struct SPartial
+{
+    std::vector<uint64_t> bins;
+    int32_t minValue = std::numeric_limits<int32_t>::max();
+    int32_t maxValue = std::numeric_limits<int32_t>::min();
+    int64_t sum = 0;
+};
+
+/**
+ * @brief Accumulates a run of samples into a partial result
+ *
+ * Min, max and sum are kept in locals so the compiler can vectorize
+ * them; the histogram increment is the only scattered access.
+ */
+template <typename T>
+void accumulate(const T *samples, size_t count, int32_t rangeMin, uint32_t binShift,
+                SPartial &partial)
+{
+    constexpr int64_t kLastBin = static_cast<int64_t>(CPixelStatistics::kBinCount - 1);
+    uint64_t *bins = partial.bins.data();
+    int32_t minValue = partial.minValue;
+    int32_t maxValue = partial.maxValue;
+    int64_t sum = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int32_t value = samples[i];
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        sum += value;
+        const int64_t bin = (static_cast<int64_t>(value) - rangeMin) >> binShift;
+        ++bins[static_cast<size_t>(std::clamp<int64_t>(bin, 0, kLastBin))];
+    }
+
+    partial.minValue = minValue;
+    partial.maxValue = maxValue;
+    partial.sum += sum;
+}
+} // namespace
+
+/**
+ * @brief Scans a pixel buffer once
+ *
+ * Chunks fill private histograms that are merged under a lock, so the
+ * result does not depend on how the pool schedules them.
+ *
+ * @param pixels Decoded samples (8-bit, or 16-bit native endian)
+ * @param bitsPerSample 8 or 16
+ * @param isSigned True for signed 16-bit samples
+ * @param range Value range the histogram is spread over
+ * @return Statistics of the buffer (invalid if it is empty)
+ */
+CPixelStatistics CPixelStatistics::compute(const CPixelStorage &pixels, uint8_t bitsPerSample,
+                                           bool isSigned, const DicomViewer::SValueRange &range)
+{
+    CPixelStatistics stats;
+    const size_t bytesPerSample = (bitsPerSample > 8) ? 2 : 1;
+    const size_t sampleCount = pixels.size() / bytesPerSample;
+    if (sampleCount == 0)
+    {
+        return stats;
+    }
+
+    // Smallest power-of-two bin width that fits the range into kBinCount bins
+    const int32_t rangeMin = std::min(range.min, range.max);
+    const int64_t span = static_cast<int64_t>(std::max(range.min, range.max)) - rangeMin + 1;
+    uint32_t binShift = 0;
+    while (((span - 1) >> binShift) >= static_cast<int64_t>(kBinCount))
+    {
+        ++binShift;
+    }
+
+    SPartial total;
+    total.bins.assign(kBinCount, 0);
+    std::mutex totalMutex;
+
+    CThreadPool::shared().parallelFor(
+        sampleCount, kGrainSamples,
+        [&](size_t begin, size_t end)
+        {
+            SPartial partial;
+            partial.bins.assign(kBinCount, 0);
+            const size_t count = end - begin;
+            if (bytesPerSample == 1)
+            {
+                accumulate(pixels.data() + begin, count, rangeMin, binShift, partial);
+            }
+            else if (isSigned)
+            {
+                const auto *samples = reinterpret_cast<const int16_t *>(pixels.data());
+                accumulate(samples + begin, count, rangeMin, binShift, partial);
+            }
+            else
+            {
+                const auto *samples = reinterpret_cast<const uint16_t *>(pixels.data());
+                accumulate(samples + begin, count, rangeMin, binShift, partial);
+            }
+
+            std::lock_guard<std::mutex> lock(totalMutex);
+            for (size_t bin = 0; bin < kBinCount; ++bin)
+            {
+                total.bins[bin] += partial.bins[bin];
+            }
+            total.minValue = std::min(total.minValue, partial.minValue);
+            total.maxValue = std::max(total.maxValue, partial.maxValue);
+            total.sum += partial.sum;
+        });
+
+    stats.m_sampleCount = sampleCount;
+    stats.m_minValue = total.minValue;
+    stats.m_maxValue = total.maxValue;
+    stats.m_mean = static_cast<double>(total.sum) / static_cast<double>(sampleCount);
+    stats.m_rangeMin = rangeMin;
+    stats.m_binShift = binShift;
+    stats.m_histogram = std::move(total.bins);
+    stats.m_cumulative.resize(kBinCount);
+    uint64_t running = 0;
+    for (size_t bin = 0; bin < kBinCount; ++bin)
+    {
+        running += stats.m_histogram[bin];
+        stats.m_cumulative[bin] = running;
+    }
+    return stats;
+}
+
+/**
+ * @brief Checks if the statistics describe any samples
+ * @return True if computed from a non-empty buffer
+ */
+bool CPixelStatistics::isValid() const
+{
+    return m_sampleCount > 0;
+}
+
+/**
+ * @brief Retrieves the number of samples scanned
+ * @return Sample count
+ */
+size_t CPixelStatistics::sampleCount() const
+{
+    return m_sampleCount;
+}
+
+/**
+ * @brief Retrieves the smallest sample value
+ * @return Minimum value
+ */
+int32_t CPixelStatistics::minValue() const
+{
+    return m_minValue;
+}
+
+/**
+ * @brief Retrieves the largest sample value
+ * @return Maximum value
+ */
+int32_t CPixelStatistics::maxValue() const
+{
+    return m_maxValue;
+}
+
+/**
+ * @brief Retrieves the mean sample value
+ * @return Mean value
+ */
+double CPixelStatistics::mean() const
+{
+    return m_mean;
+}
+
+/**
+ * @brief Retrieves the sample count per bin
+ * @return kBinCount counts (empty if invalid)
+ */
+const std::vector<uint64_t> &CPixelStatistics::histogram() const
+{
+    return m_histogram;
+}
+
+/**
+ * @brief Number of consecutive values per bin
+ * @return Bin width (a power of two)
+ */
+int32_t CPixelStatistics::binWidth() const
+{
+    return int32_t(1) << m_binShift;
+}
+
+/**
+ * @brief Smallest value that falls into a bin
+ * @param bin Bin index
+ * @return Lower bound of the bin
+ */
+int32_t CPixelStatistics::binLowerBound(size_t bin) const
+{
+    return m_rangeMin + static_cast<int32_t>(bin << m_binShift);
+}
+
+/**
+ * @brief Value below which a fraction of the samples lie
+ * @param fraction Fraction in [0, 1] (clamped)
+ * @return Percentile value, resolved to the bin width, within [min, max]
+ */
+int32_t CPixelStatistics::percentile(double fraction) const
+{
+    if (!isValid())
+    {
+        return 0;
+    }
+
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    const auto rank = static_cast<uint64_t>(
+        std::floor(fraction * static_cast<double>(m_sampleCount - 1)));
+    const auto it = std::upper_bound(m_cumulative.begin(), m_cumulative.end(), rank);
+    const size_t bin = static_cast<size_t>(std::distance(m_cumulative.begin(), it));
+
+    // Report the middle of the bin; exact when bins hold a single value
+    const int32_t value = binLowerBound(std::min(bin, kBinCount - 1)) + (binWidth() - 1) / 2;
+    return std::clamp(value, m_minValue, m_maxValue);
+}
+
+/**
+ * @brief Window spanning the full value range present
+ * @return Window/level covering [min, max]
+ */
+DicomViewer::SWindowLevel CPixelStatistics::minMaxWindow() const
+{
+    const double low = static_cast<double>(m_minValue);
+    const double high = static_cast<double>(m_maxValue);
+    return {(low + high + 1.0) / 2.0,
+            std::max(high - low + 1.0, static_cast<double>(DicomViewer::kMinWindowWidth))};
+}
+
+/**
+ * @brief Window spanning two percentiles, ignoring outliers
+ * @param lowFraction Lower percentile in [0, 1]
+ * @param highFraction Upper percentile in [0, 1]
+ * @return Window/level covering [percentile(low), percentile(high)]
+ */
+DicomViewer::SWindowLevel CPixelStatistics::percentileWindow(double lowFraction,
+                                                             double highFraction) const
+{
+    if (lowFraction > highFraction)
+    {
+        std::swap(lowFraction, highFraction);
+    }
+    const double low = static_cast<double>(percentile(lowFraction));
+    const double high = static_cast<double>(percentile(highFraction));
+    return {(low + high + 1.0) / 2.0,
+            std::max(high - low + 1.0, static_cast<double>(DicomViewer::kMinWindowWidth))};
+}
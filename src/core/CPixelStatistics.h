@@ -0,0 +1,119 @@
+/**
+ * @file CPixelStatistics.h
+ * @brief Per-image pixel statistics class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CPixelStatistics class which summarizes the decoded
+ * samples of an image (min, max, mean and a fixed-size histogram) so
+ * auto window/level, histogram presets and overlays never rescan the
+ * pixel buffer.
+ */
+
+#pragma once
+
+#include "CPixelStorage.h"
+#include "DicomViewer/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CPixelStatistics
+ * @brief Immutable min/max/histogram summary of one pixel buffer
+ *
+ * The histogram has kBinCount bins spread over the image's value
+ * range. Each bin covers a power-of-two number of values, so images
+ * with up to 12 significant bits get one exact bin per value and
+ * percentiles resolve to a single value; wider ranges resolve to the
+ * bin width. Color images are summarized over all samples.
+ *
+ * Computed in parallel row chunks on the shared thread pool.
+ */
+class CPixelStatistics
+{
+  public:
+    static constexpr size_t kBinCount = 4096;
+
+    /**
+     * @brief Constructs empty statistics (isValid() is false)
+     */
+    CPixelStatistics() = default;
+
+    /**
+     * @brief Scans a pixel buffer once
+     * @param pixels Decoded samples (8-bit, or 16-bit native endian)
+     * @param bitsPerSample 8 or 16
+     * @param isSigned True for signed 16-bit samples
+     * @param range Value range the histogram is spread over
+     * @return Statistics of the buffer (invalid if it is empty)
+     */
+    static CPixelStatistics compute(const CPixelStorage &pixels, uint8_t bitsPerSample,
+                                    bool isSigned, const DicomViewer::SValueRange &range);
+
+    /** @name Summary */
+    ///@{
+    bool isValid() const;
+    size_t sampleCount() const;
+    int32_t minValue() const;
+    int32_t maxValue() const;
+    double mean() const;
+    ///@}
+
+    /** @name Histogram */
+    ///@{
+    /**
+     * @brief Retrieves the sample count per bin
+     * @return kBinCount counts (empty if invalid)
+     */
+    const std::vector<uint64_t> &histogram() const;
+
+    /**
+     * @brief Number of consecutive values per bin
+     * @return Bin width (a power of two)
+     */
+    int32_t binWidth() const;
+
+    /**
+     * @brief Smallest value that falls into a bin
+     * @param bin Bin index
+     * @return Lower bound of the bin
+     */
+    int32_t binLowerBound(size_t bin) const;
+
+    /**
+     * @brief Value below which a fraction of the samples lie
+     * @param fraction Fraction in [0, 1] (clamped)
+     * @return Percentile value, resolved to the bin width, within [min, max]
+     */
+    int32_t percentile(double fraction) const;
+    ///@}
+
+    /** @name Window Presets */
+    ///@{
+    /**
+     * @brief Window spanning the full value range present
+     * @return Window/level covering [min, max]
+     */
+    DicomViewer::SWindowLevel minMaxWindow() const;
+
+    /**
+     * @brief Window spanning two percentiles, ignoring outliers
+     * @param lowFraction Lower percentile in [0, 1]
+     * @param highFraction Upper percentile in [0, 1]
+     * @return Window/level covering [percentile(low), percentile(high)]
+     */
+    DicomViewer::SWindowLevel percentileWindow(double lowFraction, double highFraction) const;
+    ///@}
+
+  private:
+    size_t m_sampleCount = 0;
+    int32_t m_minValue = 0;
+    int32_t m_maxValue = 0;
+    double m_mean = 0.0;
+    int32_t m_rangeMin = 0;              /**< Lower bound of bin 0 */
+    uint32_t m_binShift = 0;             /**< log2 of the bin width */
+    std::vector<uint64_t> m_histogram;   /**< Samples per bin */
+    std::vector<uint64_t> m_cumulative;  /**< Samples up to and including each bin */
+};
@@ -0,0 +1,86 @@
+/**
+ * @file CPixelStorage.cpp
+ * @brief Implementation of the CPixelStorage class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CPixelStorage.h"
+
+#include <utility>
+
+/**
+ * @brief Takes ownership of a vector of bytes
+ * @param bytes Pixel bytes to move into the storage
+ * @return Storage owning the vector
+ */
+CPixelStorage CPixelStorage::fromVector(std::vector<uint8_t> &&bytes)
+{
+    if (bytes.empty())
+    {
+        return CPixelStorage();
+    }
+
+    auto owner = std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+    const uint8_t *data = owner->data();
+    const size_t size = owner->size();
+    return adopt(data, size, std::move(owner));
+}
+
+/**
+ * @brief References a buffer kept alive by an external owner
+ * @param data First pixel byte
+ * @param size Number of bytes
+ * @param owner Object whose lifetime guarantees the buffer stays valid
+ * @return Storage sharing ownership of the owner
+ */
+CPixelStorage CPixelStorage::adopt(const uint8_t *data, size_t size,
+                                   std::shared_ptr<const void> owner)
+{
+    CPixelStorage storage;
+    if (data == nullptr || size == 0)
+    {
+        return storage;
+    }
+    storage.m_owner = std::move(owner);
+    storage.m_data = data;
+    storage.m_size = size;
+    return storage;
+}
+
+/**
+ * @brief Retrieves the first pixel byte
+ * @return Pointer to the buffer, nullptr if empty
+ */
+const uint8_t *CPixelStorage::data() const
+{
+    return m_data;
+}
+
+/**
+ * @brief Retrieves the buffer size
+ * @return Size in bytes
+ */
+size_t CPixelStorage::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief Checks if the storage references any bytes
+ * @return True if empty
+ */
+bool CPixelStorage::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief Drops this reference to the buffer
+ */
+void CPixelStorage::reset()
+{
+    m_owner.reset();
+    m_data = nullptr;
+    m_size = 0;
+}
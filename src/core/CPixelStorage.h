@@ -0,0 +1,72 @@
+/**
+ * @file CPixelStorage.h
+ * @brief Shared, read-only pixel buffer class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CPixelStorage class which references decoded pixel bytes
+ * without owning a particular container type. The bytes may live in a
+ * std::vector or directly in a decoder's buffer (e.g. DCMTK's
+ * intermediate pixel data), so a load never has to copy them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class CPixelStorage
+ * @brief Ref-counted view over an immutable pixel buffer
+ *
+ * Copies are cheap and share the same bytes; the buffer is released
+ * when the last copy goes away. The interface mirrors the parts of
+ * std::vector used by the renderers (data(), size(), empty()).
+ */
+class CPixelStorage
+{
+  public:
+    /**
+     * @brief Constructs an empty storage
+     */
+    CPixelStorage() = default;
+
+    /** @name Factories */
+    ///@{
+    /**
+     * @brief Takes ownership of a vector of bytes
+     * @param bytes Pixel bytes to move into the storage
+     * @return Storage owning the vector
+     */
+    static CPixelStorage fromVector(std::vector<uint8_t> &&bytes);
+
+    /**
+     * @brief References a buffer kept alive by an external owner
+     * @param data First pixel byte
+     * @param size Number of bytes
+     * @param owner Object whose lifetime guarantees @p data stays valid
+     * @return Storage sharing ownership of @p owner
+     */
+    static CPixelStorage adopt(const uint8_t *data, size_t size,
+                               std::shared_ptr<const void> owner);
+    ///@}
+
+    /** @name Access */
+    ///@{
+    const uint8_t *data() const;
+    size_t size() const;
+    bool empty() const;
+    ///@}
+
+    /**
+     * @brief Drops this reference to the buffer
+     */
+    void reset();
+
+  private:
+    std::shared_ptr<const void> m_owner; /**< Keeps the buffer alive */
+    const uint8_t *m_data = nullptr;     /**< First pixel byte */
+    size_t m_size = 0;                   /**< Buffer size in bytes */
+};
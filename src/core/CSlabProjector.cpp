@@ -0,0 +1,254 @@
+/**
+ * @file CSlabProjector.cpp
+ * @brief Implementation of the CSlabProjector class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CSlabProjector.h"
+
+#include "CDicomImage.h"
+#include "utils/CProjectionKernel.h"
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+constexpr size_t kBandPixels = 16 * 1024; /**< Pixels per parallel band (state stays in L2) */
+
+CProjectionKernel::EExtremum extremumFor(DicomViewer::EProjectionMode mode)
+{
+    return mode == DicomViewer::EProjectionMode::Minimum ? CProjectionKernel::EExtremum::Minimum
+                                                         : CProjectionKernel::EExtremum::Maximum;
+}
+} // namespace
+
+/**
+ * @brief Constructor
+ * @param volume Volume to project
+ */
+CSlabProjector::CSlabProjector(std::shared_ptr<const CVolume> volume)
+    : m_volume(std::move(volume))
+{
+}
+
+const std::shared_ptr<const CVolume> &CSlabProjector::volume() const
+{
+    return m_volume;
+}
+
+/**
+ * @brief Projects slices [first, first + count) of the volume
+ * @param mode Projection to compute
+ * @param first First slice of the slab
+ * @param count Slab thickness in slices
+ * @return 16-bit image, nullptr for EProjectionMode::Off or an empty slab
+ */
+std::shared_ptr<CDicomImage> CSlabProjector::project(DicomViewer::EProjectionMode mode,
+                                                     uint32_t first, uint32_t count)
+{
+    if (mode == DicomViewer::EProjectionMode::Off || !m_volume || count == 0 ||
+        first >= m_volume->depth())
+    {
+        return nullptr;
+    }
+    count = std::min(count, m_volume->depth() - first);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t width = m_volume->width();
+    const size_t pixels = width * m_volume->height();
+    const bool average = mode == DicomViewer::EProjectionMode::Average;
+    const uint32_t distance = first > m_first ? first - m_first : m_first - first;
+    // Each slide step reads three slices; past half a slab a rebuild is cheaper
+    const bool incremental = m_mode == mode && m_count == count && distance * 2 < count;
+    const uint32_t from = m_first;
+
+    // Partially updated state must not be slid from next time; every
+    // buffer is allocated here, so the bands below cannot throw
+    m_mode = DicomViewer::EProjectionMode::Off;
+    if (average)
+    {
+        m_extremes = {};
+        m_sums.resize(pixels);
+    }
+    else
+    {
+        m_sums = {};
+        m_extremes.resize(pixels);
+        if (incremental && from != first)
+        {
+            m_stale.resize(pixels);
+            m_gathered.resize(pixels);
+            m_recomputed.resize(pixels);
+        }
+    }
+    std::vector<uint8_t> bytes(pixels * sizeof(uint16_t));
+    m_mode = mode;
+    m_first = first;
+    m_count = count;
+
+    auto *output = reinterpret_cast<uint16_t *>(bytes.data());
+    const bool isSigned = m_volume->isSigned();
+    try
+    {
+        CThreadPool::shared().parallelFor(
+            m_volume->height(), std::max<size_t>(1, kBandPixels / std::max<size_t>(width, 1)),
+            [&](size_t rowBegin, size_t rowEnd)
+            {
+                const size_t begin = rowBegin * width;
+                const size_t end = rowEnd * width;
+                if (!incremental)
+                {
+                    reduceSlab(begin, end);
+                }
+                else if (from != first)
+                {
+                    slideSlab(from, begin, end);
+                }
+
+                if (average)
+                {
+                    CProjectionKernel::average(m_sums.data() + begin, count, isSigned, end - begin,
+                                               output + begin);
+                }
+                else
+                {
+                    std::memcpy(output + begin, m_extremes.data() + begin,
+                                (end - begin) * sizeof(uint16_t));
+                }
+            });
+    }
+    catch (...)
+    {
+        m_mode = DicomViewer::EProjectionMode::Off;
+        throw;
+    }
+
+    DicomViewer::SImageDimensions dims;
+    dims.width = m_volume->width();
+    dims.height = m_volume->height();
+    dims.bitsAllocated = 16;
+    dims.bitsStored = 16;
+    dims.highBit = 15;
+    dims.samplesPerPixel = 1;
+    dims.isSigned = isSigned;
+
+    auto image = std::make_shared<CDicomImage>();
+    image->setDimensions(dims);
+    image->setPhotometricInterpretation(m_volume->photometricInterpretation());
+    if (const CDicomMetadata *metadata = m_volume->sliceMetadata(first + count / 2))
+    {
+        image->setMetadata(std::make_unique<CDicomMetadata>(*metadata));
+    }
+    image->setBitsPerSample(16);
+    image->setPixelSigned(isSigned);
+    image->setValueRange(m_volume->valueRange());
+    image->setDefaultWindowLevel(m_volume->defaultWindowLevel());
+    image->setPixelData(std::move(bytes));
+    return image;
+}
+
+/**
+ * @brief Rebuilds the state of pixels [begin, end) from scratch
+ * @param begin First pixel
+ * @param end One past the last pixel
+ */
+void CSlabProjector::reduceSlab(size_t begin, size_t end)
+{
+    const size_t count = end - begin;
+    const bool isSigned = m_volume->isSigned();
+    const uint32_t last = m_first + m_count;
+    if (m_mode == DicomViewer::EProjectionMode::Average)
+    {
+        int32_t *sums = m_sums.data() + begin;
+        std::fill(sums, sums + count, 0);
+        for (uint32_t z = m_first; z < last; ++z)
+        {
+            CProjectionKernel::accumulate(m_volume->sliceData(z) + begin, isSigned, count, false,
+                                          sums);
+        }
+        return;
+    }
+
+    const auto extremum = extremumFor(m_mode);
+    uint16_t *extremes = m_extremes.data() + begin;
+    std::memcpy(extremes, m_volume->sliceData(m_first) + begin, count * sizeof(uint16_t));
+    for (uint32_t z = m_first + 1; z < last; ++z)
+    {
+        CProjectionKernel::reduce(extremum, m_volume->sliceData(z) + begin, isSigned, count,
+                                  extremes);
+    }
+}
+
+/**
+ * @brief Moves the state of pixels [begin, end) from @p from to m_first
+ *
+ * The slab moves one slice per step. Extremum pixels left stale by a
+ * step are gathered into a compact run and reduced over the new slab
+ * with the same kernel, then scattered back.
+ *
+ * @param from First slice of the slab the state was computed for
+ * @param begin First pixel
+ * @param end One past the last pixel
+ */
+void CSlabProjector::slideSlab(uint32_t from, size_t begin, size_t end)
+{
+    const size_t count = end - begin;
+    const bool isSigned = m_volume->isSigned();
+    const bool forward = m_first > from;
+    const auto sliceAt = [this, begin](uint32_t z) { return m_volume->sliceData(z) + begin; };
+
+    if (m_mode == DicomViewer::EProjectionMode::Average)
+    {
+        int32_t *sums = m_sums.data() + begin;
+        for (uint32_t slab = from; slab != m_first; forward ? ++slab : --slab)
+        {
+            const uint32_t entering = forward ? slab + m_count : slab - 1;
+            const uint32_t leaving = forward ? slab : slab + m_count - 1;
+            CProjectionKernel::accumulate(sliceAt(entering), isSigned, count, false, sums);
+            CProjectionKernel::accumulate(sliceAt(leaving), isSigned, count, true, sums);
+        }
+        return;
+    }
+
+    const auto extremum = extremumFor(m_mode);
+    uint16_t *extremes = m_extremes.data() + begin;
+    // Scratch sized by project(); bands use disjoint ranges of it
+    uint32_t *stale = m_stale.data() + begin;
+    uint16_t *gathered = m_gathered.data() + begin;
+    uint16_t *recomputed = m_recomputed.data() + begin;
+    for (uint32_t slab = from; slab != m_first; forward ? ++slab : --slab)
+    {
+        const uint32_t entering = forward ? slab + m_count : slab - 1;
+        const uint32_t leaving = forward ? slab : slab + m_count - 1;
+        const size_t staleCount = CProjectionKernel::slide(
+            extremum, sliceAt(entering), sliceAt(leaving), isSigned, count, extremes, stale);
+        if (staleCount == 0)
+        {
+            continue;
+        }
+
+        const uint32_t first = forward ? slab + 1 : slab - 1;
+        const uint16_t *firstSlice = sliceAt(first);
+        for (size_t i = 0; i < staleCount; ++i)
+        {
+            recomputed[i] = firstSlice[stale[i]];
+        }
+        for (uint32_t z = first + 1; z < first + m_count; ++z)
+        {
+            const uint16_t *slice = sliceAt(z);
+            for (size_t i = 0; i < staleCount; ++i)
+            {
+                gathered[i] = slice[stale[i]];
+            }
+            CProjectionKernel::reduce(extremum, gathered, isSigned, staleCount, recomputed);
+        }
+        for (size_t i = 0; i < staleCount; ++i)
+        {
+            extremes[stale[i]] = recomputed[i];
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file CStringPool.cpp
+ * @brief Implementation of the CStringPool class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CStringPool.h"
+
+#include <algorithm>
+
+CStringPool &CStringPool::shared()
+{
+    static CStringPool pool;
+    return pool;
+}
+
+/**
+ * @brief Returns the pooled copy of a string
+ * @param value String to intern
+ * @return Handle to the pooled copy, nullptr for an empty string
+ */
+CStringPool::Handle CStringPool::intern(std::string_view value)
+{
+    if (value.empty())
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_strings.find(value); it != m_strings.end())
+    {
+        return it->second;
+    }
+
+    if (m_strings.size() >= m_sweepSize)
+    {
+        sweep();
+    }
+    auto handle = std::make_shared<const std::string>(value);
+    m_strings.emplace(std::string_view(*handle), handle);
+    return handle;
+}
+
+size_t CStringPool::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strings.size();
+}
+
+/**
+ * @brief Drops strings only the pool refers to
+ *
+ * Called with the mutex held. A use count of one cannot rise behind
+ * our back: new handles to a pooled string only come from intern().
+ */
+void CStringPool::sweep()
+{
+    for (auto it = m_strings.begin(); it != m_strings.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            it = m_strings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    m_sweepSize = std::max(kMinSweepSize, m_strings.size() * 2);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file CStringPool.h
+ * @brief Shared string interning pool class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CStringPool class which hands out one shared, immutable
+ * copy of each distinct string, so header values repeated across the
+ * images of a study (patient name, study date, modality, series UID)
+ * are stored once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @class CStringPool
+ * @brief Thread-safe pool of reference-counted interned strings
+ *
+ * intern() returns a handle to the pooled copy of a value, creating it
+ * on first use. A string lives as long as a handle to it exists; the
+ * pool drops strings nobody refers to any more whenever it has doubled
+ * in size since the last sweep, so values of closed studies do not
+ * accumulate.
+ */
+class CStringPool
+{
+  public:
+    using Handle = std::shared_ptr<const std::string>;
+
+    static constexpr size_t kMinSweepSize = 1024;
+
+    CStringPool() = default;
+
+    CStringPool(const CStringPool &) = delete;
+    CStringPool &operator=(const CStringPool &) = delete;
+
+    /**
+     * @brief Pool shared by all loaded images
+     * @return Process-wide pool
+     */
+    static CStringPool &shared();
+
+    /**
+     * @brief Returns the pooled copy of a string
+     * @param value String to intern
+     * @return Handle to the pooled copy, nullptr for an empty string
+     */
+    Handle intern(std::string_view value);
+
+    /**
+     * @brief Number of pooled strings, including ones about to be swept
+     * @return Pool size
+     */
+    size_t size() const;
+
+  private:
+    void sweep();
+
+    mutable std::mutex m_mutex;
+    /** Keys view the strings owned by the handles */
+    std::unordered_map<std::string_view, Handle> m_strings;
+    size_t m_sweepSize = kMinSweepSize;
+};
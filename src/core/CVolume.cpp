@@ -0,0 +1,485 @@
+/**
+ * @file CVolume.cpp
+ * @brief Implementation of the CVolume class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CVolume.h"
+
+#include "CDicomImage.h"
+#include "utils/CThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <new>
+#include <string>
+#include <tuple>
+
+namespace
+{
+constexpr size_t kVoxelsPerAlignment = CVolume::kAlignment / sizeof(uint16_t);
+constexpr double kPositionTolerance = 1e-3; /**< mm; closer slices count as coincident */
+constexpr double kSpacingTolerance = 0.2;   /**< Largest gap deviation from the mean, relative */
+
+CVolume::Vector3 cross(const CVolume::Vector3 &a, const CVolume::Vector3 &b)
+{
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+double dot(const CVolume::Vector3 &a, const CVolume::Vector3 &b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * @brief Row and column direction of a slice, identity if absent or degenerate
+ */
+void orientationOf(const CDicomMetadata *metadata, CVolume::Vector3 &row, CVolume::Vector3 &column)
+{
+    row = {1.0, 0.0, 0.0};
+    column = {0.0, 1.0, 0.0};
+    const auto orientation = metadata ? metadata->imageOrientationPatient() : std::nullopt;
+    if (!orientation)
+    {
+        return;
+    }
+    const std::array<double, 6> &cosines = *orientation;
+    const CVolume::Vector3 parsedRow{cosines[0], cosines[1], cosines[2]};
+    const CVolume::Vector3 parsedColumn{cosines[3], cosines[4], cosines[5]};
+    const double rowLength = std::sqrt(dot(parsedRow, parsedRow));
+    const double columnLength = std::sqrt(dot(parsedColumn, parsedColumn));
+    if (rowLength < 1e-6 || columnLength < 1e-6)
+    {
+        return;
+    }
+    for (size_t i = 0; i < 3; ++i)
+    {
+        row[i] = parsedRow[i] / rowLength;
+        column[i] = parsedColumn[i] / columnLength;
+    }
+}
+
+/**
+ * @brief Whether sorted slice positions form one evenly spaced stack
+ *
+ * Coincident neighbours mean interleaved stacks (multi-echo MR, DWI
+ * b-values, repeated acquisitions) sharing one series; uneven gaps mean
+ * missing or irregular slices. Neither can be resampled with a single
+ * slice spacing.
+ */
+bool isEvenlySpaced(const std::vector<double> &positions)
+{
+    if (positions.size() < 2)
+    {
+        return true;
+    }
+    const double mean =
+        (positions.back() - positions.front()) / static_cast<double>(positions.size() - 1);
+    for (size_t i = 1; i < positions.size(); ++i)
+    {
+        const double gap = positions[i] - positions[i - 1];
+        if (gap <= kPositionTolerance || std::abs(gap - mean) > mean * kSpacingTolerance)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Widens one slice to 16 bits and tracks its value range
+ * @return Smallest and largest sample copied
+ */
+template <typename T>
+DicomViewer::SValueRange copySlice(const uint8_t *source, size_t count, uint16_t *target)
+{
+    const T *samples = reinterpret_cast<const T *>(source);
+    int32_t minValue = std::numeric_limits<int32_t>::max();
+    int32_t maxValue = std::numeric_limits<int32_t>::min();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int32_t value = samples[i];
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        // Same bit pattern as the value in int16_t or uint16_t, whichever
+        // the volume ends up using; assemble() rejects ranges neither fits
+        target[i] = static_cast<uint16_t>(value);
+    }
+    return {minValue, maxValue};
+}
+} // namespace
+
+/**
+ * @brief Groups single-frame grayscale images into volume candidates
+ * @param images Images to group (null entries are skipped)
+ * @return Indices into @p images, one sorted list per group of at least kMinSlices
+ */
+std::vector<std::vector<size_t>> CVolume::groupBySeries(
+    const std::vector<std::shared_ptr<const CDicomImage>> &images)
+{
+    using Key = std::tuple<std::string, uint32_t, uint32_t, std::array<double, 6>>;
+    std::map<Key, std::vector<std::pair<double, size_t>>> groups;
+
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const auto &image = images[i];
+        if (!image || !image->metadata() || image->frameCount() != 1)
+        {
+            continue;
+        }
+        const auto pi = image->photometricInterpretation();
+        const auto dims = image->dimensions();
+        if ((pi != DicomViewer::EPhotometricInterpretation::Monochrome1 &&
+             pi != DicomViewer::EPhotometricInterpretation::Monochrome2) ||
+            dims.samplesPerPixel != 1 || dims.width == 0 || dims.height == 0)
+        {
+            continue;
+        }
+
+        const CDicomMetadata &metadata = *image->metadata();
+        const std::string &uid = metadata.seriesInstanceUid();
+        const auto position = metadata.imagePositionPatient();
+        if (uid.empty() || !position)
+        {
+            continue;
+        }
+
+        Vector3 row;
+        Vector3 column;
+        orientationOf(&metadata, row, column);
+        const Key key{uid, dims.width, dims.height,
+                      metadata.imageOrientationPatient().value_or(std::array<double, 6>{})};
+        groups[key].emplace_back(dot(*position, cross(row, column)), i);
+    }
+
+    std::vector<std::vector<size_t>> result;
+    for (auto &entry : groups)
+    {
+        auto &slices = entry.second;
+        if (slices.size() < kMinSlices)
+        {
+            continue;
+        }
+        std::stable_sort(slices.begin(), slices.end(),
+                         [](const auto &a, const auto &b)
+                         { return a.first < b.first; });
+        std::vector<double> positions;
+        std::vector<size_t> indices;
+        positions.reserve(slices.size());
+        indices.reserve(slices.size());
+        for (const auto &slice : slices)
+        {
+            positions.push_back(slice.first);
+            indices.push_back(slice.second);
+        }
+        if (!isEvenlySpaced(positions))
+        {
+            continue;
+        }
+        result.push_back(std::move(indices));
+    }
+    return result;
+}
+
+/**
+ * @brief Decodes and packs slices into a new volume
+ * @param slices Slices in stacking order (see groupBySeries())
+ * @return Volume, nullptr if the slices differ in size or format,
+ *         fail to decode, do not fit 16 bits or are not evenly spaced
+ */
+std::shared_ptr<const CVolume> CVolume::assemble(
+    const std::vector<std::shared_ptr<CDicomImage>> &slices)
+{
+    if (slices.size() < kMinSlices || !slices.front())
+    {
+        return nullptr;
+    }
+    const auto dims = slices.front()->dimensions();
+    for (const auto &slice : slices)
+    {
+        if (!slice || slice->frameCount() != 1)
+        {
+            return nullptr;
+        }
+        const auto sliceDims = slice->dimensions();
+        if (sliceDims.width != dims.width || sliceDims.height != dims.height ||
+            sliceDims.samplesPerPixel != 1 || dims.width == 0 || dims.height == 0)
+        {
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<CVolume> volume(new CVolume());
+    volume->m_width = dims.width;
+    volume->m_height = dims.height;
+    volume->m_depth = static_cast<uint32_t>(slices.size());
+    const size_t sliceVoxels = static_cast<size_t>(dims.width) * dims.height;
+    volume->m_sliceStride = (sliceVoxels + kVoxelsPerAlignment - 1) / kVoxelsPerAlignment *
+                            kVoxelsPerAlignment;
+
+    const size_t bytes = volume->m_sliceStride * volume->m_depth * sizeof(uint16_t);
+    auto *voxels = static_cast<uint16_t *>(::operator new(bytes, std::align_val_t(kAlignment)));
+    volume->m_voxels.reset(voxels, [](uint16_t *memory)
+                           { ::operator delete(memory, std::align_val_t(kAlignment)); });
+
+    volume->m_slices.resize(slices.size());
+    std::atomic<bool> failed{false};
+    CThreadPool::shared().parallelFor(
+        slices.size(), 1,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t z = begin; z < end && !failed.load(std::memory_order_relaxed); ++z)
+            {
+                CDicomImage &source = *slices[z];
+                const bool wasResident = source.isPixelDataResident();
+                const CPixelStorage pixels = source.pixelData();
+                const bool is16bit = source.bitsPerSample() == 16;
+                if (pixels.size() < sliceVoxels * (is16bit ? 2 : 1))
+                {
+                    failed = true;
+                    break;
+                }
+
+                uint16_t *target = voxels + z * volume->m_sliceStride;
+                SSliceInfo &info = volume->m_slices[z];
+                if (is16bit)
+                {
+                    info.valueRange = source.isPixelSigned()
+                                          ? copySlice<int16_t>(pixels.data(), sliceVoxels, target)
+                                          : copySlice<uint16_t>(pixels.data(), sliceVoxels, target);
+                }
+                else
+                {
+                    info.valueRange = source.isPixelSigned()
+                                          ? copySlice<int8_t>(pixels.data(), sliceVoxels, target)
+                                          : copySlice<uint8_t>(pixels.data(), sliceVoxels, target);
+                }
+                std::fill(target + sliceVoxels, target + volume->m_sliceStride, uint16_t{0});
+
+                info.defaultWindowLevel = source.defaultWindowLevel();
+                if (!wasResident)
+                {
+                    // The volume holds these samples now; the slice can decode again if asked
+                    source.releasePixelData();
+                }
+            }
+        });
+    if (failed)
+    {
+        return nullptr;
+    }
+
+    DicomViewer::SValueRange range{std::numeric_limits<int32_t>::max(),
+                                   std::numeric_limits<int32_t>::min()};
+    for (const auto &info : volume->m_slices)
+    {
+        range.min = std::min(range.min, info.valueRange.min);
+        range.max = std::max(range.max, info.valueRange.max);
+    }
+    if (range.min < 0 && range.max > std::numeric_limits<int16_t>::max())
+    {
+        return nullptr;
+    }
+    volume->m_signed = range.min < 0;
+    volume->m_valueRange = range;
+    volume->m_defaultWindowLevel = volume->m_slices[volume->m_slices.size() / 2].defaultWindowLevel;
+
+    // Header fields and geometry
+    const CDicomMetadata *firstMetadata = slices.front()->metadata();
+    orientationOf(firstMetadata, volume->m_rowDirection, volume->m_columnDirection);
+    volume->m_sliceDirection = cross(volume->m_rowDirection, volume->m_columnDirection);
+    for (size_t z = 0; z < slices.size(); ++z)
+    {
+        const CDicomImage &source = *slices[z];
+        SSliceInfo &info = volume->m_slices[z];
+        if (const CDicomMetadata *metadata = source.metadata())
+        {
+            info.metadata = *metadata;
+            if (const auto position = metadata->imagePositionPatient())
+            {
+                info.position = dot(*position, volume->m_sliceDirection);
+                if (z == 0)
+                {
+                    volume->m_origin = *position;
+                }
+            }
+        }
+        info.photometric = source.photometricInterpretation();
+        info.rescaleSlope = source.rescaleSlope();
+        info.rescaleIntercept = source.rescaleIntercept();
+    }
+
+    const auto pixelSpacing = firstMetadata ? firstMetadata->pixelSpacing() : std::nullopt;
+    if (pixelSpacing && (*pixelSpacing)[0] > 0.0 && (*pixelSpacing)[1] > 0.0)
+    {
+        // Pixel Spacing is (between rows, between columns)
+        volume->m_spacing[0] = (*pixelSpacing)[1];
+        volume->m_spacing[1] = (*pixelSpacing)[0];
+    }
+    std::vector<double> positions;
+    positions.reserve(volume->m_slices.size());
+    for (const auto &info : volume->m_slices)
+    {
+        positions.push_back(info.position);
+    }
+    if (!isEvenlySpaced(positions))
+    {
+        return nullptr;
+    }
+    const double extent = positions.back() - positions.front();
+    volume->m_spacing[2] = extent / static_cast<double>(volume->m_depth - 1);
+    return volume;
+}
+
+uint32_t CVolume::width() const
+{
+    return m_width;
+}
+
+uint32_t CVolume::height() const
+{
+    return m_height;
+}
+
+uint32_t CVolume::depth() const
+{
+    return m_depth;
+}
+
+bool CVolume::isSigned() const
+{
+    return m_signed;
+}
+
+size_t CVolume::sliceStride() const
+{
+    return m_sliceStride;
+}
+
+/**
+ * @brief First voxel of a slice
+ * @param z Slice index, 0 <= z < depth()
+ * @return Pointer to width() * height() row-major samples
+ */
+const uint16_t *CVolume::sliceData(uint32_t z) const
+{
+    return m_voxels.get() + static_cast<size_t>(z) * m_sliceStride;
+}
+
+size_t CVolume::byteSize() const
+{
+    return m_sliceStride * m_depth * sizeof(uint16_t);
+}
+
+/**
+ * @brief Size of the voxel buffer a volume of these dimensions needs
+ * @param width Columns per slice
+ * @param height Rows per slice
+ * @param depth Number of slices
+ * @return Bytes assemble() would allocate
+ */
+size_t CVolume::byteSizeFor(uint32_t width, uint32_t height, uint32_t depth)
+{
+    const size_t sliceVoxels = static_cast<size_t>(width) * height;
+    const size_t stride = (sliceVoxels + kVoxelsPerAlignment - 1) / kVoxelsPerAlignment *
+                          kVoxelsPerAlignment;
+    return stride * depth * sizeof(uint16_t);
+}
+
+DicomViewer::SValueRange CVolume::valueRange() const
+{
+    return m_valueRange;
+}
+
+DicomViewer::SWindowLevel CVolume::defaultWindowLevel() const
+{
+    return m_defaultWindowLevel;
+}
+
+DicomViewer::EPhotometricInterpretation CVolume::photometricInterpretation() const
+{
+    return m_slices.empty() ? DicomViewer::EPhotometricInterpretation::Monochrome2
+                            : m_slices.front().photometric;
+}
+
+CVolume::Vector3 CVolume::origin() const
+{
+    return m_origin;
+}
+
+CVolume::Vector3 CVolume::rowDirection() const
+{
+    return m_rowDirection;
+}
+
+CVolume::Vector3 CVolume::columnDirection() const
+{
+    return m_columnDirection;
+}
+
+CVolume::Vector3 CVolume::sliceDirection() const
+{
+    return m_sliceDirection;
+}
+
+CVolume::Vector3 CVolume::spacing() const
+{
+    return m_spacing;
+}
+
+double CVolume::slicePosition(uint32_t z) const
+{
+    return z < m_depth ? m_slices[z].position : 0.0;
+}
+
+/**
+ * @brief Creates an image viewing one slice of the buffer
+ * @param z Slice index
+ * @return Slice image, nullptr if @p z is out of range
+ */
+std::shared_ptr<CDicomImage> CVolume::slice(uint32_t z) const
+{
+    if (z >= m_depth)
+    {
+        return nullptr;
+    }
+    const SSliceInfo &info = m_slices[z];
+
+    DicomViewer::SImageDimensions dims;
+    dims.width = m_width;
+    dims.height = m_height;
+    dims.bitsAllocated = 16;
+    dims.bitsStored = 16;
+    dims.highBit = 15;
+    dims.samplesPerPixel = 1;
+    dims.isSigned = m_signed;
+
+    auto image = std::make_shared<CDicomImage>();
+    image->setDimensions(dims);
+    image->setPhotometricInterpretation(info.photometric);
+    image->setRescaleSlope(info.rescaleSlope);
+    image->setRescaleIntercept(info.rescaleIntercept);
+    image->setMetadata(std::make_unique<CDicomMetadata>(info.metadata));
+    image->setBitsPerSample(16);
+    image->setPixelSigned(m_signed);
+    image->setValueRange(info.valueRange);
+    image->setDefaultWindowLevel(info.defaultWindowLevel);
+    image->setPixelData(CPixelStorage::adopt(reinterpret_cast<const uint8_t *>(sliceData(z)),
+                                             static_cast<size_t>(m_width) * m_height * sizeof(uint16_t),
+                                             m_voxels));
+    return image;
+}
+
+/**
+ * @brief Header tags of one slice
+ * @param z Slice index
+ * @return Metadata, nullptr if @p z is out of range
+ */
+const CDicomMetadata *CVolume::sliceMetadata(uint32_t z) const
+{
+    return z < m_depth ? &m_slices[z].metadata : nullptr;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file CVolume.h
+ * @brief Contiguous 3D voxel volume class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CVolume class which packs the slices of a CT/MR series
+ * into one contiguous, cache-aligned 16-bit voxel buffer, sorted along
+ * the slice normal, together with the patient-space geometry needed
+ * to resample it (MPR, projections).
+ */
+
+#pragma once
+
+#include "CDicomMetadata.h"
+#include "DicomViewer/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class CDicomImage;
+
+/**
+ * @class CVolume
+ * @brief Slices of one series stacked into a single voxel buffer
+ *
+ * Voxels are stored slice after slice, row-major within a slice, as
+ * 16-bit samples: signed when any value is negative, unsigned
+ * otherwise. Samples are the decoded, modality-transformed values
+ * (DCMTK applies rescale slope/intercept while decoding), so rescale
+ * has been applied exactly once and voxels read as Hounsfield units
+ * for CT. Every slice starts on a kAlignment-byte boundary, so a slice
+ * is a constant pointer offset away from the first one.
+ *
+ * slice() hands out a slice as a CDicomImage whose pixels point into
+ * the buffer, so the converter, renderers and viewer can display it
+ * without a copy. The buffer stays alive as long as the volume or any
+ * slice image does.
+ *
+ * Immutable after assemble(); safe to read from any thread.
+ */
+class CVolume
+{
+  public:
+    using Vector3 = std::array<double, 3>;
+
+    static constexpr size_t kAlignment = 64;   /**< Byte alignment of every slice */
+    static constexpr uint32_t kMinSlices = 2;  /**< Fewest slices that form a volume */
+
+    /** @name Assembly */
+    ///@{
+    /**
+     * @brief Groups single-frame grayscale images into volume candidates
+     *
+     * Images are grouped by Series Instance UID, dimensions and
+     * orientation; each group is sorted by Image Position Patient
+     * projected on the slice normal. Images without a series UID or
+     * position, colour and multi-frame images are left out, and so are
+     * groups whose slices coincide (multi-echo, DWI) or are not evenly
+     * spaced.
+     *
+     * @param images Images to group (null entries are skipped)
+     * @return Indices into @p images, one sorted list per group of at least kMinSlices
+     */
+    static std::vector<std::vector<size_t>> groupBySeries(
+        const std::vector<std::shared_ptr<const CDicomImage>> &images);
+
+    /**
+     * @brief Decodes and packs slices into a new volume
+     *
+     * Slices are decoded and copied in parallel on CThreadPool::shared().
+     * Slices that were not resident before are released again once
+     * copied, so assembly holds one volume plus the slices in flight.
+     *
+     * @param slices Slices in stacking order (see groupBySeries())
+     * @return Volume, nullptr if the slices differ in size or format,
+     *         fail to decode, do not fit 16 bits or are not evenly spaced
+     */
+    static std::shared_ptr<const CVolume> assemble(
+        const std::vector<std::shared_ptr<CDicomImage>> &slices);
+    ///@}
+
+    /** @name Layout */
+    ///@{
+    uint32_t width() const;
+    uint32_t height() const;
+    uint32_t depth() const;
+
+    /**
+     * @brief Checks whether voxels are int16_t rather than uint16_t
+     * @return True if samples are signed
+     */
+    bool isSigned() const;
+
+    /**
+     * @brief Distance between the first voxels of consecutive slices
+     * @return Stride in voxels (width * height rounded up to the alignment)
+     */
+    size_t sliceStride() const;
+
+    /**
+     * @brief First voxel of a slice
+     *
+     * Reinterpret as int16_t when isSigned() is true.
+     *
+     * @param z Slice index, 0 <= z < depth()
+     * @return Pointer to width() * height() row-major samples
+     */
+    const uint16_t *sliceData(uint32_t z) const;
+
+    /**
+     * @brief Size of the voxel buffer
+     * @return Bytes allocated, padding included
+     */
+    size_t byteSize() const;
+
+    /**
+     * @brief Size of the voxel buffer a volume of these dimensions needs
+     * @param width Columns per slice
+     * @param height Rows per slice
+     * @param depth Number of slices
+     * @return Bytes assemble() would allocate
+     */
+    static size_t byteSizeFor(uint32_t width, uint32_t height, uint32_t depth);
+    ///@}
+
+    /** @name Values */
+    ///@{
+    /**
+     * @brief Smallest and largest voxel value
+     * @return Range over all slices
+     */
+    DicomViewer::SValueRange valueRange() const;
+
+    /**
+     * @brief Window/level recorded in the header of the middle slice
+     * @return Default window/level
+     */
+    DicomViewer::SWindowLevel defaultWindowLevel() const;
+
+    /**
+     * @brief Photometric interpretation of the first slice
+     * @return Monochrome1 or Monochrome2
+     */
+    DicomViewer::EPhotometricInterpretation photometricInterpretation() const;
+    ///@}
+
+    /** @name Geometry (patient coordinates, mm) */
+    ///@{
+    /**
+     * @brief Position of the first voxel of slice 0
+     * @return Image Position Patient of the first slice
+     */
+    Vector3 origin() const;
+
+    /**
+     * @brief Unit vectors along rows (+x), columns (+y) and slices (+z)
+     */
+    Vector3 rowDirection() const;
+    Vector3 columnDirection() const;
+    Vector3 sliceDirection() const;
+
+    /**
+     * @brief Voxel size along x, y and z
+     * @return Column spacing, row spacing and mean slice spacing
+     */
+    Vector3 spacing() const;
+
+    /**
+     * @brief Position of a slice along sliceDirection()
+     * @param z Slice index
+     * @return Signed distance from the patient origin
+     */
+    double slicePosition(uint32_t z) const;
+    ///@}
+
+    /** @name Slice Images */
+    ///@{
+    /**
+     * @brief Creates an image viewing one slice of the buffer
+     *
+     * The image carries the slice's own metadata, photometric
+     * interpretation, value range and default window/level. Its pixels
+     * are never copied or released.
+     *
+     * @param z Slice index
+     * @return Slice image, nullptr if @p z is out of range
+     */
+    std::shared_ptr<CDicomImage> slice(uint32_t z) const;
+
+    /**
+     * @brief Header tags of one slice
+     * @param z Slice index
+     * @return Metadata, nullptr if @p z is out of range
+     */
+    const CDicomMetadata *sliceMetadata(uint32_t z) const;
+    ///@}
+
+  private:
+    /**
+     * @brief Per-slice header fields kept for slice()
+     */
+    struct SSliceInfo
+    {
+        CDicomMetadata metadata;
+        DicomViewer::EPhotometricInterpretation photometric =
+            DicomViewer::EPhotometricInterpretation::Monochrome2;
+        DicomViewer::SWindowLevel defaultWindowLevel;
+        DicomViewer::SValueRange valueRange;
+        double rescaleSlope = 1.0;
+        double rescaleIntercept = 0.0;
+        double position = 0.0;
+    };
+
+    CVolume() = default;
+
+    std::shared_ptr<uint16_t> m_voxels; /**< kAlignment-aligned voxel buffer */
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_depth = 0;
+    size_t m_sliceStride = 0;
+    bool m_signed = false;
+    DicomViewer::SValueRange m_valueRange;
+    DicomViewer::SWindowLevel m_defaultWindowLevel;
+
+    Vector3 m_origin{0.0, 0.0, 0.0};
+    Vector3 m_rowDirection{1.0, 0.0, 0.0};
+    Vector3 m_columnDirection{0.0, 1.0, 0.0};
+    Vector3 m_sliceDirection{0.0, 0.0, 1.0};
+    Vector3 m_spacing{1.0, 1.0, 1.0};
+
+    std::vector<SSliceInfo> m_slices;
+};
@@ -0,0 +1,244 @@
+/**
+ * @file DicomFolderIndexer.cpp
+ * @brief Implementation of DicomFolderIndexer
+ * @date 2026
+ */
+
+#include "DicomFolderIndexer.h"
+
+#include "core/CDicomLoader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr size_t kHeaderGrain = 16;       /**< Files per parallelFor chunk */
+constexpr size_t kProgressInterval = 128; /**< Files between progress reports */
+
+/**
+ * @brief A file found by the folder walk
+ */
+struct SFoundFile
+{
+    std::string path;
+    int64_t modifiedTime = 0;
+    uint64_t size = 0;
+};
+
+bool isDicomDir(const std::filesystem::path &path)
+{
+    std::string name = path.filename().string();
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c)
+                   { return static_cast<char>(std::toupper(c)); });
+    return name == "DICOMDIR";
+}
+} // namespace
+
+DicomFolderIndexer::DicomFolderIndexer(std::string catalogDirectory, size_t threadCount)
+    : m_catalogDirectory(std::move(catalogDirectory)),
+      m_pool(threadCount)
+{
+}
+
+DicomFolderIndexer::~DicomFolderIndexer()
+{
+    cancel();
+}
+
+void DicomFolderIndexer::index(const std::string &folderPath,
+                               ProgressCallback onProgress,
+                               CatalogCallback onCatalog)
+{
+    cancel();
+    m_cancelled = false;
+    m_worker = std::thread(
+        [this, folderPath, onProgress = std::move(onProgress), onCatalog = std::move(onCatalog)]()
+        { run(folderPath, onProgress, onCatalog); });
+}
+
+void DicomFolderIndexer::cancel()
+{
+    m_cancelled = true;
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+void DicomFolderIndexer::run(const std::string &folderPath,
+                             const ProgressCallback &onProgress,
+                             const CatalogCallback &onCatalog)
+{
+    namespace fs = std::filesystem;
+
+    // A DICOMDIR stands for the folder holding it
+    std::error_code error;
+    fs::path root(folderPath);
+    if (fs::is_regular_file(root, error))
+    {
+        root = root.parent_path();
+    }
+    const fs::path canonical = fs::weakly_canonical(root, error);
+    if (!error)
+    {
+        root = canonical;
+    }
+    const std::string rootPath = root.string();
+    const std::string savedPath = catalogPath(rootPath);
+
+    // The previous run's catalog shows the folder before the walk ends
+    auto previous = std::make_shared<CDicomCatalog>(rootPath);
+    if (previous->load(savedPath) && !m_cancelled && onCatalog)
+    {
+        onCatalog(previous, false);
+    }
+
+    std::vector<SFoundFile> files;
+    std::vector<std::string> dicomDirs;
+    std::error_code walkError;
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied,
+                                             walkError),
+         end;
+         !walkError && it != end; it.increment(walkError))
+    {
+        if (m_cancelled)
+        {
+            return;
+        }
+        std::error_code fileError;
+        if (!it->is_regular_file(fileError))
+        {
+            continue;
+        }
+        SFoundFile file;
+        file.size = it->file_size(fileError);
+        const auto modified = it->last_write_time(fileError);
+        if (fileError)
+        {
+            continue;
+        }
+        file.path = it->path().string();
+        file.modifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+        if (isDicomDir(it->path()))
+        {
+            dicomDirs.push_back(file.path);
+        }
+        files.push_back(std::move(file));
+    }
+
+    // Unchanged files keep their entry; the others are read below
+    std::vector<CDicomCatalog::SEntry> entries(files.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        const CDicomCatalog::SEntry *known = previous->find(files[i].path);
+        if (known && known->modifiedTime == files[i].modifiedTime &&
+            known->fileSize == files[i].size)
+        {
+            entries[i] = *known;
+            continue;
+        }
+        entries[i].filePath = std::move(files[i].path);
+        entries[i].modifiedTime = files[i].modifiedTime;
+        entries[i].fileSize = files[i].size;
+        pending.push_back(i);
+    }
+
+    // Files listed by a DICOMDIR need not be opened at all
+    if (!pending.empty() && !dicomDirs.empty())
+    {
+        CDicomLoader loader;
+        std::unordered_map<std::string, CDicomMetadata> records;
+        for (const std::string &dicomDir : dicomDirs)
+        {
+            for (auto &image : loader.loadDicomDir(dicomDir))
+            {
+                records.emplace(std::move(image.filePath), std::move(image.metadata));
+            }
+        }
+        auto unlisted = std::remove_if(pending.begin(), pending.end(),
+                                       [&entries, &records](size_t i)
+                                       {
+                                           auto it = records.find(entries[i].filePath);
+                                           if (it == records.end())
+                                           {
+                                               return false;
+                                           }
+                                           entries[i].isImage = true;
+                                           entries[i].setMetadata(it->second);
+                                           return true;
+                                       });
+        pending.erase(unlisted, pending.end());
+    }
+
+    const size_t total = pending.size();
+    std::atomic<size_t> read{0};
+    if (onProgress)
+    {
+        onProgress(0, total);
+    }
+    m_pool.parallelFor(total, kHeaderGrain,
+                       [&](size_t begin, size_t end)
+                       {
+                           CDicomLoader loader;
+                           CDicomMetadata metadata;
+                           for (size_t k = begin; k < end && !m_cancelled; ++k)
+                           {
+                               CDicomCatalog::SEntry &entry = entries[pending[k]];
+                               entry.isImage = (loader.loadHeader(entry.filePath, metadata) ==
+                                                DicomViewer::ELoadResult::Success);
+                               if (entry.isImage)
+                               {
+                                   entry.setMetadata(metadata);
+                               }
+                               const size_t done = ++read;
+                               if (onProgress && (done % kProgressInterval == 0 || done == total))
+                               {
+                                   onProgress(done, total);
+                               }
+                           }
+                       });
+    if (m_cancelled)
+    {
+        return;
+    }
+
+    auto catalog = std::make_shared<CDicomCatalog>(rootPath);
+    for (CDicomCatalog::SEntry &entry : entries)
+    {
+        catalog->add(std::move(entry));
+    }
+
+    // Nothing read and nothing removed: the saved catalog is still current
+    if (total > 0 || catalog->size() != previous->size())
+    {
+        catalog->save(savedPath);
+    }
+    if (onCatalog)
+    {
+        onCatalog(catalog, true);
+    }
+}
+
+/**
+ * @brief Catalog file of a folder: FNV-1a hash of its path
+ */
+std::string DicomFolderIndexer::catalogPath(const std::string &rootPath) const
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : rootPath)
+    {
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.catalog", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path(m_catalogDirectory) / name).string();
+}
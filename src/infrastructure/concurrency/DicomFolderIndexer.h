@@ -0,0 +1,53 @@
+/**
+ * @file DicomFolderIndexer.h
+ * @brief Parallel, incremental folder cataloger (infrastructure adapter)
+ * @date 2026
+ */
+
+#pragma once
+
+#include "application/ports/IFolderIndexer.h"
+#include "utils/CThreadPool.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Walks a folder and reads changed headers on a worker pool
+ *
+ * Each folder's catalog is saved under the catalog directory, named
+ * after a hash of the folder path, and reused by the next run: files
+ * whose path, size and modification time match keep their entry.
+ * Files referenced by a DICOMDIR take their tags from its records.
+ * The remaining files have only their headers read, in parallel.
+ *
+ * A run is coordinated by its own thread so that the pool's
+ * parallelFor() can be used from it.
+ */
+class DicomFolderIndexer final : public IFolderIndexer
+{
+  public:
+    /**
+     * @param catalogDirectory Folder for the saved catalogs
+     * @param threadCount Header readers (0 = one per hardware thread)
+     */
+    explicit DicomFolderIndexer(std::string catalogDirectory, size_t threadCount = 0);
+    ~DicomFolderIndexer() override;
+
+    void index(const std::string &folderPath,
+               ProgressCallback onProgress,
+               CatalogCallback onCatalog) override;
+    void cancel() override;
+
+  private:
+    void run(const std::string &folderPath,
+             const ProgressCallback &onProgress,
+             const CatalogCallback &onCatalog);
+    std::string catalogPath(const std::string &rootPath) const;
+
+    std::string m_catalogDirectory;
+    std::atomic<bool> m_cancelled{false};
+    std::thread m_worker;
+    CThreadPool m_pool;
+};
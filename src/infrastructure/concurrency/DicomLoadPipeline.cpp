@@ -0,0 +1,129 @@
+/**
+ * @file DicomLoadPipeline.cpp
+ * @brief Implementation of DicomLoadPipeline
+ * @date 2026
+ */
+
+#include "DicomLoadPipeline.h"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+DicomLoadPipeline::DicomLoadPipeline(LoaderFactory loaderFactory, size_t threadCount)
+    : m_loaderFactory(std::move(loaderFactory)),
+      m_pool(threadCount)
+{
+}
+
+DicomLoadPipeline::~DicomLoadPipeline()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    m_backlog.clear();
+    ++m_generation;
+}
+
+void DicomLoadPipeline::enqueue(std::vector<SDicomLoadRequest> requests,
+                                LoadCallback onLoaded)
+{
+    if (requests.empty())
+    {
+        return;
+    }
+
+    auto callback = std::make_shared<const LoadCallback>(std::move(onLoaded));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping)
+        {
+            return;
+        }
+        for (auto &request : requests)
+        {
+            m_backlog.push_back({std::move(request), callback, m_generation});
+        }
+    }
+    pump();
+}
+
+void DicomLoadPipeline::cancelAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_backlog.clear();
+    ++m_generation;
+}
+
+size_t DicomLoadPipeline::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_backlog.size() + m_inFlight;
+}
+
+void DicomLoadPipeline::pump()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_stopping && !m_backlog.empty() && m_inFlight < m_pool.maxQueueSize())
+    {
+        SJob job = m_backlog.front();
+        if (!m_pool.trySubmit([this, job]()
+                              { runJob(job); }))
+        {
+            break;
+        }
+        m_backlog.pop_front();
+        ++m_inFlight;
+    }
+}
+
+void DicomLoadPipeline::runJob(const SJob &job)
+{
+    bool cancelled = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cancelled = m_stopping || job.generation != m_generation;
+    }
+
+    if (!cancelled)
+    {
+        SDicomLoadResult result;
+        try
+        {
+            std::unique_ptr<IDicomLoader> loader = m_loaderFactory ? m_loaderFactory() : nullptr;
+            if (loader)
+            {
+                result = loader->load(job.request.filePath, job.request.policy);
+            }
+            else
+            {
+                result.errorMessage = "DICOM loader not configured.";
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // The in-flight count below must drop whatever the loader does
+            result = SDicomLoadResult{};
+            result.errorMessage = std::string("Failed to load DICOM file: ") + e.what();
+        }
+        catch (...)
+        {
+            result = SDicomLoadResult{};
+            result.errorMessage = "Failed to load DICOM file: unknown error.";
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            cancelled = m_stopping || job.generation != m_generation;
+        }
+        if (!cancelled && job.onLoaded && *job.onLoaded)
+        {
+            (*job.onLoaded)(job.request, std::move(result));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_inFlight;
+    }
+    pump();
+}
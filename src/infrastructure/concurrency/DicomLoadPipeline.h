@@ -0,0 +1,58 @@
+/**
+ * @file DicomLoadPipeline.h
+ * @brief Thread-pool backed batch DICOM loader (infrastructure adapter)
+ * @date 2026
+ */
+
+#pragma once
+
+#include "application/ports/IDicomLoadPipeline.h"
+#include "utils/CThreadPool.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Decodes queued files on a worker pool sized to the core count
+ *
+ * The pool queue is bounded; files beyond it wait in the pipeline's own
+ * backlog and are fed to the pool as workers finish, so enqueue() never
+ * blocks the caller. Each task builds its own IDicomLoader from the
+ * factory, keeping loaders free of cross-thread state.
+ */
+class DicomLoadPipeline final : public IDicomLoadPipeline
+{
+  public:
+    using LoaderFactory = std::function<std::unique_ptr<IDicomLoader>()>;
+
+    explicit DicomLoadPipeline(LoaderFactory loaderFactory, size_t threadCount = 0);
+    ~DicomLoadPipeline() override;
+
+    void enqueue(std::vector<SDicomLoadRequest> requests,
+                 LoadCallback onLoaded) override;
+    void cancelAll() override;
+    size_t pendingCount() const override;
+
+  private:
+    struct SJob
+    {
+        SDicomLoadRequest request;
+        std::shared_ptr<const LoadCallback> onLoaded;
+        uint64_t generation = 0;
+    };
+
+    void pump();
+    void runJob(const SJob &job);
+
+    LoaderFactory m_loaderFactory;
+
+    mutable std::mutex m_mutex;
+    std::deque<SJob> m_backlog;
+    size_t m_inFlight = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+
+    CThreadPool m_pool; /**< Declared last so workers join before state is destroyed */
+};
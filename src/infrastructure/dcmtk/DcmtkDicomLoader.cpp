@@ -6,10 +6,11 @@
 
 #include "DcmtkDicomLoader.h"
 
-SDicomLoadResult DcmtkDicomLoader::load(const std::string &filePath)
+SDicomLoadResult DcmtkDicomLoader::load(const std::string &filePath,
+                                        DicomViewer::EPixelLoadPolicy policy)
 {
     SDicomLoadResult result;
-    auto [image, loadResult] = m_loader.loadFile(filePath);
+    auto [image, loadResult] = m_loader.loadFile(filePath, policy);
     result.result = loadResult;
     result.errorMessage = CDicomLoader::errorMessage(loadResult);
     if (image)
@@ -12,7 +12,8 @@
 class DcmtkDicomLoader final : public IDicomLoader
 {
   public:
-    SDicomLoadResult load(const std::string &filePath) override;
+    SDicomLoadResult load(const std::string &filePath,
+                          DicomViewer::EPixelLoadPolicy policy) override;
 
   private:
     CDicomLoader m_loader;
@@ -0,0 +1,117 @@
+/**
+ * @file QtImageExporter.cpp
+ * @brief Implementation of QtImageExporter
+ * @date 2026
+ */
+
+#include "QtImageExporter.h"
+
+#include <QImage>
+#include <QPageLayout>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QString>
+
+namespace
+{
+    QImage bufferToImage(const SImageBuffer &buffer)
+    {
+        if (buffer.data.empty() || buffer.width <= 0 || buffer.height <= 0)
+        {
+            return QImage();
+        }
+
+        QImage::Format format = QImage::Format_RGB888;
+        int bytesPerPixel = 3;
+        switch (buffer.format)
+        {
+        case EPixelFormat::Grayscale8:
+            format = QImage::Format_Grayscale8;
+            bytesPerPixel = 1;
+            break;
+        case EPixelFormat::RGB24:
+            format = QImage::Format_RGB888;
+            bytesPerPixel = 3;
+            break;
+        case EPixelFormat::RGBA32:
+            format = QImage::Format_RGBA8888;
+            bytesPerPixel = 4;
+            break;
+        }
+
+        const int bytesPerLine = buffer.bytesPerLine > 0
+                                     ? buffer.bytesPerLine
+                                     : buffer.width * bytesPerPixel;
+        // Wraps the buffer without copying; it outlives every use below
+        return QImage(buffer.data.data(), buffer.width, buffer.height, bytesPerLine, format);
+    }
+
+    bool writePdf(const QImage &image, const QString &filePath)
+    {
+        QPdfWriter writer(filePath);
+        writer.setPageSize(QPageSize(QPageSize::A4));
+        writer.setPageOrientation(QPageLayout::Portrait);
+        writer.setResolution(300);
+
+        QPainter painter(&writer);
+        if (!painter.isActive())
+        {
+            return false;
+        }
+
+        const QRect pageRect = painter.viewport();
+        const QSize imageSize = image.size().scaled(pageRect.size(), Qt::KeepAspectRatio);
+        const int x = (pageRect.width() - imageSize.width()) / 2;
+        const int y = (pageRect.height() - imageSize.height()) / 2;
+
+        painter.drawImage(QRect(x, y, imageSize.width(), imageSize.height()), image);
+        return painter.end();
+    }
+}
+
+QtImageExporter::QtImageExporter(int jpegQuality)
+    : m_jpegQuality(jpegQuality)
+{
+}
+
+bool QtImageExporter::exportImage(const SImageBuffer &image,
+                                  const std::string &filePath,
+                                  EExportFormat format,
+                                  std::string &errorMessage) const
+{
+    const QImage source = bufferToImage(image);
+    if (source.isNull())
+    {
+        errorMessage = "Failed to export image.";
+        return false;
+    }
+
+    const QString path = QString::fromStdString(filePath);
+    switch (format)
+    {
+    case EExportFormat::Png:
+        if (!source.save(path, "PNG"))
+        {
+            errorMessage = "Failed to export image.";
+            return false;
+        }
+        return true;
+    case EExportFormat::Jpeg:
+        if (!source.save(path, "JPEG", m_jpegQuality))
+        {
+            errorMessage = "Failed to export image.";
+            return false;
+        }
+        return true;
+    case EExportFormat::Pdf:
+        if (!writePdf(source, path))
+        {
+            errorMessage = "Failed to create PDF file.";
+            return false;
+        }
+        return true;
+    }
+
+    errorMessage = "Unsupported export format.";
+    return false;
+}
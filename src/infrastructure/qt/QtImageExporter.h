@@ -0,0 +1,25 @@
+/**
+ * @file QtImageExporter.h
+ * @brief Qt-based PNG/JPEG/PDF image exporter
+ * @date 2026
+ */
+
+#pragma once
+
+#include "application/ports/IImageExporter.h"
+
+class QtImageExporter final : public IImageExporter
+{
+  public:
+    static constexpr int kDefaultJpegQuality = 95;
+
+    explicit QtImageExporter(int jpegQuality = kDefaultJpegQuality);
+
+    bool exportImage(const SImageBuffer &image,
+                     const std::string &filePath,
+                     EExportFormat format,
+                     std::string &errorMessage) const override;
+
+  private:
+    int m_jpegQuality = kDefaultJpegQuality;
+};
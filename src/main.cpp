@@ -18,6 +18,7 @@
 #include <QPixmap>
 #include <QPropertyAnimation>
 #include <QScreen>
+#include <QStandardPaths>
 #include <QStyle>
 #include <QSurfaceFormat>
 #include <QTimer>
@@ -26,7 +27,10 @@
 #include <QWindow>
 #include <memory>
 
+#include "infrastructure/concurrency/DicomFolderIndexer.h"
+#include "infrastructure/concurrency/DicomLoadPipeline.h"
 #include "infrastructure/dcmtk/DcmtkDicomLoader.h"
+#include "infrastructure/qt/QtImageExporter.h"
 #include "infrastructure/qt/QtImageRenderer.h"
 #include "infrastructure/qt/QtReportGenerator.h"
 #include "presentation/viewmodels/MainViewModel.h"
@@ -105,11 +109,30 @@ int main(int argc, char *argv[])
     logPixmapInfo("Scaled pixmap", scaledPixmap);
 
     auto loader = std::make_unique<DcmtkDicomLoader>();
+    auto loadPipeline = std::make_unique<DicomLoadPipeline>(
+        []() -> std::unique_ptr<IDicomLoader>
+        { return std::make_unique<DcmtkDicomLoader>(); });
     auto renderer = std::make_unique<QtImageRenderer>();
+    auto exporter = std::make_unique<QtImageExporter>();
     auto reportGenerator = std::make_unique<QtReportGenerator>();
+    // Folder catalogs persist across sessions in the user's cache folder
+    const QString catalogDirectory =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/catalogs";
+    auto folderIndexer = std::make_unique<DicomFolderIndexer>(
+        catalogDirectory.toStdString());
     auto viewModel = std::make_shared<MainViewModel>(std::move(loader),
+                                                     std::move(loadPipeline),
                                                      std::move(renderer),
-                                                     std::move(reportGenerator));
+                                                     std::move(exporter),
+                                                     std::move(reportGenerator),
+                                                     std::move(folderIndexer));
+
+    bool budgetOk = false;
+    const int pixelCacheMb = qEnvironmentVariableIntValue("DICOMVIEWER_PIXEL_CACHE_MB", &budgetOk);
+    if (budgetOk && pixelCacheMb >= 0)
+    {
+        viewModel->setPixelCacheBudget(static_cast<size_t>(pixelCacheMb) * 1024 * 1024);
+    }
 
     CMainWindow mainWindow(viewModel);
     mainWindow.setWindowTitle(app.applicationName());
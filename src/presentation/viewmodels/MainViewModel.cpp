@@ -6,93 +6,301 @@
 
 #include "MainViewModel.h"
 
-#include <QImage>
-#include <QPageLayout>
-#include <QPainter>
-#include <QPdfWriter>
+#include "utils/CThreadPool.h"
+
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QTimer>
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 MainViewModel::MainViewModel(std::unique_ptr<IDicomLoader> loader,
+                             std::unique_ptr<IDicomLoadPipeline> loadPipeline,
                              std::unique_ptr<IImageRenderer> renderer,
+                             std::unique_ptr<IImageExporter> exporter,
                              std::unique_ptr<IReportGenerator> reportGenerator,
+                             std::unique_ptr<IFolderIndexer> folderIndexer,
                              QObject *parent)
     : QObject(parent),
       m_loader(std::move(loader)),
+      m_loadPipeline(std::move(loadPipeline)),
+      m_folderIndexer(std::move(folderIndexer)),
+      m_assemblyGuard(std::make_shared<SAssemblyGuard>()),
       m_renderer(std::move(renderer)),
+      m_exporter(std::move(exporter)),
       m_reportGenerator(std::move(reportGenerator))
 {
 }
 
-namespace
+MainViewModel::~MainViewModel()
+{
+    // Join the workers before any member they report back to goes away.
+    m_loadPipeline.reset();
+    m_folderIndexer.reset();
+
+    // Volume assembly may still be running; its result is dropped.
+    std::lock_guard<std::mutex> lock(m_assemblyGuard->mutex);
+    m_assemblyGuard->alive = false;
+}
+
+bool MainViewModel::loadFile(const QString &filePath)
+{
+    if (!m_loader)
+    {
+        emit errorOccurred("DICOM loader not configured.");
+        return false;
+    }
+
+    SDicomLoadResult result = m_loader->load(filePath.toStdString(),
+                                             DicomViewer::EPixelLoadPolicy::Immediate);
+    if (!appendLoadedImage(filePath, result))
+    {
+        emit errorOccurred(QString::fromStdString(result.errorMessage));
+        return false;
+    }
+    return true;
+}
+
+void MainViewModel::loadFiles(const QStringList &filePaths,
+                              const SViewState &currentState,
+                              const DicomViewer::SWindowLevel &currentWindowLevel)
 {
-    QImage bufferToImage(const SImageBuffer &buffer)
+    if (filePaths.isEmpty())
     {
-        if (buffer.data.empty() || buffer.width <= 0 || buffer.height <= 0)
+        return;
+    }
+
+    if (!m_loadPipeline)
+    {
+        const int startIndex = m_loadedImages.size();
+        for (const QString &path : filePaths)
         {
-            return QImage();
+            loadFile(path);
         }
 
-        QImage::Format format = QImage::Format_RGB888;
-        int bytesPerPixel = 3;
-        switch (buffer.format)
+        if (m_loadedImages.size() > startIndex)
         {
-        case EPixelFormat::Grayscale8:
-            format = QImage::Format_Grayscale8;
-            bytesPerPixel = 1;
-            break;
-        case EPixelFormat::RGB24:
-            format = QImage::Format_RGB888;
-            bytesPerPixel = 3;
-            break;
-        case EPixelFormat::RGBA32:
-            format = QImage::Format_RGBA8888;
-            bytesPerPixel = 4;
-            break;
+            selectImage(startIndex, currentState, currentWindowLevel);
         }
+        assembleVolumes();
+        return;
+    }
 
-        const int bytesPerLine = buffer.bytesPerLine > 0
-                                     ? buffer.bytesPerLine
-                                     : buffer.width * bytesPerPixel;
-        QImage image(buffer.data.data(), buffer.width, buffer.height, bytesPerLine, format);
-        return image.copy();
+    storeCurrentState(currentState, currentWindowLevel);
+
+    const uint64_t batchId = ++m_lastBatchId;
+    m_selectOnArrivalBatchId = batchId;
+
+    std::vector<SDicomLoadRequest> requests;
+    requests.reserve(filePaths.size());
+    for (const QString &path : filePaths)
+    {
+        requests.push_back({path.toStdString(), batchId});
     }
+
+    m_loadTotal += filePaths.size();
+    emit loadProgress(m_loadCompleted, m_loadTotal);
+
+    m_loadPipeline->enqueue(
+        std::move(requests),
+        [this](const SDicomLoadRequest &request, SDicomLoadResult result)
+        {
+            // Runs on a worker thread; hand the result to the GUI thread.
+            QMetaObject::invokeMethod(
+                this,
+                [this, request, result]() mutable
+                { onFileLoaded(request, std::move(result)); },
+                Qt::QueuedConnection);
+        });
 }
 
-bool MainViewModel::loadFile(const QString &filePath)
+void MainViewModel::cancelLoading()
 {
-    if (!m_loader)
+    if (!isLoading())
     {
-        emit errorOccurred("DICOM loader not configured.");
-        return false;
+        return;
     }
 
-    SDicomLoadResult result = m_loader->load(filePath.toStdString());
+    if (m_loadPipeline)
+    {
+        m_loadPipeline->cancelAll();
+    }
+    m_lastCancelledBatchId = m_lastBatchId;
+    m_selectOnArrivalBatchId = 0;
+
+    const int skipped = m_loadTotal - m_loadCompleted;
+    m_loadTotal = 0;
+    m_loadCompleted = 0;
+    m_loadFailures.clear();
+    emit loadProgress(0, 0);
+    emit statusMessage(QString("Loading cancelled (%1 file(s) skipped)").arg(skipped), 5000);
+}
+
+bool MainViewModel::isLoading() const
+{
+    return m_loadTotal > m_loadCompleted;
+}
+
+void MainViewModel::openFolder(const QString &folderPath)
+{
+    if (folderPath.isEmpty())
+    {
+        return;
+    }
+    if (!m_folderIndexer)
+    {
+        emit errorOccurred("Folder indexer not configured.");
+        return;
+    }
+
+    const uint64_t runId = ++m_indexRunId;
+    m_indexing = true;
+    m_catalog.reset();
+    emit catalogChanged();
+    emit indexProgress(0, 0);
+    emit statusMessage(QString("Indexing %1...").arg(folderPath), 0);
+
+    m_folderIndexer->index(
+        folderPath.toStdString(),
+        [this, runId](size_t read, size_t total)
+        {
+            // Runs on worker threads; the GUI thread drops stale runs.
+            QMetaObject::invokeMethod(
+                this,
+                [this, runId, read, total]()
+                {
+                    if (runId == m_indexRunId && m_indexing)
+                    {
+                        emit indexProgress(static_cast<int>(read), static_cast<int>(total));
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        [this, runId](std::shared_ptr<const CDicomCatalog> catalog, bool complete)
+        {
+            QMetaObject::invokeMethod(
+                this,
+                [this, runId, catalog, complete]()
+                { onCatalogIndexed(runId, catalog, complete); },
+                Qt::QueuedConnection);
+        });
+}
+
+bool MainViewModel::isIndexing() const
+{
+    return m_indexing;
+}
+
+std::shared_ptr<const CDicomCatalog> MainViewModel::catalog() const
+{
+    return m_catalog;
+}
+
+void MainViewModel::onCatalogIndexed(uint64_t runId,
+                                     std::shared_ptr<const CDicomCatalog> catalog,
+                                     bool complete)
+{
+    if (runId != m_indexRunId)
+    {
+        return;
+    }
+
+    m_catalog = std::move(catalog);
+    if (complete)
+    {
+        m_indexing = false;
+        emit indexProgress(0, 0);
+        emit statusMessage(QString("Indexed %1 image(s) in %2")
+                               .arg(m_catalog->imageCount())
+                               .arg(QString::fromStdString(m_catalog->rootPath())),
+                           5000);
+    }
+    emit catalogChanged();
+}
+
+void MainViewModel::onFileLoaded(const SDicomLoadRequest &request, SDicomLoadResult result)
+{
+    if (request.batchId <= m_lastCancelledBatchId)
+    {
+        return;
+    }
+
+    const QString filePath = QString::fromStdString(request.filePath);
+    if (appendLoadedImage(filePath, result))
+    {
+        if (request.batchId == m_selectOnArrivalBatchId)
+        {
+            m_selectOnArrivalBatchId = 0;
+            const auto *entry = currentEntry();
+            const SViewState state = entry ? SViewState{entry->zoom, entry->pan, entry->rotation}
+                                           : SViewState{};
+            const DicomViewer::SWindowLevel windowLevel = entry ? entry->windowLevel
+                                                                : DicomViewer::SWindowLevel{};
+            selectImage(m_loadedImages.size() - 1, state, windowLevel);
+        }
+    }
+    else
+    {
+        m_loadFailures.append(QString("%1: %2")
+                                  .arg(QFileInfo(filePath).fileName(),
+                                       QString::fromStdString(result.errorMessage)));
+    }
+
+    ++m_loadCompleted;
+    emit loadProgress(m_loadCompleted, m_loadTotal);
+
+    if (m_loadCompleted < m_loadTotal)
+    {
+        return;
+    }
+
+    const int total = m_loadTotal;
+    m_loadTotal = 0;
+    m_loadCompleted = 0;
+    assembleVolumes();
+    if (!m_loadFailures.isEmpty())
+    {
+        const QStringList failures = m_loadFailures;
+        m_loadFailures.clear();
+        emit errorOccurred(QString("Failed to load %1 of %2 file(s):\n%3")
+                               .arg(failures.size())
+                               .arg(total)
+                               .arg(failures.join('\n')));
+    }
+}
+
+bool MainViewModel::appendLoadedImage(const QString &filePath, SDicomLoadResult &result)
+{
     if (result.result != DicomViewer::ELoadResult::Success || !result.image)
     {
-        emit errorOccurred(QString::fromStdString(result.errorMessage));
         return false;
     }
 
     result.image->resetWindowLevel();
     DicomViewer::SWindowLevel wl = result.image->windowLevel();
     m_loadedImages.push_back({filePath, result.image, DicomViewer::EPaletteType::Grayscale, wl});
+    m_pixelCache.touch(result.image);
     emit imageAdded(m_loadedImages.size() - 1);
+    trimPixelCache();
     return true;
 }
 
-void MainViewModel::loadFiles(const QStringList &filePaths,
-                              const SViewState &currentState,
-                              const DicomViewer::SWindowLevel &currentWindowLevel)
+void MainViewModel::storeCurrentState(const SViewState &currentState,
+                                      const DicomViewer::SWindowLevel &currentWindowLevel)
 {
-    const int startIndex = m_loadedImages.size();
-    for (const QString &path : filePaths)
+    if (m_currentImageIndex < 0 || m_currentImageIndex >= m_loadedImages.size())
     {
-        loadFile(path);
+        return;
     }
 
-    if (m_loadedImages.size() > startIndex)
+    auto &currentEntry = m_loadedImages[m_currentImageIndex];
+    currentEntry.zoom = currentState.zoom;
+    currentEntry.pan = currentState.pan;
+    currentEntry.rotation = currentState.rotation;
+    if (currentEntry.image)
     {
-        selectImage(startIndex, currentState, currentWindowLevel);
+        currentEntry.windowLevel = currentWindowLevel;
     }
 }
 
@@ -100,17 +308,7 @@ void MainViewModel::selectImage(int index,
                                 const SViewState &currentState,
                                 const DicomViewer::SWindowLevel &currentWindowLevel)
 {
-    if (m_currentImageIndex >= 0 && m_currentImageIndex < m_loadedImages.size())
-    {
-        auto &currentEntry = m_loadedImages[m_currentImageIndex];
-        currentEntry.zoom = currentState.zoom;
-        currentEntry.pan = currentState.pan;
-        currentEntry.rotation = currentState.rotation;
-        if (currentEntry.image)
-        {
-            currentEntry.windowLevel = currentWindowLevel;
-        }
-    }
+    storeCurrentState(currentState, currentWindowLevel);
 
     if (index < 0 || index >= m_loadedImages.size())
     {
@@ -124,8 +322,31 @@ void MainViewModel::selectImage(int index,
         return;
     }
 
+    if (m_currentImageIndex >= 0)
+    {
+        m_navigationStep = index > m_currentImageIndex ? 1 : -1;
+    }
     m_currentImageIndex = index;
+    const auto &entry = m_loadedImages[index];
+    if (entry.volume)
+    {
+        auto it = std::find(m_volumes.begin(), m_volumes.end(), entry.volume);
+        if (it != m_volumes.end())
+        {
+            std::rotate(it, it + 1, m_volumes.end());
+        }
+    }
+    else
+    {
+        m_pixelCache.touch(entry.image);
+        if (entry.volumeReleased)
+        {
+            reassembleSeries(index);
+        }
+    }
+    prefetchNeighbours();
     emit currentImageChanged();
+    trimPixelCache();
 }
 
 void MainViewModel::removeImage(int index,
@@ -137,18 +358,10 @@ void MainViewModel::removeImage(int index,
         return;
     }
 
-    if (m_currentImageIndex >= 0 && m_currentImageIndex < m_loadedImages.size())
-    {
-        auto &currentEntry = m_loadedImages[m_currentImageIndex];
-        currentEntry.zoom = currentState.zoom;
-        currentEntry.pan = currentState.pan;
-        currentEntry.rotation = currentState.rotation;
-        if (currentEntry.image)
-        {
-            currentEntry.windowLevel = currentWindowLevel;
-        }
-    }
+    storeCurrentState(currentState, currentWindowLevel);
 
+    m_pixelCache.remove(m_loadedImages[index].image.get());
+    m_pixelCache.remove(m_loadedImages[index].fileImage.get());
     m_loadedImages.removeAt(index);
     emit imageRemoved(index);
 
@@ -213,6 +426,106 @@ void MainViewModel::updateCurrentWindowLevel(double center, double width)
     entry.windowLevel.width = width;
 }
 
+void MainViewModel::setPixelCacheBudget(size_t budgetBytes)
+{
+    m_pixelCache.setBudget(budgetBytes);
+    trimPixelCache();
+}
+
+size_t MainViewModel::pixelCacheBudget() const
+{
+    return m_pixelCache.budget();
+}
+
+void MainViewModel::trimPixelCache()
+{
+    // Volumes no entry refers to any more have been freed already
+    m_volumes.erase(std::remove_if(m_volumes.begin(), m_volumes.end(),
+                                   [this](const std::shared_ptr<const CVolume> &volume)
+                                   {
+                                       return std::none_of(m_loadedImages.begin(),
+                                                           m_loadedImages.end(),
+                                                           [&volume](const SLoadedImage &entry)
+                                                           { return entry.volume == volume; });
+                                   }),
+                    m_volumes.end());
+
+    // Volumes share the budget; release the least recently viewed first
+    const auto *current = currentEntry();
+    const size_t budget = m_pixelCache.budget();
+    size_t volumeBytes = m_reformatter ? m_reformatter->byteSize() : 0;
+    for (const auto &volume : m_volumes)
+    {
+        volumeBytes += volume->byteSize();
+    }
+    for (size_t i = 0; budget > 0 && volumeBytes > budget && i < m_volumes.size();)
+    {
+        if (current && m_volumes[i] == current->volume)
+        {
+            ++i;
+            continue;
+        }
+        const auto volume = m_volumes[i];
+        m_volumes.erase(m_volumes.begin() + static_cast<std::ptrdiff_t>(i));
+        volumeBytes -= volume->byteSize();
+        releaseVolume(volume);
+    }
+
+    std::unordered_set<const CDicomImage *> pinned;
+    if (m_currentImageIndex >= 0)
+    {
+        const int first = std::max(0, m_currentImageIndex - kPinnedNeighbourCount);
+        const int last = std::min(static_cast<int>(m_loadedImages.size()) - 1,
+                                  m_currentImageIndex + kPinnedNeighbourCount);
+        for (int i = first; i <= last; ++i)
+        {
+            pinned.insert(m_loadedImages[i].image.get());
+        }
+    }
+    // Images being staged must not be released under the prefetcher
+    for (int index : prefetchIndices())
+    {
+        pinned.insert(m_loadedImages[index].image.get());
+    }
+    m_pixelCache.trim(pinned, volumeBytes);
+}
+
+std::vector<int> MainViewModel::prefetchIndices() const
+{
+    std::vector<int> indices;
+    if (m_currentImageIndex < 0)
+    {
+        return indices;
+    }
+    // Most likely next first: onwards in the direction of travel, then back
+    const auto add = [this, &indices](int index)
+    {
+        if (index >= 0 && index < m_loadedImages.size())
+        {
+            indices.push_back(index);
+        }
+    };
+    for (int i = 1; i <= kPrefetchAhead; ++i)
+    {
+        add(m_currentImageIndex + i * m_navigationStep);
+    }
+    for (int i = 1; i <= kPrefetchBehind; ++i)
+    {
+        add(m_currentImageIndex - i * m_navigationStep);
+    }
+    return indices;
+}
+
+void MainViewModel::prefetchNeighbours()
+{
+    std::vector<std::shared_ptr<const CDicomImage>> images;
+    for (int index : prefetchIndices())
+    {
+        images.push_back(m_loadedImages[index].image);
+    }
+    m_prefetcher.prefetch(images);
+}
+
 int MainViewModel::currentIndex() const
 {
     return m_currentImageIndex;
@@ -246,52 +559,428 @@ const MainViewModel::SLoadedImage *MainViewModel::entryAt(int index) const
     return &m_loadedImages[index];
 }
 
-std::optional<DicomViewer::SWindowLevel> MainViewModel::resolveWindowLevel(
-    const SLoadedImage &entry) const
+std::shared_ptr<const CVolume> MainViewModel::volumeAt(int index) const
 {
-    if (entry.windowLevel.width > 0.0)
+    const auto *entry = entryAt(index);
+    return entry ? entry->volume : nullptr;
+}
+
+void MainViewModel::assembleVolumes()
+{
+    std::vector<std::shared_ptr<const CDicomImage>> images;
+    images.reserve(m_loadedImages.size());
+    for (const auto &entry : m_loadedImages)
     {
-        return entry.windowLevel;
+        images.push_back(entry.image);
+    }
+
+    for (const auto &group : CVolume::groupBySeries(images))
+    {
+        // Series released for the budget wait until one of their images is viewed
+        const bool released = std::all_of(group.begin(), group.end(),
+                                          [this](size_t index)
+                                          { return m_loadedImages[static_cast<int>(index)].volumeReleased; });
+        if (released)
+        {
+            continue;
+        }
+
+        // Series already packed, with no slices added since, stay as they are
+        const auto &volume = m_loadedImages[static_cast<int>(group.front())].volume;
+        const bool upToDate = volume && volume->depth() == group.size() &&
+                              std::all_of(group.begin(), group.end(),
+                                          [this, &volume](size_t index)
+                                          { return m_loadedImages[static_cast<int>(index)].volume == volume; });
+        if (upToDate)
+        {
+            continue;
+        }
+
+        const auto dims = m_loadedImages[static_cast<int>(group.front())].image->dimensions();
+        const size_t budget = m_pixelCache.budget();
+        if (budget > 0 && CVolume::byteSizeFor(dims.width, dims.height,
+                                               static_cast<uint32_t>(group.size())) > budget)
+        {
+            emit statusMessage(QString("Series of %1 slices exceeds the memory budget; "
+                                       "showing it slice by slice")
+                                   .arg(group.size()),
+                               5000);
+            continue;
+        }
+
+        std::vector<std::shared_ptr<CDicomImage>> slices;
+        slices.reserve(group.size());
+        for (const size_t index : group)
+        {
+            slices.push_back(m_loadedImages[static_cast<int>(index)].image);
+        }
+
+        m_pendingAssemblies.push_back([this, guard = m_assemblyGuard, slices]()
+        {
+            auto assembled = CVolume::assemble(slices);
+            std::lock_guard<std::mutex> lock(guard->mutex);
+            if (!guard->alive)
+            {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, slices, assembled]()
+                { onVolumeAssembled(slices, assembled); },
+                Qt::QueuedConnection);
+        });
+    }
+    if (!m_assemblyRetryScheduled)
+    {
+        submitAssemblies();
     }
-    return std::nullopt;
 }
 
-bool MainViewModel::exportCurrentImage(const QString &filePath, const QString &format)
+void MainViewModel::submitAssemblies()
+{
+    m_assemblyRetryScheduled = false;
+    while (!m_pendingAssemblies.empty())
+    {
+        if (!CThreadPool::shared().trySubmit(m_pendingAssemblies.front()))
+        {
+            // The queue is full of prefetch and render work; try again shortly
+            m_assemblyRetryScheduled = true;
+            QTimer::singleShot(kAssemblyRetryMs, this, &MainViewModel::submitAssemblies);
+            return;
+        }
+        m_pendingAssemblies.pop_front();
+    }
+}
+
+void MainViewModel::reassembleSeries(int index)
+{
+    const CDicomMetadata *metadata = m_loadedImages[index].image
+                                         ? m_loadedImages[index].image->metadata()
+                                         : nullptr;
+    if (!metadata)
+    {
+        return;
+    }
+    const std::string uid = metadata->seriesInstanceUid();
+    for (auto &entry : m_loadedImages)
+    {
+        const CDicomMetadata *entryMetadata = entry.image ? entry.image->metadata() : nullptr;
+        if (entry.volumeReleased && entryMetadata && entryMetadata->seriesInstanceUid() == uid)
+        {
+            entry.volumeReleased = false;
+        }
+    }
+    assembleVolumes();
+}
+
+void MainViewModel::releaseVolume(const std::shared_ptr<const CVolume> &volume)
+{
+    // Entries fall back to their per-file images, which decode on demand
+    for (auto &entry : m_loadedImages)
+    {
+        if (entry.volume != volume)
+        {
+            continue;
+        }
+        if (entry.fileImage)
+        {
+            entry.image = std::move(entry.fileImage);
+        }
+        entry.volume.reset();
+        entry.sliceIndex = -1;
+        entry.volumeReleased = true;
+        m_pixelCache.touch(entry.image);
+    }
+}
+
+void MainViewModel::prepareReformatter()
+{
+    if (m_preparingReformatter == m_reformatter.get())
+    {
+        return;
+    }
+    m_preparingReformatter = m_reformatter.get();
+    emit statusMessage("Preparing MPR planes...", 0);
+
+    // The task keeps the reformatter alive, so its address is not reused meanwhile
+    m_pendingAssemblies.push_back([this, guard = m_assemblyGuard, reformatter = m_reformatter]()
+    {
+        reformatter->prepare();
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        if (!guard->alive)
+        {
+            return;
+        }
+        QMetaObject::invokeMethod(
+            this,
+            [this, reformatter]()
+            { onReformatterPrepared(reformatter); },
+            Qt::QueuedConnection);
+    });
+    if (!m_assemblyRetryScheduled)
+    {
+        submitAssemblies();
+    }
+}
+
+void MainViewModel::onReformatterPrepared(const std::shared_ptr<const CMprReformatter> &reformatter)
+{
+    if (m_preparingReformatter == reformatter.get())
+    {
+        m_preparingReformatter = nullptr;
+    }
+    if (reformatter != m_reformatter)
+    {
+        return;
+    }
+
+    emit statusMessage(QString("MPR ready (%1 MiB)").arg(reformatter->byteSize() / (1024 * 1024)),
+                       3000);
+    trimPixelCache();
+    m_mprImage.reset();
+    emit mprImageChanged();
+}
+
+void MainViewModel::onVolumeAssembled(const std::vector<std::shared_ptr<CDicomImage>> &slices,
+                                      const std::shared_ptr<const CVolume> &volume)
+{
+    if (!volume)
+    {
+        return;
+    }
+
+    std::unordered_map<const CDicomImage *, int> entryIndex;
+    for (int i = 0; i < m_loadedImages.size(); ++i)
+    {
+        entryIndex.emplace(m_loadedImages[i].image.get(), i);
+    }
+
+    // Entries removed or reassembled meanwhile no longer hold their slice
+    bool currentReplaced = false;
+    for (uint32_t z = 0; z < slices.size(); ++z)
+    {
+        auto it = entryIndex.find(slices[z].get());
+        if (it == entryIndex.end())
+        {
+            continue;
+        }
+        auto &entry = m_loadedImages[it->second];
+        if (!entry.fileImage)
+        {
+            // Kept so the volume can be released again; its pixels are in the volume now
+            entry.fileImage = entry.image;
+            entry.fileImage->releasePixelData();
+        }
+        entry.image = volume->slice(z);
+        entry.volume = volume;
+        entry.sliceIndex = static_cast<int>(z);
+        entry.volumeReleased = false;
+        currentReplaced = currentReplaced || it->second == m_currentImageIndex;
+    }
+
+    m_volumes.push_back(volume);
+    trimPixelCache();
+
+    emit statusMessage(QString("Assembled volume: %1 x %2 x %3")
+                           .arg(volume->width())
+                           .arg(volume->height())
+                           .arg(volume->depth()),
+                       5000);
+    if (currentReplaced)
+    {
+        emit currentImageChanged();
+    }
+}
+
+void MainViewModel::setMprPlane(DicomViewer::EMprPlane plane)
+{
+    if (plane == m_mprPlane)
+    {
+        return;
+    }
+    m_mprPlane = plane;
+    m_mprImage.reset();
+    if (m_reformatter)
+    {
+        m_mprIndex = m_reformatter->planeCount(plane) / 2;
+    }
+    emit mprImageChanged();
+}
+
+DicomViewer::EMprPlane MainViewModel::mprPlane() const
+{
+    return m_mprPlane;
+}
+
+void MainViewModel::stepMprPlane(int delta)
+{
+    const int count = mprPlaneCount();
+    if (count == 0)
+    {
+        return;
+    }
+    const auto index = static_cast<uint32_t>(
+        std::clamp(static_cast<int>(m_mprIndex) + delta, 0, count - 1));
+    if (index == m_mprIndex)
+    {
+        return;
+    }
+    m_mprIndex = index;
+    m_mprImage.reset();
+    emit mprImageChanged();
+}
+
+void MainViewModel::setProjectionMode(DicomViewer::EProjectionMode mode)
+{
+    if (mode == m_projectionMode)
+    {
+        return;
+    }
+    m_projectionMode = mode;
+    m_mprImage.reset();
+    if (mode == DicomViewer::EProjectionMode::Off)
+    {
+        m_projector.reset();
+        m_projectedIndex = -1;
+    }
+    emit mprImageChanged();
+}
+
+DicomViewer::EProjectionMode MainViewModel::projectionMode() const
+{
+    return m_projectionMode;
+}
+
+void MainViewModel::setSlabThickness(int slices)
+{
+    slices = std::max(slices, 1);
+    if (slices == m_slabThickness)
+    {
+        return;
+    }
+    m_slabThickness = slices;
+    if (m_projector)
+    {
+        m_mprImage.reset();
+        emit mprImageChanged();
+    }
+}
+
+int MainViewModel::slabThickness() const
+{
+    return m_slabThickness;
+}
+
+std::shared_ptr<CDicomImage> MainViewModel::currentMprImage()
 {
     const auto *entry = currentEntry();
-    if (!entry || !entry->image)
+    const bool hasVolume = entry && entry->volume;
+    const bool projecting = hasVolume && m_mprPlane == DicomViewer::EMprPlane::Acquisition &&
+                            m_projectionMode != DicomViewer::EProjectionMode::Off;
+    if (!projecting)
     {
-        emit errorOccurred("No image loaded to export.");
-        return false;
+        m_projector.reset();
+        m_projectedIndex = -1;
+    }
+    if (!hasVolume || m_mprPlane == DicomViewer::EMprPlane::Acquisition)
+    {
+        // Drop the bricked copy along with the reformatter
+        m_reformatter.reset();
+    }
+    if (!hasVolume || (m_mprPlane == DicomViewer::EMprPlane::Acquisition && !projecting))
+    {
+        m_mprImage.reset();
+        return nullptr;
     }
 
-    if (!m_renderer)
+    if (projecting)
     {
-        emit errorOccurred("Image renderer not configured.");
-        return false;
+        if (!m_projector || m_projector->volume() != entry->volume)
+        {
+            m_projector = std::make_unique<CSlabProjector>(entry->volume);
+            m_projectedIndex = -1;
+        }
+        if (m_projectedIndex != m_currentImageIndex)
+        {
+            // Picking another slice of the series re-centres the slab on it
+            m_mprIndex = static_cast<uint32_t>(std::max(entry->sliceIndex, 0));
+            m_projectedIndex = m_currentImageIndex;
+            m_mprImage.reset();
+        }
+        if (!m_mprImage)
+        {
+            const uint32_t depth = entry->volume->depth();
+            const uint32_t thickness = std::min(static_cast<uint32_t>(m_slabThickness), depth);
+            const uint32_t first = std::min(m_mprIndex - std::min(m_mprIndex, (thickness - 1) / 2),
+                                            depth - thickness);
+            m_mprImage = m_projector->project(m_projectionMode, first, thickness);
+        }
+        return m_mprImage;
     }
 
-    const SImageBuffer buffer = m_renderer->render(*entry->image,
-                                                   entry->palette,
-                                                   resolveWindowLevel(*entry));
-    QImage exportImage = bufferToImage(buffer);
-    if (exportImage.isNull())
+    if (!m_reformatter || m_reformatter->volume() != entry->volume)
     {
-        emit errorOccurred("Failed to export image.");
-        return false;
+        m_reformatter = std::make_shared<CMprReformatter>(entry->volume);
+        m_mprIndex = m_reformatter->planeCount(m_mprPlane) / 2;
+        m_mprImage.reset();
+    }
+    if (!m_reformatter->isReady(m_mprPlane))
+    {
+        // The acquired slice stays on screen until the bricks are built
+        prepareReformatter();
+        return nullptr;
+    }
+    if (!m_mprImage)
+    {
+        m_mprImage = m_reformatter->reformat(m_mprPlane, m_mprIndex);
     }
+    return m_mprImage;
+}
 
-    if (!exportImage.save(filePath, format.toUtf8().constData(), 95))
+int MainViewModel::mprPlaneIndex() const
+{
+    return static_cast<int>(m_mprIndex);
+}
+
+int MainViewModel::mprPlaneCount() const
+{
+    const auto *entry = currentEntry();
+    if (m_mprPlane == DicomViewer::EMprPlane::Acquisition)
     {
-        emit errorOccurred("Failed to export image.");
-        return false;
+        const bool projecting = m_projector && entry && m_projector->volume() == entry->volume;
+        return projecting ? static_cast<int>(entry->volume->depth()) : 0;
+    }
+    if (!m_reformatter || !entry || m_reformatter->volume() != entry->volume ||
+        !m_reformatter->isReady(m_mprPlane))
+    {
+        return 0;
     }
+    return static_cast<int>(m_reformatter->planeCount(m_mprPlane));
+}
 
-    emit statusMessage(QString("Exported to %1").arg(filePath), 5000);
-    return true;
+std::optional<DicomViewer::SWindowLevel> MainViewModel::resolveWindowLevel(
+    const SLoadedImage &entry) const
+{
+    if (entry.windowLevel.width > 0.0)
+    {
+        return entry.windowLevel;
+    }
+    return std::nullopt;
+}
+
+bool MainViewModel::exportCurrentImage(const QString &filePath, const QString &format)
+{
+    const QString upper = format.toUpper();
+    const bool isJpeg = (upper == "JPEG" || upper == "JPG");
+    return exportCurrent(filePath, isJpeg ? EExportFormat::Jpeg : EExportFormat::Png);
 }
 
 bool MainViewModel::exportCurrentImagePdf(const QString &filePath)
+{
+    return exportCurrent(filePath, EExportFormat::Pdf);
+}
+
+bool MainViewModel::exportCurrent(const QString &filePath, EExportFormat format)
 {
     const auto *entry = currentEntry();
     if (!entry || !entry->image)
@@ -300,42 +989,23 @@ bool MainViewModel::exportCurrentImagePdf(const QString &filePath)
         return false;
     }
 
-    if (!m_renderer)
+    if (!m_renderer || !m_exporter)
     {
         emit errorOccurred("Image renderer not configured.");
         return false;
     }
 
-    const SImageBuffer buffer = m_renderer->render(*entry->image,
+    const auto mprImage = currentMprImage();
+    const SImageBuffer buffer = m_renderer->render(mprImage ? *mprImage : *entry->image,
                                                    entry->palette,
                                                    resolveWindowLevel(*entry));
-    QImage exportImage = bufferToImage(buffer);
-    if (exportImage.isNull())
-    {
-        emit errorOccurred("Failed to export image.");
-        return false;
-    }
-
-    QPdfWriter writer(filePath);
-    writer.setPageSize(QPageSize(QPageSize::A4));
-    writer.setPageOrientation(QPageLayout::Portrait);
-    writer.setResolution(300);
-
-    QPainter painter(&writer);
-    if (!painter.isActive())
+    std::string error;
+    if (!m_exporter->exportImage(buffer, filePath.toStdString(), format, error))
     {
-        emit errorOccurred("Failed to create PDF file.");
+        emit errorOccurred(QString::fromStdString(error));
         return false;
     }
 
-    const QRect pageRect = painter.viewport();
-    const QSize imageSize = exportImage.size().scaled(pageRect.size(), Qt::KeepAspectRatio);
-    const int x = (pageRect.width() - imageSize.width()) / 2;
-    const int y = (pageRect.height() - imageSize.height()) / 2;
-
-    painter.drawImage(QRect(x, y, imageSize.width(), imageSize.height()), exportImage);
-    painter.end();
-
     emit statusMessage(QString("Exported to %1").arg(filePath), 5000);
     return true;
 }
@@ -355,11 +1025,11 @@ bool MainViewModel::generateReport(const QString &filePath, const QString &comme
         return false;
     }
 
-    const SImageBuffer buffer = m_renderer->render(*entry->image,
+    const auto mprImage = currentMprImage();
+    const SImageBuffer buffer = m_renderer->render(mprImage ? *mprImage : *entry->image,
                                                    entry->palette,
                                                    resolveWindowLevel(*entry));
-    QImage exportImage = bufferToImage(buffer);
-    if (exportImage.isNull())
+    if (buffer.data.empty())
     {
         emit errorOccurred("Failed to create report image.");
         return false;
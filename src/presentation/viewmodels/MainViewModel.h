@@ -6,17 +6,32 @@
 
 #pragma once
 
+#include "application/ports/IImageExporter.h"
 #include "application/ports/IImageRenderer.h"
 #include "application/ports/IReportGenerator.h"
+#include "application/ports/IDicomLoadPipeline.h"
 #include "application/ports/IDicomLoader.h"
+#include "application/ports/IFolderIndexer.h"
+#include "core/CDisplayPrefetcher.h"
+#include "core/CMprReformatter.h"
+#include "core/CPixelCache.h"
+#include "core/CSlabProjector.h"
+#include "core/CVolume.h"
 #include "utils/CColorPalette.h"
 
 #include <QObject>
 #include <QPointF>
 #include <QString>
+#include <QStringList>
 #include <QVector>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 class MainViewModel : public QObject
 {
@@ -39,17 +54,48 @@ class MainViewModel : public QObject
         double zoom = 1.0;
         QPointF pan;
         int rotation = 0;
+        std::shared_ptr<const CVolume> volume; // Set once the series is assembled
+        int sliceIndex = -1;                   // Position of image within volume
+        std::shared_ptr<CDicomImage> fileImage; // Per-file image the slice stands in for
+        bool volumeReleased = false;            // Volume dropped for the budget
     };
 
     explicit MainViewModel(std::unique_ptr<IDicomLoader> loader,
+                           std::unique_ptr<IDicomLoadPipeline> loadPipeline,
                            std::unique_ptr<IImageRenderer> renderer,
+                           std::unique_ptr<IImageExporter> exporter,
                            std::unique_ptr<IReportGenerator> reportGenerator,
+                           std::unique_ptr<IFolderIndexer> folderIndexer,
                            QObject *parent = nullptr);
+    ~MainViewModel() override;
 
     bool loadFile(const QString &filePath);
+
+    /**
+     * @brief Loads files in the background; returns immediately
+     *
+     * Each file is appended (imageAdded) as soon as it is decoded, in
+     * completion order. The first file of the batch to finish becomes
+     * the current image. Falls back to synchronous loading when no
+     * pipeline is configured.
+     */
     void loadFiles(const QStringList &filePaths,
                    const SViewState &currentState,
                    const DicomViewer::SWindowLevel &currentWindowLevel);
+    void cancelLoading();
+    bool isLoading() const;
+
+    /**
+     * @brief Catalogs a folder in the background; returns immediately
+     *
+     * catalogChanged is emitted with the catalog kept from the last visit
+     * of the folder, if any, and again once new and changed files have
+     * had their headers read. Images are not loaded; pass the files of a
+     * cataloged series to loadFiles() for that.
+     */
+    void openFolder(const QString &folderPath);
+    bool isIndexing() const;
+    std::shared_ptr<const CDicomCatalog> catalog() const;
     void selectImage(int index,
                      const SViewState &currentState,
                      const DicomViewer::SWindowLevel &currentWindowLevel);
@@ -60,12 +106,81 @@ class MainViewModel : public QObject
     void updateCurrentPalette(DicomViewer::EPaletteType type);
     void updateCurrentWindowLevel(double center, double width);
 
+    /**
+     * @brief Bounds the decoded pixel bytes kept resident across images
+     *
+     * Pixels of images outside the current one and its neighbours are
+     * released least recently used first and decoded again from
+     * SLoadedImage::filePath when next needed. Metadata and thumbnails
+     * stay resident.
+     *
+     * @param budgetBytes Maximum resident pixel bytes (0 = unlimited)
+     */
+    void setPixelCacheBudget(size_t budgetBytes);
+    size_t pixelCacheBudget() const;
+
     int currentIndex() const;
     int imageCount() const;
     const QVector<SLoadedImage> &images() const;
     const SLoadedImage *currentEntry() const;
     const SLoadedImage *entryAt(int index) const;
 
+    /**
+     * @brief Volume the image at @p index is a slice of
+     *
+     * Once a load batch finishes, images of the same series (two or
+     * more slices with a Series Instance UID and position) are packed
+     * into a CVolume in the background and their entries are switched
+     * to slice views of it. Volume memory is not part of the pixel
+     * cache budget.
+     *
+     * @return Volume, nullptr if the image is not part of one (yet)
+     */
+    std::shared_ptr<const CVolume> volumeAt(int index) const;
+
+    /**
+     * @brief Switches the current series between acquired slices and MPR
+     *
+     * The plane applies to whichever image is current; images that are
+     * not part of a volume always show as acquired. Moving to another
+     * volume starts at its middle plane.
+     */
+    void setMprPlane(DicomViewer::EMprPlane plane);
+    DicomViewer::EMprPlane mprPlane() const;
+
+    /**
+     * @brief Moves the reformatted plane, or the projected slab, along its normal
+     * @param delta Planes to move (clamped to the volume)
+     */
+    void stepMprPlane(int delta);
+
+    /**
+     * @brief Shows intensity projections instead of single acquired slices
+     *
+     * Applies while the plane is EMprPlane::Acquisition and the current
+     * image is part of a volume. The slab starts centred on the current
+     * slice and moves with stepMprPlane().
+     */
+    void setProjectionMode(DicomViewer::EProjectionMode mode);
+    DicomViewer::EProjectionMode projectionMode() const;
+
+    /**
+     * @brief Sets the thickness of projected slabs
+     * @param slices Slices per slab (at least 1; clipped to the volume)
+     */
+    void setSlabThickness(int slices);
+    int slabThickness() const;
+
+    /**
+     * @brief Reformatted plane or slab projection of the current image's volume
+     * @return Image to display instead of the current entry's, nullptr
+     *         when showing acquired slices or while the plane is being
+     *         prepared in the background (mprImageChanged() follows)
+     */
+    std::shared_ptr<CDicomImage> currentMprImage();
+    int mprPlaneIndex() const;
+    int mprPlaneCount() const;
+
     bool exportCurrentImage(const QString &filePath, const QString &format);
     bool exportCurrentImagePdf(const QString &filePath);
     bool generateReport(const QString &filePath, const QString &comment);
@@ -77,15 +192,91 @@ class MainViewModel : public QObject
     void imageRemoved(int index);
     void currentImageChanged();
     void paletteUpdated(DicomViewer::EPaletteType palette);
+    void loadProgress(int completed, int total);
+    void catalogChanged();
+    void indexProgress(int read, int total);
+    void mprImageChanged();
 
   private:
+    void onFileLoaded(const SDicomLoadRequest &request, SDicomLoadResult result);
+    void onCatalogIndexed(uint64_t runId, std::shared_ptr<const CDicomCatalog> catalog,
+                          bool complete);
+    bool appendLoadedImage(const QString &filePath, SDicomLoadResult &result);
+    void storeCurrentState(const SViewState &currentState,
+                           const DicomViewer::SWindowLevel &currentWindowLevel);
     std::optional<DicomViewer::SWindowLevel> resolveWindowLevel(
         const SLoadedImage &entry) const;
+    void trimPixelCache();
+    std::vector<int> prefetchIndices() const;
+    void prefetchNeighbours();
+    void assembleVolumes();
+    void submitAssemblies();
+    void reassembleSeries(int index);
+    void releaseVolume(const std::shared_ptr<const CVolume> &volume);
+    void prepareReformatter();
+    void onReformatterPrepared(const std::shared_ptr<const CMprReformatter> &reformatter);
+    void onVolumeAssembled(const std::vector<std::shared_ptr<CDicomImage>> &slices,
+                           const std::shared_ptr<const CVolume> &volume);
+    bool exportCurrent(const QString &filePath, EExportFormat format);
 
     QVector<SLoadedImage> m_loadedImages;
     int m_currentImageIndex = -1;
 
     std::unique_ptr<IDicomLoader> m_loader;
+    std::unique_ptr<IDicomLoadPipeline> m_loadPipeline;
+
+    uint64_t m_lastBatchId = 0;
+    uint64_t m_lastCancelledBatchId = 0;
+    uint64_t m_selectOnArrivalBatchId = 0;
+    int m_loadTotal = 0;
+    int m_loadCompleted = 0;
+    QStringList m_loadFailures;
+
+    std::unique_ptr<IFolderIndexer> m_folderIndexer;
+    std::shared_ptr<const CDicomCatalog> m_catalog; // Last catalog reported for the folder
+    uint64_t m_indexRunId = 0;                      // Reports of older runs are dropped
+    bool m_indexing = false;
+
+    static constexpr int kPinnedNeighbourCount = 1; /**< Images kept resident on each side */
+    CPixelCache m_pixelCache;
+
+    static constexpr int kPrefetchAhead = 2;  /**< Images staged in the direction of travel */
+    static constexpr int kPrefetchBehind = 1; /**< Images staged against it */
+    CDisplayPrefetcher m_prefetcher;
+    int m_navigationStep = 1; // Direction of the last selection change
+
+    // Lets background volume assembly know whether it may still post back
+    struct SAssemblyGuard
+    {
+        std::mutex mutex;
+        bool alive = true;
+    };
+    std::shared_ptr<SAssemblyGuard> m_assemblyGuard;
+
+    // Volume assemblies and brick builds wait here while the shared
+    // pool's queue is full; they never run on the GUI thread
+    static constexpr int kAssemblyRetryMs = 50;
+    std::deque<std::function<void()>> m_pendingAssemblies;
+    bool m_assemblyRetryScheduled = false;
+
+    // Assembled volumes and the reformatter's bricks count against the
+    // pixel cache budget; the least recently viewed volume is released
+    // first, never the current one
+    std::vector<std::shared_ptr<const CVolume>> m_volumes; // Most recently viewed last
+
+    DicomViewer::EMprPlane m_mprPlane = DicomViewer::EMprPlane::Acquisition;
+    std::shared_ptr<const CMprReformatter> m_reformatter; // Bound to the current volume
+    const CMprReformatter *m_preparingReformatter = nullptr; // Bricks being built off the GUI thread
+    uint32_t m_mprIndex = 0;
+    std::shared_ptr<CDicomImage> m_mprImage;        // Cached m_mprIndex plane or slab
+
+    static constexpr int kDefaultSlabThickness = 9; /**< Slices per projected slab */
+    DicomViewer::EProjectionMode m_projectionMode = DicomViewer::EProjectionMode::Off;
+    int m_slabThickness = kDefaultSlabThickness;
+    std::unique_ptr<CSlabProjector> m_projector; // Bound to the current volume
+    int m_projectedIndex = -1;                   // Entry the slab was centred on
+
     std::unique_ptr<IImageRenderer> m_renderer;
+    std::unique_ptr<IImageExporter> m_exporter;
     std::unique_ptr<IReportGenerator> m_reportGenerator;
 };
@@ -0,0 +1,280 @@
+/**
+ * @file CDicomTagModel.cpp
+ * @brief Implementation of the CDicomTagModel class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CDicomTagModel.h"
+
+namespace
+{
+constexpr size_t kMaxValueLength = 256;
+}
+
+/**
+ * @brief Constructor
+ * @param parent Parent object
+ */
+CDicomTagModel::CDicomTagModel(QObject *parent)
+    : QAbstractItemModel(parent)
+{
+}
+
+/**
+ * @brief Shows the complete dataset of a file
+ * @param index Tag index of the file
+ */
+void CDicomTagModel::setTagIndex(std::shared_ptr<const CDicomTagIndex> index)
+{
+    beginResetModel();
+    m_index = std::move(index);
+    m_summary.clear();
+    rebuild();
+    endResetModel();
+}
+
+/**
+ * @brief Shows the summary tags of an image without an index
+ * @param metadata Metadata to list (can be nullptr)
+ */
+void CDicomTagModel::setSummary(const CDicomMetadata *metadata)
+{
+    beginResetModel();
+    m_index.reset();
+    m_summary.clear();
+    if (metadata)
+    {
+        for (const auto &entry : metadata->allTags())
+        {
+            m_summary.emplace_back(QString::fromStdString(entry.first),
+                                   QString::fromStdString(entry.second));
+        }
+    }
+    rebuild();
+    endResetModel();
+}
+
+/**
+ * @brief Removes all rows
+ */
+void CDicomTagModel::clear()
+{
+    beginResetModel();
+    m_index.reset();
+    m_summary.clear();
+    rebuild();
+    endResetModel();
+}
+
+/**
+ * @brief Restricts the rows to tags matching a search text
+ * @param text Tag number or keyword; empty shows everything
+ */
+void CDicomTagModel::setFilter(const QString &text)
+{
+    const QString filter = text.trimmed();
+    if (filter == m_filter)
+    {
+        return;
+    }
+    beginResetModel();
+    m_filter = filter;
+    rebuild();
+    endResetModel();
+}
+
+size_t CDicomTagModel::visibleCount() const
+{
+    return m_children.size();
+}
+
+QModelIndex CDicomTagModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (row < 0 || column < 0 || column >= 2 || row >= rowCount(parent))
+    {
+        return QModelIndex();
+    }
+    if (!m_index)
+    {
+        return createIndex(row, column, quintptr(0));
+    }
+    const size_t slot = parent.isValid() ? static_cast<size_t>(parent.internalId()) + 1 : 0;
+    return createIndex(row, column, quintptr(m_children[m_firstChild[slot] + row]));
+}
+
+QModelIndex CDicomTagModel::parent(const QModelIndex &child) const
+{
+    if (!child.isValid() || !m_index)
+    {
+        return QModelIndex();
+    }
+    const int32_t parent = m_index->node(static_cast<uint32_t>(child.internalId())).parent;
+    if (parent < 0)
+    {
+        return QModelIndex();
+    }
+    return createIndex(static_cast<int>(m_row[static_cast<size_t>(parent)]), 0, quintptr(parent));
+}
+
+int CDicomTagModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+    {
+        return 0;
+    }
+    if (!m_index)
+    {
+        if (parent.isValid())
+        {
+            return 0;
+        }
+        if (m_filter.isEmpty())
+        {
+            return static_cast<int>(m_summary.size());
+        }
+        return static_cast<int>(m_children.size());
+    }
+    const size_t slot = parent.isValid() ? static_cast<size_t>(parent.internalId()) + 1 : 0;
+    return static_cast<int>(m_childCount[slot]);
+}
+
+int CDicomTagModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return 2;
+}
+
+QVariant CDicomTagModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+    {
+        return QVariant();
+    }
+
+    if (!m_index)
+    {
+        if (role != Qt::DisplayRole && role != Qt::ToolTipRole)
+        {
+            return QVariant();
+        }
+        const size_t row = m_filter.isEmpty() ? static_cast<size_t>(index.row())
+                                              : m_children[static_cast<size_t>(index.row())];
+        const auto &entry = m_summary[row];
+        return index.column() == 0 ? entry.first : entry.second;
+    }
+
+    const auto nodeIndex = static_cast<uint32_t>(index.internalId());
+    const CDicomTagIndex::SNode &node = m_index->node(nodeIndex);
+    if (role == Qt::DisplayRole)
+    {
+        if (index.column() == 0)
+        {
+            return QString::fromStdString(CDicomTagIndex::tagText(node.tag) + ' ' +
+                                          CDicomTagIndex::tagName(node.tag));
+        }
+        // Decoded on demand: only rows being painted get here
+        return QString::fromStdString(m_index->value(nodeIndex, kMaxValueLength));
+    }
+    if (role == Qt::ToolTipRole)
+    {
+        const QString length = node.length == CDicomTagIndex::kUndefinedLength
+                                   ? tr("undefined")
+                                   : QString::number(node.length);
+        if (node.tag == CDicomTagIndex::kItemTag)
+        {
+            return tr("Length: %1").arg(length);
+        }
+        return tr("VR: %1, Length: %2")
+            .arg(QString::fromLatin1(node.vr, 2))
+            .arg(length);
+    }
+    return QVariant();
+}
+
+QVariant CDicomTagModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+    return section == 0 ? tr("Tag") : tr("Value");
+}
+
+/**
+ * @brief Rebuilds the visible child lists for the current filter
+ *
+ * Runs on the index alone; nothing is decoded. Parents precede their
+ * children in the index, so one forward pass settles "has a matching
+ * ancestor" and one backward pass "has a matching descendant".
+ */
+void CDicomTagModel::rebuild()
+{
+    m_children.clear();
+    m_firstChild.clear();
+    m_childCount.clear();
+    m_row.clear();
+
+    if (!m_index)
+    {
+        // Summary rows: m_children holds the rows that pass the filter
+        if (!m_filter.isEmpty())
+        {
+            for (size_t i = 0; i < m_summary.size(); ++i)
+            {
+                if (m_summary[i].first.contains(m_filter, Qt::CaseInsensitive))
+                {
+                    m_children.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+        return;
+    }
+
+    const size_t count = m_index->size();
+    std::vector<bool> visible(count, true);
+    if (!m_filter.isEmpty())
+    {
+        const std::vector<bool> matches = m_index->match(m_filter.toStdString());
+        std::vector<bool> inMatch(count, false);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int32_t parent = m_index->node(static_cast<uint32_t>(i)).parent;
+            inMatch[i] = matches[i] || (parent >= 0 && inMatch[static_cast<size_t>(parent)]);
+            visible[i] = inMatch[i];
+        }
+        for (size_t i = count; i-- > 0;)
+        {
+            const int32_t parent = m_index->node(static_cast<uint32_t>(i)).parent;
+            if (visible[i] && parent >= 0)
+            {
+                visible[static_cast<size_t>(parent)] = true;
+            }
+        }
+    }
+
+    m_childCount.assign(count + 1, 0);
+    m_row.assign(count, 0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (visible[i])
+        {
+            const size_t slot = static_cast<size_t>(m_index->node(static_cast<uint32_t>(i)).parent + 1);
+            m_row[i] = m_childCount[slot]++;
+        }
+    }
+    m_firstChild.assign(count + 1, 0);
+    for (size_t slot = 1; slot <= count; ++slot)
+    {
+        m_firstChild[slot] = m_firstChild[slot - 1] + m_childCount[slot - 1];
+    }
+    m_children.resize(m_firstChild[count] + m_childCount[count]);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (visible[i])
+        {
+            const size_t slot = static_cast<size_t>(m_index->node(static_cast<uint32_t>(i)).parent + 1);
+            m_children[m_firstChild[slot] + m_row[i]] = static_cast<uint32_t>(i);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/**
+ * @file CDicomTagModel.h
+ * @brief Item model over a DICOM tag index
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CDicomTagModel class which exposes a CDicomTagIndex as
+ * a two-column tree (tag, value) for the metadata panel.
+ */
+
+#pragma once
+
+#include "core/CDicomMetadata.h"
+#include "core/CDicomTagIndex.h"
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CDicomTagModel
+ * @brief Tree model of every element in a DICOM file
+ *
+ * Rows map onto index nodes; values are decoded by data(), so only the
+ * rows a view actually paints are ever decoded. A filter keeps the
+ * nodes whose tag or keyword matches, together with their ancestors and
+ * the contents of matching sequences.
+ *
+ * When a file cannot be indexed the model lists the summary tags of
+ * CDicomMetadata instead, flat and filtered by name.
+ */
+class CDicomTagModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+  public:
+    /**
+     * @brief Constructor
+     * @param parent Parent object
+     */
+    explicit CDicomTagModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~CDicomTagModel() override = default;
+
+    /** @name Content */
+    ///@{
+    /**
+     * @brief Shows the complete dataset of a file
+     * @param index Tag index of the file
+     */
+    void setTagIndex(std::shared_ptr<const CDicomTagIndex> index);
+
+    /**
+     * @brief Shows the summary tags of an image without an index
+     * @param metadata Metadata to list (can be nullptr)
+     */
+    void setSummary(const CDicomMetadata *metadata);
+
+    /**
+     * @brief Removes all rows
+     */
+    void clear();
+
+    /**
+     * @brief Restricts the rows to tags matching a search text
+     * @param text Tag number or keyword; empty shows everything
+     */
+    void setFilter(const QString &text);
+
+    /**
+     * @brief Number of rows left by the filter, at any depth
+     * @return Visible row count
+     */
+    size_t visibleCount() const;
+    ///@}
+
+    /** @name QAbstractItemModel Interface */
+    ///@{
+    QModelIndex index(int row, int column,
+                      const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    ///@}
+
+  private:
+    /**
+     * @brief Rebuilds the visible child lists for the current filter
+     */
+    void rebuild();
+
+    std::shared_ptr<const CDicomTagIndex> m_index;
+    std::vector<std::pair<QString, QString>> m_summary; /**< Rows when there is no index */
+    QString m_filter;
+
+    /** Visible children grouped by parent, laid out like CDicomTagIndex */
+    std::vector<uint32_t> m_children;
+    std::vector<uint32_t> m_firstChild; /**< Per parent + 1: start in m_children */
+    std::vector<uint32_t> m_childCount; /**< Per parent + 1: visible children */
+    std::vector<uint32_t> m_row;        /**< Per node: row under its parent */
+};
@@ -11,7 +11,9 @@
 
 #include "CImageViewer.h"
 
+#include "core/CDisplayPrefetcher.h"
 #include "utils/CColorPalette.h"
+#include "utils/CThreadPool.h"
 
 #include <QApplication>
 #include <QDragEnterEvent>
@@ -28,7 +30,6 @@
 #include <QMouseEvent>
 #include <QOpenGLBuffer>
 #include <QOpenGLContext>
-#include <QOpenGLFramebufferObject>
 #include <QOpenGLPixelTransferOptions>
 #include <QOpenGLShaderProgram>
 #include <QOpenGLTexture>
@@ -60,6 +61,16 @@ constexpr double kSensitivityCenter = 1.0; /**< Window center sensitivity */
 constexpr double kZoomStep = 1.2;
 constexpr double kMinZoom = 0.1;
 constexpr double kMaxZoom = 8.0;
+constexpr double kAutoWindowLowFraction = 0.01;  /**< Auto window lower percentile */
+constexpr double kAutoWindowHighFraction = 0.99; /**< Auto window upper percentile */
+constexpr double kDefaultCineFrameRate = 30.0;   /**< Playback rate without a header rate */
+constexpr double kMinCineFrameRate = 1.0;
+constexpr double kMaxCineFrameRate = 120.0;
+constexpr uint32_t kCinePrefetchAhead = 16; /**< Frames decoded ahead of the displayed one */
+constexpr uint32_t kCinePrefetchBehind = 2; /**< Frames kept behind it for stepping back */
+constexpr int64_t kTextureUploadBudgetNs = 4000000; /**< GUI thread time per frame spent streaming a texture */
+constexpr int kThumbnailPollMs = 4;                 /**< Interval between thumbnail readback polls */
+constexpr int kStagingRetryMs = 20;                 /**< Delay before retrying a rejected staging job */
 
 struct SQuadVertex
 {
@@ -167,7 +178,8 @@ QIcon makePaletteCircleIcon(DicomViewer::EPaletteType type, const QSize &size)
  * @param parent Parent widget
  */
 CImageViewer::CImageViewer(QWidget *parent)
-    : QOpenGLWidget(parent)
+    : QOpenGLWidget(parent),
+      m_stagingGuard(std::make_shared<SStagingGuard>())
 {
     setupWidgetProperties();
     setupWindowLevelPanel();
@@ -175,6 +187,22 @@ CImageViewer::CImageViewer(QWidget *parent)
     setupPaletteSelector();
     setupHudConnections();
 
+    m_cineFrameRate = kDefaultCineFrameRate;
+    m_cineTimer = new QTimer(this);
+    m_cineTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_cineTimer, &QTimer::timeout, this, &CImageViewer::advanceCineFrame);
+
+    m_thumbnailTimer = new QTimer(this);
+    m_thumbnailTimer->setInterval(kThumbnailPollMs);
+    connect(m_thumbnailTimer, &QTimer::timeout, this, &CImageViewer::collectThumbnails);
+
+    bool budgetOk = false;
+    const int textureCacheMb = qEnvironmentVariableIntValue("DICOMVIEWER_TEXTURE_CACHE_MB", &budgetOk);
+    if (budgetOk && textureCacheMb >= 0)
+    {
+        m_textureCache.setBudget(static_cast<size_t>(textureCacheMb) * 1024 * 1024);
+    }
+
     emit paletteChanged(DicomViewer::EPaletteType::Grayscale);
     positionHud();
     m_hud->setVisible(false);
@@ -494,10 +522,16 @@ void CImageViewer::setupHudConnections()
 
 CImageViewer::~CImageViewer()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_stagingGuard->mutex);
+        m_stagingGuard->alive = false;
+    }
     if (context())
     {
         makeCurrent();
-        delete m_texture;
+        m_thumbnailRenderer.destroy();
+        m_textureUpload.destroy();
+        m_textureCache.clear();
         m_texture = nullptr;
         delete m_paletteTexture;
         m_paletteTexture = nullptr;
@@ -511,7 +545,9 @@ CImageViewer::~CImageViewer()
     }
     else
     {
-        delete m_texture;
+        m_thumbnailRenderer.destroy();
+        m_textureUpload.cancel();
+        m_textureCache.clear();
         m_texture = nullptr;
         delete m_paletteTexture;
         m_paletteTexture = nullptr;
@@ -542,7 +578,17 @@ CImageViewer::~CImageViewer()
  */
 void CImageViewer::setDicomImage(std::shared_ptr<CDicomImage> image)
 {
+    setCinePlaying(false);
     m_dicomImage = image;
+    m_frameImage.reset();
+    m_currentFrame = 0;
+    m_cineFrameRate = (image && image->cineFrameRate() > 0.0)
+                          ? std::clamp(image->cineFrameRate(), kMinCineFrameRate, kMaxCineFrameRate)
+                          : kDefaultCineFrameRate;
+    if (image && image->frameCount() > 1)
+    {
+        image->prefetchFrames(0, kCinePrefetchAhead, kCinePrefetchBehind);
+    }
     updateDisplayImage();
     m_paletteDirty = true;
     configureWindowLevelControls();
@@ -554,6 +600,7 @@ void CImageViewer::setDicomImage(std::shared_ptr<CDicomImage> image)
     }
 
     update();
+    emit frameChanged(0, static_cast<int>(frameCount()));
 }
 
 /**
@@ -561,7 +608,10 @@ void CImageViewer::setDicomImage(std::shared_ptr<CDicomImage> image)
  */
 void CImageViewer::clearImage()
 {
+    setCinePlaying(false);
     m_dicomImage.reset();
+    m_frameImage.reset();
+    m_currentFrame = 0;
     updateDisplayImage();
     configureWindowLevelControls();
 
@@ -572,6 +622,7 @@ void CImageViewer::clearImage()
     }
 
     update();
+    emit frameChanged(0, 1);
     emit imageCleared();
 }
 
@@ -626,6 +677,152 @@ void CImageViewer::resetWindowLevel()
     }
 }
 
+/**
+ * @brief Fits window/level to the 1st-99th percentile of the pixels
+ */
+void CImageViewer::autoWindowLevel()
+{
+    if (!m_dicomImage)
+    {
+        return;
+    }
+    auto stats = displayedFrame().statistics();
+    if (!stats || !stats->isValid())
+    {
+        return;
+    }
+    setWindowLevel(stats->percentileWindow(kAutoWindowLowFraction, kAutoWindowHighFraction));
+}
+
+/**
+ * @brief Number of frames of the displayed image
+ * @return Frame count, 1 for single-frame images or no image
+ */
+uint32_t CImageViewer::frameCount() const
+{
+    return m_dicomImage ? m_dicomImage->frameCount() : 1;
+}
+
+/**
+ * @brief Index of the displayed frame
+ * @return Zero-based frame index
+ */
+uint32_t CImageViewer::currentFrame() const
+{
+    return m_currentFrame;
+}
+
+/**
+ * @brief Shows a frame and prefetches its neighbours
+ *
+ * The frame itself is decoded here if the prefetch has not reached it
+ * yet; the neighbours decode on a worker meanwhile.
+ *
+ * @param index Zero-based frame index (clamped to the frame count)
+ */
+void CImageViewer::setCurrentFrame(uint32_t index)
+{
+    if (!hasImage())
+    {
+        return;
+    }
+
+    const uint32_t count = frameCount();
+    index = std::min(index, count - 1);
+    if (index == m_currentFrame)
+    {
+        return;
+    }
+
+    m_currentFrame = index;
+    m_frameImage = m_dicomImage->frame(index);
+    m_dicomImage->prefetchFrames(index, kCinePrefetchAhead, kCinePrefetchBehind);
+    updateDisplayImage();
+    update();
+    emit frameChanged(static_cast<int>(index), static_cast<int>(count));
+}
+
+/**
+ * @brief Steps one frame forward, wrapping after the last
+ */
+void CImageViewer::nextFrame()
+{
+    setCurrentFrame((m_currentFrame + 1) % frameCount());
+}
+
+/**
+ * @brief Steps one frame back, wrapping before the first
+ */
+void CImageViewer::previousFrame()
+{
+    const uint32_t count = frameCount();
+    setCurrentFrame((m_currentFrame + count - 1) % count);
+}
+
+/**
+ * @brief Starts or stops cine playback
+ * @param playing True to play (ignored for single-frame images)
+ */
+void CImageViewer::setCinePlaying(bool playing)
+{
+    playing = playing && hasImage() && frameCount() > 1;
+    if (playing == isCinePlaying())
+    {
+        return;
+    }
+
+    if (playing)
+    {
+        m_cineTimer->start(qRound(1000.0 / m_cineFrameRate));
+    }
+    else
+    {
+        m_cineTimer->stop();
+    }
+    emit cinePlayingChanged(playing);
+}
+
+/**
+ * @brief Checks if cine playback is running
+ * @return True while playing
+ */
+bool CImageViewer::isCinePlaying() const
+{
+    return m_cineTimer && m_cineTimer->isActive();
+}
+
+/**
+ * @brief Sets the playback rate
+ * @param framesPerSecond Frames per second
+ */
+void CImageViewer::setCineFrameRate(double framesPerSecond)
+{
+    m_cineFrameRate = std::clamp(framesPerSecond, kMinCineFrameRate, kMaxCineFrameRate);
+    if (isCinePlaying())
+    {
+        m_cineTimer->start(qRound(1000.0 / m_cineFrameRate));
+    }
+}
+
+/**
+ * @brief Retrieves the playback rate
+ * @return Frames per second
+ */
+double CImageViewer::cineFrameRate() const
+{
+    return m_cineFrameRate;
+}
+
+void CImageViewer::advanceCineFrame()
+{
+    if (!hasImage() || frameCount() <= 1)
+    {
+        setCinePlaying(false);
+        return;
+    }
+    nextFrame();
+}
+
 /**
  * @brief Sets the color palette for display
  * @param type Palette type to apply
@@ -673,146 +870,56 @@ void CImageViewer::notifyViewStateChanged()
     emit viewStateChanged(m_zoom, m_panOffset.x(), m_panOffset.y(), m_rotationDegrees);
 }
 
-QImage CImageViewer::renderThumbnail(const QSize &size)
+/**
+ * @brief Renders thumbnails on the GPU in batches
+ * @param requests Thumbnails to render
+ * @param size Size each thumbnail is fitted into
+ * @return False if GPU rendering is unavailable
+ */
+bool CImageViewer::requestThumbnails(const std::vector<CThumbnailRenderer::SRequest> &requests,
+                                     const QSize &size)
 {
-    if (!hasImage() || size.isEmpty())
+    if (m_useCpuFallback || !context() || requests.empty() || size.isEmpty())
     {
-        return QImage();
-    }
-
-    if (m_useCpuFallback)
-    {
-        if (m_displayImage.isNull())
-        {
-            updateDisplayImage();
-        }
-        if (m_displayImage.isNull())
-        {
-            return QImage();
-        }
-        return m_displayImage.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
-
-    if (!context())
-    {
-        return QImage();
+        return false;
     }
 
     makeCurrent();
     ensureGlResources();
-    if (m_textureDirty)
-    {
-        uploadTexture();
-    }
-    if (m_paletteDirty)
-    {
-        uploadPalette();
-    }
-    if (m_verticesDirty)
-    {
-        updateGeometry();
-    }
-
-    if (!m_shaderProgram || !m_texture)
-    {
-        doneCurrent();
-        return QImage();
-    }
-
-    QOpenGLFramebufferObjectFormat fboFormat;
-    fboFormat.setAttachment(QOpenGLFramebufferObject::NoAttachment);
-    fboFormat.setInternalTextureFormat(GL_RGBA8);
-    QOpenGLFramebufferObject fbo(size, fboFormat);
-    if (!fbo.isValid())
-    {
-        doneCurrent();
-        return QImage();
-    }
-
-    fbo.bind();
-    glViewport(0, 0, size.width(), size.height());
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    const QSize imageSize = imagePixelSize();
-    const QSize rotatedSize = rotatedImageSize();
-    if (imageSize.isEmpty() || rotatedSize.isEmpty())
-    {
-        fbo.release();
-        doneCurrent();
-        return QImage();
-    }
+    const bool rendered =
+        m_shaderProgram && m_thumbnailRenderer.render(requests, size, *m_shaderProgram, m_textureCache);
+    doneCurrent();
 
-    double scale = 1.0;
-    if (rotatedSize.width() > 0 && rotatedSize.height() > 0)
+    if (rendered && !m_thumbnailTimer->isActive())
     {
-        const double scaleX = static_cast<double>(size.width()) / rotatedSize.width();
-        const double scaleY = static_cast<double>(size.height()) / rotatedSize.height();
-        scale = std::min(scaleX, scaleY);
+        m_thumbnailTimer->start();
     }
+    return rendered;
+}
 
-    QMatrix4x4 proj;
-    proj.ortho(0.0f, static_cast<float>(size.width()),
-               static_cast<float>(size.height()), 0.0f,
-               -1.0f, 1.0f);
-
-    QMatrix4x4 model;
-    model.translate(size.width() / 2.0f, size.height() / 2.0f);
-    model.rotate(static_cast<float>(m_rotationDegrees), 0.0f, 0.0f, 1.0f);
-    model.scale(static_cast<float>(scale), static_cast<float>(scale));
-    model.translate(-imageSize.width() / 2.0f, -imageSize.height() / 2.0f);
-
-    const QMatrix4x4 mvp = proj * model;
-
-    m_shaderProgram->bind();
-    if (m_vao)
+/**
+ * @brief Emits thumbnails whose readback has finished
+ */
+void CImageViewer::collectThumbnails()
+{
+    if (!context())
     {
-        m_vao->bind();
+        m_thumbnailTimer->stop();
+        return;
     }
 
-    const int texUnit = 0;
-    m_texture->bind(texUnit);
-    m_shaderProgram->setUniformValue("u_tex", texUnit);
-
-    const bool usePalette = (m_converter.paletteType() != DicomViewer::EPaletteType::Grayscale);
-    if (usePalette && m_paletteTexture)
+    makeCurrent();
+    const auto results = m_thumbnailRenderer.collect(false);
+    if (!m_thumbnailRenderer.hasPending())
     {
-        const int lutUnit = 1;
-        m_paletteTexture->bind(lutUnit);
-        m_shaderProgram->setUniformValue("u_lut", lutUnit);
+        m_thumbnailTimer->stop();
     }
+    doneCurrent();
 
-    const auto wl = m_dicomImage->windowLevel();
-    const bool invertForMonochrome1 =
-        (m_dicomImage->photometricInterpretation() ==
-         DicomViewer::EPhotometricInterpretation::Monochrome1);
-
-    m_shaderProgram->setUniformValue("u_mvp", mvp);
-    m_shaderProgram->setUniformValue("u_wc", static_cast<float>(wl.center));
-    m_shaderProgram->setUniformValue("u_ww", static_cast<float>(wl.width));
-    m_shaderProgram->setUniformValue("u_valueMin", static_cast<float>(m_textureValueMin));
-    m_shaderProgram->setUniformValue("u_valueMax", static_cast<float>(m_textureValueMax));
-    m_shaderProgram->setUniformValue("u_isColor", m_textureIsRgb ? 1 : 0);
-    m_shaderProgram->setUniformValue("u_usePalette", usePalette ? 1 : 0);
-    m_shaderProgram->setUniformValue("u_invert", invertForMonochrome1 ? 1 : 0);
-
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-    if (m_vao)
-    {
-        m_vao->release();
-    }
-    m_shaderProgram->release();
-    m_texture->release();
-    if (usePalette && m_paletteTexture)
+    for (const auto &result : results)
     {
-        m_paletteTexture->release();
+        emit thumbnailRendered(result.index, result.image, result.thumbnail);
     }
-
-    QImage image = fbo.toImage(true);
-    fbo.release();
-    doneCurrent();
-    return image;
 }
 
 void CImageViewer::zoomIn()
@@ -974,7 +1081,7 @@ void CImageViewer::paintGL()
             return;
         }
 
-        if (m_displayImage.isNull())
+        if (m_displayImage.isNull() || displayLevel() != m_displayLevel)
         {
             updateDisplayImage();
         }
@@ -999,7 +1106,7 @@ void CImageViewer::paintGL()
         transform.scale(scale, scale);
         transform.translate(-imageSize.width() / 2.0, -imageSize.height() / 2.0);
         painter.setTransform(transform);
-        painter.drawImage(QPointF(0.0, 0.0), m_displayImage);
+        painter.drawImage(QRectF(QPointF(0.0, 0.0), QSizeF(imageSize)), m_displayImage);
         return;
     }
 
@@ -1040,6 +1147,17 @@ void CImageViewer::paintGL()
     {
         uploadTexture();
     }
+    continueTextureUpload();
+    if (m_textureUpload.isActive() && !m_textureUpload.hasLevel())
+    {
+        // Nothing sampleable yet; the next frame continues the upload
+        return;
+    }
+    if (!m_texture && !m_stagingSource.expired())
+    {
+        // Drawn once the worker has the pixels and mips ready
+        return;
+    }
     if (m_paletteDirty)
     {
         uploadPalette();
@@ -1332,19 +1450,20 @@ void CImageViewer::updateDisplayImage()
         m_textureDirty = false;
         m_verticesDirty = false;
         m_displayImage = QImage();
-        if (m_texture)
+        // The texture stays cached in case the image is shown again
+        m_texture = nullptr;
+        m_textureSource.reset();
+        if (m_textureUpload.isActive())
         {
             if (context())
             {
                 makeCurrent();
-                delete m_texture;
-                m_texture = nullptr;
+                m_textureUpload.cancel();
                 doneCurrent();
             }
             else
             {
-                delete m_texture;
-                m_texture = nullptr;
+                m_textureUpload.cancel();
             }
         }
         return;
@@ -1352,7 +1471,12 @@ void CImageViewer::updateDisplayImage()
 
     if (m_useCpuFallback)
     {
-        m_displayImage = m_converter.toQImage(*m_dicomImage, m_dicomImage->windowLevel());
+        // Convert only the pyramid level needed at the current zoom
+        const CDicomImage &frame = displayedFrame();
+        const auto level = frame.pyramidLevel(displayLevel());
+        m_displayLevel = level ? displayLevel() : 0;
+        m_displayImage = m_converter.toQImage(level ? *level : frame,
+                                              m_dicomImage->windowLevel());
         return;
     }
 
@@ -1360,6 +1484,15 @@ void CImageViewer::updateDisplayImage()
     m_verticesDirty = true;
 }
 
+/**
+ * @brief Image holding the pixels of the displayed frame
+ * @return The frame image, or the DICOM image itself for frame 0
+ */
+const CDicomImage &CImageViewer::displayedFrame() const
+{
+    return m_frameImage ? *m_frameImage : *m_dicomImage;
+}
+
 double CImageViewer::fitScale() const
 {
     if (!hasImage())
@@ -1379,6 +1512,15 @@ double CImageViewer::fitScale() const
     return std::min(scaleX, scaleY);
 }
 
+uint32_t CImageViewer::displayLevel() const
+{
+    if (!hasImage())
+    {
+        return 0;
+    }
+    return m_dicomImage->pyramidLevelForScale(fitScale() * m_zoom);
+}
+
 QSize CImageViewer::rotatedImageSize() const
 {
     if (!hasImage())
@@ -1464,25 +1606,34 @@ void CImageViewer::configureWindowLevelControls()
         return;
     }
 
-    // Calculate range based on image bit depth
+    // Slider steps follow the stored value range when known, so a 12-bit
+    // CT in 16-bit words is not spread over the full 16-bit range
+    const auto range = m_dicomImage->valueRange();
     const auto dims = m_dicomImage->dimensions();
     const int bitsStored = dims.bitsStored > 0 ? dims.bitsStored : 8;
     const int maxPixelValue = (1 << bitsStored) - 1;
 
-    // For signed images, center can be negative
-    if (dims.isSigned)
+    if (range.max > range.min)
+    {
+        m_windowCenterMin = range.min;
+        m_windowCenterMax = range.max;
+        m_windowWidthMax = (range.max - range.min) * 2;
+    }
+    else if (dims.isSigned)
     {
+        // For signed images, center can be negative
         m_windowCenterMin = -(1 << (bitsStored - 1));
         m_windowCenterMax = (1 << (bitsStored - 1)) - 1;
+        m_windowWidthMax = maxPixelValue + 1;
     }
     else
     {
         m_windowCenterMin = 0;
         m_windowCenterMax = maxPixelValue;
+        m_windowWidthMax = maxPixelValue + 1;
     }
 
     m_windowWidthMin = DicomViewer::kMinWindowWidth;
-    m_windowWidthMax = maxPixelValue + 1;
 
     {
         QSignalBlocker blockCenter(m_centerSlider);
@@ -1654,123 +1805,129 @@ void CImageViewer::uploadTexture()
         return;
     }
 
-    const auto dims = m_dicomImage->dimensions();
-    const auto &pixelData = m_dicomImage->pixelData();
-    const size_t pixelCount = static_cast<size_t>(dims.width) * dims.height;
-    if (pixelCount == 0)
+    const std::shared_ptr<const CDicomImage> source =
+        m_frameImage ? m_frameImage : std::shared_ptr<const CDicomImage>(m_dicomImage);
+    if (m_texture && m_textureSource.lock() == source)
     {
+        // Re-shown image: the texture already holds its pixels and mips
+        m_textureDirty = false;
         return;
     }
+    if (const auto *cached = m_textureCache.find(source))
+    {
+        // Recently shown image: rebind its texture instead of uploading
+        m_texture = cached->texture;
+        m_textureIsRgb = cached->isRgb;
+        m_textureValueMin = cached->valueMin;
+        m_textureValueMax = cached->valueMax;
+        m_textureSource = source;
+        m_textureUpload.cancel();
+        m_textureDirty = false;
+        return;
+    }
+    // A texture still streaming for another image is abandoned
+    m_textureUpload.cancel();
+    m_texture = nullptr;
+    m_textureSource.reset();
 
-    if (m_texture)
+    const CDicomImage &frame = *source;
+    const bool stream = m_streamTextures && CTextureUploader::isSupported(context());
+    if (stream && !frame.isStagedForDisplay() && m_stagedSource.lock() != source)
     {
-        delete m_texture;
-        m_texture = nullptr;
+        // Decoding and building the mips would stall the GUI thread;
+        // the texture dirty flag stays set until the worker is done
+        stageTextureSource(source);
+        return;
+    }
+
+    const auto dims = frame.dimensions();
+    const auto &pixelData = frame.pixelData();
+    const size_t pixelCount = static_cast<size_t>(dims.width) * dims.height;
+    if (pixelCount == 0)
+    {
+        return;
     }
 
     m_textureIsRgb = (dims.samplesPerPixel == 3);
-    const bool is16bit = (m_dicomImage->bitsPerSample() == 16);
-    const bool isSigned = m_dicomImage->isPixelSigned();
+    const bool is16bit = (frame.bitsPerSample() == 16);
+    const bool isSigned = frame.isPixelSigned();
+    const int mipLevels = static_cast<int>(std::max<uint32_t>(1, frame.pyramidLevelCount()));
     DICOMVIEWER_LOG("Upload texture - pixel bytes:" << pixelData.size()
-                                                    << "expected:" << (pixelCount * (is16bit ? 2 : 1)));
+                                                    << "expected:" << (pixelCount * (is16bit ? 2 : 1))
+                                                    << "mip levels:" << mipLevels);
 
-    QOpenGLPixelTransferOptions pixelOpts;
-    pixelOpts.setAlignment(1);
-    pixelOpts.setRowLength(static_cast<int>(dims.width));
+    auto texture = std::make_unique<QOpenGLTexture>(QOpenGLTexture::Target2D);
+    m_texture = texture.get();
+    m_texture->create();
+    m_texture->setSize(static_cast<int>(dims.width), static_cast<int>(dims.height));
+    m_texture->setMipLevels(mipLevels);
 
     if (m_textureIsRgb)
     {
-        m_texture = new QOpenGLTexture(QOpenGLTexture::Target2D);
-        m_texture->create();
-        m_texture->setSize(static_cast<int>(dims.width), static_cast<int>(dims.height));
         m_texture->setFormat(QOpenGLTexture::RGB8_UNorm);
         m_texture->allocateStorage(QOpenGLTexture::RGB, QOpenGLTexture::UInt8);
-        m_texture->setMinificationFilter(QOpenGLTexture::Linear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::ClampToEdge);
-        m_texture->setData(QOpenGLTexture::RGB, QOpenGLTexture::UInt8, pixelData.data(), &pixelOpts);
         m_textureValueMin = 0;
         m_textureValueMax = 255;
         DICOMVIEWER_LOG("GL texture upload RGB"
                         << dims.width << "x" << dims.height
                         << "bytes:" << pixelData.size());
     }
+    else if (is16bit)
+    {
+        // Signed samples go up as-is into a signed normalized texture and
+        // read back as value / 32767; mix(0, 32767, t) restores them for
+        // negative t too, so no offset copy is needed
+        m_texture->setFormat(isSigned ? QOpenGLTexture::R16_SNorm : QOpenGLTexture::R16_UNorm);
+        m_texture->allocateStorage(QOpenGLTexture::Red,
+                                   isSigned ? QOpenGLTexture::Int16 : QOpenGLTexture::UInt16);
+        m_textureValueMin = 0;
+        m_textureValueMax = isSigned ? 32767 : 65535;
+        DICOMVIEWER_LOG("GL texture upload R16" << (isSigned ? "signed" : "unsigned")
+                                                << dims.width << "x" << dims.height);
+    }
     else
     {
-        m_texture = new QOpenGLTexture(QOpenGLTexture::Target2D);
-        m_texture->create();
-        m_texture->setSize(static_cast<int>(dims.width), static_cast<int>(dims.height));
+        m_texture->setFormat(QOpenGLTexture::R8_UNorm);
+        m_texture->allocateStorage(QOpenGLTexture::Red, QOpenGLTexture::UInt8);
+        m_textureValueMin = 0;
+        m_textureValueMax = 255;
+        DICOMVIEWER_LOG("GL texture upload R8"
+                        << dims.width << "x" << dims.height);
+    }
 
-        if (is16bit)
-        {
-            m_texture->setFormat(QOpenGLTexture::R16_UNorm);
-            m_texture->allocateStorage(QOpenGLTexture::Red, QOpenGLTexture::UInt16);
-            m_texture->setMinificationFilter(QOpenGLTexture::Linear);
-            m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-            m_texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    // Mip levels come from the image pyramid, which averages raw samples
+    // before windowing, so zoomed-out views sample about one texel per pixel
+    m_texture->setMinificationFilter(mipLevels > 1 ? QOpenGLTexture::LinearMipMapLinear
+                                                   : QOpenGLTexture::Linear);
+    m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
+    m_texture->setWrapMode(QOpenGLTexture::ClampToEdge);
 
-            if (isSigned)
-            {
-                std::vector<uint16_t> converted(pixelCount);
-                const auto *src = reinterpret_cast<const int16_t *>(pixelData.data());
-                int16_t minVal = std::numeric_limits<int16_t>::max();
-                int16_t maxVal = std::numeric_limits<int16_t>::min();
-                for (size_t i = 0; i < pixelCount; ++i)
-                {
-                    minVal = std::min(minVal, src[i]);
-                    maxVal = std::max(maxVal, src[i]);
-                    converted[i] = static_cast<uint16_t>(static_cast<int>(src[i]) + 32768);
-                }
-                m_texture->setData(QOpenGLTexture::Red, QOpenGLTexture::UInt16,
-                                   converted.data(), &pixelOpts);
-                m_textureValueMin = -32768;
-                m_textureValueMax = 32767;
-                DICOMVIEWER_LOG("GL texture upload R16 signed"
-                                << dims.width << "x" << dims.height);
-                DICOMVIEWER_LOG("Pixel range signed:" << minVal << "to" << maxVal);
-            }
-            else
-            {
-                const auto *src = reinterpret_cast<const uint16_t *>(pixelData.data());
-                uint16_t minVal = std::numeric_limits<uint16_t>::max();
-                uint16_t maxVal = std::numeric_limits<uint16_t>::min();
-                for (size_t i = 0; i < pixelCount; ++i)
-                {
-                    minVal = std::min(minVal, src[i]);
-                    maxVal = std::max(maxVal, src[i]);
-                }
-                m_texture->setData(QOpenGLTexture::Red, QOpenGLTexture::UInt16,
-                                   pixelData.data(), &pixelOpts);
-                m_textureValueMin = 0;
-                m_textureValueMax = 65535;
-                DICOMVIEWER_LOG("GL texture upload R16 unsigned"
-                                << dims.width << "x" << dims.height);
-                DICOMVIEWER_LOG("Pixel range unsigned:" << minVal << "to" << maxVal);
-            }
-        }
-        else
+    if (stream && frame.isPixelDataResident())
+    {
+        // Streamed by continueTextureUpload() a few strips per frame
+        m_textureUpload.begin(std::move(texture), source);
+        m_texture = m_textureUpload.texture();
+        m_textureSource = source;
+        m_textureDirty = false;
+        return;
+    }
+
+    uploadTextureLevel(0, frame);
+    for (int mip = 1; mip < mipLevels; ++mip)
+    {
+        const auto level = frame.pyramidLevel(static_cast<uint32_t>(mip));
+        if (!level)
         {
-            m_texture->setFormat(QOpenGLTexture::R8_UNorm);
-            m_texture->allocateStorage(QOpenGLTexture::Red, QOpenGLTexture::UInt8);
-            m_texture->setMinificationFilter(QOpenGLTexture::Linear);
-            m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-            m_texture->setWrapMode(QOpenGLTexture::ClampToEdge);
-            m_texture->setData(QOpenGLTexture::Red, QOpenGLTexture::UInt8, pixelData.data(),
-                               &pixelOpts);
-            m_textureValueMin = 0;
-            m_textureValueMax = 255;
-            DICOMVIEWER_LOG("GL texture upload R8"
-                            << dims.width << "x" << dims.height);
-            const auto *src = pixelData.data();
-            uint8_t minVal = std::numeric_limits<uint8_t>::max();
-            uint8_t maxVal = std::numeric_limits<uint8_t>::min();
-            for (size_t i = 0; i < pixelCount; ++i)
-            {
-                minVal = std::min(minVal, src[i]);
-                maxVal = std::max(maxVal, src[i]);
-            }
-            DICOMVIEWER_LOG("Pixel range 8-bit:" << minVal << "to" << maxVal);
+            m_texture->setMipMaxLevel(mip - 1);
+            break;
         }
+        uploadTextureLevel(mip, *level);
+    }
+
+    // Precomputed at load, so logging the range costs no pixel scan
+    if (auto stats = m_dicomImage->statistics(); stats && stats->isValid())
+    {
+        DICOMVIEWER_LOG("Pixel range:" << stats->minValue() << "to" << stats->maxValue());
     }
 
     if (m_texture)
@@ -1779,9 +1936,133 @@ void CImageViewer::uploadTexture()
                                            << "size:" << m_texture->width() << "x" << m_texture->height());
     }
 
+    // The cache owns the texture from here and may evict older ones
+    m_textureCache.insert(source, std::move(texture), m_textureIsRgb, m_textureValueMin,
+                          m_textureValueMax);
+    m_textureSource = source;
     m_textureDirty = false;
 }
 
+/**
+ * @brief Streams the pending texture upload for one frame budget
+ *
+ * Schedules another frame while levels remain and moves the finished
+ * texture into the cache. Falls back to synchronous uploads if the
+ * staging buffers cannot be created or mapped.
+ */
+void CImageViewer::continueTextureUpload()
+{
+    if (!m_textureUpload.isActive())
+    {
+        return;
+    }
+
+    const bool complete = m_textureUpload.step(kTextureUploadBudgetNs);
+    if (!m_textureUpload.isActive())
+    {
+        DICOMVIEWER_WARN("Streaming texture upload unavailable, uploading synchronously");
+        m_streamTextures = false;
+        m_texture = nullptr;
+        m_textureSource.reset();
+        uploadTexture();
+        return;
+    }
+    if (!complete)
+    {
+        // Drawn from the finest level uploaded so far
+        update();
+        return;
+    }
+
+    const auto source = m_textureUpload.source();
+    m_textureCache.insert(source, m_textureUpload.takeTexture(), m_textureIsRgb,
+                          m_textureValueMin, m_textureValueMax);
+    DICOMVIEWER_LOG("Texture upload complete:" << m_texture->width() << "x" << m_texture->height());
+}
+
+/**
+ * @brief Decodes @p source and builds its mips on the shared pool
+ *
+ * The texture is uploaded on the next paint after the job finishes. If
+ * the image is evicted again meanwhile, that upload happens
+ * synchronously instead of staging forever.
+ *
+ * @param source Frame about to be uploaded
+ */
+void CImageViewer::stageTextureSource(const std::shared_ptr<const CDicomImage> &source)
+{
+    if (m_stagingSource.lock() == source)
+    {
+        return;
+    }
+    m_stagingSource = source;
+
+    const bool submitted = CThreadPool::shared().trySubmit(
+        [this, guard = m_stagingGuard, source]()
+        {
+            CDisplayPrefetcher::stage(*source);
+            std::lock_guard<std::mutex> lock(guard->mutex);
+            if (!guard->alive)
+            {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, source]()
+                { onTextureSourceStaged(source); },
+                Qt::QueuedConnection);
+        });
+    if (!submitted)
+    {
+        // The queue is full of prefetch work; try again shortly
+        m_stagingSource.reset();
+        QTimer::singleShot(kStagingRetryMs, this, [this]()
+                           { update(); });
+    }
+}
+
+void CImageViewer::onTextureSourceStaged(const std::shared_ptr<const CDicomImage> &source)
+{
+    if (m_stagingSource.lock() == source)
+    {
+        m_stagingSource.reset();
+    }
+    m_stagedSource = source;
+    update();
+}
+
+void CImageViewer::uploadTextureLevel(int mipLevel, const CDicomImage &source)
+{
+    const auto dims = source.dimensions();
+    const auto pixelData = source.pixelData();
+    const size_t pixelCount = static_cast<size_t>(dims.width) * dims.height;
+    if (pixelData.empty() || pixelCount == 0)
+    {
+        return;
+    }
+
+    QOpenGLPixelTransferOptions pixelOpts;
+    pixelOpts.setAlignment(1);
+    pixelOpts.setRowLength(static_cast<int>(dims.width));
+
+    if (m_textureIsRgb)
+    {
+        m_texture->setData(mipLevel, QOpenGLTexture::RGB, QOpenGLTexture::UInt8,
+                           pixelData.data(), &pixelOpts);
+    }
+    else if (source.bitsPerSample() == 16)
+    {
+        m_texture->setData(mipLevel, QOpenGLTexture::Red,
+                           source.isPixelSigned() ? QOpenGLTexture::Int16 : QOpenGLTexture::UInt16,
+                           pixelData.data(), &pixelOpts);
+    }
+    else
+    {
+        m_texture->setData(mipLevel, QOpenGLTexture::Red, QOpenGLTexture::UInt8,
+                           pixelData.data(), &pixelOpts);
+    }
+}
+
 void CImageViewer::uploadPalette()
 {
     const auto &palette = m_converter.palette();
@@ -10,6 +10,9 @@
 
 #pragma once
 
+#include "CTextureCache.h"
+#include "CThumbnailRenderer.h"
+#include "CTextureUploader.h"
 #include "core/CDicomImage.h"
 #include "utils/CColorPalette.h"
 #include "utils/CImageConverter.h"
@@ -23,6 +26,8 @@
 #include <QStringList>
 #include <QVector>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 class QFrame;
 class QEvent;
@@ -39,6 +44,7 @@ class QOpenGLShaderProgram;
 class QOpenGLBuffer;
 class QOpenGLVertexArrayObject;
 class QOpenGLTexture;
+class QTimer;
 
 /**
  * @class CImageViewer
@@ -104,6 +110,14 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
      */
     void resetWindowLevel();
 
+    /**
+     * @brief Fits window/level to the 1st-99th percentile of the pixels
+     *
+     * Reads the image's precomputed histogram, so outliers (metal,
+     * background padding) do not stretch the window.
+     */
+    void autoWindowLevel();
+
     /**
      * @brief Enables or disables mouse window/level adjustment
      * @param enabled True to enable adjustment
@@ -117,6 +131,61 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
     bool isWindowLevelAdjustmentEnabled() const;
     ///@}
 
+    /** @name Multi-frame Playback */
+    ///@{
+    /**
+     * @brief Number of frames of the displayed image
+     * @return Frame count, 1 for single-frame images or no image
+     */
+    uint32_t frameCount() const;
+
+    /**
+     * @brief Index of the displayed frame
+     * @return Zero-based frame index
+     */
+    uint32_t currentFrame() const;
+
+    /**
+     * @brief Shows a frame and prefetches its neighbours
+     * @param index Zero-based frame index (clamped to the frame count)
+     */
+    void setCurrentFrame(uint32_t index);
+
+    /**
+     * @brief Steps one frame forward, wrapping after the last
+     */
+    void nextFrame();
+
+    /**
+     * @brief Steps one frame back, wrapping before the first
+     */
+    void previousFrame();
+
+    /**
+     * @brief Starts or stops cine playback
+     * @param playing True to play (ignored for single-frame images)
+     */
+    void setCinePlaying(bool playing);
+
+    /**
+     * @brief Checks if cine playback is running
+     * @return True while playing
+     */
+    bool isCinePlaying() const;
+
+    /**
+     * @brief Sets the playback rate
+     * @param framesPerSecond Frames per second
+     */
+    void setCineFrameRate(double framesPerSecond);
+
+    /**
+     * @brief Retrieves the playback rate
+     * @return Frames per second
+     */
+    double cineFrameRate() const;
+    ///@}
+
     /** @name Color Palette Control */
     ///@{
     /**
@@ -145,11 +214,16 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
     void setViewState(const SViewState &state);
 
     /**
-     * @brief Renders a thumbnail using the current render pipeline
-     * @param size Target thumbnail size
-     * @return QImage of the thumbnail (empty if not available)
+     * @brief Renders thumbnails on the GPU in batches
+     *
+     * Results arrive asynchronously through thumbnailRendered().
+     *
+     * @param requests Thumbnails to render
+     * @param size Size each thumbnail is fitted into
+     * @return False if GPU rendering is unavailable; nothing will be emitted
      */
-    QImage renderThumbnail(const QSize &size);
+    bool requestThumbnails(const std::vector<CThumbnailRenderer::SRequest> &requests,
+                           const QSize &size);
 
     /** @name View Controls */
     ///@{
@@ -186,6 +260,27 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
     void filesDropped(const QStringList &paths);
     void viewStateChanged(double zoom, double panX, double panY, int rotation);
 
+    /**
+     * @brief Emitted when the displayed frame changes
+     * @param index Zero-based frame index
+     * @param count Number of frames
+     */
+    void frameChanged(int index, int count);
+
+    /**
+     * @brief Emitted for each thumbnail finished by requestThumbnails()
+     * @param index Index passed with the request
+     * @param image Image the thumbnail was rendered from (identity only)
+     * @param thumbnail Rendered thumbnail
+     */
+    void thumbnailRendered(int index, const CDicomImage *image, const QImage &thumbnail);
+
+    /**
+     * @brief Emitted when cine playback starts or stops
+     * @param playing True while playing
+     */
+    void cinePlayingChanged(bool playing);
+
   protected:
     /** @name Event Handlers */
     ///@{
@@ -221,7 +316,14 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
      */
     void updateDisplayImage();
 
+    /**
+     * @brief Image holding the pixels of the displayed frame
+     * @return The frame image, or the DICOM image itself for frame 0
+     */
+    const CDicomImage &displayedFrame() const;
+
     double fitScale() const;
+    uint32_t displayLevel() const;
     QSize rotatedImageSize() const;
     void positionHud();
     void positionWLControls();
@@ -234,12 +336,22 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
     QSize imagePixelSize() const;
     void ensureGlResources();
     void uploadTexture();
+    void continueTextureUpload();
+    void stageTextureSource(const std::shared_ptr<const CDicomImage> &source);
+    void onTextureSourceStaged(const std::shared_ptr<const CDicomImage> &source);
+    void collectThumbnails();
+    void uploadTextureLevel(int mipLevel, const CDicomImage &source);
     void uploadPalette();
     void updateGeometry();
     void notifyViewStateChanged();
+    void advanceCineFrame();
     ///@}
 
     std::shared_ptr<CDicomImage> m_dicomImage; /**< Source DICOM image */
+    std::shared_ptr<const CDicomImage> m_frameImage; /**< Displayed frame, null for frame 0 */
+    uint32_t m_currentFrame = 0;                     /**< Displayed frame index */
+    QTimer *m_cineTimer = nullptr;                   /**< Drives cine playback */
+    double m_cineFrameRate = 0.0;                    /**< Playback rate (fps) */
     CImageConverter m_converter;               /**< Image converter instance */
 
     bool m_isAdjustingWindowLevel = false;      /**< Mouse drag state */
@@ -273,7 +385,25 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
     QOpenGLShaderProgram *m_shaderProgram = nullptr;
     QOpenGLVertexArrayObject *m_vao = nullptr;
     QOpenGLBuffer *m_vbo = nullptr;
-    QOpenGLTexture *m_texture = nullptr;
+    CTextureCache m_textureCache;
+    CTextureUploader m_textureUpload; /**< Texture being streamed in, not yet cached */
+    bool m_streamTextures = true;     /**< False once staging buffers failed */
+
+    /**
+     * @brief Lets staging jobs on the shared pool outlive the viewer
+     */
+    struct SStagingGuard
+    {
+        std::mutex mutex;
+        bool alive = true;
+    };
+    std::shared_ptr<SStagingGuard> m_stagingGuard;
+    std::weak_ptr<const CDicomImage> m_stagingSource; /**< Frame being staged on a worker */
+    std::weak_ptr<const CDicomImage> m_stagedSource;  /**< Frame whose staging last finished */
+    CThumbnailRenderer m_thumbnailRenderer;
+    QTimer *m_thumbnailTimer = nullptr; /**< Polls thumbnail readbacks */
+    QOpenGLTexture *m_texture = nullptr;              /**< Bound texture, owned by m_textureCache */
+    std::weak_ptr<const CDicomImage> m_textureSource; /**< Frame m_texture was uploaded from */
     QOpenGLTexture *m_paletteTexture = nullptr;
     bool m_textureDirty = false;
     bool m_paletteDirty = false;
@@ -282,6 +412,7 @@ class CImageViewer : public QOpenGLWidget, protected QOpenGLFunctions
     int m_textureValueMin = 0;
     int m_textureValueMax = 255;
     QImage m_displayImage;
+    uint32_t m_displayLevel = 0; /**< Pyramid level m_displayImage was converted from */
     bool m_useCpuFallback = false;
     bool m_loggedGlInfo = false;
     bool m_loggedDrawError = false;
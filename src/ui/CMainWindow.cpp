@@ -24,16 +24,19 @@
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QPainter>
+#include <QProgressBar>
 #include <QSignalBlocker>
 #include <QSize>
 #include <QStackedWidget>
 #include <QStatusBar>
 #include <QStyle>
+#include <QTimer>
 #include <QSvgRenderer>
 #include <QTextEdit>
 #include <QToolBar>
 #include <QVBoxLayout>
 #include <algorithm>
+#include <utility>
 
 /**
  * @brief Constructor
@@ -84,6 +87,21 @@ void CMainWindow::setupMenuBar()
     openAction->setStatusTip(tr("Open a DICOM file"));
     connect(openAction, &QAction::triggered, this, &CMainWindow::onOpenFileClicked);
 
+    QAction *openFolderAction = fileMenu->addAction(tr("Open &Folder..."));
+    openFolderAction->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_O));
+    openFolderAction->setStatusTip(tr("Index a folder of DICOM files and browse its studies"));
+    connect(openFolderAction, &QAction::triggered, this, &CMainWindow::onOpenFolderClicked);
+
+    m_cancelLoadingAction = fileMenu->addAction(tr("&Cancel Loading"));
+    m_cancelLoadingAction->setStatusTip(tr("Stop loading the remaining queued files"));
+    m_cancelLoadingAction->setEnabled(false);
+    connect(m_cancelLoadingAction, &QAction::triggered, this, [this]()
+            {
+                if (m_viewModel)
+                {
+                    m_viewModel->cancelLoading();
+                } });
+
     fileMenu->addSeparator();
 
     // Export Image submenu
@@ -165,6 +183,105 @@ void CMainWindow::setupMenuBar()
     resetWLAction->setStatusTip(tr("Reset window/level to default values"));
     connect(resetWLAction, &QAction::triggered, this, &CMainWindow::onResetWindowLevelClicked);
 
+    QAction *autoWLAction = viewMenu->addAction(tr("&Auto Window/Level"));
+    autoWLAction->setShortcut(QKeySequence(Qt::SHIFT | Qt::Key_A));
+    autoWLAction->setStatusTip(tr("Fit window/level to the image histogram"));
+    connect(autoWLAction, &QAction::triggered, this, &CMainWindow::onAutoWindowLevelClicked);
+
+    QMenu *cineMenu = menuBar()->addMenu(tr("&Cine"));
+
+    m_cinePlayAction = cineMenu->addAction(tr("&Play"));
+    m_cinePlayAction->setCheckable(true);
+    m_cinePlayAction->setShortcut(QKeySequence(Qt::Key_Space));
+    m_cinePlayAction->setStatusTip(tr("Play or pause the frames of a multi-frame image"));
+    connect(m_cinePlayAction, &QAction::toggled, this, &CMainWindow::onCinePlayToggled);
+
+    QAction *nextFrameAction = cineMenu->addAction(tr("&Next Frame"));
+    nextFrameAction->setShortcut(QKeySequence(Qt::Key_Period));
+    nextFrameAction->setStatusTip(tr("Show the next frame"));
+    connect(nextFrameAction, &QAction::triggered, this, &CMainWindow::onNextFrame);
+
+    QAction *previousFrameAction = cineMenu->addAction(tr("P&revious Frame"));
+    previousFrameAction->setShortcut(QKeySequence(Qt::Key_Comma));
+    previousFrameAction->setStatusTip(tr("Show the previous frame"));
+    connect(previousFrameAction, &QAction::triggered, this, &CMainWindow::onPreviousFrame);
+
+    QMenu *mprMenu = menuBar()->addMenu(tr("&MPR"));
+    m_mprActionGroup = new QActionGroup(this);
+    m_mprActionGroup->setExclusive(true);
+
+    const struct
+    {
+        DicomViewer::EMprPlane plane;
+        const char *text;
+        Qt::Key key;
+    } planes[] = {
+        {DicomViewer::EMprPlane::Acquisition, QT_TR_NOOP("A&cquired Slices"), Qt::Key_5},
+        {DicomViewer::EMprPlane::Axial, QT_TR_NOOP("&Axial"), Qt::Key_6},
+        {DicomViewer::EMprPlane::Coronal, QT_TR_NOOP("&Coronal"), Qt::Key_7},
+        {DicomViewer::EMprPlane::Sagittal, QT_TR_NOOP("&Sagittal"), Qt::Key_8},
+    };
+    for (const auto &entry : planes)
+    {
+        QAction *action = mprMenu->addAction(tr(entry.text));
+        action->setCheckable(true);
+        action->setChecked(entry.plane == DicomViewer::EMprPlane::Acquisition);
+        action->setShortcut(QKeySequence(entry.key));
+        action->setData(static_cast<int>(entry.plane));
+        action->setStatusTip(tr("Reformat the current series (needs two or more slices of one series)"));
+        m_mprActionGroup->addAction(action);
+        connect(action, &QAction::triggered, this, &CMainWindow::onMprPlaneSelected);
+    }
+
+    mprMenu->addSeparator();
+
+    QAction *nextPlaneAction = mprMenu->addAction(tr("&Next Plane"));
+    nextPlaneAction->setShortcut(QKeySequence(Qt::Key_PageDown));
+    nextPlaneAction->setStatusTip(tr("Move the reformatted plane or projected slab forward"));
+    connect(nextPlaneAction, &QAction::triggered, this, &CMainWindow::onNextPlane);
+
+    QAction *previousPlaneAction = mprMenu->addAction(tr("&Previous Plane"));
+    previousPlaneAction->setShortcut(QKeySequence(Qt::Key_PageUp));
+    previousPlaneAction->setStatusTip(tr("Move the reformatted plane or projected slab back"));
+    connect(previousPlaneAction, &QAction::triggered, this, &CMainWindow::onPreviousPlane);
+
+    mprMenu->addSeparator();
+
+    QMenu *projectionMenu = mprMenu->addMenu(tr("P&rojection"));
+    m_projectionActionGroup = new QActionGroup(this);
+    m_projectionActionGroup->setExclusive(true);
+
+    const struct
+    {
+        DicomViewer::EProjectionMode mode;
+        const char *text;
+    } projections[] = {
+        {DicomViewer::EProjectionMode::Off, QT_TR_NOOP("&Off")},
+        {DicomViewer::EProjectionMode::Maximum, QT_TR_NOOP("&Maximum Intensity (MIP)")},
+        {DicomViewer::EProjectionMode::Minimum, QT_TR_NOOP("Mi&nimum Intensity (MinIP)")},
+        {DicomViewer::EProjectionMode::Average, QT_TR_NOOP("&Average Intensity (AvgIP)")},
+    };
+    for (const auto &entry : projections)
+    {
+        QAction *action = projectionMenu->addAction(tr(entry.text));
+        action->setCheckable(true);
+        action->setChecked(entry.mode == DicomViewer::EProjectionMode::Off);
+        action->setData(static_cast<int>(entry.mode));
+        action->setStatusTip(tr("Project a slab of acquired slices of the current series"));
+        m_projectionActionGroup->addAction(action);
+        connect(action, &QAction::triggered, this, &CMainWindow::onProjectionModeSelected);
+    }
+
+    QAction *thickerSlabAction = mprMenu->addAction(tr("&Thicker Slab"));
+    thickerSlabAction->setShortcut(QKeySequence(Qt::SHIFT | Qt::Key_PageUp));
+    thickerSlabAction->setStatusTip(tr("Add a slice on each side of the projected slab"));
+    connect(thickerSlabAction, &QAction::triggered, this, &CMainWindow::onThickerSlab);
+
+    QAction *thinnerSlabAction = mprMenu->addAction(tr("T&hinner Slab"));
+    thinnerSlabAction->setShortcut(QKeySequence(Qt::SHIFT | Qt::Key_PageDown));
+    thinnerSlabAction->setStatusTip(tr("Remove a slice from each side of the projected slab"));
+    connect(thinnerSlabAction, &QAction::triggered, this, &CMainWindow::onThinnerSlab);
+
     QMenu *helpMenu = menuBar()->addMenu(tr("&Help"));
 
     QAction *aboutAction = helpMenu->addAction(tr("&About"));
@@ -225,6 +342,14 @@ void CMainWindow::setupStatusBar()
 {
     statusBar()->setObjectName("MainStatusBar");
 
+    // Background loading progress (hidden while idle)
+    m_loadProgressBar = new QProgressBar(this);
+    m_loadProgressBar->setMaximumWidth(160);
+    m_loadProgressBar->setTextVisible(true);
+    m_loadProgressBar->setFormat(tr("Loading %v/%m"));
+    m_loadProgressBar->setVisible(false);
+    statusBar()->addPermanentWidget(m_loadProgressBar);
+
     // Image type indicator (Grayscale/RGB)
     m_imageTypeLabel = new QLabel(this);
     m_imageTypeLabel->setMinimumWidth(120);
@@ -237,6 +362,18 @@ void CMainWindow::setupStatusBar()
     m_imageSizeLabel->setMinimumWidth(100);
     statusBar()->addPermanentWidget(m_imageSizeLabel);
 
+    // Frame indicator (multi-frame images only)
+    m_frameLabel = new QLabel(this);
+    m_frameLabel->setMinimumWidth(110);
+    m_frameLabel->setVisible(false);
+    statusBar()->addPermanentWidget(m_frameLabel);
+
+    // Reformatted plane indicator (MPR only)
+    m_planeLabel = new QLabel(this);
+    m_planeLabel->setMinimumWidth(130);
+    m_planeLabel->setVisible(false);
+    statusBar()->addPermanentWidget(m_planeLabel);
+
     // Palette indicator
     m_paletteLabel = new QLabel(this);
     m_paletteLabel->setMinimumWidth(100);
@@ -284,10 +421,12 @@ void CMainWindow::setupDockWidgets()
     const QColor iconColor("#475569"); // Slate gray
 
     m_thumbnailWidget = new CThumbnailWidget(this);
+    m_studyBrowser = new CStudyBrowser(this);
     m_sidePanelStack = new QStackedWidget(this);
     m_sidePanelStack->setObjectName("SidePanelStack");
     m_sidePanelStack->addWidget(m_thumbnailWidget);
     m_sidePanelStack->addWidget(m_metadataPanel);
+    m_sidePanelStack->addWidget(m_studyBrowser);
 
     m_sidePanelDock = new QDockWidget(tr("Thumbnails"), this);
     m_sidePanelDock->setObjectName("SidePanelDock");
@@ -344,6 +483,24 @@ void CMainWindow::setupDockWidgets()
             m_sidePanelDock->raise();
         } });
 
+    m_showStudiesAction = new QAction(this);
+    m_showStudiesAction->setCheckable(true);
+    m_showStudiesAction->setText(tr("Studies"));
+    m_showStudiesAction->setIcon(loadSvgIcon(":/icons/list-tree.svg", iconColor));
+    m_showStudiesAction->setToolTip(tr("Show studies of the indexed folder"));
+    sideGroup->addAction(m_showStudiesAction);
+    sideBar->addAction(m_showStudiesAction);
+    connect(m_showStudiesAction, &QAction::triggered, this, [this]()
+            {
+        if (m_sidePanelStack) {
+            m_sidePanelStack->setCurrentIndex(2);
+        }
+        if (m_sidePanelDock) {
+            m_sidePanelDock->setWindowTitle(tr("Studies"));
+            m_sidePanelDock->show();
+            m_sidePanelDock->raise();
+        } });
+
     sideBar->addSeparator();
 
     // Open file action
@@ -370,6 +527,12 @@ void CMainWindow::setupConnections()
             this, &CMainWindow::onViewStateChanged);
     connect(m_imageViewer, &CImageViewer::filesDropped,
             this, &CMainWindow::onFilesDropped);
+    connect(m_imageViewer, &CImageViewer::frameChanged,
+            this, &CMainWindow::onFrameChanged);
+    connect(m_imageViewer, &CImageViewer::cinePlayingChanged,
+            this, &CMainWindow::onCinePlayingChanged);
+    connect(m_imageViewer, &CImageViewer::thumbnailRendered,
+            this, &CMainWindow::onThumbnailRendered);
     if (m_thumbnailWidget)
     {
         connect(m_thumbnailWidget, &CThumbnailWidget::imageSelected,
@@ -377,6 +540,12 @@ void CMainWindow::setupConnections()
         connect(m_thumbnailWidget, &CThumbnailWidget::imageDeleteRequested,
                 this, &CMainWindow::onThumbnailDeleteRequested);
     }
+    if (m_studyBrowser)
+    {
+        // Opening a series loads its files as if they had been dropped
+        connect(m_studyBrowser, &CStudyBrowser::seriesActivated,
+                this, &CMainWindow::onFilesDropped);
+    }
 
     if (m_viewModel)
     {
@@ -397,6 +566,22 @@ void CMainWindow::setupConnections()
                 this, &CMainWindow::applyCurrentImage);
         connect(m_viewModel.get(), &MainViewModel::paletteUpdated,
                 this, &CMainWindow::applyPaletteState);
+        connect(m_viewModel.get(), &MainViewModel::loadProgress,
+                this, &CMainWindow::onLoadProgress);
+        connect(m_viewModel.get(), &MainViewModel::mprImageChanged,
+                this, &CMainWindow::onMprImageChanged);
+        connect(m_viewModel.get(), &MainViewModel::catalogChanged,
+                this, [this]()
+                {
+                    if (m_studyBrowser)
+                    {
+                        m_studyBrowser->setCatalog(m_viewModel->catalog());
+                    } });
+        if (m_studyBrowser)
+        {
+            connect(m_viewModel.get(), &MainViewModel::indexProgress,
+                    m_studyBrowser, &CStudyBrowser::setProgress);
+        }
     }
 }
 
@@ -451,6 +636,37 @@ void CMainWindow::onOpenFileClicked()
     }
 }
 
+/**
+ * @brief Handles Open Folder action
+ */
+void CMainWindow::onOpenFolderClicked()
+{
+    const QString startDir = m_lastOpenDirectory.isEmpty()
+                                 ? QDir::homePath()
+                                 : m_lastOpenDirectory;
+
+    const QString folderPath = QFileDialog::getExistingDirectory(
+        this,
+        tr("Open DICOM Folder"),
+        startDir);
+
+    if (folderPath.isEmpty())
+    {
+        return;
+    }
+
+    m_lastOpenDirectory = folderPath;
+
+    if (m_viewModel)
+    {
+        m_viewModel->openFolder(folderPath);
+        if (m_showStudiesAction)
+        {
+            m_showStudiesAction->trigger();
+        }
+    }
+}
+
 void CMainWindow::onFilesDropped(const QStringList &filePaths)
 {
     if (filePaths.isEmpty())
@@ -476,6 +692,213 @@ void CMainWindow::onResetWindowLevelClicked()
     m_imageViewer->resetWindowLevel();
 }
 
+/**
+ * @brief Handles Auto Window/Level action
+ */
+void CMainWindow::onAutoWindowLevelClicked()
+{
+    m_imageViewer->autoWindowLevel();
+}
+
+/**
+ * @brief Handles the Play cine action
+ * @param checked True to start playback
+ */
+void CMainWindow::onCinePlayToggled(bool checked)
+{
+    m_imageViewer->setCinePlaying(checked);
+}
+
+/**
+ * @brief Handles the Next Frame action
+ */
+void CMainWindow::onNextFrame()
+{
+    m_imageViewer->setCinePlaying(false);
+    m_imageViewer->nextFrame();
+}
+
+/**
+ * @brief Handles the Previous Frame action
+ */
+void CMainWindow::onPreviousFrame()
+{
+    m_imageViewer->setCinePlaying(false);
+    m_imageViewer->previousFrame();
+}
+
+/**
+ * @brief Updates the frame indicator
+ * @param index Zero-based frame index
+ * @param count Number of frames
+ */
+void CMainWindow::onFrameChanged(int index, int count)
+{
+    m_frameLabel->setVisible(count > 1);
+    m_frameLabel->setText(tr("Frame: %1/%2").arg(index + 1).arg(count));
+}
+
+/**
+ * @brief Keeps the Play action in sync with the viewer
+ * @param playing True while playing
+ */
+void CMainWindow::onCinePlayingChanged(bool playing)
+{
+    QSignalBlocker blocker(m_cinePlayAction);
+    m_cinePlayAction->setChecked(playing);
+    m_cinePlayAction->setText(playing ? tr("&Pause") : tr("&Play"));
+}
+
+/**
+ * @brief Handles the plane actions of the MPR menu
+ */
+void CMainWindow::onMprPlaneSelected()
+{
+    auto *action = qobject_cast<QAction *>(sender());
+    if (action && m_viewModel)
+    {
+        m_viewModel->setMprPlane(static_cast<DicomViewer::EMprPlane>(action->data().toInt()));
+    }
+}
+
+/**
+ * @brief Handles the Next Plane action
+ */
+void CMainWindow::onNextPlane()
+{
+    if (m_viewModel)
+    {
+        m_viewModel->stepMprPlane(1);
+    }
+}
+
+/**
+ * @brief Handles the Previous Plane action
+ */
+void CMainWindow::onPreviousPlane()
+{
+    if (m_viewModel)
+    {
+        m_viewModel->stepMprPlane(-1);
+    }
+}
+
+/**
+ * @brief Handles the mode actions of the Projection menu
+ */
+void CMainWindow::onProjectionModeSelected()
+{
+    auto *action = qobject_cast<QAction *>(sender());
+    if (action && m_viewModel)
+    {
+        m_viewModel->setProjectionMode(
+            static_cast<DicomViewer::EProjectionMode>(action->data().toInt()));
+    }
+}
+
+/**
+ * @brief Handles the Thicker Slab action
+ */
+void CMainWindow::onThickerSlab()
+{
+    if (m_viewModel)
+    {
+        m_viewModel->setSlabThickness(m_viewModel->slabThickness() + 2);
+    }
+}
+
+/**
+ * @brief Handles the Thinner Slab action
+ */
+void CMainWindow::onThinnerSlab()
+{
+    if (m_viewModel)
+    {
+        m_viewModel->setSlabThickness(m_viewModel->slabThickness() - 2);
+    }
+}
+
+/**
+ * @brief Shows the reformatted plane after a plane change
+ *
+ * Only the displayed image changes; palette, view state and the
+ * series' window/level carry over.
+ */
+void CMainWindow::onMprImageChanged()
+{
+    const auto *entry = m_viewModel ? m_viewModel->currentEntry() : nullptr;
+    if (!entry || !entry->image)
+    {
+        updatePlaneDisplay();
+        return;
+    }
+
+    const auto mprImage = m_viewModel->currentMprImage();
+    const auto &shown = mprImage ? mprImage : entry->image;
+    m_imageViewer->setDicomImage(shown);
+    if (entry->windowLevel.width > 0.0)
+    {
+        m_imageViewer->setWindowLevel(entry->windowLevel);
+    }
+    else
+    {
+        m_imageViewer->resetWindowLevel();
+    }
+    updateImageTypeDisplay(shown.get());
+    updatePlaneDisplay();
+}
+
+/**
+ * @brief Updates the MPR plane indicator
+ */
+void CMainWindow::updatePlaneDisplay()
+{
+    const int count = m_viewModel ? m_viewModel->mprPlaneCount() : 0;
+    m_planeLabel->setVisible(count > 0);
+    if (count == 0)
+    {
+        return;
+    }
+
+    QString planeName;
+    switch (m_viewModel->mprPlane())
+    {
+    case DicomViewer::EMprPlane::Axial:
+        planeName = tr("Axial");
+        break;
+    case DicomViewer::EMprPlane::Coronal:
+        planeName = tr("Coronal");
+        break;
+    case DicomViewer::EMprPlane::Sagittal:
+        planeName = tr("Sagittal");
+        break;
+    default:
+        planeName = tr("Slice");
+        break;
+    }
+
+    const auto volume = m_viewModel->volumeAt(m_viewModel->currentIndex());
+    if (m_viewModel->mprPlane() == DicomViewer::EMprPlane::Acquisition && volume)
+    {
+        QString modeName;
+        switch (m_viewModel->projectionMode())
+        {
+        case DicomViewer::EProjectionMode::Minimum:
+            modeName = tr("MinIP");
+            break;
+        case DicomViewer::EProjectionMode::Average:
+            modeName = tr("AvgIP");
+            break;
+        default:
+            modeName = tr("MIP");
+            break;
+        }
+        const int thickness = std::min(m_viewModel->slabThickness(), count);
+        planeName = tr("%1 %2 mm").arg(modeName).arg(thickness * volume->spacing()[2], 0, 'f', 1);
+    }
+    m_planeLabel->setText(tr("%1: %2/%3").arg(planeName).arg(m_viewModel->mprPlaneIndex() + 1).arg(count));
+}
+
 /**
  * @brief Handles window/level changes from image viewer
  * @param center New window center value
@@ -485,18 +908,9 @@ void CMainWindow::onWindowLevelChanged(double center, double width)
 {
     updateWindowLevelDisplay(center, width);
 
-    if (m_thumbnailWidget && m_viewModel && m_viewModel->currentIndex() >= 0)
+    if (m_viewModel)
     {
-        const QImage thumb =
-            m_imageViewer->renderThumbnail(m_thumbnailWidget->thumbnailSize());
-        if (!thumb.isNull())
-        {
-            m_thumbnailWidget->setThumbnailImage(m_viewModel->currentIndex(), thumb);
-        }
-        else
-        {
-            m_thumbnailWidget->updateThumbnail(m_viewModel->currentIndex(), m_imageViewer->paletteType());
-        }
+        refreshThumbnail(m_viewModel->currentIndex());
     }
 
     if (m_viewModel)
@@ -660,25 +1074,9 @@ void CMainWindow::applyPaletteState(DicomViewer::EPaletteType type)
         }
     }
 
-    if (!m_thumbnailWidget || !m_viewModel)
-    {
-        return;
-    }
-
-    const int currentIndex = m_viewModel->currentIndex();
-    if (currentIndex < 0)
-    {
-        return;
-    }
-
-    const QImage thumb = m_imageViewer->renderThumbnail(m_thumbnailWidget->thumbnailSize());
-    if (!thumb.isNull())
-    {
-        m_thumbnailWidget->setThumbnailImage(currentIndex, thumb);
-    }
-    else
+    if (m_viewModel)
     {
-        m_thumbnailWidget->updateThumbnail(currentIndex, type);
+        refreshThumbnail(m_viewModel->currentIndex());
     }
 }
 
@@ -721,18 +1119,9 @@ void CMainWindow::onViewStateChanged(double zoom, double panX, double panY, int
     const bool rotationChanged = (entry && entry->rotation != rotation);
     m_viewModel->updateCurrentViewState(zoom, panX, panY, rotation);
 
-    if (rotationChanged && m_thumbnailWidget)
+    if (rotationChanged)
     {
-        const QImage thumb =
-            m_imageViewer->renderThumbnail(m_thumbnailWidget->thumbnailSize());
-        if (!thumb.isNull())
-        {
-            m_thumbnailWidget->setThumbnailImage(m_viewModel->currentIndex(), thumb);
-        }
-        else
-        {
-            m_thumbnailWidget->updateThumbnail(m_viewModel->currentIndex(), entry ? entry->palette : m_imageViewer->paletteType());
-        }
+        refreshThumbnail(m_viewModel->currentIndex());
     }
 }
 
@@ -793,6 +1182,80 @@ void CMainWindow::onImageAdded(int index)
     }
 }
 
+/**
+ * @brief Queues a thumbnail to be rendered again from its entry's display state
+ *
+ * Thumbnails queued during one event loop iteration are rendered in a
+ * single GPU batch.
+ *
+ * @param index Thumbnail index
+ */
+void CMainWindow::refreshThumbnail(int index)
+{
+    if (!m_thumbnailWidget || index < 0)
+    {
+        return;
+    }
+    if (!m_pendingThumbnails.contains(index))
+    {
+        m_pendingThumbnails.append(index);
+    }
+    if (m_pendingThumbnails.size() == 1)
+    {
+        QTimer::singleShot(0, this, &CMainWindow::flushThumbnails);
+    }
+}
+
+/**
+ * @brief Renders all queued thumbnails, on the CPU if the GPU is unavailable
+ */
+void CMainWindow::flushThumbnails()
+{
+    const QVector<int> indices = std::exchange(m_pendingThumbnails, {});
+    if (!m_thumbnailWidget || !m_viewModel)
+    {
+        return;
+    }
+
+    // Thumbnails show the acquired image, not the MPR plane or projection
+    std::vector<CThumbnailRenderer::SRequest> requests;
+    for (int index : indices)
+    {
+        const auto *entry = m_viewModel->entryAt(index);
+        if (!entry || !entry->image)
+        {
+            continue;
+        }
+        CThumbnailRenderer::SRequest request;
+        request.index = index;
+        request.image = entry->image;
+        request.windowLevel = entry->image->windowLevel();
+        request.palette = entry->palette;
+        request.rotationDegrees = entry->rotation;
+        requests.push_back(std::move(request));
+    }
+
+    if (requests.empty() ||
+        m_imageViewer->requestThumbnails(requests, m_thumbnailWidget->thumbnailSize()))
+    {
+        return;
+    }
+    for (const auto &request : requests)
+    {
+        m_thumbnailWidget->updateThumbnail(request.index, request.palette);
+    }
+}
+
+void CMainWindow::onThumbnailRendered(int index, const CDicomImage *image, const QImage &thumbnail)
+{
+    // Indices shift when images are removed while a batch is in flight
+    const auto *entry = m_viewModel ? m_viewModel->entryAt(index) : nullptr;
+    if (m_thumbnailWidget && entry && entry->image.get() == image)
+    {
+        m_thumbnailWidget->setThumbnailImage(index, thumbnail);
+    }
+}
+
 void CMainWindow::onImageRemoved(int index)
 {
     if (m_thumbnailWidget)
@@ -801,6 +1264,26 @@ void CMainWindow::onImageRemoved(int index)
     }
 }
 
+void CMainWindow::onLoadProgress(int completed, int total)
+{
+    const bool loading = total > 0 && completed < total;
+    if (m_cancelLoadingAction)
+    {
+        m_cancelLoadingAction->setEnabled(loading);
+    }
+    if (!m_loadProgressBar)
+    {
+        return;
+    }
+
+    m_loadProgressBar->setVisible(loading);
+    if (loading)
+    {
+        m_loadProgressBar->setRange(0, total);
+        m_loadProgressBar->setValue(completed);
+    }
+}
+
 void CMainWindow::applyCurrentImage()
 {
     if (!m_viewModel)
@@ -815,6 +1298,7 @@ void CMainWindow::applyCurrentImage()
         m_metadataPanel->clearMetadata();
         updateWindowLevelDisplay(0, 0);
         updateImageTypeDisplay(nullptr);
+        updatePlaneDisplay();
         setWindowTitle(tr("DICOM Viewer"));
         if (m_thumbnailWidget)
         {
@@ -824,7 +1308,9 @@ void CMainWindow::applyCurrentImage()
         return;
     }
 
-    m_imageViewer->setDicomImage(entry->image);
+    // Series shown as MPR display the reformatted plane instead
+    const auto mprImage = m_viewModel->currentMprImage();
+    m_imageViewer->setDicomImage(mprImage ? mprImage : entry->image);
     m_imageViewer->setColorPalette(entry->palette);
     m_imageViewer->setViewState({entry->zoom, entry->pan, entry->rotation});
     applyPaletteState(entry->palette);
@@ -837,11 +1323,12 @@ void CMainWindow::applyCurrentImage()
         m_imageViewer->resetWindowLevel();
     }
 
-    m_metadataPanel->setMetadata(entry->image->metadata());
+    m_metadataPanel->setMetadata(entry->image->metadata(), entry->filePath);
 
-    const auto wl = entry->image->windowLevel();
+    const auto wl = (mprImage ? mprImage : entry->image)->windowLevel();
     updateWindowLevelDisplay(wl.center, wl.width);
-    updateImageTypeDisplay(entry->image.get());
+    updateImageTypeDisplay(mprImage ? mprImage.get() : entry->image.get());
+    updatePlaneDisplay();
 
     if (m_thumbnailWidget)
     {
@@ -855,19 +1342,7 @@ void CMainWindow::applyCurrentImage()
         statusBar()->showMessage(tr("Selected: %1").arg(entry->filePath), 3000);
     }
 
-    if (m_thumbnailWidget)
-    {
-        const QImage thumb =
-            m_imageViewer->renderThumbnail(m_thumbnailWidget->thumbnailSize());
-        if (!thumb.isNull())
-        {
-            m_thumbnailWidget->setThumbnailImage(m_viewModel->currentIndex(), thumb);
-        }
-        else
-        {
-            m_thumbnailWidget->updateThumbnail(m_viewModel->currentIndex(), entry->palette);
-        }
-    }
+    refreshThumbnail(m_viewModel->currentIndex());
 }
 
 void CMainWindow::onZoomIn()
@@ -12,6 +12,7 @@
 
 #include "CImageViewer.h"
 #include "CMetadataPanel.h"
+#include "CStudyBrowser.h"
 #include "CThumbnailWidget.h"
 #include "core/CDicomImage.h"
 #include "presentation/viewmodels/MainViewModel.h"
@@ -19,9 +20,12 @@
 #include <QMainWindow>
 #include <QString>
 #include <QStringList>
+#include <QVector>
 #include <memory>
 
+class QAction;
 class QLabel;
+class QProgressBar;
 class QDockWidget;
 class QActionGroup;
 class QStackedWidget;
@@ -77,11 +81,73 @@ class CMainWindow : public QMainWindow
      */
     void onOpenFileClicked();
 
+    /**
+     * @brief Handles Open Folder action
+     */
+    void onOpenFolderClicked();
+
     /**
      * @brief Handles Reset Window/Level action
      */
     void onResetWindowLevelClicked();
 
+    /**
+     * @brief Handles Auto Window/Level action
+     */
+    void onAutoWindowLevelClicked();
+
+    /**
+     * @brief Handles the Play cine action
+     * @param checked True to start playback
+     */
+    void onCinePlayToggled(bool checked);
+
+    /**
+     * @brief Handles the Next/Previous Frame actions
+     */
+    void onNextFrame();
+    void onPreviousFrame();
+
+    /**
+     * @brief Updates the frame indicator
+     * @param index Zero-based frame index
+     * @param count Number of frames
+     */
+    void onFrameChanged(int index, int count);
+
+    /**
+     * @brief Keeps the Play action in sync with the viewer
+     * @param playing True while playing
+     */
+    void onCinePlayingChanged(bool playing);
+
+    /**
+     * @brief Handles the plane actions of the MPR menu
+     */
+    void onMprPlaneSelected();
+
+    /**
+     * @brief Handles the Next/Previous Plane actions
+     */
+    void onNextPlane();
+    void onPreviousPlane();
+
+    /**
+     * @brief Handles the mode actions of the Projection menu
+     */
+    void onProjectionModeSelected();
+
+    /**
+     * @brief Handles the Thicker/Thinner Slab actions
+     */
+    void onThickerSlab();
+    void onThinnerSlab();
+
+    /**
+     * @brief Shows the reformatted plane after a plane change
+     */
+    void onMprImageChanged();
+
     /**
      * @brief Handles window/level changes from image viewer
      * @param center New window center
@@ -171,6 +237,7 @@ class CMainWindow : public QMainWindow
      * @param image Pointer to the current image
      */
     void updateImageTypeDisplay(const CDicomImage *image);
+    void updatePlaneDisplay();
     void applyPaletteState(DicomViewer::EPaletteType type);
 
     /**
@@ -184,20 +251,34 @@ class CMainWindow : public QMainWindow
     void applyCurrentImage();
     void onImageAdded(int index);
     void onImageRemoved(int index);
+    void onLoadProgress(int completed, int total);
+    void refreshThumbnail(int index);
+    void flushThumbnails();
+    void onThumbnailRendered(int index, const CDicomImage *image, const QImage &thumbnail);
 
     CImageViewer *m_imageViewer = nullptr;
     CMetadataPanel *m_metadataPanel = nullptr;
     CThumbnailWidget *m_thumbnailWidget = nullptr;
+    CStudyBrowser *m_studyBrowser = nullptr;
     QDockWidget *m_sidePanelDock = nullptr;
     QStackedWidget *m_sidePanelStack = nullptr;
     QLabel *m_windowLevelLabel = nullptr;
     QLabel *m_imageTypeLabel = nullptr;
     QLabel *m_imageSizeLabel = nullptr;
     QLabel *m_paletteLabel = nullptr;
+    QLabel *m_frameLabel = nullptr;
+    QLabel *m_planeLabel = nullptr;
+    QProgressBar *m_loadProgressBar = nullptr;
+    QAction *m_cancelLoadingAction = nullptr;
+    QAction *m_showStudiesAction = nullptr;
+    QAction *m_cinePlayAction = nullptr;
     QMenu *m_paletteMenu = nullptr;
     QActionGroup *m_paletteActionGroup = nullptr;
+    QActionGroup *m_mprActionGroup = nullptr;
+    QActionGroup *m_projectionActionGroup = nullptr;
 
     std::shared_ptr<MainViewModel> m_viewModel;
 
     QString m_lastOpenDirectory; /**< Last used directory for file dialog */
+    QVector<int> m_pendingThumbnails; /**< Thumbnails to render in the next batch */
 };
@@ -4,19 +4,31 @@
  * @author DICOM Viewer Project
  * @date 2026
  *
- * Implements the DICOM metadata display panel using a QTableWidget
- * to show tag names and values in a two-column format.
+ * Implements the DICOM metadata display panel using a QTreeView over
+ * a CDicomTagModel to show tag names and values in a two-column format.
  */
 
 #include "CMetadataPanel.h"
 
+#include "CDicomTagModel.h"
+#include "core/CDicomTagIndex.h"
+
+#include <QFile>
 #include <QHeaderView>
+#include <QLineEdit>
 #include <QResizeEvent>
-#include <QTableWidget>
+#include <QShowEvent>
+#include <QTreeView>
 #include <QVBoxLayout>
 #include <algorithm>
 #include <cmath>
 
+namespace
+{
+/** Filter results up to this many rows are shown fully expanded */
+constexpr size_t kMaxExpandedRows = 500;
+}
+
 /**
  * @brief Constructor
  * @param parent Parent widget
@@ -30,10 +42,26 @@ CMetadataPanel::CMetadataPanel(QWidget *parent)
 /**
  * @brief Sets metadata to display
  * @param metadata Pointer to metadata object (can be nullptr)
+ * @param filePath File the metadata was read from; without one only
+ *        the summary tags are shown
  */
-void CMetadataPanel::setMetadata(const CDicomMetadata *metadata)
+void CMetadataPanel::setMetadata(const CDicomMetadata *metadata, const QString &filePath)
 {
-    populateTable(metadata);
+    m_hasMetadata = (metadata != nullptr);
+    m_metadata = metadata ? *metadata : CDicomMetadata();
+    m_filePath = filePath;
+
+    // Frames of one file share the tree already shown
+    if (!m_filePath.isEmpty() && m_filePath == m_shownPath)
+    {
+        m_pending = false;
+        return;
+    }
+    m_pending = true;
+    if (isVisible())
+    {
+        populateTree();
+    }
 }
 
 /**
@@ -41,49 +69,63 @@ void CMetadataPanel::setMetadata(const CDicomMetadata *metadata)
  */
 void CMetadataPanel::clearMetadata()
 {
-    m_tableWidget->setRowCount(0);
+    m_hasMetadata = false;
+    m_metadata = CDicomMetadata();
+    m_filePath.clear();
+    m_shownPath.clear();
+    m_pending = false;
+    m_model->clear();
+}
+
+void CMetadataPanel::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (m_pending)
+    {
+        populateTree();
+    }
 }
 
 void CMetadataPanel::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
-    if (!m_tableWidget || m_updatingColumns)
+    if (!m_treeView || m_updatingColumns)
     {
         return;
     }
 
-    const int viewWidth = m_tableWidget->viewport()->width();
+    const int viewWidth = m_treeView->viewport()->width();
     if (viewWidth <= 0)
     {
         return;
     }
 
-    const int minWidth = m_tableWidget->horizontalHeader()->minimumSectionSize();
+    const int minWidth = m_treeView->header()->minimumSectionSize();
     const double ratioMin = static_cast<double>(minWidth) / viewWidth;
     const double ratioMax = 1.0 - ratioMin;
     const double ratio = std::clamp(m_columnRatio, ratioMin, ratioMax);
 
     m_updatingColumns = true;
     const int targetWidth = static_cast<int>(std::round(viewWidth * ratio));
-    m_tableWidget->setColumnWidth(0, targetWidth);
+    m_treeView->setColumnWidth(0, targetWidth);
     m_updatingColumns = false;
 }
 
 void CMetadataPanel::updateColumnRatio(int logicalIndex, int oldSize, int newSize)
 {
     Q_UNUSED(oldSize);
-    if (m_updatingColumns || logicalIndex != 0 || !m_tableWidget)
+    if (m_updatingColumns || logicalIndex != 0 || !m_treeView)
     {
         return;
     }
 
-    const int viewWidth = m_tableWidget->viewport()->width();
+    const int viewWidth = m_treeView->viewport()->width();
     if (viewWidth <= 0)
     {
         return;
     }
 
-    const int minWidth = m_tableWidget->horizontalHeader()->minimumSectionSize();
+    const int minWidth = m_treeView->header()->minimumSectionSize();
     const double ratioMin = static_cast<double>(minWidth) / viewWidth;
     const double ratioMax = 1.0 - ratioMin;
     m_columnRatio = std::clamp(static_cast<double>(newSize) / viewWidth, ratioMin, ratioMax);
@@ -96,57 +138,85 @@ void CMetadataPanel::setupUi()
 {
     m_layout = new QVBoxLayout(this);
     m_layout->setContentsMargins(0, 0, 0, 0);
-
-    m_tableWidget = new QTableWidget(this);
-    m_tableWidget->setObjectName("MetadataTable");
-    m_tableWidget->setColumnCount(2);
-    m_tableWidget->setHorizontalHeaderLabels({tr("Tag"), tr("Value")});
-    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableWidget->setAlternatingRowColors(true);
-    m_tableWidget->verticalHeader()->setVisible(false);
-    m_tableWidget->setShowGrid(true);
-
-    // Allow user to resize Tag column only; Value stays inside the table
-    auto *header = m_tableWidget->horizontalHeader();
+    m_layout->setSpacing(4);
+
+    m_searchEdit = new QLineEdit(this);
+    m_searchEdit->setObjectName("MetadataSearch");
+    m_searchEdit->setPlaceholderText(tr("Search tag or keyword, e.g. 0010,0010 or PatientName"));
+    m_searchEdit->setClearButtonEnabled(true);
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &CMetadataPanel::applyFilter);
+    m_layout->addWidget(m_searchEdit);
+
+    m_model = new CDicomTagModel(this);
+
+    m_treeView = new QTreeView(this);
+    m_treeView->setObjectName("MetadataTable");
+    m_treeView->setModel(m_model);
+    m_treeView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_treeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_treeView->setAlternatingRowColors(true);
+    // Rows are never measured individually, so huge datasets scroll freely
+    m_treeView->setUniformRowHeights(true);
+    m_treeView->setTextElideMode(Qt::ElideRight);
+
+    // Allow user to resize Tag column only; Value stays inside the tree
+    auto *header = m_treeView->header();
     header->setSectionsMovable(false);
     header->setStretchLastSection(true);
     header->setSectionResizeMode(0, QHeaderView::Interactive);
     header->setSectionResizeMode(1, QHeaderView::Stretch);
     header->setMinimumSectionSize(80);
-    m_tableWidget->setSizeAdjustPolicy(QAbstractScrollArea::AdjustIgnored);
+    m_treeView->setSizeAdjustPolicy(QAbstractScrollArea::AdjustIgnored);
     connect(header, &QHeaderView::sectionResized,
             this, &CMetadataPanel::updateColumnRatio);
 
-    m_layout->addWidget(m_tableWidget);
+    m_layout->addWidget(m_treeView);
 }
 
 /**
- * @brief Populates the table with metadata
- * @param metadata Metadata to display
+ * @brief Fills the tree from the pending file or metadata
+ *
+ * The index walk only reads element headers from the mapped file, so
+ * it is cheap enough to run on the UI thread when the panel is shown.
  */
-void CMetadataPanel::populateTable(const CDicomMetadata *metadata)
+void CMetadataPanel::populateTree()
 {
-    m_tableWidget->setRowCount(0);
+    m_pending = false;
+    m_shownPath.clear();
 
-    if (metadata == nullptr || metadata->isEmpty())
+    std::shared_ptr<const CDicomTagIndex> index;
+    if (!m_filePath.isEmpty())
     {
-        return;
+        index = CDicomTagIndex::build(QFile::encodeName(m_filePath).toStdString());
     }
 
-    const auto tags = metadata->allTags();
-    m_tableWidget->setRowCount(static_cast<int>(tags.size()));
-
-    int row = 0;
-    for (const auto &entry : tags)
+    if (index)
     {
-        auto *tagItem = new QTableWidgetItem(QString::fromStdString(entry.first));
-        auto *valueItem = new QTableWidgetItem(QString::fromStdString(entry.second));
-
-        m_tableWidget->setItem(row, 0, tagItem);
-        m_tableWidget->setItem(row, 1, valueItem);
-        row++;
+        m_model->setTagIndex(std::move(index));
+        m_shownPath = m_filePath;
+    }
+    else if (m_hasMetadata && !m_metadata.isEmpty())
+    {
+        m_model->setSummary(&m_metadata);
+    }
+    else
+    {
+        m_model->clear();
     }
 
-    m_tableWidget->resizeColumnsToContents();
+    // The model keeps the filter; expand the new results like typed ones
+    applyFilter(m_searchEdit->text());
+}
+
+/**
+ * @brief Filters the tree by the search text
+ * @param text Tag number or keyword
+ */
+void CMetadataPanel::applyFilter(const QString &text)
+{
+    m_model->setFilter(text);
+    if (!text.trimmed().isEmpty() && m_model->visibleCount() <= kMaxExpandedRows)
+    {
+        m_treeView->expandAll();
+    }
 }
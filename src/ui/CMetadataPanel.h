@@ -4,27 +4,33 @@
  * @author DICOM Viewer Project
  * @date 2026
  *
- * Defines the CMetadataPanel widget which displays DICOM metadata
- * in a tabular format using QTableWidget.
+ * Defines the CMetadataPanel widget which displays the complete DICOM
+ * dataset of the current image as a searchable tree.
  */
 
 #pragma once
 
 #include "core/CDicomMetadata.h"
 
+#include <QString>
 #include <QWidget>
 
-class QTableWidget;
+class CDicomTagModel;
+class QLineEdit;
+class QTreeView;
 class QVBoxLayout;
 class QResizeEvent;
+class QShowEvent;
 
 /**
  * @class CMetadataPanel
  * @brief Widget for displaying DICOM metadata
  *
- * Displays DICOM header tags in a two-column table format with
- * tag names and values. Provides patient, study, series, and
- * image information extracted from DICOM files.
+ * Displays every element of the current file, sequences included, in
+ * a two-column tree of tags and values. The tag index behind the tree
+ * is built only while the panel is shown, and the search field filters
+ * it by tag number or keyword. Files that cannot be indexed fall back
+ * to the summary tags held by CDicomMetadata.
  */
 class CMetadataPanel : public QWidget
 {
@@ -47,8 +53,10 @@ class CMetadataPanel : public QWidget
     /**
      * @brief Sets metadata to display
      * @param metadata Pointer to metadata object (can be nullptr)
+     * @param filePath File the metadata was read from; without one only
+     *        the summary tags are shown
      */
-    void setMetadata(const CDicomMetadata *metadata);
+    void setMetadata(const CDicomMetadata *metadata, const QString &filePath = QString());
 
     /**
      * @brief Clears displayed metadata
@@ -58,6 +66,7 @@ class CMetadataPanel : public QWidget
 
   protected:
     void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
 
   private:
     /** @name Internal Methods */
@@ -68,15 +77,22 @@ class CMetadataPanel : public QWidget
     void setupUi();
 
     /**
-     * @brief Populates the table with metadata
-     * @param metadata Metadata to display
+     * @brief Fills the tree from the pending file or metadata
      */
-    void populateTable(const CDicomMetadata *metadata);
+    void populateTree();
+    void applyFilter(const QString &text);
     void updateColumnRatio(int logicalIndex, int oldSize, int newSize);
     ///@}
 
-    QTableWidget *m_tableWidget = nullptr; /**< Table for displaying tags */
-    QVBoxLayout *m_layout = nullptr;       /**< Main layout */
+    QLineEdit *m_searchEdit = nullptr;   /**< Tag search field */
+    QTreeView *m_treeView = nullptr;     /**< Tree for displaying tags */
+    CDicomTagModel *m_model = nullptr;   /**< Tag index model */
+    QVBoxLayout *m_layout = nullptr;     /**< Main layout */
+    CDicomMetadata m_metadata;           /**< Summary tags of the current image */
+    bool m_hasMetadata = false;
+    QString m_filePath;                  /**< File of the current image */
+    QString m_shownPath;                 /**< File the tree currently shows */
+    bool m_pending = false;              /**< Tree is out of date */
     double m_columnRatio = 0.5;
     bool m_updatingColumns = false;
 };
@@ -0,0 +1,222 @@
+/**
+ * @file CStudyBrowser.cpp
+ * @brief Implementation of CStudyBrowser
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CStudyBrowser.h"
+
+#include <QDate>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace
+{
+using EField = CDicomCatalog::EField;
+
+/** Item data role holding the index of a series in m_series */
+constexpr int kSeriesRole = Qt::UserRole + 1;
+
+QString fieldText(const CDicomCatalog::SEntry &entry, EField field)
+{
+    return QString::fromStdString(entry.field(field)).trimmed();
+}
+
+QString patientLabel(const CDicomCatalog::SEntry &entry)
+{
+    // Person names separate their components with carets
+    QString name = fieldText(entry, EField::PatientName).replace('^', ' ').simplified();
+    const QString id = fieldText(entry, EField::PatientId);
+    if (name.isEmpty())
+    {
+        name = QObject::tr("Unknown patient");
+    }
+    return id.isEmpty() ? name : QString("%1 (%2)").arg(name, id);
+}
+
+QString studyLabel(const CDicomCatalog::SEntry &entry)
+{
+    const QString rawDate = fieldText(entry, EField::StudyDate);
+    const QDate date = QDate::fromString(rawDate, "yyyyMMdd");
+    QString label = date.isValid() ? date.toString(Qt::ISODate) : rawDate;
+    const QString description = fieldText(entry, EField::StudyDescription);
+    if (!description.isEmpty())
+    {
+        label = label.isEmpty() ? description : label + "  " + description;
+    }
+    return label.isEmpty() ? QObject::tr("Study") : label;
+}
+
+QString seriesLabel(const CDicomCatalog::SEntry &entry)
+{
+    QStringList parts;
+    if (entry.seriesNumber != 0)
+    {
+        parts << QString("#%1").arg(entry.seriesNumber);
+    }
+    const QString modality = fieldText(entry, EField::Modality);
+    if (!modality.isEmpty())
+    {
+        parts << modality;
+    }
+    const QString description = fieldText(entry, EField::SeriesDescription);
+    if (!description.isEmpty())
+    {
+        parts << description;
+    }
+    return parts.isEmpty() ? QObject::tr("Series") : parts.join("  ");
+}
+} // namespace
+
+CStudyBrowser::CStudyBrowser(QWidget *parent)
+    : QWidget(parent)
+{
+    setObjectName("StudyBrowser");
+
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(6, 6, 6, 6);
+    layout->setSpacing(4);
+
+    m_emptyLabel = new QLabel(tr("No folder indexed\nUse File > Open Folder..."), this);
+    m_emptyLabel->setObjectName("StudyBrowserEmpty");
+    m_emptyLabel->setAlignment(Qt::AlignCenter);
+
+    m_treeWidget = new QTreeWidget(this);
+    m_treeWidget->setObjectName("StudyBrowserTree");
+    m_treeWidget->setColumnCount(2);
+    m_treeWidget->setHeaderLabels({tr("Patient / Study / Series"), tr("Images")});
+    m_treeWidget->setUniformRowHeights(true);
+    m_treeWidget->setAlternatingRowColors(true);
+    m_treeWidget->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_treeWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    auto *header = m_treeWidget->header();
+    header->setStretchLastSection(false);
+    header->setSectionResizeMode(0, QHeaderView::Stretch);
+    header->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+
+    m_progressLabel = new QLabel(this);
+    m_progressLabel->setObjectName("StudyBrowserProgress");
+    m_progressLabel->setVisible(false);
+
+    layout->addWidget(m_emptyLabel);
+    layout->addWidget(m_treeWidget);
+    layout->addWidget(m_progressLabel);
+
+    connect(m_treeWidget, &QTreeWidget::itemActivated,
+            this, [this](QTreeWidgetItem *item, int)
+            { onItemActivated(item); });
+
+    updateEmptyState();
+}
+
+/**
+ * @brief Shows the patients, studies and series of a catalog
+ * @param catalog Catalog to show (can be nullptr)
+ */
+void CStudyBrowser::setCatalog(std::shared_ptr<const CDicomCatalog> catalog)
+{
+    m_treeWidget->clear();
+    m_series.clear();
+    m_catalog = std::move(catalog);
+    if (!m_catalog)
+    {
+        updateEmptyState();
+        return;
+    }
+
+    const auto patients = m_catalog->patients();
+    QList<QTreeWidgetItem *> patientItems;
+    patientItems.reserve(static_cast<int>(patients.size()));
+    for (const auto &patient : patients)
+    {
+        auto *patientItem = new QTreeWidgetItem();
+        int patientImages = 0;
+        for (const auto &study : patient.studies)
+        {
+            auto *studyItem = new QTreeWidgetItem(patientItem);
+            int studyImages = 0;
+            for (const auto &series : study.series)
+            {
+                const auto &first = m_catalog->entry(series.instances.front());
+                auto *seriesItem = new QTreeWidgetItem(studyItem);
+                seriesItem->setText(0, seriesLabel(first));
+                seriesItem->setText(1, QString::number(series.instances.size()));
+                seriesItem->setToolTip(0, tr("Double-click to open this series"));
+                seriesItem->setData(0, kSeriesRole, static_cast<int>(m_series.size()));
+                m_series.push_back(series.instances);
+                studyImages += static_cast<int>(series.instances.size());
+            }
+            const auto &first = m_catalog->entry(study.series.front().instances.front());
+            studyItem->setText(0, studyLabel(first));
+            studyItem->setText(1, QString::number(studyImages));
+            const QString accession = fieldText(first, EField::AccessionNumber);
+            if (!accession.isEmpty())
+            {
+                studyItem->setToolTip(0, tr("Accession Number: %1").arg(accession));
+            }
+            patientImages += studyImages;
+        }
+        const auto &first =
+            m_catalog->entry(patient.studies.front().series.front().instances.front());
+        patientItem->setText(0, patientLabel(first));
+        patientItem->setText(1, QString::number(patientImages));
+        patientItems.append(patientItem);
+    }
+    m_treeWidget->addTopLevelItems(patientItems);
+
+    // A single patient is shown opened up to its series
+    if (patientItems.size() == 1)
+    {
+        patientItems.front()->setExpanded(true);
+        for (int i = 0; i < patientItems.front()->childCount(); ++i)
+        {
+            patientItems.front()->child(i)->setExpanded(true);
+        }
+    }
+    updateEmptyState();
+}
+
+/**
+ * @brief Shows how many headers of the folder have been read
+ * @param read Headers read so far
+ * @param total Headers to read; 0 hides the progress
+ */
+void CStudyBrowser::setProgress(int read, int total)
+{
+    m_progressLabel->setVisible(total > 0);
+    if (total > 0)
+    {
+        m_progressLabel->setText(tr("Reading headers: %1 of %2").arg(read).arg(total));
+    }
+}
+
+void CStudyBrowser::onItemActivated(QTreeWidgetItem *item)
+{
+    if (!item || !m_catalog)
+    {
+        return;
+    }
+    const QVariant series = item->data(0, kSeriesRole);
+    if (!series.isValid())
+    {
+        return;
+    }
+
+    QStringList filePaths;
+    for (uint32_t index : m_series[static_cast<size_t>(series.toInt())])
+    {
+        filePaths.append(QString::fromStdString(m_catalog->entry(index).filePath));
+    }
+    emit seriesActivated(filePaths);
+}
+
+void CStudyBrowser::updateEmptyState()
+{
+    const bool empty = m_treeWidget->topLevelItemCount() == 0;
+    m_emptyLabel->setVisible(empty);
+    m_treeWidget->setVisible(!empty);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file CStudyBrowser.h
+ * @brief Patient/study/series browser for cataloged folders
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#pragma once
+
+#include "core/CDicomCatalog.h"
+
+#include <QStringList>
+#include <QWidget>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class QLabel;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+/**
+ * @class CStudyBrowser
+ * @brief Lists the series of a folder catalog by patient and study
+ *
+ * Only patients, studies and series get tree items; instances stay in
+ * the catalog until a series is opened, so folders with tens of
+ * thousands of files populate at once.
+ */
+class CStudyBrowser : public QWidget
+{
+    Q_OBJECT
+
+  public:
+    /**
+     * @brief Constructor
+     * @param parent Parent widget
+     */
+    explicit CStudyBrowser(QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~CStudyBrowser() override = default;
+
+    /**
+     * @brief Shows the patients, studies and series of a catalog
+     * @param catalog Catalog to show (can be nullptr)
+     */
+    void setCatalog(std::shared_ptr<const CDicomCatalog> catalog);
+
+    /**
+     * @brief Shows how many headers of the folder have been read
+     * @param read Headers read so far
+     * @param total Headers to read; 0 hides the progress
+     */
+    void setProgress(int read, int total);
+
+  signals:
+    /**
+     * @brief Emitted when a series is opened (double-click or Enter)
+     * @param filePaths Files of the series, by instance number
+     */
+    void seriesActivated(const QStringList &filePaths);
+
+  private:
+    void onItemActivated(QTreeWidgetItem *item);
+    void updateEmptyState();
+
+    QTreeWidget *m_treeWidget = nullptr;
+    QLabel *m_emptyLabel = nullptr;
+    QLabel *m_progressLabel = nullptr;
+    std::shared_ptr<const CDicomCatalog> m_catalog;
+    std::vector<std::vector<uint32_t>> m_series; /**< Entry indices per series item */
+};
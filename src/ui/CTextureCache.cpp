@@ -0,0 +1,182 @@
+/**
+ * @file CTextureCache.cpp
+ * @brief Implementation of the CTextureCache class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CTextureCache.h"
+
+#include "core/CDicomImage.h"
+
+#include <QOpenGLTexture>
+
+#include <algorithm>
+
+namespace
+{
+/**
+ * @brief Estimated video memory of a texture, mip chain included
+ */
+size_t textureBytes(const QOpenGLTexture &texture)
+{
+    size_t texelBytes = 1;
+    switch (texture.format())
+    {
+    case QOpenGLTexture::RGB8_UNorm:
+        texelBytes = 4; // Drivers pad RGB to RGBA
+        break;
+    case QOpenGLTexture::R16_UNorm:
+    case QOpenGLTexture::R16_SNorm:
+        texelBytes = 2;
+        break;
+    default:
+        break;
+    }
+
+    size_t bytes = 0;
+    size_t width = static_cast<size_t>(texture.width());
+    size_t height = static_cast<size_t>(texture.height());
+    for (int level = 0; level < std::max(1, texture.mipLevels()); ++level)
+    {
+        bytes += width * height * texelBytes;
+        width = std::max<size_t>(1, width / 2);
+        height = std::max<size_t>(1, height / 2);
+    }
+    return bytes;
+}
+} // namespace
+
+/**
+ * @brief Constructor
+ * @param budgetBytes Maximum estimated texture bytes (0 = unlimited)
+ */
+CTextureCache::CTextureCache(size_t budgetBytes)
+    : m_budgetBytes(budgetBytes)
+{
+}
+
+CTextureCache::~CTextureCache()
+{
+    clear();
+}
+
+/**
+ * @brief Sets the byte budget; takes effect on the next insert()
+ * @param budgetBytes Maximum estimated texture bytes (0 = unlimited)
+ */
+void CTextureCache::setBudget(size_t budgetBytes)
+{
+    m_budgetBytes = budgetBytes;
+}
+
+size_t CTextureCache::budget() const
+{
+    return m_budgetBytes;
+}
+
+/**
+ * @brief Estimated bytes of all cached textures
+ * @return Total bytes
+ */
+size_t CTextureCache::residentBytes() const
+{
+    return m_residentBytes;
+}
+
+/**
+ * @brief Looks up the texture of an image and marks it most recently used
+ * @param image Image the texture was uploaded from
+ * @return Texture, nullptr if not cached
+ */
+const CTextureCache::STexture *CTextureCache::find(const std::shared_ptr<const CDicomImage> &image)
+{
+    auto it = m_index.find(image.get());
+    if (it == m_index.end())
+    {
+        return nullptr;
+    }
+    // A dead image whose address was reused is not the same image
+    if (it->second->image.lock() != image)
+    {
+        erase(it->second);
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return &m_lru.front().texture;
+}
+
+/**
+ * @brief Adds a freshly uploaded texture as most recently used
+ * @param image Image the texture was uploaded from
+ * @param texture Texture (ownership passes to the cache)
+ * @param isRgb True for RGB texels
+ * @param valueMin Sample value of texel 0.0
+ * @param valueMax Sample value of texel 1.0
+ * @return Cached entry
+ */
+const CTextureCache::STexture *CTextureCache::insert(const std::shared_ptr<const CDicomImage> &image,
+                                                     std::unique_ptr<QOpenGLTexture> texture,
+                                                     bool isRgb, int valueMin, int valueMax)
+{
+    if (auto it = m_index.find(image.get()); it != m_index.end())
+    {
+        erase(it->second);
+    }
+
+    SEntry entry;
+    entry.key = image.get();
+    entry.image = image;
+    entry.bytes = textureBytes(*texture);
+    entry.texture = {texture.get(), isRgb, valueMin, valueMax};
+    entry.owner = std::move(texture);
+    m_residentBytes += entry.bytes;
+    m_lru.push_front(std::move(entry));
+    m_index[image.get()] = m_lru.begin();
+
+    evict(image.get());
+    return &m_lru.front().texture;
+}
+
+/**
+ * @brief Deletes every cached texture
+ */
+void CTextureCache::clear()
+{
+    m_lru.clear();
+    m_index.clear();
+    m_residentBytes = 0;
+}
+
+void CTextureCache::erase(std::list<SEntry>::iterator it)
+{
+    m_residentBytes -= it->bytes;
+    m_index.erase(it->key);
+    m_lru.erase(it);
+}
+
+/**
+ * @brief Drops textures of dead images, then least recently used ones over budget
+ * @param keep Image whose texture must survive
+ */
+void CTextureCache::evict(const CDicomImage *keep)
+{
+    for (auto it = m_lru.begin(); it != m_lru.end();)
+    {
+        auto next = std::next(it);
+        if (it->image.expired())
+        {
+            erase(it);
+        }
+        it = next;
+    }
+
+    if (m_budgetBytes == 0)
+    {
+        return;
+    }
+    while (m_residentBytes > m_budgetBytes && m_lru.back().key != keep)
+    {
+        erase(std::prev(m_lru.end()));
+    }
+}
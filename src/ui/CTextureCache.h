@@ -0,0 +1,122 @@
+/**
+ * @file CTextureCache.h
+ * @brief GPU texture cache keyed by image identity class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CTextureCache class which keeps the textures of recently
+ * displayed images alive within a video memory budget, so switching
+ * back to an image rebinds its texture instead of uploading it again.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+class CDicomImage;
+class QOpenGLTexture;
+
+/**
+ * @class CTextureCache
+ * @brief Least-recently-used textures within a byte budget
+ *
+ * Entries are keyed by the CDicomImage (or frame) a texture was
+ * uploaded from and hold it weakly: textures of images that no longer
+ * exist are deleted on the next insert(). Sizes are estimated from the
+ * texture format and dimensions, mip chain included.
+ *
+ * The cache only depends on a current QOpenGLContext, so it works the
+ * same with a QOffscreenSurface and software GL (Mesa llvmpipe) as in
+ * CImageViewer. Every call except budget accessors must be made with
+ * the context that owns the textures current.
+ *
+ * Not thread-safe; owned by one GL widget.
+ */
+class CTextureCache
+{
+  public:
+    static constexpr size_t kDefaultBudgetBytes = size_t(512) * 1024 * 1024;
+
+    /**
+     * @brief How to map texels back to sample values
+     */
+    struct STexture
+    {
+        QOpenGLTexture *texture = nullptr;
+        bool isRgb = false;
+        int valueMin = 0; /**< Sample value of texel 0.0 */
+        int valueMax = 0; /**< Sample value of texel 1.0 */
+    };
+
+    /**
+     * @brief Constructor
+     * @param budgetBytes Maximum estimated texture bytes (0 = unlimited)
+     */
+    explicit CTextureCache(size_t budgetBytes = kDefaultBudgetBytes);
+
+    /**
+     * @brief Destructor; call clear() first while the context is current
+     */
+    ~CTextureCache();
+
+    CTextureCache(const CTextureCache &) = delete;
+    CTextureCache &operator=(const CTextureCache &) = delete;
+
+    /** @name Budget */
+    ///@{
+    void setBudget(size_t budgetBytes);
+    size_t budget() const;
+    size_t residentBytes() const;
+    ///@}
+
+    /**
+     * @brief Looks up the texture of an image and marks it most recently used
+     * @param image Image the texture was uploaded from
+     * @return Texture, nullptr if not cached
+     */
+    const STexture *find(const std::shared_ptr<const CDicomImage> &image);
+
+    /**
+     * @brief Adds a freshly uploaded texture as most recently used
+     *
+     * Replaces any texture cached for @p image, then evicts least
+     * recently used textures until the budget is met. The new texture
+     * itself is never evicted, even if it alone exceeds the budget.
+     *
+     * @param image Image the texture was uploaded from
+     * @param texture Texture (ownership passes to the cache)
+     * @param isRgb True for RGB texels
+     * @param valueMin Sample value of texel 0.0
+     * @param valueMax Sample value of texel 1.0
+     * @return Cached entry
+     */
+    const STexture *insert(const std::shared_ptr<const CDicomImage> &image,
+                           std::unique_ptr<QOpenGLTexture> texture, bool isRgb, int valueMin,
+                           int valueMax);
+
+    /**
+     * @brief Deletes every cached texture
+     */
+    void clear();
+
+  private:
+    struct SEntry
+    {
+        const CDicomImage *key = nullptr;
+        std::weak_ptr<const CDicomImage> image;
+        std::unique_ptr<QOpenGLTexture> owner;
+        STexture texture;
+        size_t bytes = 0;
+    };
+
+    void erase(std::list<SEntry>::iterator it);
+    void evict(const CDicomImage *keep);
+
+    std::list<SEntry> m_lru; /**< Front = most recently used */
+    std::unordered_map<const CDicomImage *, std::list<SEntry>::iterator> m_index;
+    size_t m_budgetBytes = kDefaultBudgetBytes;
+    size_t m_residentBytes = 0;
+};
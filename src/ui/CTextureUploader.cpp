@@ -0,0 +1,344 @@
+/**
+ * @file CTextureUploader.cpp
+ * @brief Implementation of the CTextureUploader class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CTextureUploader.h"
+
+#include "core/CDicomImage.h"
+
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLTexture>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <DicomViewer/Debug.h>
+
+CTextureUploader::~CTextureUploader() = default;
+
+/**
+ * @brief Whether a context provides buffer mapping and fences
+ * @param context Context to check
+ * @return True for OpenGL 3.2+ or OpenGL ES 3.0+
+ */
+bool CTextureUploader::isSupported(const QOpenGLContext *context)
+{
+    if (!context)
+    {
+        return false;
+    }
+    const auto version = qMakePair(context->format().majorVersion(), context->format().minorVersion());
+    return context->isOpenGLES() ? version >= qMakePair(3, 0) : version >= qMakePair(3, 2);
+}
+
+/**
+ * @brief Starts uploading @p source and its pyramid into @p texture
+ * @param texture Texture with allocated storage
+ * @param source Image whose pixels to upload
+ */
+void CTextureUploader::begin(std::unique_ptr<QOpenGLTexture> texture,
+                             std::shared_ptr<const CDicomImage> source)
+{
+    cancel();
+    if (!texture || !source)
+    {
+        return;
+    }
+
+    if (!source->isPixelDataResident())
+    {
+        return;
+    }
+
+    const auto dims = source->dimensions();
+    if (dims.samplesPerPixel == 3)
+    {
+        m_format = GL_RGB;
+        m_type = GL_UNSIGNED_BYTE;
+        m_pixelBytes = 3;
+    }
+    else if (source->bitsPerSample() == 16)
+    {
+        m_format = GL_RED;
+        m_type = source->isPixelSigned() ? GL_SHORT : GL_UNSIGNED_SHORT;
+        m_pixelBytes = 2;
+    }
+    else
+    {
+        m_format = GL_RED;
+        m_type = GL_UNSIGNED_BYTE;
+        m_pixelBytes = 1;
+    }
+
+    // The texture clamps its level count to what GL allows; levels the
+    // pyramid cannot provide are cut off with the max level
+    const int mipLevels = std::max(1, texture->mipLevels());
+    for (int level = 0; level < mipLevels; ++level)
+    {
+        const auto image =
+            level == 0 ? source : source->residentPyramidLevel(static_cast<uint32_t>(level));
+        CPixelStorage pixels = image ? image->pixelData() : CPixelStorage();
+        if (pixels.empty())
+        {
+            if (level == 0)
+            {
+                return;
+            }
+            texture->setMipMaxLevel(level - 1);
+            break;
+        }
+
+        SLevel entry;
+        entry.level = level;
+        entry.pixels = std::move(pixels);
+        entry.width = std::max(1, texture->width() >> level);
+        entry.height = std::max(1, texture->height() >> level);
+        entry.rowLength = static_cast<int>(image->dimensions().width);
+        m_levels.push_back(std::move(entry));
+    }
+    std::reverse(m_levels.begin(), m_levels.end());
+
+    m_texture = std::move(texture);
+    m_source = std::move(source);
+}
+
+/**
+ * @brief Uploads strips until the budget is spent or the texture is complete
+ * @param budgetNs Time to spend in nanoseconds
+ * @return True once every level is uploaded
+ */
+bool CTextureUploader::step(int64_t budgetNs)
+{
+    if (!isActive())
+    {
+        return false;
+    }
+    if (!ensureStagingBuffers())
+    {
+        cancel();
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(budgetNs);
+    while (m_nextLevel < m_levels.size())
+    {
+        if (m_hasLevel && std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+        if (!acquireStagingBuffer())
+        {
+            // The GPU still reads it; blocking here would stall the GUI thread
+            break;
+        }
+        if (!uploadStrip())
+        {
+            // Rows left undefined must never reach the texture cache
+            cancel();
+            break;
+        }
+    }
+
+    auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+    gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    gl->glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    // Make sure the fences reach the GPU even if nothing is drawn
+    gl->glFlush();
+    return isActive() && m_nextLevel == m_levels.size();
+}
+
+bool CTextureUploader::isActive() const
+{
+    return m_texture != nullptr;
+}
+
+bool CTextureUploader::hasLevel() const
+{
+    return m_hasLevel;
+}
+
+QOpenGLTexture *CTextureUploader::texture() const
+{
+    return m_texture.get();
+}
+
+const std::shared_ptr<const CDicomImage> &CTextureUploader::source() const
+{
+    return m_source;
+}
+
+/**
+ * @brief Hands over the texture of a finished upload
+ * @return Complete texture, nullptr if no upload finished
+ */
+std::unique_ptr<QOpenGLTexture> CTextureUploader::takeTexture()
+{
+    if (!m_texture || m_nextLevel < m_levels.size())
+    {
+        return nullptr;
+    }
+    auto texture = std::move(m_texture);
+    cancel();
+    return texture;
+}
+
+/**
+ * @brief Abandons the upload in progress and deletes its texture
+ */
+void CTextureUploader::cancel()
+{
+    m_texture.reset();
+    m_source.reset();
+    m_levels.clear();
+    m_nextLevel = 0;
+    m_nextRow = 0;
+    m_hasLevel = false;
+}
+
+/**
+ * @brief Cancels and deletes the staging buffers and fences
+ */
+void CTextureUploader::destroy()
+{
+    cancel();
+    auto *context = QOpenGLContext::currentContext();
+    if (!context || m_bufferBytes == 0)
+    {
+        return;
+    }
+    auto *gl = context->extraFunctions();
+    for (auto &fence : m_fences)
+    {
+        if (fence)
+        {
+            gl->glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    gl->glDeleteBuffers(kStagingBuffers, m_buffers.data());
+    m_buffers.fill(0);
+    m_bufferBytes = 0;
+}
+
+/**
+ * @brief Creates or grows the staging buffers to hold a strip of level 0
+ * @return False if the buffers could not be created
+ */
+bool CTextureUploader::ensureStagingBuffers()
+{
+    const SLevel &finest = m_levels.back();
+    const size_t bytes = std::max(kStripBytes, static_cast<size_t>(finest.rowLength) * m_pixelBytes);
+    if (m_bufferBytes >= bytes)
+    {
+        return true;
+    }
+
+    auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+    while (gl->glGetError() != GL_NO_ERROR)
+    {
+    }
+    if (m_bufferBytes == 0)
+    {
+        gl->glGenBuffers(kStagingBuffers, m_buffers.data());
+    }
+    for (int i = 0; i < kStagingBuffers; ++i)
+    {
+        if (m_fences[i])
+        {
+            gl->glDeleteSync(m_fences[i]);
+            m_fences[i] = nullptr;
+        }
+        gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[i]);
+        gl->glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr,
+                         GL_STREAM_DRAW);
+    }
+    gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (gl->glGetError() != GL_NO_ERROR)
+    {
+        DICOMVIEWER_WARN("Failed to allocate texture staging buffers of" << bytes << "bytes");
+        gl->glDeleteBuffers(kStagingBuffers, m_buffers.data());
+        m_buffers.fill(0);
+        m_bufferBytes = 0;
+        return false;
+    }
+    m_bufferBytes = bytes;
+    return true;
+}
+
+/**
+ * @brief Polls whether the GPU is done reading the next staging buffer
+ * @return True if the buffer may be written
+ */
+bool CTextureUploader::acquireStagingBuffer()
+{
+    __GLsync *&fence = m_fences[m_nextBuffer];
+    if (!fence)
+    {
+        return true;
+    }
+    auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+    const GLenum status = gl->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        return false;
+    }
+    gl->glDeleteSync(fence);
+    fence = nullptr;
+    return true;
+}
+
+/**
+ * @brief Copies the next strip of rows into a staging buffer and uploads it
+ * @return False if the staging buffer could not be mapped; the strip is not advanced
+ */
+bool CTextureUploader::uploadStrip()
+{
+    const SLevel &level = m_levels[m_nextLevel];
+    const size_t rowBytes = static_cast<size_t>(level.rowLength) * m_pixelBytes;
+    const int rows = std::min(level.height - m_nextRow,
+                              static_cast<int>(std::max<size_t>(1, m_bufferBytes / rowBytes)));
+    const size_t bytes = static_cast<size_t>(rows) * rowBytes;
+
+    auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+    gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[m_nextBuffer]);
+    // Invalidating lets the driver hand out fresh memory instead of syncing
+    void *mapped = gl->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped)
+    {
+        DICOMVIEWER_WARN("Failed to map texture staging buffer");
+        return false;
+    }
+    std::memcpy(mapped, level.pixels.data() + static_cast<size_t>(m_nextRow) * rowBytes, bytes);
+    if (!gl->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+    {
+        // The store was corrupted while mapped (e.g. a mode switch)
+        DICOMVIEWER_WARN("Texture staging buffer lost while mapped");
+        return false;
+    }
+
+    m_texture->bind();
+    gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    gl->glPixelStorei(GL_UNPACK_ROW_LENGTH, level.rowLength);
+    gl->glTexSubImage2D(GL_TEXTURE_2D, level.level, 0, m_nextRow, level.width, rows, m_format,
+                        m_type, nullptr);
+    m_texture->release();
+    m_fences[m_nextBuffer] = gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_nextBuffer = (m_nextBuffer + 1) % kStagingBuffers;
+
+    m_nextRow += rows;
+    if (m_nextRow >= level.height)
+    {
+        // Sample from the finest level that is fully in
+        m_texture->setMipBaseLevel(level.level);
+        m_hasLevel = true;
+        ++m_nextLevel;
+        m_nextRow = 0;
+    }
+    return true;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file CTextureUploader.h
+ * @brief Incremental texture upload through pixel buffer objects class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CTextureUploader class which streams the mip chain of an
+ * image into a texture a few row strips per frame, so uploading a large
+ * 16-bit image never blocks the GUI thread for more than a frame budget.
+ */
+
+#pragma once
+
+#include "core/CPixelStorage.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class CDicomImage;
+class QOpenGLContext;
+class QOpenGLTexture;
+struct __GLsync;
+
+/**
+ * @class CTextureUploader
+ * @brief Streams pyramid levels into a texture through a ring of PBOs
+ *
+ * Levels are uploaded coarsest first. Rows are copied into one of
+ * kStagingBuffers pixel unpack buffers and handed to glTexSubImage2D
+ * from there, so the transfer itself runs asynchronously; a fence per
+ * buffer tells when the GPU has consumed it and the buffer may be
+ * refilled. While level 0 is incomplete the texture's base level is the
+ * finest complete level, so the texture can be drawn as soon as the
+ * first level is in and sharpens as finer ones arrive.
+ *
+ * The texture is expected to have immutable storage for all its mip
+ * levels already allocated (QOpenGLTexture::allocateStorage()).
+ *
+ * Not thread-safe; every call except isActive() and the accessors must
+ * be made with the owning context current.
+ */
+class CTextureUploader
+{
+  public:
+    static constexpr size_t kStripBytes = size_t(4) * 1024 * 1024; /**< Staging buffer size */
+    static constexpr int kStagingBuffers = 3;
+
+    CTextureUploader() = default;
+
+    /**
+     * @brief Destructor; call destroy() first while the context is current
+     */
+    ~CTextureUploader();
+
+    CTextureUploader(const CTextureUploader &) = delete;
+    CTextureUploader &operator=(const CTextureUploader &) = delete;
+
+    /**
+     * @brief Whether a context provides buffer mapping and fences
+     * @param context Context to check (OpenGL 3.2 or OpenGL ES 3.0 required)
+     * @return True if the uploader can be used with @p context
+     */
+    static bool isSupported(const QOpenGLContext *context);
+
+    /**
+     * @brief Starts uploading @p source and its pyramid into @p texture
+     *
+     * Abandons any upload in progress. Nothing is transferred until the
+     * first step(). Only pixels and pyramid levels already in memory are
+     * used, so nothing is decoded or filtered here; stage the image on a
+     * worker first (CDisplayPrefetcher::stage()). Mip levels that are not
+     * built are cut off, and nothing starts if the pixels are not resident.
+     *
+     * @param texture Texture with allocated storage (ownership passes to the uploader)
+     * @param source Image whose pixels to upload
+     */
+    void begin(std::unique_ptr<QOpenGLTexture> texture, std::shared_ptr<const CDicomImage> source);
+
+    /**
+     * @brief Uploads strips until the budget is spent or the texture is complete
+     *
+     * Never waits for the GPU: if the next staging buffer is still in
+     * use the step ends and the next one continues, so the texture may
+     * not be drawable yet when this returns (see hasLevel()). The budget
+     * applies once a level is in; levels go up coarsest first. If a
+     * staging buffer cannot be created or mapped the upload is
+     * cancelled, so isActive() turns false and the caller must upload
+     * another way.
+     *
+     * @param budgetNs Time to spend in nanoseconds
+     * @return True once every level is uploaded
+     */
+    bool step(int64_t budgetNs);
+
+    /** @name Upload State */
+    ///@{
+    bool isActive() const;
+    bool hasLevel() const; /**< At least one level is in, so the texture can be drawn */
+    QOpenGLTexture *texture() const;
+    const std::shared_ptr<const CDicomImage> &source() const;
+    ///@}
+
+    /**
+     * @brief Hands over the texture of a finished upload
+     * @return Complete texture, nullptr if no upload finished
+     */
+    std::unique_ptr<QOpenGLTexture> takeTexture();
+
+    /**
+     * @brief Abandons the upload in progress and deletes its texture
+     */
+    void cancel();
+
+    /**
+     * @brief Cancels and deletes the staging buffers and fences
+     */
+    void destroy();
+
+  private:
+    /**
+     * @brief One mip level still to be uploaded
+     */
+    struct SLevel
+    {
+        int level = 0;
+        CPixelStorage pixels; /**< Keeps the level's bytes alive */
+        int width = 0;        /**< Texels per row in the texture */
+        int height = 0;       /**< Rows in the texture */
+        int rowLength = 0;    /**< Pixels per row in @c pixels */
+    };
+
+    bool ensureStagingBuffers();
+    bool acquireStagingBuffer();
+    bool uploadStrip();
+
+    std::unique_ptr<QOpenGLTexture> m_texture;
+    std::shared_ptr<const CDicomImage> m_source;
+    std::vector<SLevel> m_levels; /**< Coarsest first */
+    size_t m_nextLevel = 0;
+    int m_nextRow = 0;
+    bool m_hasLevel = false; /**< At least one level complete */
+    uint32_t m_format = 0;   /**< GL pixel format of the source */
+    uint32_t m_type = 0;     /**< GL pixel type of the source */
+    size_t m_pixelBytes = 0;
+
+    std::array<uint32_t, kStagingBuffers> m_buffers{};
+    std::array<__GLsync *, kStagingBuffers> m_fences{};
+    size_t m_bufferBytes = 0;
+    int m_nextBuffer = 0;
+};
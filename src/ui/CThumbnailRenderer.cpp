@@ -0,0 +1,482 @@
+/**
+ * @file CThumbnailRenderer.cpp
+ * @brief Implementation of the CThumbnailRenderer class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CThumbnailRenderer.h"
+
+#include "CTextureUploader.h"
+#include "core/CDicomImage.h"
+#include "utils/CColorPalette.h"
+
+#include <QMatrix4x4>
+#include <QOpenGLBuffer>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLPixelTransferOptions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLVertexArrayObject>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <DicomViewer/Debug.h>
+
+namespace
+{
+constexpr GLuint64 kReadbackWaitNs = 1000000000; /**< Longest wait in collect(true) */
+
+/**
+ * @brief Uploads one pyramid level into a texture without mips
+ * @param level Level image
+ * @param info Receives how texels map back to sample values
+ * @return Texture, nullptr for an image without pixels
+ */
+std::unique_ptr<QOpenGLTexture> createLevelTexture(const CDicomImage &level,
+                                                   CTextureCache::STexture &info)
+{
+    const auto dims = level.dimensions();
+    const auto pixels = level.pixelData();
+    if (pixels.empty() || dims.width == 0 || dims.height == 0)
+    {
+        return nullptr;
+    }
+
+    auto texture = std::make_unique<QOpenGLTexture>(QOpenGLTexture::Target2D);
+    texture->create();
+    texture->setSize(static_cast<int>(dims.width), static_cast<int>(dims.height));
+    texture->setMipLevels(1);
+
+    QOpenGLPixelTransferOptions pixelOpts;
+    pixelOpts.setAlignment(1);
+    pixelOpts.setRowLength(static_cast<int>(dims.width));
+
+    info.isRgb = dims.samplesPerPixel == 3;
+    info.valueMin = 0;
+    if (info.isRgb)
+    {
+        texture->setFormat(QOpenGLTexture::RGB8_UNorm);
+        texture->allocateStorage(QOpenGLTexture::RGB, QOpenGLTexture::UInt8);
+        texture->setData(QOpenGLTexture::RGB, QOpenGLTexture::UInt8, pixels.data(), &pixelOpts);
+        info.valueMax = 255;
+    }
+    else if (level.bitsPerSample() == 16)
+    {
+        // Same signed normalized mapping as the viewer's own textures
+        const bool isSigned = level.isPixelSigned();
+        const auto type = isSigned ? QOpenGLTexture::Int16 : QOpenGLTexture::UInt16;
+        texture->setFormat(isSigned ? QOpenGLTexture::R16_SNorm : QOpenGLTexture::R16_UNorm);
+        texture->allocateStorage(QOpenGLTexture::Red, type);
+        texture->setData(QOpenGLTexture::Red, type, pixels.data(), &pixelOpts);
+        info.valueMax = isSigned ? 32767 : 65535;
+    }
+    else
+    {
+        texture->setFormat(QOpenGLTexture::R8_UNorm);
+        texture->allocateStorage(QOpenGLTexture::Red, QOpenGLTexture::UInt8);
+        texture->setData(QOpenGLTexture::Red, QOpenGLTexture::UInt8, pixels.data(), &pixelOpts);
+        info.valueMax = 255;
+    }
+    texture->setMinificationFilter(QOpenGLTexture::Linear);
+    texture->setMagnificationFilter(QOpenGLTexture::Linear);
+    texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    return texture;
+}
+} // namespace
+
+CThumbnailRenderer::CThumbnailRenderer() = default;
+
+CThumbnailRenderer::~CThumbnailRenderer() = default;
+
+/**
+ * @brief Draws thumbnails and starts reading them back
+ * @param requests Thumbnails to draw
+ * @param cellSize Size each thumbnail is fitted into
+ * @param program Linked viewer shader program
+ * @param textures Viewer texture cache searched for full-resolution textures
+ * @return False if nothing could be drawn
+ */
+bool CThumbnailRenderer::render(const std::vector<SRequest> &requests, const QSize &cellSize,
+                                QOpenGLShaderProgram &program, CTextureCache &textures)
+{
+    if (requests.empty() || cellSize.isEmpty() || !ensureAtlas(cellSize))
+    {
+        return false;
+    }
+
+    auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+    const int perPage = m_columns * m_rows;
+    bool drawn = false;
+    for (size_t first = 0; first < requests.size(); first += static_cast<size_t>(perPage))
+    {
+        const size_t count = std::min(requests.size() - first, static_cast<size_t>(perPage));
+        const int columns = std::min(static_cast<int>(count), m_columns);
+        const int rows = (static_cast<int>(count) + m_columns - 1) / m_columns;
+        const QSize pageSize(columns * cellSize.width(), rows * cellSize.height());
+
+        m_atlas->bind();
+        gl->glViewport(0, 0, pageSize.width(), pageSize.height());
+        gl->glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        gl->glClear(GL_COLOR_BUFFER_BIT);
+        program.bind();
+        m_vao->bind();
+        program.setUniformValue("u_tex", 0);
+        program.setUniformValue("u_lut", 1);
+
+        std::vector<SCell> cells;
+        cells.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const SRequest &request = requests[first + i];
+            const CTextureCache::STexture *texture = request.image ? textureFor(request, textures)
+                                                                   : nullptr;
+            if (!texture)
+            {
+                continue;
+            }
+
+            const auto dims = request.image->dimensions();
+            const bool quarterTurn = (request.rotationDegrees / 90) % 2 != 0;
+            const double rotatedWidth = quarterTurn ? dims.height : dims.width;
+            const double rotatedHeight = quarterTurn ? dims.width : dims.height;
+            const double scale = std::min(cellSize.width() / rotatedWidth,
+                                          cellSize.height() / rotatedHeight);
+
+            const int column = static_cast<int>(i) % m_columns;
+            const int row = static_cast<int>(i) / m_columns;
+            gl->glViewport(column * cellSize.width(), row * cellSize.height(), cellSize.width(),
+                           cellSize.height());
+
+            // Bottom-up projection: glReadPixels returns the top image row first
+            QMatrix4x4 mvp;
+            mvp.ortho(0.0f, static_cast<float>(cellSize.width()), 0.0f,
+                      static_cast<float>(cellSize.height()), -1.0f, 1.0f);
+            mvp.translate(cellSize.width() / 2.0f, cellSize.height() / 2.0f);
+            mvp.rotate(static_cast<float>(request.rotationDegrees), 0.0f, 0.0f, 1.0f);
+            mvp.scale(static_cast<float>(scale), static_cast<float>(scale));
+            mvp.translate(-static_cast<float>(dims.width) / 2.0f,
+                          -static_cast<float>(dims.height) / 2.0f);
+            mvp.scale(static_cast<float>(dims.width), static_cast<float>(dims.height));
+
+            QOpenGLTexture *lut = paletteTexture(request.palette);
+            texture->texture->bind(0);
+            if (lut)
+            {
+                lut->bind(1);
+            }
+            program.setUniformValue("u_mvp", mvp);
+            program.setUniformValue("u_wc", static_cast<float>(request.windowLevel.center));
+            program.setUniformValue("u_ww", static_cast<float>(request.windowLevel.width));
+            program.setUniformValue("u_valueMin", static_cast<float>(texture->valueMin));
+            program.setUniformValue("u_valueMax", static_cast<float>(texture->valueMax));
+            program.setUniformValue("u_isColor", texture->isRgb ? 1 : 0);
+            program.setUniformValue("u_usePalette", lut ? 1 : 0);
+            program.setUniformValue(
+                "u_invert", request.image->photometricInterpretation() ==
+                                    DicomViewer::EPhotometricInterpretation::Monochrome1
+                                ? 1
+                                : 0);
+            gl->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+            const int drawnWidth = std::max(1, static_cast<int>(std::lround(rotatedWidth * scale)));
+            const int drawnHeight = std::max(1, static_cast<int>(std::lround(rotatedHeight * scale)));
+            SCell cell;
+            cell.index = request.index;
+            cell.image = request.image.get();
+            cell.rect = QRect(column * cellSize.width() + (cellSize.width() - drawnWidth) / 2,
+                              row * cellSize.height() + (cellSize.height() - drawnHeight) / 2,
+                              drawnWidth, drawnHeight);
+            cells.push_back(cell);
+        }
+
+        m_vao->release();
+        program.release();
+        if (!cells.empty())
+        {
+            readBack(pageSize, std::move(cells));
+            drawn = true;
+        }
+        m_atlas->release();
+    }
+    return drawn;
+}
+
+/**
+ * @brief Takes the thumbnails of pages whose readback has finished
+ * @param wait True to block until every pending page is read back
+ * @return Finished thumbnails in request order
+ */
+std::vector<CThumbnailRenderer::SResult> CThumbnailRenderer::collect(bool wait)
+{
+    std::vector<SResult> results;
+    auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+    while (!m_pending.empty())
+    {
+        SReadback &page = m_pending.front();
+        const uint8_t *pixels = page.pixels.data();
+        if (page.buffer != 0)
+        {
+            const GLenum status = gl->glClientWaitSync(page.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                                       wait ? kReadbackWaitNs : 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+            {
+                break;
+            }
+            gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, page.buffer);
+            pixels = static_cast<const uint8_t *>(
+                gl->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                     static_cast<GLsizeiptr>(page.size.width()) * page.size.height() * 4,
+                                     GL_MAP_READ_BIT));
+        }
+
+        if (pixels)
+        {
+            const QImage atlas(pixels, page.size.width(), page.size.height(),
+                               page.size.width() * 4, QImage::Format_RGBA8888);
+            for (const SCell &cell : page.cells)
+            {
+                results.push_back({cell.index, cell.image, atlas.copy(cell.rect)});
+            }
+        }
+        else
+        {
+            DICOMVIEWER_WARN("Failed to map thumbnail readback buffer");
+        }
+
+        if (page.buffer != 0)
+        {
+            if (pixels)
+            {
+                gl->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            gl->glDeleteSync(page.fence);
+            m_freeBuffers.push_back(page.buffer);
+        }
+        m_pending.pop_front();
+    }
+    return results;
+}
+
+bool CThumbnailRenderer::hasPending() const
+{
+    return !m_pending.empty();
+}
+
+/**
+ * @brief Deletes every GL resource and drops pending readbacks
+ */
+void CThumbnailRenderer::destroy()
+{
+    auto *context = QOpenGLContext::currentContext();
+    if (context)
+    {
+        auto *gl = context->extraFunctions();
+        for (SReadback &page : m_pending)
+        {
+            if (page.buffer != 0)
+            {
+                gl->glDeleteSync(page.fence);
+                m_freeBuffers.push_back(page.buffer);
+            }
+        }
+        if (!m_freeBuffers.empty())
+        {
+            gl->glDeleteBuffers(static_cast<GLsizei>(m_freeBuffers.size()), m_freeBuffers.data());
+        }
+    }
+    m_pending.clear();
+    m_freeBuffers.clear();
+    m_palettes.clear();
+    m_levelTextures.clear();
+    m_vbo.reset();
+    m_vao.reset();
+    m_atlas.reset();
+    m_cellSize = QSize();
+}
+
+/**
+ * @brief Creates the atlas for @p cellSize and the unit quad on first use
+ * @param cellSize Size of one thumbnail cell
+ * @return False if the framebuffer could not be created
+ */
+bool CThumbnailRenderer::ensureAtlas(const QSize &cellSize)
+{
+    if (!m_vao)
+    {
+        static const float kUnitQuad[] = {0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
+                                          0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+        m_vao = std::make_unique<QOpenGLVertexArrayObject>();
+        m_vao->create();
+        m_vbo = std::make_unique<QOpenGLBuffer>(QOpenGLBuffer::VertexBuffer);
+        m_vbo->create();
+
+        auto *gl = QOpenGLContext::currentContext()->extraFunctions();
+        m_vao->bind();
+        m_vbo->bind();
+        m_vbo->allocate(kUnitQuad, sizeof(kUnitQuad));
+        // Same layout as the viewer's quad: position at 0, texture coordinate at 1
+        gl->glEnableVertexAttribArray(0);
+        gl->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
+        gl->glEnableVertexAttribArray(1);
+        gl->glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float),
+                                  reinterpret_cast<const void *>(2 * sizeof(float)));
+        m_vao->release();
+        m_vbo->release();
+    }
+
+    if (m_atlas && m_cellSize == cellSize)
+    {
+        return true;
+    }
+
+    m_columns = std::max(1, kMaxAtlasExtent / cellSize.width());
+    m_rows = std::max(1, kMaxAtlasExtent / cellSize.height());
+    QOpenGLFramebufferObjectFormat format;
+    format.setAttachment(QOpenGLFramebufferObject::NoAttachment);
+    format.setInternalTextureFormat(GL_RGBA8);
+    m_atlas = std::make_unique<QOpenGLFramebufferObject>(
+        QSize(m_columns * cellSize.width(), m_rows * cellSize.height()), format);
+    if (!m_atlas->isValid())
+    {
+        DICOMVIEWER_WARN("Failed to create thumbnail atlas for cell size" << cellSize);
+        m_atlas.reset();
+        return false;
+    }
+    m_cellSize = cellSize;
+    return true;
+}
+
+/**
+ * @brief Texture to draw a request from
+ *
+ * Prefers the viewer's full-resolution texture with its mips, then a
+ * cached upload of the pyramid level matching the thumbnail size.
+ *
+ * @param request Thumbnail request with an image
+ * @param textures Viewer texture cache
+ * @return Texture, nullptr if the image has no pixels
+ */
+const CTextureCache::STexture *CThumbnailRenderer::textureFor(const SRequest &request,
+                                                              CTextureCache &textures)
+{
+    if (const auto *cached = textures.find(request.image))
+    {
+        return cached;
+    }
+
+    const auto dims = request.image->dimensions();
+    const double scale = std::min(static_cast<double>(m_cellSize.width()) / dims.width,
+                                  static_cast<double>(m_cellSize.height()) / dims.height);
+    std::shared_ptr<const CDicomImage> level =
+        request.image->pyramidLevel(request.image->pyramidLevelForScale(scale));
+    if (!level)
+    {
+        level = request.image;
+    }
+    if (const auto *cached = m_levelTextures.find(level))
+    {
+        return cached;
+    }
+
+    CTextureCache::STexture info;
+    auto texture = createLevelTexture(*level, info);
+    if (!texture)
+    {
+        return nullptr;
+    }
+    return m_levelTextures.insert(level, std::move(texture), info.isRgb, info.valueMin,
+                                  info.valueMax);
+}
+
+/**
+ * @brief Lookup table texture of a palette, built on first use
+ * @param type Palette type
+ * @return Texture, nullptr for grayscale
+ */
+QOpenGLTexture *CThumbnailRenderer::paletteTexture(DicomViewer::EPaletteType type)
+{
+    if (type == DicomViewer::EPaletteType::Grayscale)
+    {
+        return nullptr;
+    }
+    auto &texture = m_palettes[type];
+    if (texture)
+    {
+        return texture.get();
+    }
+
+    const CColorPalette palette(type);
+    std::array<uint8_t, 256 * 3> lut{};
+    for (int i = 0; i < 256; ++i)
+    {
+        const auto rgb = palette.mapRgb(static_cast<uint8_t>(i));
+        lut[i * 3 + 0] = rgb[0];
+        lut[i * 3 + 1] = rgb[1];
+        lut[i * 3 + 2] = rgb[2];
+    }
+
+    QOpenGLPixelTransferOptions pixelOpts;
+    pixelOpts.setAlignment(1);
+    pixelOpts.setRowLength(256);
+
+    texture = std::make_unique<QOpenGLTexture>(QOpenGLTexture::Target2D);
+    texture->setSize(256, 1);
+    texture->setFormat(QOpenGLTexture::RGB8_UNorm);
+    texture->allocateStorage(QOpenGLTexture::RGB, QOpenGLTexture::UInt8);
+    texture->setMinificationFilter(QOpenGLTexture::Linear);
+    texture->setMagnificationFilter(QOpenGLTexture::Linear);
+    texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    texture->setData(QOpenGLTexture::RGB, QOpenGLTexture::UInt8, lut.data(), &pixelOpts);
+    return texture.get();
+}
+
+/**
+ * @brief Queues the readback of the bound atlas page
+ *
+ * With fences the pixels go into a pixel pack buffer and are mapped by
+ * collect() once the GPU is done; otherwise they are read immediately.
+ *
+ * @param size Read-back area, anchored at the atlas origin
+ * @param cells Thumbnails drawn on the page
+ */
+void CThumbnailRenderer::readBack(const QSize &size, std::vector<SCell> cells)
+{
+    auto *context = QOpenGLContext::currentContext();
+    auto *gl = context->extraFunctions();
+    const size_t bytes = static_cast<size_t>(size.width()) * size.height() * 4;
+
+    SReadback page;
+    page.size = size;
+    page.cells = std::move(cells);
+    gl->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    if (CTextureUploader::isSupported(context))
+    {
+        if (m_freeBuffers.empty())
+        {
+            GLuint buffer = 0;
+            gl->glGenBuffers(1, &buffer);
+            m_freeBuffers.push_back(buffer);
+        }
+        page.buffer = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+        gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, page.buffer);
+        gl->glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr,
+                         GL_STREAM_READ);
+        gl->glReadPixels(0, 0, size.width(), size.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        page.fence = gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        gl->glFlush();
+    }
+    else
+    {
+        page.pixels.resize(bytes);
+        gl->glReadPixels(0, 0, size.width(), size.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                         page.pixels.data());
+    }
+    m_pending.push_back(std::move(page));
+}
@@ -0,0 +1,151 @@
+/**
+ * @file CThumbnailRenderer.h
+ * @brief Batched GPU thumbnail rendering class declaration
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CThumbnailRenderer class which draws many thumbnails into
+ * one reusable framebuffer atlas per pass and reads them back without
+ * stalling the GUI thread.
+ */
+
+#pragma once
+
+#include "CTextureCache.h"
+#include "DicomViewer/Types.h"
+
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+class CDicomImage;
+class QOpenGLBuffer;
+class QOpenGLFramebufferObject;
+class QOpenGLShaderProgram;
+class QOpenGLTexture;
+class QOpenGLVertexArrayObject;
+struct __GLsync;
+
+/**
+ * @class CThumbnailRenderer
+ * @brief Renders thumbnail batches into an atlas with asynchronous readback
+ *
+ * Each render() packs the requested thumbnails into cells of an
+ * offscreen atlas (at most kMaxAtlasExtent pixels square, allocated
+ * once per cell size) and draws them with the viewer's shader in one
+ * framebuffer pass per atlas page. Pages are read back into pixel pack
+ * buffers guarded by fences; collect() hands out the thumbnails of
+ * pages the GPU has finished.
+ *
+ * Thumbnails sample the viewer's cached full-resolution texture when
+ * there is one, otherwise the pyramid level closest to the thumbnail
+ * size, uploaded once into a small cache of its own.
+ *
+ * Not thread-safe; every call must be made with the owning context
+ * current.
+ */
+class CThumbnailRenderer
+{
+  public:
+    static constexpr int kMaxAtlasExtent = 2048;
+    static constexpr size_t kLevelTextureBudgetBytes = size_t(64) * 1024 * 1024;
+
+    /**
+     * @brief One thumbnail to render
+     */
+    struct SRequest
+    {
+        int index = -1; /**< Caller's identifier, returned with the result */
+        std::shared_ptr<const CDicomImage> image;
+        DicomViewer::SWindowLevel windowLevel{};
+        DicomViewer::EPaletteType palette = DicomViewer::EPaletteType::Grayscale;
+        int rotationDegrees = 0;
+    };
+
+    /**
+     * @brief One finished thumbnail
+     */
+    struct SResult
+    {
+        int index = -1;
+        const CDicomImage *image = nullptr; /**< Identity of the request's image */
+        QImage thumbnail;                   /**< Fitted to the cell, bars cropped */
+    };
+
+    CThumbnailRenderer();
+
+    /**
+     * @brief Destructor; call destroy() first while the context is current
+     */
+    ~CThumbnailRenderer();
+
+    CThumbnailRenderer(const CThumbnailRenderer &) = delete;
+    CThumbnailRenderer &operator=(const CThumbnailRenderer &) = delete;
+
+    /**
+     * @brief Draws thumbnails and starts reading them back
+     * @param requests Thumbnails to draw
+     * @param cellSize Size each thumbnail is fitted into
+     * @param program Linked viewer shader program
+     * @param textures Viewer texture cache searched for full-resolution textures
+     * @return False if nothing could be drawn
+     */
+    bool render(const std::vector<SRequest> &requests, const QSize &cellSize,
+                QOpenGLShaderProgram &program, CTextureCache &textures);
+
+    /**
+     * @brief Takes the thumbnails of pages whose readback has finished
+     * @param wait True to block until every pending page is read back
+     * @return Finished thumbnails in request order
+     */
+    std::vector<SResult> collect(bool wait);
+
+    /**
+     * @brief Whether pages are still being read back
+     * @return True while collect() has thumbnails to deliver
+     */
+    bool hasPending() const;
+
+    /**
+     * @brief Deletes every GL resource and drops pending readbacks
+     */
+    void destroy();
+
+  private:
+    struct SCell
+    {
+        int index = -1;
+        const CDicomImage *image = nullptr;
+        QRect rect; /**< Drawn area in the read-back page, top row first */
+    };
+
+    struct SReadback
+    {
+        uint32_t buffer = 0;        /**< Pixel pack buffer, 0 when read synchronously */
+        __GLsync *fence = nullptr;
+        QSize size;                 /**< Read-back area of the atlas */
+        std::vector<uint8_t> pixels; /**< Synchronous readback */
+        std::vector<SCell> cells;
+    };
+
+    bool ensureAtlas(const QSize &cellSize);
+    const CTextureCache::STexture *textureFor(const SRequest &request, CTextureCache &textures);
+    QOpenGLTexture *paletteTexture(DicomViewer::EPaletteType type);
+    void readBack(const QSize &size, std::vector<SCell> cells);
+
+    std::unique_ptr<QOpenGLFramebufferObject> m_atlas;
+    QSize m_cellSize;
+    int m_columns = 0;
+    int m_rows = 0;
+    std::unique_ptr<QOpenGLVertexArrayObject> m_vao;
+    std::unique_ptr<QOpenGLBuffer> m_vbo; /**< Unit quad */
+    CTextureCache m_levelTextures{kLevelTextureBudgetBytes};
+    std::map<DicomViewer::EPaletteType, std::unique_ptr<QOpenGLTexture>> m_palettes;
+    std::deque<SReadback> m_pending;
+    std::vector<uint32_t> m_freeBuffers;
+};
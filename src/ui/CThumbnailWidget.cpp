@@ -234,15 +234,21 @@ QImage CThumbnailWidget::buildThumbnail(const CDicomImage &image, DicomViewer::E
         return QImage();
     }
 
+    // Convert the smallest pyramid level that still covers the thumbnail
+    const auto dims = image.dimensions();
+    const double scale = std::min(static_cast<double>(m_thumbnailSize.width()) / dims.width,
+                                  static_cast<double>(m_thumbnailSize.height()) / dims.height);
+    const auto level = image.pyramidLevel(image.pyramidLevelForScale(scale));
+
     CImageConverter converter;
     converter.setPalette(palette);
-    QImage fullImage = converter.toQImage(image, image.windowLevel());
-    if (fullImage.isNull())
+    QImage converted = converter.toQImage(level ? *level : image, image.windowLevel());
+    if (converted.isNull())
     {
         return QImage();
     }
 
-    return fullImage.scaled(m_thumbnailSize, Qt::KeepAspectRatio,
+    return converted.scaled(m_thumbnailSize, Qt::KeepAspectRatio,
                             Qt::SmoothTransformation);
 }
 
@@ -12,6 +12,7 @@
 #include <QObject>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 /**
  * @brief Default constructor - creates grayscale palette
@@ -75,6 +76,15 @@ std::array<uint8_t, 3> CColorPalette::mapRgb(uint8_t grayValue) const
     return m_lut[grayValue];
 }
 
+/**
+ * @brief Gets the palette as one 32-bit entry per grayscale value
+ * @return Packed lookup table (R, G, B, 0 in memory order)
+ */
+const std::array<uint32_t, 256> &CColorPalette::packedLut() const
+{
+    return m_packedLut;
+}
+
 /**
  * @brief Gets the palette name for display
  * @return Human-readable palette name
@@ -166,6 +176,12 @@ void CColorPalette::generateLut()
         generateGrayscale();
         break;
     }
+
+    for (size_t i = 0; i < m_lut.size(); ++i)
+    {
+        m_packedLut[i] = 0;
+        std::memcpy(&m_packedLut[i], m_lut[i].data(), 3);
+    }
 }
 
 /**
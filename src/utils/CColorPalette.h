@@ -15,6 +15,7 @@
 #include <QColor>
 #include <QString>
 #include <array>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -66,6 +67,17 @@ class CColorPalette
      */
     std::array<uint8_t, 3> mapRgb(uint8_t grayValue) const;
 
+    /**
+     * @brief Gets the palette as one 32-bit entry per grayscale value
+     *
+     * Each entry holds R, G, B in its first three bytes (memory order)
+     * and zero in the fourth, so a pixel can be written with a single
+     * 4-byte store into an RGB24 row.
+     *
+     * @return Packed lookup table
+     */
+    const std::array<uint32_t, 256> &packedLut() const;
+
     /**
      * @brief Gets the palette name for display
      * @return Palette name
@@ -137,4 +149,5 @@ class CColorPalette
 
     DicomViewer::EPaletteType m_type = DicomViewer::EPaletteType::Grayscale; /**< Current palette type */
     std::array<std::array<uint8_t, 3>, 256> m_lut; /**< RGB lookup table */
+    std::array<uint32_t, 256> m_packedLut{};       /**< m_lut as 4-byte entries */
 };
@@ -10,6 +10,9 @@
  */
 
 #include "CImageConverter.h"
+#include "CLutCache.h"
+#include "CThreadPool.h"
+#include "CWindowLevelKernel.h"
 
 #include <algorithm>
 #include <array>
@@ -43,6 +46,24 @@ const CColorPalette &CImageConverter::palette() const
     return m_palette;
 }
 
+/**
+ * @brief Sets the minimum number of pixels converted per parallel band
+ * @param pixels Pixels per band (0 restores the default)
+ */
+void CImageConverter::setGrainSize(size_t pixels)
+{
+    m_grainPixels = pixels > 0 ? pixels : kDefaultGrainPixels;
+}
+
+/**
+ * @brief Gets the minimum number of pixels converted per parallel band
+ * @return Pixels per band
+ */
+size_t CImageConverter::grainSize() const
+{
+    return m_grainPixels;
+}
+
 /**
  * @brief Converts DICOM image to QImage using current window/level
  * @param dicomImage Source DICOM image
@@ -87,7 +108,10 @@ QImage CImageConverter::toQImage(const CDicomImage &dicomImage,
  * @brief Converts monochrome DICOM image to QImage with palette
  *
  * Supports both 8-bit and 16-bit pixel data. Applies window/level
- * transformation and optional color palette.
+ * transformation and optional color palette. Uses the SIMD kernels
+ * when the CPU supports them; the lookup-table path below is the
+ * portable fallback, with tables cached in CLutCache. Rows are
+ * converted in parallel bands.
  *
  * @param image Source DICOM image
  * @param wl Window/level settings for contrast adjustment
@@ -119,115 +143,139 @@ QImage CImageConverter::convertMonochrome(const CDicomImage &image,
                                 DicomViewer::EPhotometricInterpretation::Monochrome1);
     const bool isSigned = image.isPixelSigned();
 
-    int minValue = 0;
-    int maxValue = 255;
-    if (is16bit)
+    if (CWindowLevelKernel::isAccelerated())
     {
-        if (isSigned)
-        {
-            minValue = -32768;
-            maxValue = 32767;
-        }
-        else
-        {
-            minValue = 0;
-            maxValue = 65535;
-        }
+        return convertMonochromeSimd(pixelData.data(), dims, is16bit, isSigned,
+                                     wl, isMonochrome1, useColorPalette);
     }
 
-    const auto lut = buildWindowLevelLut(wl, minValue, maxValue, isMonochrome1);
-    const int lutOffset = -minValue;
-
-    if (!useColorPalette)
+    // Tables cover only the image's stored value range and are reused
+    // across renders with the same settings
+    const auto range = image.valueRange();
+    CLutCache::SKey key;
+    key.center = wl.center;
+    key.width = wl.width;
+    key.minValue = range.min;
+    key.maxValue = range.max;
+    key.invert = isMonochrome1;
+    key.palette = m_palette.type();
+    const auto lut = CLutCache::shared().acquire(key, m_palette);
+    const int lutMin = std::min(range.min, range.max);
+    const int lutLast = static_cast<int>(lut->gray.size()) - 1;
+
+    // Grayscale output, or RGB output through the palette
+    QImage result(static_cast<int>(dims.width),
+                  static_cast<int>(dims.height),
+                  useColorPalette ? QImage::Format_RGB888 : QImage::Format_Grayscale8);
+    if (result.isNull())
     {
-        QImage result(static_cast<int>(dims.width),
-                      static_cast<int>(dims.height),
-                      QImage::Format_Grayscale8);
+        return QImage();
+    }
+
+    uint8_t *dstBits = result.bits();
+    const size_t dstStride = static_cast<size_t>(result.bytesPerLine());
+    const uint8_t *srcBits = pixelData.data();
 
-        if (is16bit)
+    forEachRowBand(dims, [&](uint32_t rowBegin, uint32_t rowEnd)
+                   {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
         {
-            const auto *src = reinterpret_cast<const uint16_t *>(pixelData.data());
-            for (uint32_t y = 0; y < dims.height; ++y)
+            uint8_t *dstRow = dstBits + static_cast<size_t>(y) * dstStride;
+            const size_t rowOffset = static_cast<size_t>(y) * dims.width;
+            for (uint32_t x = 0; x < dims.width; ++x)
             {
-                uint8_t *dstRow = result.scanLine(static_cast<int>(y));
-                const size_t rowOffset = static_cast<size_t>(y) * dims.width;
-                for (uint32_t x = 0; x < dims.width; ++x)
+                const size_t index = rowOffset + x;
+                int pixelValue = 0;
+                if (is16bit)
                 {
-                    const size_t index = rowOffset + x;
-                    int pixelValue = isSigned
-                                         ? static_cast<int>(reinterpret_cast<const int16_t *>(src)[index])
-                                         : static_cast<int>(src[index]);
-                    dstRow[x] = lut[static_cast<size_t>(pixelValue + lutOffset)];
+                    const auto *src = reinterpret_cast<const uint16_t *>(srcBits);
+                    pixelValue = isSigned
+                                     ? static_cast<int>(reinterpret_cast<const int16_t *>(src)[index])
+                                     : static_cast<int>(src[index]);
                 }
-            }
-        }
-        else
-        {
-            const uint8_t *src = pixelData.data();
-            for (uint32_t y = 0; y < dims.height; ++y)
-            {
-                uint8_t *dstRow = result.scanLine(static_cast<int>(y));
-                const size_t rowOffset = static_cast<size_t>(y) * dims.width;
-                for (uint32_t x = 0; x < dims.width; ++x)
+                else
+                {
+                    pixelValue = srcBits[index];
+                }
+                const auto lutIndex = static_cast<size_t>(
+                    std::clamp(pixelValue - lutMin, 0, lutLast));
+
+                if (!useColorPalette)
                 {
-                    dstRow[x] = lut[src[rowOffset + x]];
+                    dstRow[x] = lut->gray[lutIndex];
+                }
+                else if (x + 1 < dims.width)
+                {
+                    // One 4-byte store; the spare byte is overwritten next
+                    std::memcpy(dstRow + x * 3, &lut->rgb[lutIndex], 4);
+                }
+                else
+                {
+                    std::memcpy(dstRow + x * 3, &lut->rgb[lutIndex], 3);
                 }
             }
-        }
+        } });
 
-        return result;
-    }
+    return result;
+}
 
-    std::array<std::array<uint8_t, 3>, 256> rgbLut{};
-    for (int i = 0; i < 256; ++i)
-    {
-        auto rgb = m_palette.mapRgb(static_cast<uint8_t>(i));
-        rgbLut[i] = {rgb[0], rgb[1], rgb[2]};
-    }
+/**
+ * @brief Converts monochrome pixels with the SIMD window/level kernels
+ *
+ * Window/level and the palette expansion run in a single pass per row,
+ * with no lookup table to build; the palette's packed table is used
+ * as is.
+ *
+ * @param pixels First pixel byte
+ * @param dims Image dimensions
+ * @param is16bit True for 16-bit samples
+ * @param isSigned True for signed 16-bit samples
+ * @param wl Window/level settings for contrast adjustment
+ * @param invert True to invert output (MONOCHROME1)
+ * @param useColorPalette True to expand through the current palette
+ * @return QImage with applied palette
+ */
+QImage CImageConverter::convertMonochromeSimd(const uint8_t *pixels,
+                                              const DicomViewer::SImageDimensions &dims,
+                                              bool is16bit,
+                                              bool isSigned,
+                                              const DicomViewer::SWindowLevel &wl,
+                                              bool invert,
+                                              bool useColorPalette) const
+{
+    using ESampleFormat = CWindowLevelKernel::ESampleFormat;
+    const ESampleFormat format = !is16bit ? ESampleFormat::Unsigned8
+                                 : isSigned ? ESampleFormat::Signed16
+                                            : ESampleFormat::Unsigned16;
+    const size_t rowBytes = static_cast<size_t>(dims.width) * (is16bit ? 2 : 1);
+    const CWindowLevelKernel kernel(wl, invert);
 
-    // Apply color palette - output as RGB
     QImage result(static_cast<int>(dims.width),
                   static_cast<int>(dims.height),
-                  QImage::Format_RGB888);
-
-    if (is16bit)
+                  useColorPalette ? QImage::Format_RGB888 : QImage::Format_Grayscale8);
+    if (result.isNull())
     {
-        const auto *src = reinterpret_cast<const uint16_t *>(pixelData.data());
-        for (uint32_t y = 0; y < dims.height; ++y)
+        return QImage();
+    }
+
+    uint8_t *dstBits = result.bits();
+    const size_t dstStride = static_cast<size_t>(result.bytesPerLine());
+
+    forEachRowBand(dims, [&](uint32_t rowBegin, uint32_t rowEnd)
+                   {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
         {
-            uint8_t *dstRow = result.scanLine(static_cast<int>(y));
-            const size_t rowOffset = static_cast<size_t>(y) * dims.width;
-            for (uint32_t x = 0; x < dims.width; ++x)
+            const uint8_t *srcRow = pixels + static_cast<size_t>(y) * rowBytes;
+            uint8_t *dstRow = dstBits + static_cast<size_t>(y) * dstStride;
+            if (useColorPalette)
             {
-                const size_t index = rowOffset + x;
-                int pixelValue = isSigned
-                                     ? static_cast<int>(reinterpret_cast<const int16_t *>(src)[index])
-                                     : static_cast<int>(src[index]);
-                const uint8_t value = lut[static_cast<size_t>(pixelValue + lutOffset)];
-                const auto &rgb = rgbLut[value];
-                dstRow[x * 3 + 0] = rgb[0];
-                dstRow[x * 3 + 1] = rgb[1];
-                dstRow[x * 3 + 2] = rgb[2];
+                kernel.toRgb(srcRow, format, dims.width, m_palette.packedLut(), dstRow);
             }
-        }
-    }
-    else
-    {
-        const uint8_t *src = pixelData.data();
-        for (uint32_t y = 0; y < dims.height; ++y)
-        {
-            uint8_t *dstRow = result.scanLine(static_cast<int>(y));
-            const size_t rowOffset = static_cast<size_t>(y) * dims.width;
-            for (uint32_t x = 0; x < dims.width; ++x)
+            else
             {
-                const uint8_t value = lut[src[rowOffset + x]];
-                const auto &rgb = rgbLut[value];
-                dstRow[x * 3 + 0] = rgb[0];
-                dstRow[x * 3 + 1] = rgb[1];
-                dstRow[x * 3 + 2] = rgb[2];
+                kernel.toGray(srcRow, format, dims.width, dstRow);
             }
-        }
-    }
+        } });
 
     return result;
 }
@@ -251,6 +299,10 @@ QImage CImageConverter::convertRgb(const CDicomImage &image) const
     QImage result(static_cast<int>(dims.width),
                   static_cast<int>(dims.height),
                   QImage::Format_RGB888);
+    if (result.isNull())
+    {
+        return QImage();
+    }
 
     // Verify data size matches expected dimensions (3 bytes per pixel)
     const size_t expectedSize = static_cast<size_t>(dims.width) * dims.height * 3;
@@ -261,65 +313,38 @@ QImage CImageConverter::convertRgb(const CDicomImage &image) const
 
     // Copy pixel data row by row
     const size_t rowBytes = static_cast<size_t>(dims.width) * 3;
-    for (uint32_t y = 0; y < dims.height; ++y)
-    {
-        const uint8_t *srcRow = pixelData.data() + (y * rowBytes);
-        uint8_t *dstRow = result.scanLine(static_cast<int>(y));
-        std::memcpy(dstRow, srcRow, rowBytes);
-    }
+    uint8_t *dstBits = result.bits();
+    const size_t dstStride = static_cast<size_t>(result.bytesPerLine());
+    forEachRowBand(dims, [&](uint32_t rowBegin, uint32_t rowEnd)
+                   {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            const uint8_t *srcRow = pixelData.data() + (y * rowBytes);
+            uint8_t *dstRow = dstBits + static_cast<size_t>(y) * dstStride;
+            std::memcpy(dstRow, srcRow, rowBytes);
+        } });
 
     return result;
 }
 
-std::vector<uint8_t> CImageConverter::buildWindowLevelLut(
-    const DicomViewer::SWindowLevel &wl,
-    int minValue,
-    int maxValue,
-    bool invertForMonochrome1) const
+/**
+ * @brief Runs a row conversion over the image in parallel bands
+ *
+ * Bands cover at least the configured grain of pixels, so small images
+ * (thumbnails, CT slices) stay on the calling thread. Each band writes
+ * only its own rows, so the output does not depend on scheduling.
+ *
+ * @param dims Image dimensions
+ * @param convertRows Callable invoked as convertRows(rowBegin, rowEnd)
+ */
+void CImageConverter::forEachRowBand(
+    const DicomViewer::SImageDimensions &dims,
+    const std::function<void(uint32_t rowBegin, uint32_t rowEnd)> &convertRows) const
 {
-    if (maxValue < minValue)
-    {
-        std::swap(minValue, maxValue);
-    }
-
-    const int range = maxValue - minValue + 1;
-    std::vector<uint8_t> lut(static_cast<size_t>(range));
-
-    if (wl.width <= 0.0)
-    {
-        std::fill(lut.begin(), lut.end(), static_cast<uint8_t>(0));
-        return lut;
-    }
-
-    const double lowerBound = wl.center - (wl.width / 2.0);
-    const double upperBound = wl.center + (wl.width / 2.0);
-    const double scale = 255.0 / wl.width;
-
-    for (int i = 0; i < range; ++i)
-    {
-        const double rawValue = static_cast<double>(minValue + i);
-        uint8_t value;
-
-        if (rawValue <= lowerBound)
-        {
-            value = 0;
-        }
-        else if (rawValue >= upperBound)
-        {
-            value = 255;
-        }
-        else
-        {
-            value = static_cast<uint8_t>((rawValue - lowerBound) * scale);
-        }
-
-        if (invertForMonochrome1)
-        {
-            value = 255 - value;
-        }
-
-        lut[static_cast<size_t>(i)] = value;
-    }
-
-    return lut;
+    const size_t width = std::max<size_t>(1, dims.width);
+    const size_t rowsPerBand = std::max<size_t>(1, m_grainPixels / width);
+    CThreadPool::shared().parallelFor(
+        dims.height, rowsPerBand,
+        [&convertRows](size_t begin, size_t end)
+        { convertRows(static_cast<uint32_t>(begin), static_cast<uint32_t>(end)); });
 }
@@ -15,6 +15,8 @@
 #include "core/CDicomImage.h"
 
 #include <QImage>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 /**
@@ -55,6 +57,26 @@ class CImageConverter
     const CColorPalette &palette() const;
     ///@}
 
+    /** @name Parallelism */
+    ///@{
+    /**
+     * @brief Sets the minimum number of pixels converted per parallel band
+     *
+     * Rows are grouped into bands of at least this many pixels and
+     * converted on CThreadPool::shared(); images below one band are
+     * converted on the calling thread.
+     *
+     * @param pixels Pixels per band (0 restores the default)
+     */
+    void setGrainSize(size_t pixels);
+
+    /**
+     * @brief Gets the minimum number of pixels converted per parallel band
+     * @return Pixels per band
+     */
+    size_t grainSize() const;
+    ///@}
+
     /** @name Conversion Methods */
     ///@{
     /**
@@ -86,6 +108,25 @@ class CImageConverter
     QImage convertMonochrome(const CDicomImage &image,
                              const DicomViewer::SWindowLevel &wl) const;
 
+    /**
+     * @brief Converts monochrome pixels with the SIMD window/level kernels
+     * @param pixels First pixel byte
+     * @param dims Image dimensions
+     * @param is16bit True for 16-bit samples
+     * @param isSigned True for signed 16-bit samples
+     * @param wl Window/level settings for contrast adjustment
+     * @param invert True to invert output (MONOCHROME1)
+     * @param useColorPalette True to expand through the current palette
+     * @return QImage with applied palette
+     */
+    QImage convertMonochromeSimd(const uint8_t *pixels,
+                                 const DicomViewer::SImageDimensions &dims,
+                                 bool is16bit,
+                                 bool isSigned,
+                                 const DicomViewer::SWindowLevel &wl,
+                                 bool invert,
+                                 bool useColorPalette) const;
+
     /**
      * @brief Converts RGB DICOM image to QImage
      * @param image Source DICOM image
@@ -94,19 +135,16 @@ class CImageConverter
     QImage convertRgb(const CDicomImage &image) const;
 
     /**
-     * @brief Builds lookup table for window/level transformation
-     * @param wl Window/level settings
-     * @param minValue Minimum input value
-     * @param maxValue Maximum input value
-     * @param invertForMonochrome1 True to invert output values
-     * @return Lookup table mapping input values to 8-bit output
+     * @brief Runs a row conversion over the image in parallel bands
+     * @param dims Image dimensions
+     * @param convertRows Callable invoked as convertRows(rowBegin, rowEnd)
      */
-    std::vector<uint8_t> buildWindowLevelLut(
-        const DicomViewer::SWindowLevel &wl,
-        int minValue,
-        int maxValue,
-        bool invertForMonochrome1) const;
+    void forEachRowBand(const DicomViewer::SImageDimensions &dims,
+                        const std::function<void(uint32_t rowBegin, uint32_t rowEnd)> &convertRows) const;
     ///@}
 
+    static constexpr size_t kDefaultGrainPixels = size_t(256) * 1024;
+
     CColorPalette m_palette; /**< Color palette for grayscale images */
+    size_t m_grainPixels = kDefaultGrainPixels; /**< Minimum pixels per parallel band */
 };
@@ -0,0 +1,180 @@
+/**
+ * @file CLutCache.cpp
+ * @brief Implementation of the CLutCache class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CLutCache.h"
+
+#include <algorithm>
+
+/**
+ * @brief Compares two keys field by field
+ * @param other Key to compare with
+ * @return True if both keys describe the same table
+ */
+bool CLutCache::SKey::operator==(const SKey &other) const
+{
+    return center == other.center &&
+           width == other.width &&
+           minValue == other.minValue &&
+           maxValue == other.maxValue &&
+           invert == other.invert &&
+           palette == other.palette;
+}
+
+/**
+ * @brief Constructor
+ * @param capacity Number of tables kept (at least 1)
+ */
+CLutCache::CLutCache(size_t capacity)
+    : m_capacity(std::max<size_t>(1, capacity))
+{
+}
+
+/**
+ * @brief Returns the table for a key, building it on a miss
+ *
+ * Tables are built outside the lock; if two threads miss on the same
+ * key at once, both build and the first one inserted wins.
+ *
+ * @param key Display settings
+ * @param palette Palette matching key.palette (used on a miss)
+ * @return Shared, immutable table
+ */
+std::shared_ptr<const CLutCache::SLut> CLutCache::acquire(const SKey &key,
+                                                          const CColorPalette &palette)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if ((*it)->key == key)
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it);
+                return m_entries.front();
+            }
+        }
+    }
+
+    auto lut = std::make_shared<SLut>();
+    lut->key = key;
+    lut->gray = buildWindowLevelLut({key.center, key.width}, key.minValue, key.maxValue,
+                                    key.invert);
+    if (key.palette != DicomViewer::EPaletteType::Grayscale)
+    {
+        // Fuse the palette so each pixel needs a single lookup
+        const auto &packed = palette.packedLut();
+        lut->rgb.resize(lut->gray.size());
+        std::transform(lut->gray.begin(), lut->gray.end(), lut->rgb.begin(),
+                       [&packed](uint8_t value)
+                       { return packed[value]; });
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_buildCount;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if ((*it)->key == key)
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return m_entries.front();
+        }
+    }
+    m_entries.push_front(std::move(lut));
+    if (m_entries.size() > m_capacity)
+    {
+        m_entries.pop_back();
+    }
+    return m_entries.front();
+}
+
+/**
+ * @brief Drops all cached tables
+ */
+void CLutCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+/**
+ * @brief Number of tables built since construction
+ * @return Miss count
+ */
+size_t CLutCache::buildCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_buildCount;
+}
+
+/**
+ * @brief Process-wide cache shared by all converters
+ * @return Shared cache instance
+ */
+CLutCache &CLutCache::shared()
+{
+    static CLutCache s_cache;
+    return s_cache;
+}
+
+/**
+ * @brief Builds lookup table for window/level transformation
+ * @param wl Window/level settings
+ * @param minValue Minimum input value
+ * @param maxValue Maximum input value
+ * @param invertForMonochrome1 True to invert output values
+ * @return Lookup table mapping input values to 8-bit output
+ */
+std::vector<uint8_t> CLutCache::buildWindowLevelLut(const DicomViewer::SWindowLevel &wl,
+                                                    int minValue,
+                                                    int maxValue,
+                                                    bool invertForMonochrome1)
+{
+    if (maxValue < minValue)
+    {
+        std::swap(minValue, maxValue);
+    }
+
+    const int range = maxValue - minValue + 1;
+    std::vector<uint8_t> lut(static_cast<size_t>(range));
+
+    if (wl.width <= 0.0)
+    {
+        std::fill(lut.begin(), lut.end(), static_cast<uint8_t>(0));
+        return lut;
+    }
+
+    const double lowerBound = wl.center - (wl.width / 2.0);
+    const double upperBound = wl.center + (wl.width / 2.0);
+    const double scale = 255.0 / wl.width;
+
+    for (int i = 0; i < range; ++i)
+    {
+        const double rawValue = static_cast<double>(minValue + i);
+        uint8_t value;
+
+        if (rawValue <= lowerBound)
+        {
+            value = 0;
+        }
+        else if (rawValue >= upperBound)
+        {
+            value = 255;
+        }
+        else
+        {
+            value = static_cast<uint8_t>((rawValue - lowerBound) * scale);
+        }
+
+        if (invertForMonochrome1)
+        {
+            value = 255 - value;
+        }
+
+        lut[static_cast<size_t>(i)] = value;
+    }
+
+    return lut;
+}
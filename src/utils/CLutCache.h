@@ -0,0 +1,113 @@
+/**
+ * @file CLutCache.h
+ * @brief Cache of window/level display lookup tables
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CLutCache class which keeps recently used window/level
+ * lookup tables, each fused with its palette, so repeated renders with
+ * the same settings do no table work at all.
+ */
+
+#pragma once
+
+#include "CColorPalette.h"
+#include "DicomViewer/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class CLutCache
+ * @brief Small MRU cache of window/level LUTs keyed by display settings
+ *
+ * A table covers only the stored value range of the image it was built
+ * for, not the full 16-bit domain. Palette tables map a raw value
+ * straight to packed RGB, so converting a pixel takes one lookup.
+ *
+ * Thread-safe; entries are immutable and shared with callers.
+ */
+class CLutCache
+{
+  public:
+    static constexpr size_t kDefaultCapacity = 8;
+
+    /**
+     * @brief Everything a table depends on
+     */
+    struct SKey
+    {
+        double center = 0.0;
+        double width = 0.0;
+        int minValue = 0;
+        int maxValue = 255;
+        bool invert = false;
+        DicomViewer::EPaletteType palette = DicomViewer::EPaletteType::Grayscale;
+
+        bool operator==(const SKey &other) const;
+    };
+
+    /**
+     * @brief Lookup tables for one key, indexed by (value - minValue)
+     */
+    struct SLut
+    {
+        SKey key;
+        std::vector<uint8_t> gray; /**< Display value per raw value */
+        std::vector<uint32_t> rgb; /**< Packed R, G, B, 0 per raw value (palettes only) */
+    };
+
+    /**
+     * @brief Constructor
+     * @param capacity Number of tables kept (at least 1)
+     */
+    explicit CLutCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Returns the table for @p key, building it on a miss
+     * @param key Display settings
+     * @param palette Palette matching key.palette (used on a miss)
+     * @return Shared, immutable table
+     */
+    std::shared_ptr<const SLut> acquire(const SKey &key, const CColorPalette &palette);
+
+    /**
+     * @brief Drops all cached tables
+     */
+    void clear();
+
+    /**
+     * @brief Number of tables built since construction
+     * @return Miss count
+     */
+    size_t buildCount() const;
+
+    /**
+     * @brief Process-wide cache shared by all converters
+     * @return Shared cache instance
+     */
+    static CLutCache &shared();
+
+    /**
+     * @brief Builds lookup table for window/level transformation
+     * @param wl Window/level settings
+     * @param minValue Minimum input value
+     * @param maxValue Maximum input value
+     * @param invertForMonochrome1 True to invert output values
+     * @return Lookup table mapping input values to 8-bit output
+     */
+    static std::vector<uint8_t> buildWindowLevelLut(const DicomViewer::SWindowLevel &wl,
+                                                    int minValue,
+                                                    int maxValue,
+                                                    bool invertForMonochrome1);
+
+  private:
+    mutable std::mutex m_mutex;
+    std::list<std::shared_ptr<const SLut>> m_entries; /**< Front = most recently used */
+    size_t m_capacity = kDefaultCapacity;
+    size_t m_buildCount = 0;
+};
@@ -0,0 +1,551 @@
+/**
+ * @file CProjectionKernel.cpp
+ * @brief Implementation of the CProjectionKernel class
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Dispatch follows CWindowLevelKernel: SSE2 is compiled unconditionally
+ * on x86-64, AVX2 kernels carry a per-function target attribute and
+ * only run after the CPU reports support. SSE2 has no unsigned 16-bit
+ * min/max, so unsigned samples are biased by 0x8000 and compared
+ * signed.
+ */
+
+#include "CProjectionKernel.h"
+
+#include "CWindowLevelKernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DICOMVIEWER_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DICOMVIEWER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DICOMVIEWER_TARGET_AVX2
+#endif
+
+namespace
+{
+using EExtremum = CProjectionKernel::EExtremum;
+using EInstructionSet = CWindowLevelKernel::EInstructionSet;
+
+/**
+ * @brief Sample value as stored in the volume
+ */
+template <bool Signed>
+inline int32_t sampleValue(uint16_t sample)
+{
+    if constexpr (Signed)
+    {
+        return static_cast<int16_t>(sample);
+    }
+    else
+    {
+        return sample;
+    }
+}
+
+/**
+ * @brief Checks whether @p candidate replaces @p current
+ */
+template <bool Signed, EExtremum Extremum>
+inline bool replaces(uint16_t candidate, uint16_t current)
+{
+    if constexpr (Extremum == EExtremum::Maximum)
+    {
+        return sampleValue<Signed>(candidate) > sampleValue<Signed>(current);
+    }
+    else
+    {
+        return sampleValue<Signed>(candidate) < sampleValue<Signed>(current);
+    }
+}
+
+/** @name Scalar reference; also handles the tails of the SIMD loops */
+///@{
+template <bool Signed, EExtremum Extremum>
+void reduceScalar(const uint16_t *src, size_t begin, size_t count, uint16_t *dst)
+{
+    for (size_t i = begin; i < count; ++i)
+    {
+        if (replaces<Signed, Extremum>(src[i], dst[i]))
+        {
+            dst[i] = src[i];
+        }
+    }
+}
+
+template <bool Signed, EExtremum Extremum>
+size_t slideScalar(const uint16_t *entering, const uint16_t *leaving, size_t begin, size_t count,
+                   uint16_t *dst, uint32_t *stale, size_t staleCount)
+{
+    for (size_t i = begin; i < count; ++i)
+    {
+        const uint16_t current = dst[i];
+        if (replaces<Signed, Extremum>(entering[i], current))
+        {
+            dst[i] = entering[i];
+        }
+        else if (leaving[i] == current && entering[i] != current)
+        {
+            stale[staleCount++] = static_cast<uint32_t>(i);
+        }
+    }
+    return staleCount;
+}
+
+template <bool Signed, bool Subtract>
+void accumulateScalar(const uint16_t *src, size_t begin, size_t count, int32_t *sums)
+{
+    for (size_t i = begin; i < count; ++i)
+    {
+        if constexpr (Subtract)
+        {
+            sums[i] -= sampleValue<Signed>(src[i]);
+        }
+        else
+        {
+            sums[i] += sampleValue<Signed>(src[i]);
+        }
+    }
+}
+
+template <bool Signed>
+void averageScalar(const int32_t *sums, float scale, size_t begin, size_t count, uint16_t *dst)
+{
+    constexpr long kLowest = Signed ? -32768 : 0;
+    constexpr long kHighest = Signed ? 32767 : 65535;
+    for (size_t i = begin; i < count; ++i)
+    {
+        // Same float reciprocal and round-to-nearest as the SIMD paths
+        const long mean = std::lrint(static_cast<float>(sums[i]) * scale);
+        dst[i] = static_cast<uint16_t>(std::clamp(mean, kLowest, kHighest));
+    }
+}
+///@}
+
+#if defined(DICOMVIEWER_X86_SIMD)
+
+/** @name SSE2 (8 samples per iteration) */
+///@{
+template <bool Signed, EExtremum Extremum>
+inline __m128i extremumSse2(__m128i a, __m128i b)
+{
+    if constexpr (!Signed)
+    {
+        const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+        return _mm_xor_si128(extremumSse2<true, Extremum>(_mm_xor_si128(a, bias),
+                                                          _mm_xor_si128(b, bias)),
+                             bias);
+    }
+    else if constexpr (Extremum == EExtremum::Maximum)
+    {
+        return _mm_max_epi16(a, b);
+    }
+    else
+    {
+        return _mm_min_epi16(a, b);
+    }
+}
+
+template <bool Signed, EExtremum Extremum>
+void reduceSse2(const uint16_t *src, size_t count, uint16_t *dst)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto *target = reinterpret_cast<__m128i *>(dst + i);
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(target, extremumSse2<Signed, Extremum>(_mm_loadu_si128(target), value));
+    }
+    reduceScalar<Signed, Extremum>(src, i, count, dst);
+}
+
+template <bool Signed, EExtremum Extremum>
+size_t slideSse2(const uint16_t *entering, const uint16_t *leaving, size_t count, uint16_t *dst,
+                 uint32_t *stale)
+{
+    size_t staleCount = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto *target = reinterpret_cast<__m128i *>(dst + i);
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(entering + i));
+        const __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i *>(leaving + i));
+        const __m128i current = _mm_loadu_si128(target);
+        const __m128i next = extremumSse2<Signed, Extremum>(current, in);
+        _mm_storeu_si128(target, next);
+
+        // Stale: the old extremum leaves and the entering sample did not replace it
+        const int mask = _mm_movemask_epi8(
+            _mm_andnot_si128(_mm_cmpeq_epi16(next, in), _mm_cmpeq_epi16(out, current)));
+        if (mask != 0)
+        {
+            for (int lane = 0; lane < 8; ++lane)
+            {
+                if (mask & (1 << (2 * lane)))
+                {
+                    stale[staleCount++] = static_cast<uint32_t>(i + lane);
+                }
+            }
+        }
+    }
+    return slideScalar<Signed, Extremum>(entering, leaving, i, count, dst, stale, staleCount);
+}
+
+template <bool Signed, bool Subtract>
+void accumulateSse2(const uint16_t *src, size_t count, int32_t *sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i lo, hi;
+        if constexpr (Signed)
+        {
+            lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        }
+        else
+        {
+            lo = _mm_unpacklo_epi16(v, zero);
+            hi = _mm_unpackhi_epi16(v, zero);
+        }
+        auto *s0 = reinterpret_cast<__m128i *>(sums + i);
+        auto *s1 = reinterpret_cast<__m128i *>(sums + i + 4);
+        if constexpr (Subtract)
+        {
+            _mm_storeu_si128(s0, _mm_sub_epi32(_mm_loadu_si128(s0), lo));
+            _mm_storeu_si128(s1, _mm_sub_epi32(_mm_loadu_si128(s1), hi));
+        }
+        else
+        {
+            _mm_storeu_si128(s0, _mm_add_epi32(_mm_loadu_si128(s0), lo));
+            _mm_storeu_si128(s1, _mm_add_epi32(_mm_loadu_si128(s1), hi));
+        }
+    }
+    accumulateScalar<Signed, Subtract>(src, i, count, sums);
+}
+
+template <bool Signed>
+void averageSse2(const int32_t *sums, float scaleValue, size_t count, uint16_t *dst)
+{
+    const __m128 scale = _mm_set1_ps(scaleValue);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i a = _mm_cvtps_epi32(_mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + i))), scale));
+        __m128i b = _mm_cvtps_epi32(_mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + i + 4))), scale));
+        __m128i packed;
+        if constexpr (Signed)
+        {
+            packed = _mm_packs_epi32(a, b);
+        }
+        else
+        {
+            // No packus_epi32 before SSE4.1: pack biased, then unbias
+            const __m128i bias = _mm_set1_epi32(32768);
+            a = _mm_sub_epi32(a, bias);
+            b = _mm_sub_epi32(b, bias);
+            packed = _mm_xor_si128(_mm_packs_epi32(a, b), _mm_set1_epi16(static_cast<short>(0x8000)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    }
+    averageScalar<Signed>(sums, scaleValue, i, count, dst);
+}
+///@}
+
+/** @name AVX2 (16 samples per iteration) */
+///@{
+template <bool Signed, EExtremum Extremum>
+DICOMVIEWER_TARGET_AVX2 inline __m256i extremumAvx2(__m256i a, __m256i b)
+{
+    if constexpr (Extremum == EExtremum::Maximum)
+    {
+        return Signed ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+    }
+    else
+    {
+        return Signed ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+    }
+}
+
+template <bool Signed, EExtremum Extremum>
+DICOMVIEWER_TARGET_AVX2 void reduceAvx2(const uint16_t *src, size_t count, uint16_t *dst)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        auto *target = reinterpret_cast<__m256i *>(dst + i);
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(target,
+                            extremumAvx2<Signed, Extremum>(_mm256_loadu_si256(target), value));
+    }
+    reduceScalar<Signed, Extremum>(src, i, count, dst);
+}
+
+template <bool Signed, EExtremum Extremum>
+DICOMVIEWER_TARGET_AVX2 size_t slideAvx2(const uint16_t *entering, const uint16_t *leaving,
+                                         size_t count, uint16_t *dst, uint32_t *stale)
+{
+    size_t staleCount = 0;
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        auto *target = reinterpret_cast<__m256i *>(dst + i);
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(entering + i));
+        const __m256i out = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(leaving + i));
+        const __m256i current = _mm256_loadu_si256(target);
+        const __m256i next = extremumAvx2<Signed, Extremum>(current, in);
+        _mm256_storeu_si256(target, next);
+
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_andnot_si256(_mm256_cmpeq_epi16(next, in), _mm256_cmpeq_epi16(out, current))));
+        if (mask != 0)
+        {
+            for (int lane = 0; lane < 16; ++lane)
+            {
+                if (mask & (1u << (2 * lane)))
+                {
+                    stale[staleCount++] = static_cast<uint32_t>(i + lane);
+                }
+            }
+        }
+    }
+    return slideScalar<Signed, Extremum>(entering, leaving, i, count, dst, stale, staleCount);
+}
+
+template <bool Signed, bool Subtract>
+DICOMVIEWER_TARGET_AVX2 void accumulateAvx2(const uint16_t *src, size_t count, int32_t *sums)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+        const __m256i lo = Signed ? _mm256_cvtepi16_epi32(v0) : _mm256_cvtepu16_epi32(v0);
+        const __m256i hi = Signed ? _mm256_cvtepi16_epi32(v1) : _mm256_cvtepu16_epi32(v1);
+        auto *s0 = reinterpret_cast<__m256i *>(sums + i);
+        auto *s1 = reinterpret_cast<__m256i *>(sums + i + 8);
+        if constexpr (Subtract)
+        {
+            _mm256_storeu_si256(s0, _mm256_sub_epi32(_mm256_loadu_si256(s0), lo));
+            _mm256_storeu_si256(s1, _mm256_sub_epi32(_mm256_loadu_si256(s1), hi));
+        }
+        else
+        {
+            _mm256_storeu_si256(s0, _mm256_add_epi32(_mm256_loadu_si256(s0), lo));
+            _mm256_storeu_si256(s1, _mm256_add_epi32(_mm256_loadu_si256(s1), hi));
+        }
+    }
+    accumulateScalar<Signed, Subtract>(src, i, count, sums);
+}
+
+template <bool Signed>
+DICOMVIEWER_TARGET_AVX2 void averageAvx2(const int32_t *sums, float scaleValue, size_t count,
+                                         uint16_t *dst)
+{
+    const __m256 scale = _mm256_set1_ps(scaleValue);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(
+            _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + i))),
+            scale));
+        const __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(
+            _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + i + 8))),
+            scale));
+        // Packs work per 128-bit lane; restore sample order afterwards
+        const __m256i packed = Signed ? _mm256_packs_epi32(a, b) : _mm256_packus_epi32(a, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    averageScalar<Signed>(sums, scaleValue, i, count, dst);
+}
+///@}
+
+#endif // DICOMVIEWER_X86_SIMD
+
+template <bool Signed, EExtremum Extremum>
+void reduceDispatch(EInstructionSet isa, const uint16_t *src, size_t count, uint16_t *dst)
+{
+    switch (isa)
+    {
+#if defined(DICOMVIEWER_X86_SIMD)
+    case EInstructionSet::Avx2:
+        reduceAvx2<Signed, Extremum>(src, count, dst);
+        return;
+    case EInstructionSet::Sse2:
+        reduceSse2<Signed, Extremum>(src, count, dst);
+        return;
+#endif
+    default:
+        reduceScalar<Signed, Extremum>(src, 0, count, dst);
+        return;
+    }
+}
+
+template <bool Signed, EExtremum Extremum>
+size_t slideDispatch(EInstructionSet isa, const uint16_t *entering, const uint16_t *leaving,
+                     size_t count, uint16_t *dst, uint32_t *stale)
+{
+    switch (isa)
+    {
+#if defined(DICOMVIEWER_X86_SIMD)
+    case EInstructionSet::Avx2:
+        return slideAvx2<Signed, Extremum>(entering, leaving, count, dst, stale);
+    case EInstructionSet::Sse2:
+        return slideSse2<Signed, Extremum>(entering, leaving, count, dst, stale);
+#endif
+    default:
+        return slideScalar<Signed, Extremum>(entering, leaving, 0, count, dst, stale, 0);
+    }
+}
+
+template <bool Signed, bool Subtract>
+void accumulateDispatch(EInstructionSet isa, const uint16_t *src, size_t count, int32_t *sums)
+{
+    switch (isa)
+    {
+#if defined(DICOMVIEWER_X86_SIMD)
+    case EInstructionSet::Avx2:
+        accumulateAvx2<Signed, Subtract>(src, count, sums);
+        return;
+    case EInstructionSet::Sse2:
+        accumulateSse2<Signed, Subtract>(src, count, sums);
+        return;
+#endif
+    default:
+        accumulateScalar<Signed, Subtract>(src, 0, count, sums);
+        return;
+    }
+}
+
+template <bool Signed>
+void averageDispatch(EInstructionSet isa, const int32_t *sums, float scale, size_t count,
+                     uint16_t *dst)
+{
+    switch (isa)
+    {
+#if defined(DICOMVIEWER_X86_SIMD)
+    case EInstructionSet::Avx2:
+        averageAvx2<Signed>(sums, scale, count, dst);
+        return;
+    case EInstructionSet::Sse2:
+        averageSse2<Signed>(sums, scale, count, dst);
+        return;
+#endif
+    default:
+        averageScalar<Signed>(sums, scale, 0, count, dst);
+        return;
+    }
+}
+} // namespace
+
+/**
+ * @brief Folds one slice into a running extremum
+ * @param extremum Maximum or minimum
+ * @param src Samples of the slice entering the slab
+ * @param isSigned True to compare as int16_t
+ * @param count Number of samples
+ * @param dst Running extremum, updated in place
+ */
+void CProjectionKernel::reduce(EExtremum extremum, const uint16_t *src, bool isSigned, size_t count,
+                               uint16_t *dst)
+{
+    const EInstructionSet isa = CWindowLevelKernel::instructionSet();
+    const bool maximum = extremum == EExtremum::Maximum;
+    if (isSigned)
+    {
+        maximum ? reduceDispatch<true, EExtremum::Maximum>(isa, src, count, dst)
+                : reduceDispatch<true, EExtremum::Minimum>(isa, src, count, dst);
+    }
+    else
+    {
+        maximum ? reduceDispatch<false, EExtremum::Maximum>(isa, src, count, dst)
+                : reduceDispatch<false, EExtremum::Minimum>(isa, src, count, dst);
+    }
+}
+
+/**
+ * @brief Moves a slab by one slice
+ * @param extremum Maximum or minimum
+ * @param entering Samples of the slice entering the slab
+ * @param leaving Samples of the slice leaving the slab
+ * @param isSigned True to compare as int16_t
+ * @param count Number of samples
+ * @param dst Running extremum, updated in place
+ * @param stale Receives the indices to recompute
+ * @return Number of indices written to stale
+ */
+size_t CProjectionKernel::slide(EExtremum extremum, const uint16_t *entering,
+                                const uint16_t *leaving, bool isSigned, size_t count,
+                                uint16_t *dst, uint32_t *stale)
+{
+    const EInstructionSet isa = CWindowLevelKernel::instructionSet();
+    const bool maximum = extremum == EExtremum::Maximum;
+    if (isSigned)
+    {
+        return maximum
+                   ? slideDispatch<true, EExtremum::Maximum>(isa, entering, leaving, count, dst, stale)
+                   : slideDispatch<true, EExtremum::Minimum>(isa, entering, leaving, count, dst, stale);
+    }
+    return maximum
+               ? slideDispatch<false, EExtremum::Maximum>(isa, entering, leaving, count, dst, stale)
+               : slideDispatch<false, EExtremum::Minimum>(isa, entering, leaving, count, dst, stale);
+}
+
+/**
+ * @brief Adds or subtracts one slice to/from running sums
+ * @param src Samples of the slice
+ * @param isSigned True to widen as int16_t
+ * @param count Number of samples
+ * @param subtract True when the slice leaves the slab
+ * @param sums Running sums, updated in place
+ */
+void CProjectionKernel::accumulate(const uint16_t *src, bool isSigned, size_t count, bool subtract,
+                                   int32_t *sums)
+{
+    const EInstructionSet isa = CWindowLevelKernel::instructionSet();
+    if (isSigned)
+    {
+        subtract ? accumulateDispatch<true, true>(isa, src, count, sums)
+                 : accumulateDispatch<true, false>(isa, src, count, sums);
+    }
+    else
+    {
+        subtract ? accumulateDispatch<false, true>(isa, src, count, sums)
+                 : accumulateDispatch<false, false>(isa, src, count, sums);
+    }
+}
+
+/**
+ * @brief Converts running sums to rounded means
+ * @param sums Running sums
+ * @param slices Number of slices summed
+ * @param isSigned True to store int16_t means
+ * @param count Number of samples
+ * @param dst Output samples
+ */
+void CProjectionKernel::average(const int32_t *sums, uint32_t slices, bool isSigned, size_t count,
+                                uint16_t *dst)
+{
+    const EInstructionSet isa = CWindowLevelKernel::instructionSet();
+    const float scale = 1.0f / static_cast<float>(std::max(slices, 1u));
+    if (isSigned)
+    {
+        averageDispatch<true>(isa, sums, scale, count, dst);
+    }
+    else
+    {
+        averageDispatch<false>(isa, sums, scale, count, dst);
+    }
+}
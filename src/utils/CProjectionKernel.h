@@ -0,0 +1,97 @@
+/**
+ * @file CProjectionKernel.h
+ * @brief SIMD reductions across slices for intensity projections
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CProjectionKernel class which folds runs of 16-bit
+ * samples from one slice into a running maximum, minimum or 32-bit
+ * sum, using SSE2 or AVX2 selected at runtime (see
+ * CWindowLevelKernel::instructionSet()). Pure C++ (no Qt).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class CProjectionKernel
+ * @brief Per-sample reductions used by slab projections
+ *
+ * Samples are passed as uint16_t bit patterns and compared as int16_t
+ * when @c isSigned is true, matching CVolume's voxel layout. Every
+ * function processes one contiguous run; callers split images into
+ * row bands and call them once per slice.
+ */
+class CProjectionKernel
+{
+  public:
+    /**
+     * @brief Extremum kept by reduce() and slide()
+     */
+    enum class EExtremum
+    {
+        Maximum,
+        Minimum
+    };
+
+    /** @name Extremum Projections */
+    ///@{
+    /**
+     * @brief Folds one slice into a running extremum
+     * @param extremum Maximum or minimum
+     * @param src Samples of the slice entering the slab
+     * @param isSigned True to compare as int16_t
+     * @param count Number of samples
+     * @param dst Running extremum, updated in place
+     */
+    static void reduce(EExtremum extremum, const uint16_t *src, bool isSigned, size_t count,
+                       uint16_t *dst);
+
+    /**
+     * @brief Moves a slab by one slice
+     *
+     * Folds @p entering into @p dst and lists the samples whose
+     * extremum may have left with @p leaving: those where the old
+     * extremum equals the leaving sample and the entering one does not
+     * replace it. Only these need recomputing over the new slab.
+     *
+     * @param extremum Maximum or minimum
+     * @param entering Samples of the slice entering the slab
+     * @param leaving Samples of the slice leaving the slab
+     * @param isSigned True to compare as int16_t
+     * @param count Number of samples
+     * @param dst Running extremum, updated in place
+     * @param stale Receives the indices to recompute (room for @p count)
+     * @return Number of indices written to @p stale
+     */
+    static size_t slide(EExtremum extremum, const uint16_t *entering, const uint16_t *leaving,
+                        bool isSigned, size_t count, uint16_t *dst, uint32_t *stale);
+    ///@}
+
+    /** @name Average Projections */
+    ///@{
+    /**
+     * @brief Adds or subtracts one slice to/from running sums
+     * @param src Samples of the slice
+     * @param isSigned True to widen as int16_t
+     * @param count Number of samples
+     * @param subtract True when the slice leaves the slab
+     * @param sums Running sums, updated in place
+     */
+    static void accumulate(const uint16_t *src, bool isSigned, size_t count, bool subtract,
+                           int32_t *sums);
+
+    /**
+     * @brief Converts running sums to rounded means
+     * @param sums Running sums
+     * @param slices Number of slices summed (> 0)
+     * @param isSigned True to store int16_t means
+     * @param count Number of samples
+     * @param dst Output samples
+     */
+    static void average(const int32_t *sums, uint32_t slices, bool isSigned, size_t count,
+                        uint16_t *dst);
+    ///@}
+};
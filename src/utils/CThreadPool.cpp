@@ -0,0 +1,268 @@
+/**
+ * @file CThreadPool.cpp
+ * @brief Implementation of the CThreadPool class
+ * @author DICOM Viewer Project
+ * @date 2026
+ */
+
+#include "CThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+CThreadPool::CThreadPool(size_t threadCount, size_t maxQueueSize)
+{
+    const size_t workers = threadCount > 0 ? threadCount : defaultThreadCount();
+    m_maxQueueSize = maxQueueSize > 0 ? maxQueueSize : workers * 4;
+
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+    {
+        m_workers.emplace_back([this]()
+                               { workerLoop(); });
+    }
+}
+
+CThreadPool::~CThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_tasks.clear();
+    }
+    m_taskAvailable.notify_all();
+    m_spaceAvailable.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+bool CThreadPool::submit(Task task)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_spaceAvailable.wait(lock, [this]()
+                              { return m_stopping || m_tasks.size() < m_maxQueueSize; });
+        if (m_stopping)
+        {
+            return false;
+        }
+        m_tasks.push_back(std::move(task));
+    }
+    m_taskAvailable.notify_one();
+    return true;
+}
+
+bool CThreadPool::trySubmit(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_tasks.size() >= m_maxQueueSize)
+        {
+            return false;
+        }
+        m_tasks.push_back(std::move(task));
+    }
+    m_taskAvailable.notify_one();
+    return true;
+}
+
+size_t CThreadPool::cancelPending()
+{
+    size_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dropped = m_tasks.size();
+        m_tasks.clear();
+        if (m_activeTasks == 0)
+        {
+            m_idle.notify_all();
+        }
+    }
+    m_spaceAvailable.notify_all();
+    return dropped;
+}
+
+void CThreadPool::waitForIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]()
+                { return m_tasks.empty() && m_activeTasks == 0; });
+}
+
+void CThreadPool::parallelFor(size_t count, size_t grain,
+                              const std::function<void(size_t begin, size_t end)> &body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    grain = std::max<size_t>(1, grain);
+    const size_t chunkCount = (count + grain - 1) / grain;
+    if (chunkCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Shared with helpers, which may start after the caller has returned;
+    // by then no chunk is left and they exit without touching body.
+    struct SState
+    {
+        std::function<void(size_t, size_t)> body;
+        size_t count = 0;
+        size_t grain = 0;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<bool> failed{false};
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t finishedChunks = 0;
+        std::exception_ptr error; /**< First exception thrown by body */
+    };
+    auto state = std::make_shared<SState>();
+    state->body = body;
+    state->count = count;
+    state->grain = grain;
+    state->chunkCount = chunkCount;
+
+    auto work = [](SState &s)
+    {
+        for (;;)
+        {
+            const size_t chunk = s.nextChunk.fetch_add(1);
+            if (chunk >= s.chunkCount)
+            {
+                return;
+            }
+            // After a failure the remaining chunks are counted, not run
+            std::exception_ptr error;
+            if (!s.failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    const size_t begin = chunk * s.grain;
+                    s.body(begin, std::min(s.count, begin + s.grain));
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    s.failed = true;
+                }
+            }
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (error && !s.error)
+            {
+                s.error = error;
+            }
+            if (++s.finishedChunks == s.chunkCount)
+            {
+                s.done.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = std::min(threadCount(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        if (!trySubmit([state, work]()
+                       { work(*state); }))
+        {
+            break;
+        }
+    }
+
+    work(*state);
+
+    // Chunks still running on helpers use the caller's captures: wait for
+    // them even when a chunk failed
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]()
+                     { return state->finishedChunks == state->chunkCount; });
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+size_t CThreadPool::threadCount() const
+{
+    return m_workers.size();
+}
+
+size_t CThreadPool::maxQueueSize() const
+{
+    return m_maxQueueSize;
+}
+
+size_t CThreadPool::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tasks.size();
+}
+
+bool CThreadPool::isWorkerThread() const
+{
+    const auto id = std::this_thread::get_id();
+    return std::any_of(m_workers.begin(), m_workers.end(),
+                       [id](const std::thread &worker)
+                       { return worker.get_id() == id; });
+}
+
+size_t CThreadPool::defaultThreadCount()
+{
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+CThreadPool &CThreadPool::shared()
+{
+    static CThreadPool s_pool;
+    return s_pool;
+}
+
+void CThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskAvailable.wait(lock, [this]()
+                                 { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_activeTasks;
+        }
+        m_spaceAvailable.notify_one();
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // A throwing task must not take the worker down or leave
+            // m_activeTasks raised, which would hang waitForIdle()
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeTasks;
+            if (m_activeTasks == 0 && m_tasks.empty())
+            {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
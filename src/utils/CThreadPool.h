@@ -0,0 +1,146 @@
+/**
+ * @file CThreadPool.h
+ * @brief Fixed-size worker pool with a bounded task queue
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CThreadPool class used to run decoding and conversion
+ * work off the GUI thread. Pure C++ (no Qt) so it can be shared by
+ * the core, infrastructure and utility layers.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class CThreadPool
+ * @brief Runs queued tasks on a fixed set of worker threads
+ *
+ * The queue is bounded: submit() blocks while it is full and
+ * trySubmit() fails instead, so producers that must not block (the
+ * GUI thread) can keep their own backlog and feed the pool as
+ * workers free up. Pending tasks can be dropped with cancelPending();
+ * tasks already running are always allowed to finish.
+ */
+class CThreadPool
+{
+  public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param threadCount Number of workers (0 = one per hardware thread)
+     * @param maxQueueSize Maximum queued tasks (0 = 4 x thread count)
+     */
+    explicit CThreadPool(size_t threadCount = 0, size_t maxQueueSize = 0);
+
+    /**
+     * @brief Destructor - drops pending tasks and joins all workers
+     */
+    ~CThreadPool();
+
+    /** @name Non-copyable, Non-movable */
+    ///@{
+    CThreadPool(const CThreadPool &) = delete;
+    CThreadPool &operator=(const CThreadPool &) = delete;
+    ///@}
+
+    /** @name Task Submission */
+    ///@{
+    /**
+     * @brief Queues a task, blocking while the queue is full
+     *
+     * Exceptions thrown by the task are swallowed; tasks that need to
+     * report failure must catch and forward it themselves.
+     *
+     * @param task Task to run
+     * @return False if the pool is shutting down
+     */
+    bool submit(Task task);
+
+    /**
+     * @brief Queues a task if there is room, without blocking
+     * @param task Task to run
+     * @return False if the queue is full or the pool is shutting down
+     */
+    bool trySubmit(Task task);
+
+    /**
+     * @brief Drops all tasks that have not started yet
+     * @return Number of dropped tasks
+     */
+    size_t cancelPending();
+
+    /**
+     * @brief Blocks until the queue is empty and no task is running
+     */
+    void waitForIdle();
+
+    /**
+     * @brief Runs @p body over [0, count) split into chunks of @p grain
+     *
+     * The calling thread works on chunks too and returns once all of
+     * them are done. Helpers are queued with trySubmit(), so a full or
+     * busy pool degrades to the caller doing the work instead of
+     * blocking. The caller only waits for chunks that have started, never
+     * for queued helpers, so calling from one of the pool's own workers
+     * cannot deadlock. Chunk boundaries only depend on @p count and
+     * @p grain.
+     *
+     * If @p body throws, no further chunks are started; once the chunks
+     * already running have finished, the first exception is rethrown
+     * on the calling thread.
+     *
+     * @param count Number of items
+     * @param grain Items per chunk (0 = 1)
+     * @param body Callable invoked as body(begin, end) for each chunk
+     */
+    void parallelFor(size_t count, size_t grain,
+                     const std::function<void(size_t begin, size_t end)> &body);
+    ///@}
+
+    /** @name Properties */
+    ///@{
+    size_t threadCount() const;
+    size_t maxQueueSize() const;
+    size_t pendingCount() const;
+
+    /**
+     * @brief Checks if the calling thread is one of this pool's workers
+     * @return True when called from a worker
+     */
+    bool isWorkerThread() const;
+    ///@}
+
+    /**
+     * @brief Number of hardware threads (at least 1)
+     * @return Default worker count
+     */
+    static size_t defaultThreadCount();
+
+    /**
+     * @brief Process-wide pool for short data-parallel work (rendering)
+     * @return Pool with one worker per hardware thread
+     */
+    static CThreadPool &shared();
+
+  private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<Task> m_tasks;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+    std::condition_variable m_spaceAvailable;
+    std::condition_variable m_idle;
+    size_t m_maxQueueSize = 0;
+    size_t m_activeTasks = 0;
+    bool m_stopping = false;
+};
@@ -0,0 +1,378 @@
+/**
+ * @file CWindowLevelKernel.cpp
+ * @brief Implementation of the CWindowLevelKernel class
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * SSE2 is the x86-64 baseline and is compiled unconditionally there.
+ * AVX2 kernels are compiled with a per-function target attribute (no
+ * global -mavx2 flag) and only run after the CPU reports support.
+ */
+
+#include "CWindowLevelKernel.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DICOMVIEWER_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DICOMVIEWER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DICOMVIEWER_TARGET_AVX2
+#endif
+
+namespace
+{
+using ESampleFormat = CWindowLevelKernel::ESampleFormat;
+using EInstructionSet = CWindowLevelKernel::EInstructionSet;
+
+/**
+ * @brief Display values produced per palette expansion block
+ */
+constexpr size_t kRgbBlockSize = 256;
+
+/**
+ * @brief Bytes per source sample
+ */
+size_t bytesPerSample(ESampleFormat format)
+{
+    return format == ESampleFormat::Unsigned8 ? 1 : 2;
+}
+
+/**
+ * @brief Reads sample @p index as a float
+ */
+template <ESampleFormat Format>
+float loadSample(const uint8_t *src, size_t index)
+{
+    if constexpr (Format == ESampleFormat::Unsigned8)
+    {
+        return static_cast<float>(src[index]);
+    }
+    else if constexpr (Format == ESampleFormat::Unsigned16)
+    {
+        return static_cast<float>(reinterpret_cast<const uint16_t *>(src)[index]);
+    }
+    else
+    {
+        return static_cast<float>(reinterpret_cast<const int16_t *>(src)[index]);
+    }
+}
+
+/**
+ * @brief Scalar reference; also handles the tails of the SIMD loops
+ */
+template <ESampleFormat Format>
+void grayScalar(const uint8_t *src, size_t begin, size_t count,
+                float lower, float scale, bool invert, uint8_t *dst)
+{
+    const uint8_t invertMask = invert ? 0xFF : 0x00;
+    for (size_t i = begin; i < count; ++i)
+    {
+        float t = (loadSample<Format>(src, i) - lower) * scale;
+        t = std::min(std::max(t, 0.0f), 255.0f);
+        dst[i] = static_cast<uint8_t>(static_cast<uint8_t>(t) ^ invertMask);
+    }
+}
+
+#if defined(DICOMVIEWER_X86_SIMD)
+
+/** @name SSE2 (16 samples per iteration) */
+///@{
+inline __m128i windowSse2(__m128i values, __m128 lower, __m128 scale)
+{
+    __m128 x = _mm_cvtepi32_ps(values);
+    x = _mm_mul_ps(_mm_sub_ps(x, lower), scale);
+    x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    return _mm_cvttps_epi32(x);
+}
+
+template <ESampleFormat Format>
+void graySse2(const uint8_t *src, size_t count, float lowerValue, float scaleValue,
+              bool invert, uint8_t *dst)
+{
+    const __m128 lower = _mm_set1_ps(lowerValue);
+    const __m128 scale = _mm_set1_ps(scaleValue);
+    const __m128i invertMask = _mm_set1_epi8(invert ? static_cast<char>(0xFF) : 0);
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a, b, c, d;
+        if constexpr (Format == ESampleFormat::Unsigned8)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            a = _mm_unpacklo_epi16(lo, zero);
+            b = _mm_unpackhi_epi16(lo, zero);
+            c = _mm_unpacklo_epi16(hi, zero);
+            d = _mm_unpackhi_epi16(hi, zero);
+        }
+        else
+        {
+            const auto *p = reinterpret_cast<const __m128i *>(src + i * 2);
+            const __m128i v0 = _mm_loadu_si128(p);
+            const __m128i v1 = _mm_loadu_si128(p + 1);
+            if constexpr (Format == ESampleFormat::Unsigned16)
+            {
+                a = _mm_unpacklo_epi16(v0, zero);
+                b = _mm_unpackhi_epi16(v0, zero);
+                c = _mm_unpacklo_epi16(v1, zero);
+                d = _mm_unpackhi_epi16(v1, zero);
+            }
+            else
+            {
+                // Duplicate each word into both halves, then sign-extend
+                a = _mm_srai_epi32(_mm_unpacklo_epi16(v0, v0), 16);
+                b = _mm_srai_epi32(_mm_unpackhi_epi16(v0, v0), 16);
+                c = _mm_srai_epi32(_mm_unpacklo_epi16(v1, v1), 16);
+                d = _mm_srai_epi32(_mm_unpackhi_epi16(v1, v1), 16);
+            }
+        }
+
+        const __m128i ab = _mm_packs_epi32(windowSse2(a, lower, scale),
+                                           windowSse2(b, lower, scale));
+        const __m128i cd = _mm_packs_epi32(windowSse2(c, lower, scale),
+                                           windowSse2(d, lower, scale));
+        const __m128i out = _mm_xor_si128(_mm_packus_epi16(ab, cd), invertMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), out);
+    }
+
+    grayScalar<Format>(src, i, count, lowerValue, scaleValue, invert, dst);
+}
+///@}
+
+/** @name AVX2 (32 samples per iteration) */
+///@{
+DICOMVIEWER_TARGET_AVX2 inline __m256i windowAvx2(__m256i values, __m256 lower, __m256 scale)
+{
+    __m256 x = _mm256_cvtepi32_ps(values);
+    x = _mm256_mul_ps(_mm256_sub_ps(x, lower), scale);
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()), _mm256_set1_ps(255.0f));
+    return _mm256_cvttps_epi32(x);
+}
+
+template <ESampleFormat Format>
+DICOMVIEWER_TARGET_AVX2 inline __m256i widenAvx2(const uint8_t *src, size_t index)
+{
+    if constexpr (Format == ESampleFormat::Unsigned8)
+    {
+        return _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + index)));
+    }
+    else if constexpr (Format == ESampleFormat::Unsigned16)
+    {
+        return _mm256_cvtepu16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + index * 2)));
+    }
+    else
+    {
+        return _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + index * 2)));
+    }
+}
+
+template <ESampleFormat Format>
+DICOMVIEWER_TARGET_AVX2 void grayAvx2(const uint8_t *src, size_t count, float lowerValue,
+                                      float scaleValue, bool invert, uint8_t *dst)
+{
+    const __m256 lower = _mm256_set1_ps(lowerValue);
+    const __m256 scale = _mm256_set1_ps(scaleValue);
+    const __m256i invertMask = _mm256_set1_epi8(invert ? static_cast<char>(0xFF) : 0);
+    // packs/packus interleave 128-bit lanes; this restores sample order
+    const __m256i laneOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i a = windowAvx2(widenAvx2<Format>(src, i), lower, scale);
+        const __m256i b = windowAvx2(widenAvx2<Format>(src, i + 8), lower, scale);
+        const __m256i c = windowAvx2(widenAvx2<Format>(src, i + 16), lower, scale);
+        const __m256i d = windowAvx2(widenAvx2<Format>(src, i + 24), lower, scale);
+
+        const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b),
+                                                   _mm256_packs_epi32(c, d));
+        const __m256i out = _mm256_xor_si256(
+            _mm256_permutevar8x32_epi32(packed, laneOrder), invertMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), out);
+    }
+
+    grayScalar<Format>(src, i, count, lowerValue, scaleValue, invert, dst);
+}
+///@}
+
+/**
+ * @brief Queries CPUID/XGETBV for AVX2 with OS-enabled YMM state
+ */
+bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // DICOMVIEWER_X86_SIMD
+
+template <ESampleFormat Format>
+void grayDispatch(EInstructionSet isa, const uint8_t *src, size_t count,
+                  float lower, float scale, bool invert, uint8_t *dst)
+{
+    switch (isa)
+    {
+#if defined(DICOMVIEWER_X86_SIMD)
+    case EInstructionSet::Avx2:
+        grayAvx2<Format>(src, count, lower, scale, invert, dst);
+        return;
+    case EInstructionSet::Sse2:
+        graySse2<Format>(src, count, lower, scale, invert, dst);
+        return;
+#endif
+    default:
+        grayScalar<Format>(src, 0, count, lower, scale, invert, dst);
+        return;
+    }
+}
+
+EInstructionSet detectInstructionSet()
+{
+#if defined(DICOMVIEWER_X86_SIMD)
+    return cpuSupportsAvx2() ? EInstructionSet::Avx2 : EInstructionSet::Sse2;
+#else
+    return EInstructionSet::Scalar;
+#endif
+}
+} // namespace
+
+/**
+ * @brief Constructor
+ * @param wl Window/level to apply (width <= 0 maps everything to 0)
+ * @param invert True to invert the output (MONOCHROME1)
+ */
+CWindowLevelKernel::CWindowLevelKernel(const DicomViewer::SWindowLevel &wl, bool invert)
+{
+    if (wl.width <= 0.0)
+    {
+        // Degenerate window: everything maps to black, never inverted
+        return;
+    }
+    m_lower = static_cast<float>(wl.center - (wl.width / 2.0));
+    m_scale = static_cast<float>(255.0 / wl.width);
+    m_invert = invert;
+}
+
+/**
+ * @brief Maps samples to 8-bit display values
+ * @param src First source sample
+ * @param format Source sample layout
+ * @param count Number of samples
+ * @param dst Output buffer of count bytes
+ */
+void CWindowLevelKernel::toGray(const void *src, ESampleFormat format, size_t count,
+                                uint8_t *dst) const
+{
+    const auto *bytes = static_cast<const uint8_t *>(src);
+    const EInstructionSet isa = instructionSet();
+    switch (format)
+    {
+    case ESampleFormat::Unsigned8:
+        grayDispatch<ESampleFormat::Unsigned8>(isa, bytes, count, m_lower, m_scale, m_invert, dst);
+        break;
+    case ESampleFormat::Unsigned16:
+        grayDispatch<ESampleFormat::Unsigned16>(isa, bytes, count, m_lower, m_scale, m_invert, dst);
+        break;
+    case ESampleFormat::Signed16:
+        grayDispatch<ESampleFormat::Signed16>(isa, bytes, count, m_lower, m_scale, m_invert, dst);
+        break;
+    }
+}
+
+/**
+ * @brief Maps samples to RGB24 through a palette in the same pass
+ *
+ * Display values are produced a block at a time into a stack buffer
+ * and expanded immediately, so neither the source nor an intermediate
+ * 8-bit image is traversed twice.
+ *
+ * @param src First source sample
+ * @param format Source sample layout
+ * @param count Number of samples
+ * @param palette Display value to packed RGB table
+ * @param dst Output buffer of 3 x count bytes
+ */
+void CWindowLevelKernel::toRgb(const void *src, ESampleFormat format, size_t count,
+                               const PackedRgbTable &palette, uint8_t *dst) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const auto *bytes = static_cast<const uint8_t *>(src);
+    const size_t stride = bytesPerSample(format);
+    uint8_t block[kRgbBlockSize];
+
+    for (size_t offset = 0; offset < count; offset += kRgbBlockSize)
+    {
+        const size_t n = std::min(kRgbBlockSize, count - offset);
+        toGray(bytes + offset * stride, format, n, block);
+
+        uint8_t *out = dst + offset * 3;
+        const bool isLastBlock = (offset + n == count);
+        const size_t wideCount = isLastBlock ? n - 1 : n;
+        // One 4-byte store per pixel; the spare byte is overwritten by
+        // the next pixel, and the final pixel must not write past dst
+        for (size_t j = 0; j < wideCount; ++j)
+        {
+            std::memcpy(out + j * 3, &palette[block[j]], 4);
+        }
+        if (isLastBlock)
+        {
+            std::memcpy(out + (n - 1) * 3, &palette[block[n - 1]], 3);
+        }
+    }
+}
+
+/**
+ * @brief Instruction set detected on this CPU (evaluated once)
+ * @return Best supported instruction set
+ */
+CWindowLevelKernel::EInstructionSet CWindowLevelKernel::instructionSet()
+{
+    static const EInstructionSet s_instructionSet = detectInstructionSet();
+    return s_instructionSet;
+}
+
+/**
+ * @brief Checks if a SIMD implementation is available
+ * @return True unless the kernels would run scalar code
+ */
+bool CWindowLevelKernel::isAccelerated()
+{
+    return instructionSet() != EInstructionSet::Scalar;
+}
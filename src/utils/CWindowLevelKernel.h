@@ -0,0 +1,111 @@
+/**
+ * @file CWindowLevelKernel.h
+ * @brief SIMD window/level kernels for monochrome pixel rows
+ * @author DICOM Viewer Project
+ * @date 2026
+ *
+ * Defines the CWindowLevelKernel class which maps 8-bit, 16-bit
+ * unsigned and 16-bit signed samples to 8-bit display values (and
+ * optionally to RGB through a palette) using SSE2 or AVX2, selected
+ * at runtime from the CPU's capabilities. Pure C++ (no Qt).
+ */
+
+#pragma once
+
+#include "DicomViewer/Types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class CWindowLevelKernel
+ * @brief Applies one window/level setting to runs of pixels
+ *
+ * Window/level is evaluated directly in vector registers as
+ * clamp((value - lower) * 255 / width, 0, 255), truncated, and
+ * optionally inverted for MONOCHROME1. The RGB variants expand each
+ * block of display values through the palette while it is still in
+ * cache, so a row is read and written exactly once.
+ *
+ * Callers should check isAccelerated() and keep their own scalar
+ * path for CPUs without SIMD support.
+ */
+class CWindowLevelKernel
+{
+  public:
+    /**
+     * @brief Layout of the source samples
+     */
+    enum class ESampleFormat
+    {
+        Unsigned8,
+        Unsigned16,
+        Signed16
+    };
+
+    /**
+     * @brief Instruction set used by the kernels
+     */
+    enum class EInstructionSet
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /**
+     * @brief Display value to RGB, packed as R, G, B, 0 in memory order
+     */
+    using PackedRgbTable = std::array<uint32_t, 256>;
+
+    /**
+     * @brief Constructor
+     * @param wl Window/level to apply (width <= 0 maps everything to 0)
+     * @param invert True to invert the output (MONOCHROME1)
+     */
+    CWindowLevelKernel(const DicomViewer::SWindowLevel &wl, bool invert);
+
+    /** @name Row Conversion */
+    ///@{
+    /**
+     * @brief Maps samples to 8-bit display values
+     * @param src First source sample
+     * @param format Source sample layout
+     * @param count Number of samples
+     * @param dst Output buffer of @p count bytes
+     */
+    void toGray(const void *src, ESampleFormat format, size_t count, uint8_t *dst) const;
+
+    /**
+     * @brief Maps samples to RGB24 through a palette in the same pass
+     * @param src First source sample
+     * @param format Source sample layout
+     * @param count Number of samples
+     * @param palette Display value to packed RGB table (see CColorPalette::packedLut())
+     * @param dst Output buffer of 3 x @p count bytes
+     */
+    void toRgb(const void *src, ESampleFormat format, size_t count,
+               const PackedRgbTable &palette, uint8_t *dst) const;
+    ///@}
+
+    /** @name CPU Dispatch */
+    ///@{
+    /**
+     * @brief Instruction set detected on this CPU (evaluated once)
+     * @return Best supported instruction set
+     */
+    static EInstructionSet instructionSet();
+
+    /**
+     * @brief Checks if a SIMD implementation is available
+     * @return True unless the kernels would run scalar code
+     */
+    static bool isAccelerated();
+    ///@}
+
+  private:
+    float m_lower = 0.0f; /**< Window lower bound */
+    float m_scale = 0.0f; /**< 255 / window width */
+    bool m_invert = false;
+};